@@ -335,6 +335,7 @@
         'src/core/lib/iomgr/timer_generic.cc',
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/timer_uv.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
@@ -374,10 +375,12 @@
         'src/core/lib/transport/bdp_estimator.cc',
         'src/core/lib/transport/byte_stream.cc',
         'src/core/lib/transport/connectivity_state.cc',
+        'src/core/lib/transport/delivery_rate_estimator.cc',
         'src/core/lib/transport/error_utils.cc',
         'src/core/lib/transport/metadata.cc',
         'src/core/lib/transport/metadata_batch.cc',
         'src/core/lib/transport/pid_controller.cc',
+        'src/core/lib/transport/rtt_estimator.cc',
         'src/core/lib/transport/static_metadata.cc',
         'src/core/lib/transport/status_conversion.cc',
         'src/core/lib/transport/status_metadata.cc',
@@ -408,6 +411,7 @@
         'src/core/ext/transport/chttp2/transport/parsing.cc',
         'src/core/ext/transport/chttp2/transport/stream_lists.cc',
         'src/core/ext/transport/chttp2/transport/stream_map.cc',
+        'src/core/ext/transport/chttp2/transport/write_scheduler.cc',
         'src/core/ext/transport/chttp2/transport/varint.cc',
         'src/core/ext/transport/chttp2/transport/writing.cc',
         'src/core/ext/transport/chttp2/alpn/alpn.cc',
@@ -751,6 +755,7 @@
         'src/core/lib/iomgr/timer_generic.cc',
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/timer_uv.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
@@ -790,10 +795,12 @@
         'src/core/lib/transport/bdp_estimator.cc',
         'src/core/lib/transport/byte_stream.cc',
         'src/core/lib/transport/connectivity_state.cc',
+        'src/core/lib/transport/delivery_rate_estimator.cc',
         'src/core/lib/transport/error_utils.cc',
         'src/core/lib/transport/metadata.cc',
         'src/core/lib/transport/metadata_batch.cc',
         'src/core/lib/transport/pid_controller.cc',
+        'src/core/lib/transport/rtt_estimator.cc',
         'src/core/lib/transport/static_metadata.cc',
         'src/core/lib/transport/status_conversion.cc',
         'src/core/lib/transport/status_metadata.cc',
@@ -871,6 +878,7 @@
         'src/core/ext/transport/chttp2/transport/parsing.cc',
         'src/core/ext/transport/chttp2/transport/stream_lists.cc',
         'src/core/ext/transport/chttp2/transport/stream_map.cc',
+        'src/core/ext/transport/chttp2/transport/write_scheduler.cc',
         'src/core/ext/transport/chttp2/transport/varint.cc',
         'src/core/ext/transport/chttp2/transport/writing.cc',
         'src/core/ext/transport/chttp2/alpn/alpn.cc',
@@ -1020,6 +1028,7 @@
         'src/core/lib/iomgr/timer_generic.cc',
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/timer_uv.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
@@ -1059,10 +1068,12 @@
         'src/core/lib/transport/bdp_estimator.cc',
         'src/core/lib/transport/byte_stream.cc',
         'src/core/lib/transport/connectivity_state.cc',
+        'src/core/lib/transport/delivery_rate_estimator.cc',
         'src/core/lib/transport/error_utils.cc',
         'src/core/lib/transport/metadata.cc',
         'src/core/lib/transport/metadata_batch.cc',
         'src/core/lib/transport/pid_controller.cc',
+        'src/core/lib/transport/rtt_estimator.cc',
         'src/core/lib/transport/static_metadata.cc',
         'src/core/lib/transport/status_conversion.cc',
         'src/core/lib/transport/status_metadata.cc',
@@ -1140,6 +1151,7 @@
         'src/core/ext/transport/chttp2/transport/parsing.cc',
         'src/core/ext/transport/chttp2/transport/stream_lists.cc',
         'src/core/ext/transport/chttp2/transport/stream_map.cc',
+        'src/core/ext/transport/chttp2/transport/write_scheduler.cc',
         'src/core/ext/transport/chttp2/transport/varint.cc',
         'src/core/ext/transport/chttp2/transport/writing.cc',
         'src/core/ext/transport/chttp2/alpn/alpn.cc',
@@ -1265,6 +1277,7 @@
         'src/core/lib/iomgr/timer_generic.cc',
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/timer_uv.cc',
         'src/core/lib/iomgr/udp_server.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
@@ -1304,10 +1317,12 @@
         'src/core/lib/transport/bdp_estimator.cc',
         'src/core/lib/transport/byte_stream.cc',
         'src/core/lib/transport/connectivity_state.cc',
+        'src/core/lib/transport/delivery_rate_estimator.cc',
         'src/core/lib/transport/error_utils.cc',
         'src/core/lib/transport/metadata.cc',
         'src/core/lib/transport/metadata_batch.cc',
         'src/core/lib/transport/pid_controller.cc',
+        'src/core/lib/transport/rtt_estimator.cc',
         'src/core/lib/transport/static_metadata.cc',
         'src/core/lib/transport/status_conversion.cc',
         'src/core/lib/transport/status_metadata.cc',
@@ -1339,6 +1354,7 @@
         'src/core/ext/transport/chttp2/transport/parsing.cc',
         'src/core/ext/transport/chttp2/transport/stream_lists.cc',
         'src/core/ext/transport/chttp2/transport/stream_map.cc',
+        'src/core/ext/transport/chttp2/transport/write_scheduler.cc',
         'src/core/ext/transport/chttp2/transport/varint.cc',
         'src/core/ext/transport/chttp2/transport/writing.cc',
         'src/core/ext/transport/chttp2/alpn/alpn.cc',
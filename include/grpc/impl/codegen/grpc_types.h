@@ -197,6 +197,13 @@ typedef struct {
 #define GRPC_ARG_HTTP2_MAX_FRAME_SIZE "grpc.http2.max_frame_size"
 /** Should BDP probing be performed? */
 #define GRPC_ARG_HTTP2_BDP_PROBE "grpc.http2.bdp_probe"
+/** How BDP probes size the receive window, string valued: "bdp_pid" (the
+    default) smooths the estimated BDP with a PID controller; "delivery_rate"
+    (experimental) tracks the max delivery rate and min round trip time of
+    recent probes in the style of BBR. BM_StreamingRampUp_Trickle in
+    bm_fullstack_trickle compares their time to full throughput and peak
+    window. */
+#define GRPC_ARG_HTTP2_WINDOW_STRATEGY "grpc.http2.window_strategy"
 /** Minimum time between sending successive ping frames without receiving any
     data frame, Int valued, milliseconds. */
 #define GRPC_ARG_HTTP2_MIN_SENT_PING_INTERVAL_WITHOUT_DATA_MS \
@@ -219,6 +226,21 @@ typedef struct {
 /** How much data are we willing to queue up per stream if
     GRPC_WRITE_BUFFER_HINT is set? This is an upper bound */
 #define GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE "grpc.http2.write_buffer_size"
+/** How should writes be shared between streams? "fifo" (the default) lets
+    each stream write everything it can when its turn comes, "wdrr" (weighted
+    deficit round robin) bounds each turn to a share proportional to the
+    stream's weight, which calls can set with a "grpc-priority" metadata
+    element valued 1 to 256 (default 16). String valued. */
+#define GRPC_ARG_HTTP2_WRITE_SCHEDULER "grpc.http2.write_scheduler"
+/** How long, in microseconds, may a write smaller than the transport's target
+    write size be held back so that frames becoming ready in the meantime are
+    sent along with it? Trades latency for fewer, larger writes when many
+    streams each have a little to send. Frames that become ready end the hold
+    once it has lasted this long, but a write that no more frames join waits
+    for a timer with millisecond granularity: it may be held for up to this
+    value rounded up to whole milliseconds, and for at least 1ms. Defaults to
+    0 (never hold writes). */
+#define GRPC_ARG_HTTP2_WRITE_CORK_US "grpc.http2.write_cork_us"
 /** Should we allow receipt of true-binary data on http2 connections?
     Defaults to on (1) */
 #define GRPC_ARG_HTTP2_ENABLE_TRUE_BINARY "grpc.http2.true_binary"
@@ -233,6 +255,12 @@ typedef struct {
     Int valued, 0(false)/1(true). */
 #define GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS \
   "grpc.keepalive_permit_without_calls"
+/** Makes keepalive adaptive: while a connection has no calls, each keepalive
+    ping doubles the time until the next one, up to this value. The first call
+    brings it back to GRPC_ARG_KEEPALIVE_TIME_MS. Only matters along with
+    GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS. Int valued, milliseconds; no
+    higher than GRPC_ARG_KEEPALIVE_TIME_MS (the default) disables it. */
+#define GRPC_ARG_KEEPALIVE_MAX_TIME_MS "grpc.keepalive_max_time_ms"
 /** Default authority to pass if none specified on call construction. A string.
  * */
 #define GRPC_ARG_DEFAULT_AUTHORITY "grpc.default_authority"
@@ -304,6 +332,11 @@ typedef struct {
  * channel tracing to be disabled. */
 #define GRPC_ARG_MAX_CHANNEL_TRACE_EVENT_MEMORY_PER_NODE \
   "grpc.max_channel_trace_event_memory_per_node"
+/** Channel arg (integer) setting how many arenas of finished calls a channel
+ * keeps around to allocate later calls from, so that calls in the steady
+ * state do not malloc their call state. 0 disables this. Defaults to 4, and
+ * is capped at 16. */
+#define GRPC_ARG_CALL_ARENA_POOL_SIZE "grpc.call_arena_pool_size"
 /** If non-zero, gRPC library will track stats and information at at per channel
  * level. Disabling channelz naturally disables channel tracing. The default
  * is for channelz to be enabled. */
@@ -323,6 +356,27 @@ typedef struct {
   "grpc.experimental.tcp_min_read_chunk_size"
 #define GRPC_ARG_TCP_MAX_READ_CHUNK_SIZE \
   "grpc.experimental.tcp_max_read_chunk_size"
+/** Channel arg (boolean) enabling MSG_ZEROCOPY sends on TCP endpoints when
+   the platform supports it. Defaults to false. */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_tx_zerocopy_enabled"
+/** Channel arg (integer) setting the minimum size, in bytes, of a write for it
+   to be sent with MSG_ZEROCOPY. Smaller writes are copied into the kernel as
+   usual. */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_tx_zerocopy_send_bytes_threshold"
+/** Channel arg (integer) setting the maximum number of zerocopy writes whose
+   buffers may be held by the kernel at the same time on one endpoint. Writes
+   beyond this limit are copied. */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS \
+  "grpc.experimental.tcp_tx_zerocopy_max_simultaneous_sends"
+/** Channel arg (integer) setting SO_BUSY_POLL, in microseconds, on the sockets
+   accepted by a server where the platform supports it. The kernel then busy
+   polls the device queue on blocking receives instead of waiting for an
+   interrupt. Values above net.core.busy_poll need CAP_NET_ADMIN. If setting
+   it fails, the error is logged once and later sockets are left alone.
+   Defaults to 0 (disabled). */
+#define GRPC_ARG_TCP_BUSY_POLL_US "grpc.experimental.tcp_busy_poll_us"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_call_timeout_ms"
@@ -481,6 +535,15 @@ typedef enum grpc_call_error {
    GRPC_INITIAL_METADATA_WAIT_FOR_READY_EXPLICITLY_SET | \
    GRPC_INITIAL_METADATA_CORKED | GRPC_WRITE_THROUGH)
 
+/** Receive message flags */
+/** Receive several messages in one operation: grpc_op.data.recv_message
+    points to an array of max_messages byte buffers. The operation completes
+    once a first message has been received, together with as many of the
+    messages right behind it as had already been received in full by then. */
+#define GRPC_RECV_MESSAGE_BATCH (0x00000001u)
+/** Mask of all valid flags */
+#define GRPC_RECV_MESSAGE_USED_MASK GRPC_RECV_MESSAGE_BATCH
+
 /** A single metadata element */
 typedef struct grpc_metadata {
   /** the key, value values are expected to line up with grpc_mdelem: if
@@ -641,6 +704,13 @@ typedef struct grpc_op {
        */
     struct grpc_op_recv_message {
       struct grpc_byte_buffer** recv_message;
+      /** Only read with GRPC_RECV_MESSAGE_BATCH: recv_message then points to
+          an array of max_messages byte buffers, and the number of messages
+          received is stored in *message_count. Zero messages mean that
+          trailing metadata was received, in which case recv_message[0] is
+          NULL. */
+      size_t max_messages;
+      size_t* message_count;
     } recv_message;
     struct grpc_op_recv_status_on_client {
       /** ownership of the array is with the caller, but ownership of the
@@ -19,6 +19,7 @@
 #ifndef GRPCPP_CHANNEL_IMPL_H
 #define GRPCPP_CHANNEL_IMPL_H
 
+#include <chrono>
 #include <memory>
 #include <mutex>
 
@@ -69,6 +70,13 @@ class Channel final : public ::grpc::ChannelInterface,
   /// not available.
   grpc::string GetServiceConfigJSON() const;
 
+  /// Gets the round trip times that the channel's connections measured with
+  /// HTTP/2 pings: the average of their smoothed round trip times, and the
+  /// smallest of their recent ones. Returns false if no connection measured
+  /// one yet, or if channelz is disabled (see GRPC_ARG_ENABLE_CHANNELZ).
+  bool GetRoundTripTimes(std::chrono::microseconds* smoothed_rtt,
+                         std::chrono::microseconds* min_rtt) const;
+
  private:
   template <class InputMessage, class OutputMessage>
   friend class ::grpc::internal::BlockingUnaryCallImpl;
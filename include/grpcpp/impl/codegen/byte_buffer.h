@@ -56,6 +56,8 @@ namespace internal {
 class CallOpSendMessage;
 template <class R>
 class CallOpRecvMessage;
+template <class R>
+class CallOpRecvMessages;
 class CallOpGenericRecvMessage;
 class ExternalConnectionAcceptorImpl;
 template <class R>
@@ -168,6 +170,8 @@ class ByteBuffer final {
   friend class internal::CallOpSendMessage;
   template <class R>
   friend class internal::CallOpRecvMessage;
+  template <class R>
+  friend class internal::CallOpRecvMessages;
   friend class internal::CallOpGenericRecvMessage;
   template <class ServiceType, class RequestType, class ResponseType>
   friend class ::grpc_impl::internal::RpcMethodHandler;
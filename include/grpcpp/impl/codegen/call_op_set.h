@@ -22,6 +22,7 @@
 #include <cstring>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/impl/codegen/grpc_types.h>
@@ -491,6 +492,93 @@ class CallOpRecvMessage {
   bool hijacked_ = false;
 };
 
+/// Receives up to max_messages messages in one operation: the first one, and
+/// after it those that the transport already holds in full. Calls with
+/// interceptors receive a single message, so that each message still goes
+/// through the POST_RECV_MESSAGE hook.
+template <class R>
+class CallOpRecvMessages {
+ public:
+  CallOpRecvMessages()
+      : got_message(false), messages_(nullptr), max_messages_(0) {}
+
+  void RecvMessages(std::vector<R>* messages, size_t max_messages) {
+    GPR_CODEGEN_ASSERT(max_messages > 0);
+    messages_ = messages;
+    max_messages_ = max_messages;
+  }
+
+  bool got_message;
+
+ protected:
+  void AddOp(grpc_op* ops, size_t* nops) {
+    if (messages_ == nullptr || hijacked_) return;
+    recv_bufs_.resize(max_messages_);
+    message_count_ = 0;
+    grpc_op* op = &ops[(*nops)++];
+    op->op = GRPC_OP_RECV_MESSAGE;
+    op->flags = max_messages_ > 1 ? GRPC_RECV_MESSAGE_BATCH : 0;
+    op->reserved = NULL;
+    // ByteBuffer has the representation of a grpc_byte_buffer*
+    op->data.recv_message.recv_message = recv_bufs_[0].c_buffer_ptr();
+    op->data.recv_message.max_messages = max_messages_;
+    op->data.recv_message.message_count = &message_count_;
+  }
+
+  void FinishOp(bool* status) {
+    if (messages_ == nullptr || hijacked_) return;
+    if (max_messages_ == 1) message_count_ = recv_bufs_[0].Valid() ? 1 : 0;
+    got_message = *status && message_count_ > 0;
+    // Existing elements are reused as deserialization targets
+    messages_->resize(got_message ? message_count_ : 0);
+    for (size_t i = 0; i < message_count_; i++) {
+      if (got_message) {
+        got_message = SerializationTraits<R>::Deserialize(
+                          recv_bufs_[i].bbuf_ptr(), &(*messages_)[i])
+                          .ok();
+        recv_bufs_[i].Release();
+      } else {
+        recv_bufs_[i].Clear();
+      }
+    }
+    if (!got_message) {
+      messages_->clear();
+      *status = false;
+    }
+  }
+
+  void SetInterceptionHookPoint(
+      InterceptorBatchMethodsImpl* interceptor_methods) {
+    if (messages_ == nullptr) return;
+    if (interceptor_methods->InterceptorsListEmpty()) return;
+    max_messages_ = 1;
+    messages_->resize(1);
+    interceptor_methods->SetRecvMessage(&(*messages_)[0], &got_message);
+  }
+
+  void SetFinishInterceptionHookPoint(
+      InterceptorBatchMethodsImpl* interceptor_methods) {
+    if (messages_ == nullptr) return;
+    interceptor_methods->AddInterceptionHookPoint(
+        experimental::InterceptionHookPoints::POST_RECV_MESSAGE);
+    if (!got_message) interceptor_methods->SetRecvMessage(nullptr, nullptr);
+  }
+  void SetHijackingState(InterceptorBatchMethodsImpl* interceptor_methods) {
+    hijacked_ = true;
+    if (messages_ == nullptr) return;
+    interceptor_methods->AddInterceptionHookPoint(
+        experimental::InterceptionHookPoints::PRE_RECV_MESSAGE);
+    got_message = true;
+  }
+
+ private:
+  std::vector<R>* messages_;
+  size_t max_messages_;
+  std::vector<ByteBuffer> recv_bufs_;
+  size_t message_count_ = 0;
+  bool hijacked_ = false;
+};
+
 class DeserializeFunc {
  public:
   virtual Status Deserialize(ByteBuffer* buf) = 0;
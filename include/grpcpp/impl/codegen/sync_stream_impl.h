@@ -153,6 +153,21 @@ class ClientReaderInterface : public internal::ClientStreamingInterface,
   /// the first read. Calling this method is optional, and if it is not called
   /// the metadata will be available in ClientContext after the first read.
   virtual void WaitForInitialMetadata() = 0;
+
+  /// Replace the contents of \a msgs with up to \a max_messages messages:
+  /// the next one, and as many of those after it as have already been
+  /// received in full. Returns false, leaving \a msgs empty, where \a
+  /// ReaderInterface::Read would. The default implementation reads one
+  /// message with \a ReaderInterface::Read.
+  virtual bool ReadMessages(std::vector<R>* msgs, size_t max_messages) {
+    GPR_CODEGEN_ASSERT(max_messages > 0);
+    msgs->resize(1);
+    if (!this->Read(&msgs->front())) {
+      msgs->clear();
+      return false;
+    }
+    return true;
+  }
 };
 
 namespace internal {
@@ -214,6 +229,19 @@ class ClientReader final : public ClientReaderInterface<R> {
     return cq_.Pluck(&ops) && ops.got_message;
   }
 
+  /// See the \a ClientReaderInterface.ReadMessages method for semantics.
+  bool ReadMessages(std::vector<R>* msgs, size_t max_messages) override {
+    ::grpc::internal::CallOpSet<::grpc::internal::CallOpRecvInitialMetadata,
+                                ::grpc::internal::CallOpRecvMessages<R>>
+        ops;
+    if (!context_->initial_metadata_received_) {
+      ops.RecvInitialMetadata(context_);
+    }
+    ops.RecvMessages(msgs, max_messages);
+    call_.PerformOps(&ops);
+    return cq_.Pluck(&ops) && ops.got_message;
+  }
+
   /// See the \a ClientStreamingInterface.Finish method for semantics.
   ///
   /// Side effect:
@@ -424,6 +452,21 @@ class ClientReaderWriterInterface : public internal::ClientStreamingInterface,
   ///
   /// \return Whether the writes were successful.
   virtual bool WritesDone() = 0;
+
+  /// Replace the contents of \a msgs with up to \a max_messages messages:
+  /// the next one, and as many of those after it as have already been
+  /// received in full. Returns false, leaving \a msgs empty, where \a
+  /// ReaderInterface::Read would. The default implementation reads one
+  /// message with \a ReaderInterface::Read.
+  virtual bool ReadMessages(std::vector<R>* msgs, size_t max_messages) {
+    GPR_CODEGEN_ASSERT(max_messages > 0);
+    msgs->resize(1);
+    if (!this->Read(&msgs->front())) {
+      msgs->clear();
+      return false;
+    }
+    return true;
+  }
 };
 
 namespace internal {
@@ -483,6 +526,20 @@ class ClientReaderWriter final : public ClientReaderWriterInterface<W, R> {
     return cq_.Pluck(&ops) && ops.got_message;
   }
 
+  /// See the \a ClientReaderWriterInterface.ReadMessages method for
+  /// semantics.
+  bool ReadMessages(std::vector<R>* msgs, size_t max_messages) override {
+    ::grpc::internal::CallOpSet<::grpc::internal::CallOpRecvInitialMetadata,
+                                ::grpc::internal::CallOpRecvMessages<R>>
+        ops;
+    if (!context_->initial_metadata_received_) {
+      ops.RecvInitialMetadata(context_);
+    }
+    ops.RecvMessages(msgs, max_messages);
+    call_.PerformOps(&ops);
+    return cq_.Pluck(&ops) && ops.got_message;
+  }
+
   /// See the \a WriterInterface.Write method for semantics.
   ///
   /// Side effect:
@@ -21,6 +21,8 @@
 
 #include <stdint.h>
 
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <grpcpp/impl/codegen/call.h>
 #include <grpcpp/support/async_stream.h>
@@ -44,6 +46,7 @@ class MockClientReader : public ::grpc_impl::ClientReaderInterface<R> {
 
   /// ClientReaderInterface
   MOCK_METHOD0_T(WaitForInitialMetadata, void());
+  MOCK_METHOD2_T(ReadMessages, bool(std::vector<R>*, size_t));
 };
 
 template <class W>
@@ -80,6 +83,7 @@ class MockClientReaderWriter
   /// ClientReaderWriterInterface
   MOCK_METHOD0_T(WaitForInitialMetadata, void());
   MOCK_METHOD0_T(WritesDone, bool());
+  MOCK_METHOD2_T(ReadMessages, bool(std::vector<R>*, size_t));
 };
 
 /// TODO: We do not support mocking an async RPC for now.
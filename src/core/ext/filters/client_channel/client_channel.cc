@@ -374,35 +374,28 @@ class CallData {
                  GRPC_ERROR_NONE);
     }
 
-    iterator begin() const override {
-      static_assert(sizeof(grpc_linked_mdelem*) <= sizeof(intptr_t),
-                    "iterator size too large");
-      return iterator(this, reinterpret_cast<intptr_t>(batch_->list.head));
-    }
+    // Iterator handles are positions in the batch
+    iterator begin() const override { return iterator(this, 0); }
     iterator end() const override {
-      static_assert(sizeof(grpc_linked_mdelem*) <= sizeof(intptr_t),
-                    "iterator size too large");
-      return iterator(this, 0);
+      return iterator(this, static_cast<intptr_t>(batch_->list.count));
     }
 
     iterator erase(iterator it) override {
-      grpc_linked_mdelem* linked_mdelem =
-          reinterpret_cast<grpc_linked_mdelem*>(GetIteratorHandle(it));
-      intptr_t handle = reinterpret_cast<intptr_t>(linked_mdelem->next);
-      grpc_metadata_batch_remove(batch_, linked_mdelem);
+      intptr_t handle = GetIteratorHandle(it);
+      grpc_metadata_batch_remove(batch_,
+                                 grpc_metadata_batch_elems(batch_)[handle]);
+      // the next element moved down into our position
       return iterator(this, handle);
     }
 
    private:
     intptr_t IteratorHandleNext(intptr_t handle) const override {
-      grpc_linked_mdelem* linked_mdelem =
-          reinterpret_cast<grpc_linked_mdelem*>(handle);
-      return reinterpret_cast<intptr_t>(linked_mdelem->next);
+      return handle + 1;
     }
     std::pair<StringView, StringView> IteratorHandleGet(
         intptr_t handle) const override {
       grpc_linked_mdelem* linked_mdelem =
-          reinterpret_cast<grpc_linked_mdelem*>(handle);
+          grpc_metadata_batch_elems(batch_)[handle];
       return std::make_pair(StringView(GRPC_MDKEY(linked_mdelem->md)),
                             StringView(GRPC_MDVALUE(linked_mdelem->md)));
     }
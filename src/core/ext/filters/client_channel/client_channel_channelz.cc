@@ -48,6 +48,11 @@ void SubchannelNode::SetChildSocket(RefCountedPtr<SocketNode> socket) {
   child_socket_ = std::move(socket);
 }
 
+RefCountedPtr<SocketNode> SubchannelNode::child_socket() {
+  MutexLock lock(&socket_mu_);
+  return child_socket_;
+}
+
 void SubchannelNode::PopulateConnectivityState(grpc_json* json) {
   grpc_connectivity_state state =
       connectivity_state_.Load(MemoryOrder::RELAXED);
@@ -107,5 +112,31 @@ grpc_json* SubchannelNode::RenderJson() {
   return top_level_json;
 }
 
+bool GetRoundTripTimes(ChannelNode* channel_node, int64_t* smoothed_rtt_us,
+                       int64_t* min_rtt_us) {
+  int64_t smoothed_rtt_sum = 0;
+  int64_t min_rtt = -1;
+  int connections = 0;
+  // The transports publish their estimates to their socket nodes
+  InlinedVector<intptr_t, 8> uuids = channel_node->ChildSubchannels();
+  for (size_t i = 0; i < uuids.size(); ++i) {
+    RefCountedPtr<BaseNode> node = ChannelzRegistry::Get(uuids[i]);
+    if (node == nullptr || node->type() != BaseNode::EntityType::kSubchannel) {
+      continue;
+    }
+    RefCountedPtr<SocketNode> socket =
+        static_cast<SubchannelNode*>(node.get())->child_socket();
+    if (socket == nullptr || socket->smoothed_rtt_us() == 0) continue;
+    smoothed_rtt_sum += socket->smoothed_rtt_us();
+    min_rtt = min_rtt == -1 ? socket->min_rtt_us()
+                            : GPR_MIN(min_rtt, socket->min_rtt_us());
+    ++connections;
+  }
+  if (connections == 0) return false;
+  *smoothed_rtt_us = smoothed_rtt_sum / connections;
+  *min_rtt_us = min_rtt;
+  return true;
+}
+
 }  // namespace channelz
 }  // namespace grpc_core
@@ -44,6 +44,7 @@ class SubchannelNode : public BaseNode {
   // the subchannel's transport is created and set to nullptr when the
   // subchannel unrefs the transport.
   void SetChildSocket(RefCountedPtr<SocketNode> socket);
+  RefCountedPtr<SocketNode> child_socket();
 
   grpc_json* RenderJson() override;
 
@@ -72,6 +73,13 @@ class SubchannelNode : public BaseNode {
   ChannelTrace trace_;
 };
 
+// Gets the round trip times that the connections of the subchannels of
+// \a channel_node measured with HTTP/2 pings: the average of their smoothed
+// round trip times, and the smallest of their recent ones, in microseconds.
+// Returns false if none of them measured one yet.
+bool GetRoundTripTimes(ChannelNode* channel_node, int64_t* smoothed_rtt_us,
+                       int64_t* min_rtt_us);
+
 }  // namespace channelz
 }  // namespace grpc_core
 
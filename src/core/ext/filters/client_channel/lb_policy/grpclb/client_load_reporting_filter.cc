@@ -99,12 +99,15 @@ static void clr_start_transport_stream_op_batch(
   // Handle send_initial_metadata.
   if (batch->send_initial_metadata) {
     // Grab client stats object from metadata.
-    grpc_linked_mdelem* client_stats_md =
-        batch->payload->send_initial_metadata.send_initial_metadata->list.head;
-    for (; client_stats_md != nullptr;
-         client_stats_md = client_stats_md->next) {
-      if (GRPC_SLICE_START_PTR(GRPC_MDKEY(client_stats_md->md)) ==
+    grpc_metadata_batch* send_initial_metadata =
+        batch->payload->send_initial_metadata.send_initial_metadata;
+    grpc_linked_mdelem* client_stats_md = nullptr;
+    for (size_t i = 0; i < send_initial_metadata->list.count; i++) {
+      grpc_linked_mdelem* md =
+          grpc_metadata_batch_elems(send_initial_metadata)[i];
+      if (GRPC_SLICE_START_PTR(GRPC_MDKEY(md->md)) ==
           static_cast<const void*>(grpc_core::kGrpcLbClientStatsMetadataKey)) {
+        client_stats_md = md;
         break;
       }
     }
@@ -122,9 +125,7 @@ static void clr_start_transport_stream_op_batch(
         batch->on_complete = &calld->on_complete_for_send;
       }
       // Remove metadata so it doesn't go out on the wire.
-      grpc_metadata_batch_remove(
-          batch->payload->send_initial_metadata.send_initial_metadata,
-          client_stats_md);
+      grpc_metadata_batch_remove(send_initial_metadata, client_stats_md);
     }
   }
   // Intercept completion of recv_initial_metadata.
@@ -106,6 +106,8 @@ static void write_action_begin_locked(void* t, grpc_error* error);
 static void write_action(void* t, grpc_error* error);
 static void write_action_end(void* t, grpc_error* error);
 static void write_action_end_locked(void* t, grpc_error* error);
+static void write_cork_timer_fired(void* t, grpc_error* error);
+static void write_cork_timer_fired_locked(void* t, grpc_error* error);
 
 static void read_action(void* t, grpc_error* error);
 static void read_action_locked(void* t, grpc_error* error);
@@ -221,6 +223,7 @@ grpc_chttp2_transport::~grpc_chttp2_transport() {
   }
 
   flow_control.Destroy();
+  write_scheduler.Destroy();
 
   GRPC_ERROR_UNREF(closed_with_error);
   gpr_free(ping_acks);
@@ -230,9 +233,10 @@ grpc_chttp2_transport::~grpc_chttp2_transport() {
 static const grpc_transport_vtable* get_vtable(void);
 
 /* Returns whether bdp is enabled */
-static bool read_channel_args(grpc_chttp2_transport* t,
-                              const grpc_channel_args* channel_args,
-                              bool is_client) {
+static bool read_channel_args(
+    grpc_chttp2_transport* t, const grpc_channel_args* channel_args,
+    bool is_client, bool* weighted_writes,
+    grpc_core::chttp2::WindowStrategy* window_strategy) {
   bool enable_bdp = true;
   bool channelz_enabled = GRPC_ENABLE_CHANNELZ_DEFAULT;
   size_t i;
@@ -293,9 +297,31 @@ static bool read_channel_args(grpc_chttp2_transport* t,
                            GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE)) {
       t->write_buffer_size = static_cast<uint32_t>(grpc_channel_arg_get_integer(
           &channel_args->args[i], {0, 0, MAX_WRITE_BUFFER_SIZE}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_CORK_US)) {
+      t->write_cork_us = static_cast<uint32_t>(grpc_channel_arg_get_integer(
+          &channel_args->args[i], {0, 0, INT_MAX}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_SCHEDULER)) {
+      const char* value = grpc_channel_arg_get_string(&channel_args->args[i]);
+      if (value != nullptr && 0 == strcmp(value, "wdrr")) {
+        *weighted_writes = true;
+      } else if (value != nullptr && 0 != strcmp(value, "fifo")) {
+        gpr_log(GPR_ERROR, "%s: unknown write scheduler '%s', using fifo",
+                GRPC_ARG_HTTP2_WRITE_SCHEDULER, value);
+      }
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_HTTP2_BDP_PROBE)) {
       enable_bdp = grpc_channel_arg_get_bool(&channel_args->args[i], true);
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WINDOW_STRATEGY)) {
+      const char* value = grpc_channel_arg_get_string(&channel_args->args[i]);
+      if (value != nullptr && 0 == strcmp(value, "delivery_rate")) {
+        *window_strategy = grpc_core::chttp2::WindowStrategy::kDeliveryRate;
+      } else if (value != nullptr && 0 != strcmp(value, "bdp_pid")) {
+        gpr_log(GPR_ERROR, "%s: unknown window strategy '%s', using bdp_pid",
+                GRPC_ARG_HTTP2_WINDOW_STRATEGY, value);
+      }
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_KEEPALIVE_TIME_MS)) {
       const int value = grpc_channel_arg_get_integer(
@@ -314,6 +340,11 @@ static bool read_channel_args(grpc_chttp2_transport* t,
                                    : g_default_server_keepalive_timeout_ms,
                                0, INT_MAX});
       t->keepalive_timeout = value == INT_MAX ? GRPC_MILLIS_INF_FUTURE : value;
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_KEEPALIVE_MAX_TIME_MS)) {
+      const int value = grpc_channel_arg_get_integer(
+          &channel_args->args[i], grpc_integer_options{0, 0, INT_MAX});
+      t->keepalive_max_time = value;
     } else if (0 == strcmp(channel_args->args[i].key,
                            GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS)) {
       t->keepalive_permit_without_calls = static_cast<uint32_t>(
@@ -409,6 +440,7 @@ static void init_transport_keepalive_settings(grpc_chttp2_transport* t) {
     t->keepalive_permit_without_calls =
         g_default_server_keepalive_permit_without_calls;
   }
+  t->keepalive_max_time = 0;
 }
 
 static void configure_transport_ping_policy(grpc_chttp2_transport* t) {
@@ -420,14 +452,36 @@ static void configure_transport_ping_policy(grpc_chttp2_transport* t) {
       g_default_min_recv_ping_interval_without_data_ms;
 }
 
+/* Time from now until the next keepalive ping, unless something is read
+   first */
+static grpc_millis next_keepalive_time(grpc_chttp2_transport* t) {
+  if (grpc_chttp2_stream_map_size(&t->stream_map) > 0) {
+    return t->keepalive_time;
+  }
+  return GPR_MAX(t->keepalive_idle_time, t->keepalive_time);
+}
+
+/* A new stream ends the idle backoff of keepalive pings. A ping timer set for
+   the longer idle interval is cancelled, and init_keepalive_ping_locked sets it
+   again for keepalive_time. */
+static void reset_keepalive_idle_time(grpc_chttp2_transport* t) {
+  if (t->keepalive_idle_time <= t->keepalive_time) return;
+  t->keepalive_idle_time = t->keepalive_time;
+  if (t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING) {
+    grpc_timer_cancel(&t->keepalive_ping_timer);
+  }
+}
+
 static void init_keepalive_pings_if_enabled(grpc_chttp2_transport* t) {
+  t->keepalive_max_time = GPR_MAX(t->keepalive_max_time, t->keepalive_time);
+  t->keepalive_idle_time = t->keepalive_time;
   if (t->keepalive_time != GRPC_MILLIS_INF_FUTURE) {
     t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
     GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
     GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
                       grpc_schedule_on_exec_ctx);
     grpc_timer_init(&t->keepalive_ping_timer,
-                    grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
+                    grpc_core::ExecCtx::Get()->Now() + next_keepalive_time(t),
                     &t->init_keepalive_ping_locked);
   } else {
     /* Use GRPC_CHTTP2_KEEPALIVE_STATE_DISABLED to indicate there are no
@@ -492,13 +546,24 @@ grpc_chttp2_transport::grpc_chttp2_transport(
   init_transport_keepalive_settings(this);
 
   bool enable_bdp = true;
+  bool weighted_writes = false;
+  grpc_core::chttp2::WindowStrategy window_strategy =
+      grpc_core::chttp2::WindowStrategy::kBdpPid;
   if (channel_args) {
-    enable_bdp = read_channel_args(this, channel_args, is_client);
+    enable_bdp = read_channel_args(this, channel_args, is_client,
+                                   &weighted_writes, &window_strategy);
+  }
+
+  if (weighted_writes) {
+    write_scheduler.Init<grpc_core::chttp2::WeightedDrrWriteScheduler>(
+        grpc_core::chttp2::kDefaultWriteQuantum);
+  } else {
+    write_scheduler.Init<grpc_core::chttp2::FifoWriteScheduler>();
   }
 
   if (g_flow_control_enabled) {
-    flow_control.Init<grpc_core::chttp2::TransportFlowControl>(this,
-                                                               enable_bdp);
+    flow_control.Init<grpc_core::chttp2::TransportFlowControl>(
+        this, enable_bdp, window_strategy);
   } else {
     flow_control.Init<grpc_core::chttp2::TransportFlowControlDisabled>(this);
     enable_bdp = false;
@@ -559,6 +624,10 @@ static void close_transport_locked(grpc_chttp2_transport* t,
       }
       t->close_transport_on_writes_finished =
           grpc_error_add_child(t->close_transport_on_writes_finished, error);
+      if (t->write_corked) {
+        /* send the held back write now rather than when its cork expires */
+        grpc_timer_cancel(&t->write_cork_timer);
+      }
       return;
     }
     GPR_ASSERT(error != GRPC_ERROR_NONE);
@@ -637,6 +706,7 @@ grpc_chttp2_stream::grpc_chttp2_stream(grpc_chttp2_transport* t,
     *t->accepting_stream = this;
     grpc_chttp2_stream_map_add(&t->stream_map, id, this);
     post_destructive_reclaimer(t);
+    reset_keepalive_idle_time(t);
   }
   if (t->flow_control->flow_control_enabled()) {
     flow_control.Init<grpc_core::chttp2::StreamFlowControl>(
@@ -913,6 +983,14 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
     case GRPC_CHTTP2_WRITE_STATE_WRITING:
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE,
                       grpc_chttp2_initiate_write_reason_string(reason));
+      if (t->write_corked) {
+        /* The gathered write is being held back: add the new frames to it
+         * once the combiner is done, as for a fresh write. */
+        t->combiner->FinallyRun(
+            GRPC_CLOSURE_INIT(&t->write_action_begin_locked,
+                              write_action_begin_locked, t, nullptr),
+            GRPC_ERROR_NONE);
+      }
       break;
     case GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE:
       break;
@@ -935,6 +1013,51 @@ static const char* begin_writing_desc(bool partial) {
   }
 }
 
+/* Holds back a write smaller than the target write size for up to
+ * t->write_cork_us, so that frames which become ready in the meantime go out
+ * in the same endpoint write instead of in a string of small ones. Called
+ * each time frames are gathered into t->outbuf; returns true if the write is
+ * (still) being held back.
+ *
+ * New frames end the hold as soon as the write has been held for
+ * write_cork_us. Without them, the hold ends when write_cork_timer fires,
+ * which the timer list rounds up to whole milliseconds. */
+static bool maybe_cork_write(grpc_chttp2_transport* t, bool partial) {
+  if (t->write_cork_us == 0) return false;
+  const bool flush =
+      partial || t->closed_with_error != GRPC_ERROR_NONE ||
+      t->close_transport_on_writes_finished != nullptr ||
+      t->reading_paused_on_pending_induced_frames ||
+      t->outbuf.length >= grpc_chttp2_target_write_size(t);
+  if (!t->write_corked) {
+    /* a cancelled timer may still be about to run its closure */
+    if (flush || t->have_write_cork_timer) return false;
+    GRPC_STATS_INC_HTTP2_WRITES_CORKED();
+    t->write_corked = true;
+    t->have_write_cork_timer = true;
+    t->write_cork_start = gpr_now(GPR_CLOCK_MONOTONIC);
+    GRPC_CHTTP2_REF_TRANSPORT(t, "write_cork_timer");
+    grpc_timer_init(
+        &t->write_cork_timer,
+        grpc_core::ExecCtx::Get()->Now() +
+            GPR_MAX(1, (t->write_cork_us + GPR_US_PER_MS - 1) / GPR_US_PER_MS),
+        GRPC_CLOSURE_INIT(&t->write_cork_timer_fired_locked,
+                          write_cork_timer_fired, t,
+                          grpc_schedule_on_exec_ctx));
+    return true;
+  }
+  /* once write_cork_timer has fired, the write must go */
+  if (!flush && t->have_write_cork_timer &&
+      gpr_time_cmp(
+          gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), t->write_cork_start),
+          gpr_time_from_micros(t->write_cork_us, GPR_TIMESPAN)) < 0) {
+    return true;
+  }
+  t->write_corked = false;
+  grpc_timer_cancel(&t->write_cork_timer);
+  return false;
+}
+
 static void write_action_begin_locked(void* gt, grpc_error* error_ignored) {
   GPR_TIMER_SCOPE("write_action_begin_locked", 0);
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
@@ -942,9 +1065,12 @@ static void write_action_begin_locked(void* gt, grpc_error* error_ignored) {
   grpc_chttp2_begin_write_result r;
   if (t->closed_with_error != GRPC_ERROR_NONE) {
     r.writing = false;
+    r.partial = false;
   } else {
     r = grpc_chttp2_begin_write(t);
   }
+  /* a held back write is still there to be sent */
+  r.writing = r.writing || t->write_corked;
   if (r.writing) {
     if (r.partial) {
       GRPC_STATS_INC_HTTP2_PARTIAL_WRITES();
@@ -953,6 +1079,7 @@ static void write_action_begin_locked(void* gt, grpc_error* error_ignored) {
                     r.partial ? GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE
                               : GRPC_CHTTP2_WRITE_STATE_WRITING,
                     begin_writing_desc(r.partial));
+    if (maybe_cork_write(t, r.partial)) return;
     write_action(t, GRPC_ERROR_NONE);
     if (t->reading_paused_on_pending_induced_frames) {
       GPR_ASSERT(t->num_pending_induced_frames == 0);
@@ -979,6 +1106,14 @@ static void write_action(void* gt, grpc_error* error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
   void* cl = t->cl;
   t->cl = nullptr;
+  GRPC_STATS_INC_HTTP2_WRITE_SIZE(static_cast<int>(t->outbuf.length));
+  GRPC_STATS_INC_HTTP2_FRAMES_PER_WRITE(
+      static_cast<int>(t->num_frames_in_next_write));
+  t->num_frames_in_next_write = 0;
+  if (t->ping_queue.inflight_start_pending) {
+    t->ping_queue.inflight_start = gpr_now(GPR_CLOCK_MONOTONIC);
+    t->ping_queue.inflight_start_pending = false;
+  }
   grpc_endpoint_write(
       t->ep, &t->outbuf,
       GRPC_CLOSURE_INIT(&t->write_action_end_locked, write_action_end, t,
@@ -1044,6 +1179,28 @@ static void write_action_end_locked(void* tp, grpc_error* error) {
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "writing");
 }
 
+static void write_cork_timer_fired(void* tp, grpc_error* error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->combiner->Run(GRPC_CLOSURE_INIT(&t->write_cork_timer_fired_locked,
+                                     write_cork_timer_fired_locked, t, nullptr),
+                   GRPC_ERROR_REF(error));
+}
+
+/* The cork expired (or was cancelled by close_transport_locked): send the
+ * held back write. New frames may have sent it already, or be waiting to be
+ * gathered into it by write_action_begin_locked (the write state is then
+ * WRITING_WITH_MORE), which will send it. */
+static void write_cork_timer_fired_locked(void* tp, grpc_error* /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->have_write_cork_timer = false;
+  if (t->write_corked &&
+      t->write_state == GRPC_CHTTP2_WRITE_STATE_WRITING) {
+    t->write_corked = false;
+    write_action(t, GRPC_ERROR_NONE);
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "write_cork_timer");
+}
+
 // Dirties an HTTP2 setting to be sent out next time a writing path occurs.
 // If the change needs to occur immediately, manually initiate a write.
 static void queue_setting_update(grpc_chttp2_transport* t,
@@ -1146,6 +1303,7 @@ static void maybe_start_some_streams(grpc_chttp2_transport* t) {
 
     grpc_chttp2_stream_map_add(&t->stream_map, s->id, s);
     post_destructive_reclaimer(t);
+    reset_keepalive_idle_time(t);
     grpc_chttp2_mark_stream_writable(t, s);
     grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_START_NEW_STREAM);
   }
@@ -1236,6 +1394,19 @@ static bool contains_non_ok_status(grpc_metadata_batch* batch) {
   return false;
 }
 
+static void set_write_weight_from_metadata(grpc_chttp2_stream* s,
+                                           grpc_metadata_batch* md) {
+  grpc_linked_mdelem* const* elems = grpc_metadata_batch_elems(md);
+  for (size_t i = 0; i < md->list.count; i++) {
+    const uint32_t weight =
+        grpc_core::chttp2::StreamWeightFromMetadata(elems[i]->md);
+    if (weight != 0) {
+      s->write_weight = weight;
+      return;
+    }
+  }
+}
+
 static void maybe_become_writable_due_to_send_msg(grpc_chttp2_transport* t,
                                                   grpc_chttp2_stream* s) {
   if (s->id != 0 && (!s->write_buffering ||
@@ -1326,10 +1497,10 @@ static void complete_fetch_locked(void* gs, grpc_error* error) {
 
 static void log_metadata(const grpc_metadata_batch* md_batch, uint32_t id,
                          bool is_client, bool is_initial) {
-  for (grpc_linked_mdelem* md = md_batch->list.head; md != nullptr;
-       md = md->next) {
-    char* key = grpc_slice_to_c_string(GRPC_MDKEY(md->md));
-    char* value = grpc_slice_to_c_string(GRPC_MDVALUE(md->md));
+  grpc_linked_mdelem* const* elems = grpc_metadata_batch_elems(md_batch);
+  for (size_t i = 0; i < md_batch->list.count; i++) {
+    char* key = grpc_slice_to_c_string(GRPC_MDKEY(elems[i]->md));
+    char* value = grpc_slice_to_c_string(GRPC_MDVALUE(elems[i]->md));
     gpr_log(GPR_INFO, "HTTP:%d:%s:%s: %s: %s", id, is_initial ? "HDR" : "TRL",
             is_client ? "CLI" : "SVR", key, value);
     gpr_free(key);
@@ -1415,6 +1586,9 @@ static void perform_stream_op_locked(void* stream_op,
                    [GRPC_CHTTP2_SETTINGS_MAX_HEADER_LIST_SIZE];
     if (t->is_client) {
       s->deadline = GPR_MIN(s->deadline, s->send_initial_metadata->deadline);
+      if (t->write_scheduler->uses_stream_weights()) {
+        set_write_weight_from_metadata(s, s->send_initial_metadata);
+      }
     }
     if (metadata_size > metadata_peer_limit) {
       grpc_chttp2_cancel_stream(
@@ -1592,6 +1766,8 @@ static void perform_stream_op_locked(void* stream_op,
     GPR_ASSERT(!s->pending_byte_stream);
     s->recv_message_ready = op_payload->recv_message.recv_message_ready;
     s->recv_message = op_payload->recv_message.recv_message;
+    s->next_message_available =
+        op_payload->recv_message.next_message_available;
     if (s->id != 0) {
       if (!s->read_closed) {
         before = s->frame_storage.length +
@@ -1746,6 +1922,17 @@ static void retry_initiate_ping_locked(void* tp, grpc_error* error) {
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "retry_initiate_ping_locked");
 }
 
+static void record_ping_rtt(grpc_chttp2_transport* t) {
+  gpr_timespec rtt = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC),
+                                  t->ping_queue.inflight_start);
+  t->rtt_estimator.AddSample(gpr_timespec_to_micros(rtt) * 1e-6);
+  if (t->channelz_socket != nullptr) {
+    t->channelz_socket->RecordRtt(
+        static_cast<int64_t>(t->rtt_estimator.SmoothedRtt() * 1e6),
+        static_cast<int64_t>(t->rtt_estimator.MinRtt() * 1e6));
+  }
+}
+
 void grpc_chttp2_ack_ping(grpc_chttp2_transport* t, uint64_t id) {
   grpc_chttp2_ping_queue* pq = &t->ping_queue;
   if (pq->inflight_id != id) {
@@ -1754,6 +1941,11 @@ void grpc_chttp2_ack_ping(grpc_chttp2_transport* t, uint64_t id) {
     gpr_free(from);
     return;
   }
+  /* every ping is sent on behalf of some closure: a ping without any is
+     one that was acked already */
+  if (!grpc_closure_list_empty(pq->lists[GRPC_CHTTP2_PCL_INFLIGHT])) {
+    record_ping_rtt(t);
+  }
   GRPC_CLOSURE_LIST_SCHED(&pq->lists[GRPC_CHTTP2_PCL_INFLIGHT]);
   if (!grpc_closure_list_empty(pq->lists[GRPC_CHTTP2_PCL_NEXT])) {
     grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_CONTINUE_PINGS);
@@ -1772,6 +1964,7 @@ static void send_goaway(grpc_chttp2_transport* t, grpc_error* error) {
   grpc_chttp2_goaway_append(t->last_new_stream_id,
                             static_cast<uint32_t>(http_error),
                             grpc_slice_ref_internal(slice), &t->qbuf);
+  t->num_queued_frames++;
   grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_GOAWAY_SENT);
   GRPC_ERROR_UNREF(error);
 }
@@ -1890,6 +2083,12 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
           grpc_slice_buffer_swap(&s->unprocessed_incoming_frames_buffer,
                                  &s->frame_storage);
           s->unprocessed_incoming_frames_decompressed = false;
+        } else if (s->stream_decompression_method ==
+                   GRPC_STREAM_COMPRESSION_IDENTITY_DECOMPRESS) {
+          /* keep the rest of a partly deframed message next to its start, so
+           * that it can be handed over in one piece */
+          grpc_slice_buffer_move_into(&s->frame_storage,
+                                      &s->unprocessed_incoming_frames_buffer);
         }
         if (!s->unprocessed_incoming_frames_decompressed &&
             s->stream_decompression_method !=
@@ -1947,6 +2146,10 @@ void grpc_chttp2_maybe_complete_recv_message(grpc_chttp2_transport* t,
     s->unprocessed_incoming_frames_buffer_cached_length =
         s->unprocessed_incoming_frames_buffer.length;
     if (error == GRPC_ERROR_NONE && *s->recv_message != nullptr) {
+      if (s->next_message_available != nullptr) {
+        *s->next_message_available =
+            grpc_chttp2_data_parser_has_next_message(&s->data_parser, s);
+      }
       null_then_sched_closure(&s->recv_message_ready);
     } else if (s->published_metadata[1] != GRPC_METADATA_NOT_PUBLISHED) {
       *s->recv_message = nullptr;
@@ -2388,6 +2591,7 @@ static void close_from_api(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
   grpc_slice_buffer_add(&t->qbuf, status_hdr);
   grpc_slice_buffer_add(&t->qbuf, message_pfx);
   grpc_slice_buffer_add(&t->qbuf, grpc_slice_ref_internal(slice));
+  t->num_queued_frames++;
   grpc_chttp2_add_rst_stream_to_next_write(t, s->id, GRPC_HTTP2_NO_ERROR,
                                            &s->stats.outgoing);
 
@@ -2660,7 +2864,7 @@ static void finish_bdp_ping_locked(void* tp, grpc_error* error) {
     return;
   }
   t->bdp_ping_started = false;
-  grpc_millis next_ping = t->flow_control->bdp_estimator()->CompletePing();
+  grpc_millis next_ping = t->flow_control->CompleteBdpPing();
   grpc_chttp2_act_on_flowctl_action(t->flow_control->PeriodicUpdate(), t,
                                     nullptr);
   GPR_ASSERT(!t->have_next_bdp_ping_timer);
@@ -2773,6 +2977,14 @@ static void init_keepalive_ping_locked(void* arg, grpc_error* error) {
     if (t->keepalive_permit_without_calls ||
         grpc_chttp2_stream_map_size(&t->stream_map) > 0) {
       t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_PINGING;
+      if (grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
+        /* nothing was read for a whole interval without any stream: ping
+           less often until a stream comes */
+        t->keepalive_idle_time =
+            t->keepalive_idle_time > t->keepalive_max_time / 2
+                ? t->keepalive_max_time
+                : 2 * t->keepalive_idle_time;
+      }
       GRPC_CHTTP2_REF_TRANSPORT(t, "keepalive ping end");
       grpc_timer_init_unset(&t->keepalive_watchdog_timer);
       send_keepalive_ping_locked(t);
@@ -2782,7 +2994,7 @@ static void init_keepalive_ping_locked(void* arg, grpc_error* error) {
       GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
                         grpc_schedule_on_exec_ctx);
       grpc_timer_init(&t->keepalive_ping_timer,
-                      grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
+                      grpc_core::ExecCtx::Get()->Now() + next_keepalive_time(t),
                       &t->init_keepalive_ping_locked);
     }
   } else if (error == GRPC_ERROR_CANCELLED) {
@@ -2791,7 +3003,7 @@ static void init_keepalive_ping_locked(void* arg, grpc_error* error) {
     GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
                       grpc_schedule_on_exec_ctx);
     grpc_timer_init(&t->keepalive_ping_timer,
-                    grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
+                    grpc_core::ExecCtx::Get()->Now() + next_keepalive_time(t),
                     &t->init_keepalive_ping_locked);
   }
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "init keepalive ping");
@@ -2854,7 +3066,7 @@ static void finish_keepalive_ping_locked(void* arg, grpc_error* error) {
       GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
                         grpc_schedule_on_exec_ctx);
       grpc_timer_init(&t->keepalive_ping_timer,
-                      grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
+                      grpc_core::ExecCtx::Get()->Now() + next_keepalive_time(t),
                       &t->init_keepalive_ping_locked);
     }
   }
@@ -3136,6 +3348,11 @@ void Chttp2IncomingByteStream::Shutdown(grpc_error* error) {
   GRPC_ERROR_UNREF(Finished(error, true /* reset_on_error */));
 }
 
+void Chttp2BufferedByteStream::Orphan() {
+  SliceBufferByteStream::Orphan();
+  grpc_core::Delete(this);
+}
+
 }  // namespace grpc_core
 
 /*******************************************************************************
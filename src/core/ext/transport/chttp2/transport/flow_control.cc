@@ -173,10 +173,12 @@ TransportFlowControlDisabled::TransportFlowControlDisabled(
 }
 
 TransportFlowControl::TransportFlowControl(const grpc_chttp2_transport* t,
-                                           bool enable_bdp_probe)
+                                           bool enable_bdp_probe,
+                                           WindowStrategy window_strategy)
     : t_(t),
       enable_bdp_probe_(enable_bdp_probe),
       bdp_estimator_(t->peer_string),
+      window_strategy_(window_strategy),
       pid_controller_(grpc_core::PidController::Args()
                           .set_gain_p(4)
                           .set_gain_i(8)
@@ -185,7 +187,8 @@ TransportFlowControl::TransportFlowControl(const grpc_chttp2_transport* t,
                           .set_min_control_value(-1)
                           .set_max_control_value(25)
                           .set_integral_range(10)),
-      last_pid_update_(grpc_core::ExecCtx::Get()->Now()) {}
+      last_pid_update_(grpc_core::ExecCtx::Get()->Now()),
+      delivery_rate_estimator_(t->peer_string) {}
 
 uint32_t TransportFlowControl::MaybeSendUpdate(bool writing_anyway) {
   FlowControlTrace trace("t updt sent", this, nullptr);
@@ -341,6 +344,39 @@ double TransportFlowControl::SmoothLogBdp(double value) {
   return pid_controller_.Update(bdp_error, dt > kMaxDt ? kMaxDt : dt);
 }
 
+// Scales a window down as memory pressure gets high. Unlike
+// AdjustForMemoryPressure, this never grows the window under low pressure:
+// the delivery rate strategy only offers the peer what the path can use.
+static double ScaleForMemoryPressure(grpc_resource_quota* quota,
+                                     double window) {
+  double memory_pressure = grpc_resource_quota_get_memory_pressure(quota);
+  static const double kHighMemPressure = 0.8;
+  static const double kMaxMemPressure = 0.9;
+  if (memory_pressure > kHighMemPressure) {
+    window *= 1 - GPR_MIN(1, (memory_pressure - kHighMemPressure) /
+                                 (kMaxMemPressure - kHighMemPressure));
+  }
+  return window;
+}
+
+double TransportFlowControl::TargetDeliveryRateWindow() {
+  return ScaleForMemoryPressure(
+      grpc_resource_user_quota(grpc_endpoint_get_resource_user(t_->ep)),
+      static_cast<double>(delivery_rate_estimator_.TargetWindow()));
+}
+
+grpc_millis TransportFlowControl::CompleteBdpPing() {
+  grpc_millis next_ping = bdp_estimator_.CompletePing();
+  if (window_strategy_ == WindowStrategy::kDeliveryRate) {
+    delivery_rate_estimator_.AddSample(bdp_estimator_.last_ping_bytes(),
+                                       bdp_estimator_.last_ping_rtt(),
+                                       target_initial_window_size_);
+    next_ping = grpc_core::ExecCtx::Get()->Now() +
+                delivery_rate_estimator_.NextPingDelay();
+  }
+  return next_ping;
+}
+
 FlowControlAction::Urgency TransportFlowControl::DeltaUrgency(
     int64_t value, grpc_chttp2_setting_id setting_id) {
   int64_t delta = value - static_cast<int64_t>(
@@ -360,7 +396,11 @@ FlowControlAction TransportFlowControl::PeriodicUpdate() {
     // target might change based on how much memory pressure we are under
     // TODO(ncteisen): experiment with setting target to be huge under low
     // memory pressure.
-    const double target = pow(2, SmoothLogBdp(TargetLogBdp()));
+    const bool delivery_rate =
+        window_strategy_ == WindowStrategy::kDeliveryRate;
+    const double target = delivery_rate
+                              ? TargetDeliveryRateWindow()
+                              : pow(2, SmoothLogBdp(TargetLogBdp()));
 
     // Though initial window 'could' drop to 0, we keep the floor at 128
     target_initial_window_size_ =
@@ -372,7 +412,8 @@ FlowControlAction TransportFlowControl::PeriodicUpdate() {
         static_cast<uint32_t>(target_initial_window_size_));
 
     // get bandwidth estimate and update max_frame accordingly.
-    double bw_dbl = bdp_estimator_.EstimateBandwidth();
+    double bw_dbl = delivery_rate ? delivery_rate_estimator_.MaxBandwidth()
+                                  : bdp_estimator_.EstimateBandwidth();
     // we target the max of BDP or bandwidth in microseconds.
     int32_t frame_size = static_cast<int32_t> GPR_CLAMP(
         GPR_MAX((int32_t)GPR_CLAMP(bw_dbl, 0, INT_MAX) / 1000,
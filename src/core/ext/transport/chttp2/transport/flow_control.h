@@ -27,6 +27,7 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/transport/bdp_estimator.h"
+#include "src/core/lib/transport/delivery_rate_estimator.h"
 #include "src/core/lib/transport/pid_controller.h"
 
 struct grpc_chttp2_transport;
@@ -51,6 +52,15 @@ static constexpr uint32_t kFrameSize = 1024 * 1024;
 class TransportFlowControl;
 class StreamFlowControl;
 
+// How TransportFlowControl turns BDP pings into an initial window size.
+enum class WindowStrategy : uint8_t {
+  // Smooth the BdpEstimator's estimate with a PID controller.
+  kBdpPid,
+  // Size the window from the max delivery rate and min round trip time seen
+  // by BDP pings, with BBR-style startup and probing (DeliveryRateEstimator).
+  kDeliveryRate,
+};
+
 // Encapsulates a collections of actions the transport needs to take with
 // regard to flow control. Each action comes with urgencies that tell the
 // transport how quickly the action must take place.
@@ -163,6 +173,10 @@ class TransportFlowControlBase {
   // accordingly.
   virtual FlowControlAction PeriodicUpdate() { abort(); }
 
+  // Called when a BDP ping is acked. Returns when to schedule the next one.
+  // Only called when bdp_estimator() is not nullptr.
+  virtual grpc_millis CompleteBdpPing() { abort(); }
+
   // Called to do bookkeeping when a stream owned by this transport sends
   // data on the wire
   virtual void StreamSentData(int64_t /* size */) { abort(); }
@@ -221,13 +235,16 @@ class TransportFlowControlDisabled final : public TransportFlowControlBase {
 // to be as performant as possible.
 class TransportFlowControl final : public TransportFlowControlBase {
  public:
-  TransportFlowControl(const grpc_chttp2_transport* t, bool enable_bdp_probe);
+  TransportFlowControl(const grpc_chttp2_transport* t, bool enable_bdp_probe,
+                       WindowStrategy window_strategy);
   ~TransportFlowControl() {}
 
   bool flow_control_enabled() const override { return true; }
 
   bool bdp_probe() const { return enable_bdp_probe_; }
 
+  WindowStrategy window_strategy() const { return window_strategy_; }
+
   // returns an announce if we should send a transport update to our peer,
   // else returns zero; writing_anyway indicates if a write would happen
   // regardless of the send - if it is false and this function returns non-zero,
@@ -245,6 +262,8 @@ class TransportFlowControl final : public TransportFlowControlBase {
   // to let chttp2 change its parameters
   FlowControlAction PeriodicUpdate() override;
 
+  grpc_millis CompleteBdpPing() override;
+
   void StreamSentData(int64_t size) override { remote_window_ -= size; }
 
   grpc_error* ValidateRecvData(int64_t incoming_frame_size);
@@ -295,6 +314,10 @@ class TransportFlowControl final : public TransportFlowControlBase {
 
   BdpEstimator* bdp_estimator() override { return &bdp_estimator_; }
 
+  const DeliveryRateEstimator* delivery_rate_estimator() const {
+    return &delivery_rate_estimator_;
+  }
+
   void TestOnlyForceHugeWindow() override {
     announced_window_ = 1024 * 1024 * 1024;
     remote_window_ = 1024 * 1024 * 1024;
@@ -303,6 +326,7 @@ class TransportFlowControl final : public TransportFlowControlBase {
  private:
   double TargetLogBdp();
   double SmoothLogBdp(double value);
+  double TargetDeliveryRateWindow();
   FlowControlAction::Urgency DeltaUrgency(int64_t value,
                                           grpc_chttp2_setting_id setting_id);
 
@@ -333,9 +357,14 @@ class TransportFlowControl final : public TransportFlowControlBase {
   /* bdp estimation */
   grpc_core::BdpEstimator bdp_estimator_;
 
+  const WindowStrategy window_strategy_;
+
   /* pid controller */
   grpc_core::PidController pid_controller_;
   grpc_millis last_pid_update_ = 0;
+
+  /* window model for WindowStrategy::kDeliveryRate */
+  grpc_core::DeliveryRateEstimator delivery_rate_estimator_;
 };
 
 // Fat interface with all methods a stream flow control implementation needs
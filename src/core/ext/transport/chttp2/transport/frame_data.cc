@@ -27,6 +27,7 @@
 #include <grpc/support/string_util.h>
 #include "src/core/ext/transport/chttp2/transport/internal.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
@@ -188,12 +189,35 @@ grpc_error* grpc_deframe_unprocessed_incoming_frames(
         if (t->channelz_socket != nullptr) {
           t->channelz_socket->RecordMessageReceived();
         }
-        p->state = GRPC_CHTTP2_DATA_FRAME;
         ++cur;
         message_flags = 0;
         if (p->is_frame_compressed) {
           message_flags |= GRPC_WRITE_INTERNAL_COMPRESS;
         }
+        if (slices->length - static_cast<size_t>(cur - beg) >=
+            p->frame_size) {
+          /* The whole message is here already: hand it over as is, rather
+           * than through a byte stream that goes back to the transport for
+           * every slice */
+          if (cur != end) {
+            grpc_slice_buffer_sub_first(slices, static_cast<size_t>(cur - beg),
+                                        static_cast<size_t>(end - beg));
+          } else {
+            grpc_slice_buffer_remove_first(slices);
+          }
+          s->stats.incoming.data_bytes += p->frame_size;
+          grpc_slice_buffer message;
+          grpc_slice_buffer_init(&message);
+          if (p->frame_size > 0) {
+            grpc_slice_buffer_move_first(slices, p->frame_size, &message);
+          }
+          stream_out->reset(grpc_core::New<grpc_core::Chttp2BufferedByteStream>(
+              &message, message_flags));
+          grpc_slice_buffer_destroy_internal(&message);
+          p->state = GRPC_CHTTP2_DATA_FH_0;
+          return GRPC_ERROR_NONE;
+        }
+        p->state = GRPC_CHTTP2_DATA_FRAME;
         p->parsing_frame = grpc_core::New<grpc_core::Chttp2IncomingByteStream>(
             t, s, p->frame_size, message_flags);
         stream_out->reset(p->parsing_frame);
@@ -279,6 +303,36 @@ grpc_error* grpc_deframe_unprocessed_incoming_frames(
   return GRPC_ERROR_NONE;
 }
 
+bool grpc_chttp2_data_parser_has_next_message(grpc_chttp2_data_parser* p,
+                                              grpc_chttp2_stream* s) {
+  if (p->state != GRPC_CHTTP2_DATA_FH_0 ||
+      s->stream_decompression_method !=
+          GRPC_STREAM_COMPRESSION_IDENTITY_DECOMPRESS) {
+    return false;
+  }
+  /* frame_storage picks up where unprocessed_incoming_frames_buffer ends */
+  grpc_slice_buffer* buffers[] = {&s->unprocessed_incoming_frames_buffer,
+                                  &s->frame_storage};
+  const size_t available = buffers[0]->length + buffers[1]->length;
+  if (available < GRPC_HEADER_SIZE_IN_BYTES) return false;
+  uint8_t header[GRPC_HEADER_SIZE_IN_BYTES];
+  size_t n = 0;
+  for (grpc_slice_buffer* buffer : buffers) {
+    for (size_t i = 0; i < buffer->count && n < GRPC_HEADER_SIZE_IN_BYTES;
+         i++) {
+      const size_t len = GPR_MIN(GRPC_SLICE_LENGTH(buffer->slices[i]),
+                                 GRPC_HEADER_SIZE_IN_BYTES - n);
+      memcpy(header + n, GRPC_SLICE_START_PTR(buffer->slices[i]), len);
+      n += len;
+    }
+  }
+  const uint32_t message_size = (static_cast<uint32_t>(header[1]) << 24) |
+                                (static_cast<uint32_t>(header[2]) << 16) |
+                                (static_cast<uint32_t>(header[3]) << 8) |
+                                static_cast<uint32_t>(header[4]);
+  return available - GRPC_HEADER_SIZE_IN_BYTES >= message_size;
+}
+
 grpc_error* grpc_chttp2_data_parser_parse(void* parser,
                                           grpc_chttp2_transport* t,
                                           grpc_chttp2_stream* s,
@@ -79,4 +79,9 @@ grpc_error* grpc_deframe_unprocessed_incoming_frames(
     grpc_slice_buffer* slices, grpc_slice* slice_out,
     grpc_core::OrphanablePtr<grpc_core::ByteStream>* stream_out);
 
+/* Whether the next message of s has been received in full, so that
+   deframing it needs no more data from the peer */
+bool grpc_chttp2_data_parser_has_next_message(grpc_chttp2_data_parser* p,
+                                              grpc_chttp2_stream* s);
+
 #endif /* GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_FRAME_DATA_H */
@@ -68,11 +68,12 @@ namespace {
 /* don't consider adding anything bigger than this to the hpack table */
 constexpr size_t kMaxDecoderSpaceUsage = 512;
 constexpr size_t kDataFrameHeaderSize = 9;
-constexpr uint8_t kMaxFilterValue = 255;
+constexpr uint8_t kMaxSketchValue = 255;
+/* halve the sketch after this many increments */
+constexpr uint32_t kSketchResetSamples = 16 * GRPC_CHTTP2_HPACKC_SKETCH_WIDTH;
+/* per entry overhead in the decoder table, per spec */
+constexpr size_t kEntryOverhead = 32;
 
-/* if the probability of this item being seen again is < 1/x then don't add
-   it to the table */
-#define ONE_ON_ADD_PROBABILITY (GRPC_CHTTP2_HPACKC_NUM_VALUES >> 1)
 /* The hpack index we encode over the wire. Meaningful to the hpack encoder and
    parser on the remote end as well as HTTP2. *Not* the same as
    HpackEncoderSlotHash, which is only meaningful to the hpack encoder
@@ -223,39 +224,66 @@ static void UpdateAddOrEvict(Hashtable hashtable, const ValueType& value,
 #endif
 }
 
-/* halve all counts because an element reached max */
-static void HalveFilter(uint8_t idx, uint32_t* sum, uint8_t* elems) {
-  *sum = 0;
-  for (int i = 0; i < GRPC_CHTTP2_HPACKC_NUM_VALUES; i++) {
-    elems[i] /= 2;
-    (*sum) += elems[i];
+/* Sketch counter for hash in the given row: each row looks at different
+   bits of the hash, so that items colliding in one row rarely collide in the
+   other. */
+static uint32_t SketchSlot(uint32_t hash, int row) {
+  if (row == 0) {
+    return hash & (GRPC_CHTTP2_HPACKC_SKETCH_WIDTH - 1);
   }
+  return (hash * 0x9e3779b1u) >> (32 - GRPC_CHTTP2_HPACKC_SKETCH_WIDTH_BITS);
 }
 
-/* increment a filter count, halve all counts if one element reaches max */
-static void IncrementFilter(uint8_t idx, uint32_t* sum, uint8_t* elems) {
-  elems[idx]++;
-  if (GPR_LIKELY(elems[idx] < kMaxFilterValue)) {
-    (*sum)++;
-  } else {
-    HalveFilter(idx, sum, elems);
+static uint32_t SketchEstimate(const grpc_chttp2_hpack_compressor* c,
+                               uint32_t hash) {
+  uint32_t estimate = kMaxSketchValue;
+  for (int row = 0; row < GRPC_CHTTP2_HPACKC_SKETCH_ROWS; row++) {
+    estimate = GPR_MIN(estimate, c->sketch[row][SketchSlot(hash, row)]);
   }
+  return estimate;
 }
 
-static uint32_t UpdateHashtablePopularity(
-    grpc_chttp2_hpack_compressor* hpack_compressor, uint32_t elem_hash) {
-  const uint32_t popularity_hash = HASH_FRAGMENT_1(elem_hash);
-  IncrementFilter(popularity_hash, &hpack_compressor->filter_elems_sum,
-                  hpack_compressor->filter_elems);
-  return popularity_hash;
+/* Counts one more sighting of hash, and returns its new estimate */
+static uint32_t SketchIncrement(grpc_chttp2_hpack_compressor* c,
+                                uint32_t hash) {
+  if (++c->sketch_samples == kSketchResetSamples) {
+    for (int row = 0; row < GRPC_CHTTP2_HPACKC_SKETCH_ROWS; row++) {
+      for (int i = 0; i < GRPC_CHTTP2_HPACKC_SKETCH_WIDTH; i++) {
+        c->sketch[row][i] /= 2;
+      }
+    }
+    c->sketch_samples = 0;
+  }
+  uint32_t estimate = kMaxSketchValue;
+  for (int row = 0; row < GRPC_CHTTP2_HPACKC_SKETCH_ROWS; row++) {
+    uint8_t* counter = &c->sketch[row][SketchSlot(hash, row)];
+    if (*counter < kMaxSketchValue) ++*counter;
+    estimate = GPR_MIN(estimate, *counter);
+  }
+  return estimate;
 }
 
-static bool CanAddToHashtable(grpc_chttp2_hpack_compressor* hpack_compressor,
-                              uint32_t popularity_hash) {
-  const bool can_add =
-      hpack_compressor->filter_elems[popularity_hash] >=
-      hpack_compressor->filter_elems_sum / ONE_ON_ADD_PROBABILITY;
-  return can_add;
+/* Whether a new entry of elem_size bytes, estimated to be seen frequency
+   times and saving saving bytes each time, is worth adding to the decoder
+   table. The table is a FIFO: adding to a full table evicts its oldest
+   entries, so the newcomer must be expected to save at least as many bytes as
+   they would. */
+static bool WorthIndexing(const grpc_chttp2_hpack_compressor* c,
+                          uint32_t frequency, size_t elem_size,
+                          uint32_t saving) {
+  if (elem_size > c->max_table_size) return false;
+  uint64_t evicted_savings = 0;
+  uint32_t table_size = c->table_size;
+  uint32_t index = c->tail_remote_index;
+  while (table_size + elem_size > c->max_table_size) {
+    index++;
+    const uint32_t slot = index % c->cap_table_elems;
+    table_size -= c->table_elem_size[slot];
+    evicted_savings +=
+        static_cast<uint64_t>(SketchEstimate(c, c->table_elem_hash[slot])) *
+        c->table_elem_saving[slot];
+  }
+  return static_cast<uint64_t>(frequency) * saving >= evicted_savings;
 }
 } /* namespace */
 
@@ -274,6 +302,8 @@ typedef struct {
   uint32_t stream_id;
   grpc_slice_buffer* output;
   grpc_transport_one_way_stats* stats;
+  /* bytes of header names and values encoded so far */
+  size_t raw_bytes;
   /* maximum size of a frame */
   size_t max_frame_size;
   bool use_true_binary_metadata;
@@ -388,9 +418,12 @@ static void evict_entry(grpc_chttp2_hpack_compressor* c) {
 
 // Reserve space in table for the new element, evict entries if needed.
 // Return the new index of the element. Return 0 to indicate not adding to
-// table.
+// table. sketch_hash and saving are remembered to weigh the element against
+// later candidates that would evict it.
 static uint32_t prepare_space_for_new_elem(grpc_chttp2_hpack_compressor* c,
-                                           size_t elem_size) {
+                                           size_t elem_size,
+                                           uint32_t sketch_hash,
+                                           uint32_t saving) {
   uint32_t new_index = c->tail_remote_index + c->table_elems + 1;
   GPR_DEBUG_ASSERT(elem_size < 65536);
 
@@ -411,6 +444,9 @@ static uint32_t prepare_space_for_new_elem(grpc_chttp2_hpack_compressor* c,
   GPR_ASSERT(c->table_elems < c->max_table_size);
   c->table_elem_size[new_index % c->cap_table_elems] =
       static_cast<uint16_t>(elem_size);
+  c->table_elem_hash[new_index % c->cap_table_elems] = sketch_hash;
+  c->table_elem_saving[new_index % c->cap_table_elems] =
+      static_cast<uint16_t>(GPR_MIN(saving, UINT16_MAX));
   c->table_size = static_cast<uint16_t>(c->table_size + elem_size);
   c->table_elems++;
 
@@ -438,7 +474,9 @@ static void AddElemWithIndex(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
 
 static void add_elem(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
                      size_t elem_size, uint32_t elem_hash, uint32_t key_hash) {
-  uint32_t new_index = prepare_space_for_new_elem(c, elem_size);
+  uint32_t new_index = prepare_space_for_new_elem(
+      c, elem_size, elem_hash,
+      static_cast<uint32_t>(elem_size - kEntryOverhead));
   if (new_index != 0) {
     AddElemWithIndex(c, elem, new_index, elem_hash, key_hash);
   }
@@ -446,7 +484,9 @@ static void add_elem(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
 
 static void add_key(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
                     size_t elem_size, uint32_t key_hash) {
-  uint32_t new_index = prepare_space_for_new_elem(c, elem_size);
+  uint32_t new_index = prepare_space_for_new_elem(
+      c, elem_size, key_hash,
+      static_cast<uint32_t>(GRPC_SLICE_LENGTH(GRPC_MDKEY(elem))));
   if (new_index != 0) {
     AddKeyWithIndex(c, GRPC_MDKEY(elem).refcount, new_index, key_hash);
   }
@@ -618,36 +658,41 @@ static uint32_t dynidx(grpc_chttp2_hpack_compressor* c, uint32_t elem_index) {
 
 struct EmitIndexedStatus {
   EmitIndexedStatus() = default;
-  EmitIndexedStatus(uint32_t elem_hash, bool emitted, bool can_add)
-      : elem_hash(elem_hash), emitted(emitted), can_add(can_add) {}
+  EmitIndexedStatus(uint32_t elem_hash, bool emitted, uint32_t frequency)
+      : elem_hash(elem_hash), emitted(emitted), frequency(frequency) {}
   const uint32_t elem_hash = 0;
   const bool emitted = false;
-  const bool can_add = false;
+  /* how often the elem has been seen recently */
+  const uint32_t frequency = 0;
 };
 
+/* hash of an interned (or static) elem */
+static uint32_t interned_elem_hash(grpc_mdelem elem) {
+  return GRPC_MDELEM_STORAGE(elem) == GRPC_MDELEM_STORAGE_INTERNED
+             ? reinterpret_cast<grpc_core::InternedMetadata*>(
+                   GRPC_MDELEM_DATA(elem))
+                   ->hash()
+             : reinterpret_cast<grpc_core::StaticMetadata*>(
+                   GRPC_MDELEM_DATA(elem))
+                   ->hash();
+}
+
 static EmitIndexedStatus maybe_emit_indexed(grpc_chttp2_hpack_compressor* c,
                                             grpc_mdelem elem,
                                             framer_state* st) {
-  const uint32_t elem_hash =
-      GRPC_MDELEM_STORAGE(elem) == GRPC_MDELEM_STORAGE_INTERNED
-          ? reinterpret_cast<grpc_core::InternedMetadata*>(
-                GRPC_MDELEM_DATA(elem))
-                ->hash()
-          : reinterpret_cast<grpc_core::StaticMetadata*>(GRPC_MDELEM_DATA(elem))
-                ->hash();
-  /* Update filter to see if we can perhaps add this elem. */
-  const uint32_t popularity_hash = UpdateHashtablePopularity(c, elem_hash);
+  const uint32_t elem_hash = interned_elem_hash(elem);
+  /* Count this elem, to see if it is worth adding. */
+  const uint32_t frequency = SketchIncrement(c, elem_hash);
   /* is this elem currently in the decoders table? */
   HpackEncoderIndex indices_key;
   if (GetMatchingIndex<MetadataComparator>(c->elem_table.entries, elem,
                                            elem_hash, &indices_key) &&
       indices_key > c->tail_remote_index) {
     emit_indexed(c, dynidx(c, indices_key), st);
-    return EmitIndexedStatus(elem_hash, true, false);
+    return EmitIndexedStatus(elem_hash, true, frequency);
   }
   /* Didn't hit either cuckoo index, so no emit. */
-  return EmitIndexedStatus(elem_hash, false,
-                           CanAddToHashtable(c, popularity_hash));
+  return EmitIndexedStatus(elem_hash, false, frequency);
 }
 
 static void emit_maybe_add(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
@@ -684,6 +729,8 @@ static void hpack_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
   if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
     hpack_enc_log(elem);
   }
+  st->raw_bytes += GRPC_SLICE_LENGTH(elem_key) +
+                   GRPC_SLICE_LENGTH(GRPC_MDVALUE(elem));
   const bool elem_interned = GRPC_MDELEM_IS_INTERNED(elem);
   const bool key_interned = elem_interned || grpc_slice_is_interned(elem_key);
   /* Key is not interned, emit literals. */
@@ -702,11 +749,22 @@ static void hpack_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
       grpc_chttp2_get_size_in_hpack_table(elem, st->use_true_binary_metadata);
   const bool decoder_space_available =
       decoder_space_usage < kMaxDecoderSpaceUsage;
-  const bool should_add_elem =
-      elem_interned && decoder_space_available && ret.can_add;
+  bool should_add_elem = false;
+  if (elem_interned && decoder_space_available) {
+    should_add_elem = WorthIndexing(
+        c, ret.frequency, decoder_space_usage,
+        static_cast<uint32_t>(decoder_space_usage - kEntryOverhead));
+    if (!should_add_elem) {
+      c->stats.index_rejected++;
+      GRPC_STATS_INC_HPACK_SEND_INDEX_REJECTED();
+    }
+  }
   const uint32_t elem_hash = ret.elem_hash;
   /* no hits for the elem... maybe there's a key? */
   const uint32_t key_hash = elem_key.refcount->Hash(elem_key);
+  /* the value changes: all that can be reused is the key, so count that */
+  const uint32_t key_frequency =
+      elem_interned ? 0 : SketchIncrement(c, key_hash);
   HpackEncoderIndex indices_key;
   if (GetMatchingIndex<SliceRefComparator>(
           c->key_table.entries, elem_key.refcount, key_hash, &indices_key) &&
@@ -716,7 +774,16 @@ static void hpack_enc(grpc_chttp2_hpack_compressor* c, grpc_mdelem elem,
     return;
   }
   /* no elem, key in the table... fall back to literal emission */
-  const bool should_add_key = !elem_interned && decoder_space_available;
+  bool should_add_key = false;
+  if (!elem_interned && decoder_space_available) {
+    should_add_key = WorthIndexing(
+        c, key_frequency, decoder_space_usage,
+        static_cast<uint32_t>(GRPC_SLICE_LENGTH(elem_key)));
+    if (!should_add_key) {
+      c->stats.index_rejected++;
+      GRPC_STATS_INC_HPACK_SEND_INDEX_REJECTED();
+    }
+  }
   if (should_add_elem || should_add_key) {
     emit_lithdr_v<EmitLitHdrVType::INC_IDX_V>(c, elem, st);
   } else {
@@ -746,6 +813,116 @@ static void deadline_enc(grpc_chttp2_hpack_compressor* c, grpc_millis deadline,
 
 static uint32_t elems_for_bytes(uint32_t bytes) { return (bytes + 31) / 32; }
 
+/* The fragment for the batch, or null if it cannot have one */
+static grpc_chttp2_hpack_fragment* fragment_for(grpc_chttp2_hpack_compressor* c,
+                                                grpc_metadata_batch* metadata) {
+  if (metadata->list.count == 0) return nullptr;
+  const grpc_linked_mdelem* key = metadata->idx.named.path != nullptr
+                                      ? metadata->idx.named.path
+                                      : grpc_metadata_batch_elems(metadata)[0];
+  if (!GRPC_MDELEM_IS_INTERNED(key->md)) return nullptr;
+  return &c->fragments[interned_elem_hash(key->md) %
+                       GRPC_CHTTP2_HPACKC_NUM_FRAGMENTS];
+}
+
+static grpc_mdelem fragment_key(grpc_metadata_batch* metadata) {
+  return metadata->idx.named.path != nullptr
+             ? metadata->idx.named.path->md
+             : grpc_metadata_batch_elems(metadata)[0]->md;
+}
+
+/* Emits as much of the cached fragment f as matches the leading headers of
+   metadata, if it was encoded against the current decoder table. Returns the
+   number of leading headers it covers. */
+static uint32_t emit_fragment(grpc_chttp2_hpack_compressor* c,
+                              grpc_chttp2_hpack_fragment* f,
+                              grpc_metadata_batch* metadata, framer_state* st) {
+  if (f->key.payload != fragment_key(metadata).payload ||
+      f->tail_remote_index != c->tail_remote_index ||
+      f->table_elems != c->table_elems) {
+    return 0;
+  }
+  grpc_linked_mdelem* const* elems = grpc_metadata_batch_elems(metadata);
+  uint32_t n = 0;
+  size_t raw_bytes = 0;
+  for (; n < f->num_elems && n < metadata->list.count &&
+         elems[n]->md.payload == f->elems[n].payload;
+       n++) {
+    if (f->sketched & (1u << n)) SketchIncrement(c, f->elem_hashes[n]);
+    raw_bytes += GRPC_SLICE_LENGTH(GRPC_MDKEY(elems[n]->md)) +
+                 GRPC_SLICE_LENGTH(GRPC_MDVALUE(elems[n]->md));
+  }
+  if (n == 0) return 0;
+  const uint8_t length = f->ends[n - 1];
+  memcpy(add_tiny_header_data(st, length), f->bytes, length);
+#ifndef NDEBUG
+  if (GRPC_SLICE_START_PTR(GRPC_MDKEY(f->elems[n - 1]))[0] != ':') {
+    st->seen_regular_header = 1;
+  }
+#endif
+  st->raw_bytes += raw_bytes;
+  c->stats.fragment_hits++;
+  GRPC_STATS_INC_COUNTER_BY(GRPC_STATS_COUNTER_HPACK_SEND_INDEXED, n);
+  return n;
+}
+
+/* Re-encodes the fragment f for the leading headers of metadata that the
+   decoder table (as it is after encoding metadata) holds, keeping the refs
+   to the elems it already had */
+static void fill_fragment(grpc_chttp2_hpack_compressor* c,
+                          grpc_chttp2_hpack_fragment* f,
+                          grpc_metadata_batch* metadata) {
+  const uint32_t old_num_elems = f->num_elems;
+  uint32_t n = 0;
+  uint8_t length = 0;
+  f->sketched = 0;
+  grpc_linked_mdelem* const* elems = grpc_metadata_batch_elems(metadata);
+  while (n < metadata->list.count && n < GRPC_CHTTP2_HPACKC_FRAGMENT_ELEMS) {
+    const grpc_mdelem md = elems[n]->md;
+    if (!GRPC_MDELEM_IS_INTERNED(md)) break;
+    uint32_t index;
+    uintptr_t static_index;
+    if (GRPC_MDELEM_STORAGE(md) == GRPC_MDELEM_STORAGE_STATIC &&
+        (static_index = reinterpret_cast<grpc_core::StaticMetadata*>(
+                            GRPC_MDELEM_DATA(md))
+                            ->StaticIndex()) < GRPC_CHTTP2_LAST_STATIC_ENTRY) {
+      index = static_cast<uint32_t>(static_index + 1);
+    } else {
+      const uint32_t elem_hash = interned_elem_hash(md);
+      HpackEncoderIndex table_index;
+      if (!GetMatchingIndex<MetadataComparator>(c->elem_table.entries, md,
+                                                elem_hash, &table_index) ||
+          table_index <= c->tail_remote_index) {
+        break;
+      }
+      index = dynidx(c, table_index);
+      f->sketched |= 1u << n;
+      f->elem_hashes[n] = elem_hash;
+    }
+    const uint32_t len = GRPC_CHTTP2_VARINT_LENGTH(index, 1);
+    if (length + len > sizeof(f->bytes)) break;
+    GRPC_CHTTP2_WRITE_VARINT(index, 1, 0x80, &f->bytes[length], len);
+    length = static_cast<uint8_t>(length + len);
+    f->ends[n] = length;
+    if (n >= old_num_elems || f->elems[n].payload != md.payload) {
+      if (n < old_num_elems) GRPC_MDELEM_UNREF(f->elems[n]);
+      f->elems[n] = GRPC_MDELEM_REF(md);
+    }
+    n++;
+  }
+  for (uint32_t i = n; i < old_num_elems; i++) {
+    GRPC_MDELEM_UNREF(f->elems[i]);
+  }
+  f->num_elems = n;
+  const grpc_mdelem key = fragment_key(metadata);
+  if (f->key.payload != key.payload) {
+    GRPC_MDELEM_UNREF(f->key);
+    f->key = GRPC_MDELEM_REF(key);
+  }
+  f->tail_remote_index = c->tail_remote_index;
+  f->table_elems = c->table_elems;
+}
+
 void grpc_chttp2_hpack_compressor_init(grpc_chttp2_hpack_compressor* c) {
   memset(c, 0, sizeof(*c));
   c->max_table_size = GRPC_CHTTP2_HPACKC_INITIAL_TABLE_SIZE;
@@ -755,6 +932,10 @@ void grpc_chttp2_hpack_compressor_init(grpc_chttp2_hpack_compressor* c) {
   const size_t alloc_size = sizeof(*c->table_elem_size) * c->cap_table_elems;
   c->table_elem_size = static_cast<uint16_t*>(gpr_malloc(alloc_size));
   memset(c->table_elem_size, 0, alloc_size);
+  c->table_elem_hash = static_cast<uint32_t*>(
+      gpr_zalloc(sizeof(*c->table_elem_hash) * c->cap_table_elems));
+  c->table_elem_saving = static_cast<uint16_t*>(
+      gpr_zalloc(sizeof(*c->table_elem_saving) * c->cap_table_elems));
 }
 
 void grpc_chttp2_hpack_compressor_destroy(grpc_chttp2_hpack_compressor* c) {
@@ -765,7 +946,23 @@ void grpc_chttp2_hpack_compressor_destroy(grpc_chttp2_hpack_compressor* c) {
     }
     GRPC_MDELEM_UNREF(GetEntry<grpc_mdelem>(c->elem_table.entries, i));
   }
+  for (int i = 0; i < GRPC_CHTTP2_HPACKC_NUM_FRAGMENTS; i++) {
+    grpc_chttp2_hpack_fragment* f = &c->fragments[i];
+    GRPC_MDELEM_UNREF(f->key);
+    for (uint32_t j = 0; j < f->num_elems; j++) {
+      GRPC_MDELEM_UNREF(f->elems[j]);
+    }
+  }
   gpr_free(c->table_elem_size);
+  gpr_free(c->table_elem_hash);
+  gpr_free(c->table_elem_saving);
+}
+
+double grpc_chttp2_hpack_compressor_compression_ratio(
+    const grpc_chttp2_hpack_compressor* c) {
+  if (c->stats.encoded_bytes == 0) return 0;
+  return static_cast<double>(c->stats.raw_bytes) /
+         static_cast<double>(c->stats.encoded_bytes);
 }
 
 void grpc_chttp2_hpack_compressor_set_max_usable_size(
@@ -778,6 +975,10 @@ void grpc_chttp2_hpack_compressor_set_max_usable_size(
 static void rebuild_elems(grpc_chttp2_hpack_compressor* c, uint32_t new_cap) {
   uint16_t* table_elem_size =
       static_cast<uint16_t*>(gpr_malloc(sizeof(*table_elem_size) * new_cap));
+  uint32_t* table_elem_hash = static_cast<uint32_t*>(
+      gpr_zalloc(sizeof(*table_elem_hash) * new_cap));
+  uint16_t* table_elem_saving = static_cast<uint16_t*>(
+      gpr_zalloc(sizeof(*table_elem_saving) * new_cap));
   uint32_t i;
 
   memset(table_elem_size, 0, sizeof(*table_elem_size) * new_cap);
@@ -787,11 +988,19 @@ static void rebuild_elems(grpc_chttp2_hpack_compressor* c, uint32_t new_cap) {
     uint32_t ofs = c->tail_remote_index + i + 1;
     table_elem_size[ofs % new_cap] =
         c->table_elem_size[ofs % c->cap_table_elems];
+    table_elem_hash[ofs % new_cap] =
+        c->table_elem_hash[ofs % c->cap_table_elems];
+    table_elem_saving[ofs % new_cap] =
+        c->table_elem_saving[ofs % c->cap_table_elems];
   }
 
   c->cap_table_elems = new_cap;
   gpr_free(c->table_elem_size);
+  gpr_free(c->table_elem_hash);
+  gpr_free(c->table_elem_saving);
   c->table_elem_size = table_elem_size;
+  c->table_elem_hash = table_elem_hash;
+  c->table_elem_saving = table_elem_saving;
 }
 
 void grpc_chttp2_hpack_compressor_set_max_table_size(
@@ -839,7 +1048,9 @@ void grpc_chttp2_encode_header(grpc_chttp2_hpack_compressor* c,
   st.output = outbuf;
   st.is_first_frame = 1;
   st.stats = options->stats;
+  st.raw_bytes = 0;
   st.max_frame_size = options->max_frame_size;
+  const uint64_t header_bytes_at_start = st.stats->header_bytes;
   st.use_true_binary_metadata = options->use_true_binary_metadata;
 
   /* Encode a metadata batch; store the returned values, representing
@@ -859,13 +1070,28 @@ void grpc_chttp2_encode_header(grpc_chttp2_hpack_compressor* c,
         (static_index =
              reinterpret_cast<grpc_core::StaticMetadata*>(GRPC_MDELEM_DATA(md))
                  ->StaticIndex()) < GRPC_CHTTP2_LAST_STATIC_ENTRY) {
+      st.raw_bytes += GRPC_SLICE_LENGTH(GRPC_MDKEY(md)) +
+                      GRPC_SLICE_LENGTH(GRPC_MDVALUE(md));
       emit_indexed(c, static_cast<uint32_t>(static_index + 1), &st);
     } else {
       hpack_enc(c, md, &st);
     }
   }
   grpc_metadata_batch_assert_ok(metadata);
-  for (grpc_linked_mdelem* l = metadata->list.head; l; l = l->next) {
+  grpc_chttp2_hpack_fragment* fragment =
+      extra_headers_size == 0 && !GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)
+          ? fragment_for(c, metadata)
+          : nullptr;
+  const uint32_t tail_remote_index_at_start = c->tail_remote_index;
+  const uint32_t table_elems_at_start = c->table_elems;
+  size_t i = 0;
+  if (fragment != nullptr) {
+    i = emit_fragment(c, fragment, metadata, &st);
+  }
+  const bool fragment_hit = i != 0;
+  grpc_linked_mdelem* const* elems = grpc_metadata_batch_elems(metadata);
+  for (; i < metadata->list.count; i++) {
+    const grpc_linked_mdelem* l = elems[i];
     const bool is_static =
         GRPC_MDELEM_STORAGE(l->md) == GRPC_MDELEM_STORAGE_STATIC;
     uintptr_t static_index;
@@ -873,6 +1099,8 @@ void grpc_chttp2_encode_header(grpc_chttp2_hpack_compressor* c,
         (static_index = reinterpret_cast<grpc_core::StaticMetadata*>(
                             GRPC_MDELEM_DATA(l->md))
                             ->StaticIndex()) < GRPC_CHTTP2_LAST_STATIC_ENTRY) {
+      st.raw_bytes += GRPC_SLICE_LENGTH(GRPC_MDKEY(l->md)) +
+                      GRPC_SLICE_LENGTH(GRPC_MDVALUE(l->md));
       emit_indexed(c, static_cast<uint32_t>(static_index + 1), &st);
     } else {
       hpack_enc(c, l->md, &st);
@@ -883,5 +1111,203 @@ void grpc_chttp2_encode_header(grpc_chttp2_hpack_compressor* c,
     deadline_enc(c, deadline, &st);
   }
 
+  /* refill the fragment if none of it applied. Not after a batch that
+     changed the decoder table though: the next one likely will too, which
+     would make the fragment stale before it is used. */
+  if (fragment != nullptr && !fragment_hit &&
+      tail_remote_index_at_start == c->tail_remote_index &&
+      table_elems_at_start == c->table_elems) {
+    fill_fragment(c, fragment, metadata);
+  }
+
   finish_frame(&st, 1, options->is_eof);
+  const uint64_t encoded_bytes = st.stats->header_bytes - header_bytes_at_start;
+  c->stats.raw_bytes += st.raw_bytes;
+  c->stats.encoded_bytes += encoded_bytes;
+  GRPC_STATS_INC_COUNTER_BY(GRPC_STATS_COUNTER_HPACK_SEND_RAW_BYTES,
+                            st.raw_bytes);
+  GRPC_STATS_INC_COUNTER_BY(GRPC_STATS_COUNTER_HPACK_SEND_ENCODED_BYTES,
+                            encoded_bytes);
+}
+
+/* Pre-encoded pieces of trailers-only header blocks: the :status, and the
+   names of the other headers for when they go out as literals that are not
+   indexed */
+/* ":status: 200" is entry 8 of the static table */
+static const uint8_t kStatus200Indexed = 0x88;
+/* "content-type" is entry 31 of the static table */
+static const char kContentTypeName[] = "\x0f\x10";
+static const char kGrpcStatusName[] =
+    "\x00\x0b"
+    "grpc-status";
+static const char kGrpcMessageName[] =
+    "\x00\x0c"
+    "grpc-message";
+
+namespace {
+/* How the trailers-only fast path sends a header: by its index in the decoder
+   table, else as a literal named by the index of its key, else as a literal
+   with a pre-encoded name. */
+struct TrailersOnlyHeader {
+  TrailersOnlyHeader(grpc_mdelem elem, const char* name, size_t name_length)
+      : elem(elem), name(name), name_length(name_length) {}
+
+  size_t Length() const {
+    if (elem_index != 0) return GRPC_CHTTP2_VARINT_LENGTH(elem_index, 1);
+    const uint32_t value_length = ValueLength();
+    return (key_index != 0 ? GRPC_CHTTP2_VARINT_LENGTH(key_index, 4)
+                           : name_length) +
+           GRPC_CHTTP2_VARINT_LENGTH(value_length, 1) + value_length;
+  }
+
+  uint8_t* Write(uint8_t* p) const {
+    if (elem_index != 0) {
+      const uint32_t len = GRPC_CHTTP2_VARINT_LENGTH(elem_index, 1);
+      GRPC_CHTTP2_WRITE_VARINT(elem_index, 1, 0x80, p, len);
+      return p + len;
+    }
+    if (key_index != 0) {
+      const uint32_t len = GRPC_CHTTP2_VARINT_LENGTH(key_index, 4);
+      GRPC_CHTTP2_WRITE_VARINT(key_index, 4, 0x00, p, len);
+      p += len;
+    } else {
+      memcpy(p, name, name_length);
+      p += name_length;
+    }
+    const uint32_t value_length = ValueLength();
+    const uint32_t len = GRPC_CHTTP2_VARINT_LENGTH(value_length, 1);
+    GRPC_CHTTP2_WRITE_VARINT(value_length, 1, 0x00, p, len);
+    p += len;
+    memcpy(p, GRPC_SLICE_START_PTR(GRPC_MDVALUE(elem)), value_length);
+    return p + value_length;
+  }
+
+  uint32_t ValueLength() const {
+    return static_cast<uint32_t>(GRPC_SLICE_LENGTH(GRPC_MDVALUE(elem)));
+  }
+
+  const grpc_mdelem elem;
+  const char* const name;
+  const size_t name_length;
+  uint32_t elem_index = 0;
+  uint32_t key_index = 0;
+  /* what hpack_enc counts in the sketch for this header */
+  uint32_t sketch_hash = 0;
+};
+}  // namespace
+
+/* Looks up how to send header, following hpack_enc. Returns false if
+   hpack_enc would add it (or its key) to the decoder table: only the general
+   encoder does that. */
+static bool trailers_only_lookup(grpc_chttp2_hpack_compressor* c,
+                                 TrailersOnlyHeader* header) {
+  const grpc_mdelem elem = header->elem;
+  const grpc_slice& key = GRPC_MDKEY(elem);
+  const bool elem_interned = GRPC_MDELEM_IS_INTERNED(elem);
+  const size_t decoder_space_usage =
+      grpc_chttp2_get_size_in_hpack_table(elem, false);
+  const bool decoder_space_available =
+      decoder_space_usage < kMaxDecoderSpaceUsage;
+  const uint32_t key_hash = key.refcount->Hash(key);
+  HpackEncoderIndex index;
+  if (elem_interned) {
+    const uint32_t elem_hash = interned_elem_hash(elem);
+    header->sketch_hash = elem_hash;
+    if (GetMatchingIndex<MetadataComparator>(c->elem_table.entries, elem,
+                                             elem_hash, &index) &&
+        index > c->tail_remote_index) {
+      header->elem_index = dynidx(c, index);
+      return true;
+    }
+    if (decoder_space_available &&
+        WorthIndexing(
+            c, SketchEstimate(c, elem_hash) + 1, decoder_space_usage,
+            static_cast<uint32_t>(decoder_space_usage - kEntryOverhead))) {
+      return false;
+    }
+  } else {
+    header->sketch_hash = key_hash;
+  }
+  if (GetMatchingIndex<SliceRefComparator>(c->key_table.entries, key.refcount,
+                                           key_hash, &index) &&
+      index > c->tail_remote_index) {
+    header->key_index = dynidx(c, index);
+    return true;
+  }
+  return elem_interned || !decoder_space_available ||
+         !WorthIndexing(c, SketchEstimate(c, key_hash) + 1,
+                        decoder_space_usage,
+                        static_cast<uint32_t>(GRPC_SLICE_LENGTH(key)));
+}
+
+bool grpc_chttp2_encode_trailers_only(grpc_chttp2_hpack_compressor* c,
+                                      grpc_mdelem** extra_headers,
+                                      size_t extra_headers_size,
+                                      grpc_metadata_batch* metadata,
+                                      const grpc_encode_header_options* options,
+                                      grpc_slice_buffer* outbuf) {
+  if (extra_headers_size != 2 ||
+      extra_headers[0]->payload != GRPC_MDELEM_STATUS_200.payload ||
+      extra_headers[1]->payload !=
+          GRPC_MDELEM_CONTENT_TYPE_APPLICATION_SLASH_GRPC.payload) {
+    return false;
+  }
+  /* a pending table size change must lead the block, and tracing wants every
+     header logged: leave both to grpc_chttp2_encode_header */
+  if (c->advertise_table_size_change != 0 ||
+      metadata->deadline != GRPC_MILLIS_INF_FUTURE ||
+      GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+    return false;
+  }
+  const grpc_linked_mdelem* status = metadata->idx.named.grpc_status;
+  const grpc_linked_mdelem* message = metadata->idx.named.grpc_message;
+  if (status == nullptr ||
+      metadata->list.count != (message == nullptr ? 1u : 2u)) {
+    return false;
+  }
+  TrailersOnlyHeader headers[] = {
+      {*extra_headers[1], kContentTypeName, sizeof(kContentTypeName) - 1},
+      {status->md, kGrpcStatusName, sizeof(kGrpcStatusName) - 1},
+      {message != nullptr ? message->md : GRPC_MDNULL, kGrpcMessageName,
+       sizeof(kGrpcMessageName) - 1}};
+  const size_t num_headers = message != nullptr ? 3 : 2;
+  size_t len = 1;
+  size_t raw_bytes = GRPC_SLICE_LENGTH(GRPC_MDKEY(*extra_headers[0])) +
+                     GRPC_SLICE_LENGTH(GRPC_MDVALUE(*extra_headers[0]));
+  for (size_t i = 0; i < num_headers; i++) {
+    if (!trailers_only_lookup(c, &headers[i])) return false;
+    len += headers[i].Length();
+    raw_bytes += GRPC_SLICE_LENGTH(GRPC_MDKEY(headers[i].elem)) +
+                 GRPC_SLICE_LENGTH(GRPC_MDVALUE(headers[i].elem));
+  }
+  if (len > options->max_frame_size) return false;
+
+  /* the usual response fits in an inlined slice */
+  uint8_t* p;
+  if (kDataFrameHeaderSize + len <= GRPC_SLICE_INLINED_SIZE) {
+    p = grpc_slice_buffer_tiny_add(outbuf, kDataFrameHeaderSize + len);
+  } else {
+    grpc_slice frame = GRPC_SLICE_MALLOC(kDataFrameHeaderSize + len);
+    p = GRPC_SLICE_START_PTR(frame);
+    grpc_slice_buffer_add(outbuf, frame);
+  }
+  fill_header(p, GRPC_CHTTP2_FRAME_HEADER, options->stream_id, len,
+              static_cast<uint8_t>(
+                  (options->is_eof ? GRPC_CHTTP2_DATA_FLAG_END_STREAM : 0) |
+                  GRPC_CHTTP2_DATA_FLAG_END_HEADERS));
+  p += kDataFrameHeaderSize;
+  *p++ = kStatus200Indexed;
+  for (size_t i = 0; i < num_headers; i++) {
+    SketchIncrement(c, headers[i].sketch_hash);
+    p = headers[i].Write(p);
+  }
+
+  options->stats->framing_bytes += kDataFrameHeaderSize;
+  options->stats->header_bytes += len;
+  c->stats.raw_bytes += raw_bytes;
+  c->stats.encoded_bytes += len;
+  GRPC_STATS_INC_COUNTER_BY(GRPC_STATS_COUNTER_HPACK_SEND_RAW_BYTES,
+                            raw_bytes);
+  GRPC_STATS_INC_COUNTER_BY(GRPC_STATS_COUNTER_HPACK_SEND_ENCODED_BYTES, len);
+  return true;
 }
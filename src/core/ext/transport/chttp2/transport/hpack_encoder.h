@@ -35,9 +35,51 @@
 #define GRPC_CHTTP2_HPACKC_INITIAL_TABLE_SIZE 4096
 /* maximum table size we'll actually use */
 #define GRPC_CHTTP2_HPACKC_MAX_TABLE_SIZE (1024 * 1024)
+/* dimensions of the frequency sketch deciding what to add to the table */
+#define GRPC_CHTTP2_HPACKC_SKETCH_WIDTH_BITS 8
+#define GRPC_CHTTP2_HPACKC_SKETCH_WIDTH \
+  (1 << GRPC_CHTTP2_HPACKC_SKETCH_WIDTH_BITS)
+#define GRPC_CHTTP2_HPACKC_SKETCH_ROWS 2
+/* number of pre-encoded header block fragments kept per compressor */
+#define GRPC_CHTTP2_HPACKC_NUM_FRAGMENTS 8
+/* maximum number of headers in a fragment */
+#define GRPC_CHTTP2_HPACKC_FRAGMENT_ELEMS 12
 
 extern grpc_core::TraceFlag grpc_http_trace;
 
+struct grpc_chttp2_hpack_compressor_stats {
+  /* bytes of header names and values given to the encoder */
+  uint64_t raw_bytes;
+  /* bytes of header block the encoder produced for them, without framing */
+  uint64_t encoded_bytes;
+  /* headers that were not added to the table because they were not expected
+     to save more bytes than the entries they would evict */
+  uint64_t index_rejected;
+  /* batches with leading headers copied from a cached fragment */
+  uint64_t fragment_hits;
+};
+
+/* The encoding of the leading headers of a batch, all of them sent by index,
+   kept to be copied out as is the next time a batch starts with (some of) the
+   same headers. Batches are matched by their :path (which registered calls
+   intern), or else by their first header. */
+struct grpc_chttp2_hpack_fragment {
+  grpc_mdelem key;
+  /* the state of the decoder table the fragment was encoded against: adding
+     or evicting entries shifts the dynamic indices */
+  uint32_t tail_remote_index;
+  uint32_t table_elems;
+  uint32_t num_elems;
+  grpc_mdelem elems[GRPC_CHTTP2_HPACKC_FRAGMENT_ELEMS];
+  /* the elems that hpack_enc would count in the sketch (bit i for elems[i]:
+     those not in the static table), and their hashes */
+  uint32_t sketched;
+  uint32_t elem_hashes[GRPC_CHTTP2_HPACKC_FRAGMENT_ELEMS];
+  /* the encoding, and where the encoding of each elem ends in it */
+  uint8_t bytes[GRPC_SLICE_INLINED_SIZE];
+  uint8_t ends[GRPC_CHTTP2_HPACKC_FRAGMENT_ELEMS];
+};
+
 struct grpc_chttp2_hpack_compressor {
   uint32_t max_table_size;
   uint32_t max_table_elems;
@@ -50,17 +92,27 @@ struct grpc_chttp2_hpack_compressor {
   uint32_t table_size;
   uint32_t table_elems;
   uint16_t* table_elem_size;
+  /* for each entry of the decoder table: the hash it is counted under in the
+     sketch, and the bytes each use of it saves over a literal. Together they
+     weigh the entry against a newcomer that would evict it. */
+  uint32_t* table_elem_hash;
+  uint16_t* table_elem_saving;
   /** if non-zero, advertise to the decoder that we'll start using a table
       of this size */
   uint8_t advertise_table_size_change;
 
-  /* filter tables for elems: this tables provides an approximate
-     popularity count for particular hashes, and are used to determine whether
-     a new literal should be added to the compression table or not.
-     They track a single integer that counts how often a particular value has
-     been seen. When that count reaches max (255), all values are halved. */
-  uint32_t filter_elems_sum;
-  uint8_t filter_elems[GRPC_CHTTP2_HPACKC_NUM_VALUES];
+  /* frequency sketch: approximate counts of how often each element (or, for
+     elements with values that are not interned, each key) has been seen.
+     An item's estimate is its smallest counter across the rows, so hash
+     collisions can only overestimate it. All counters are halved after a
+     fixed number of increments, so estimates follow the recent workload. */
+  uint32_t sketch_samples;
+  uint8_t sketch[GRPC_CHTTP2_HPACKC_SKETCH_ROWS]
+                [GRPC_CHTTP2_HPACKC_SKETCH_WIDTH];
+
+  grpc_chttp2_hpack_compressor_stats stats;
+
+  grpc_chttp2_hpack_fragment fragments[GRPC_CHTTP2_HPACKC_NUM_FRAGMENTS];
 
   /* entry tables for keys & elems: these tables track values that have been
      seen and *may* be in the decompressor table */
@@ -90,6 +142,11 @@ void grpc_chttp2_hpack_compressor_set_max_table_size(
 void grpc_chttp2_hpack_compressor_set_max_usable_size(
     grpc_chttp2_hpack_compressor* c, uint32_t max_table_size);
 
+/* Ratio of raw header bytes to encoded header bytes over the lifetime of the
+   compressor (so, of its connection), or 0 before anything was encoded */
+double grpc_chttp2_hpack_compressor_compression_ratio(
+    const grpc_chttp2_hpack_compressor* c);
+
 typedef struct {
   uint32_t stream_id;
   bool is_eof;
@@ -105,4 +162,18 @@ void grpc_chttp2_encode_header(grpc_chttp2_hpack_compressor* c,
                                const grpc_encode_header_options* options,
                                grpc_slice_buffer* outbuf);
 
+/* Encodes a trailers-only response (extra_headers being the :status and
+   content-type moved over from the initial metadata) without going through
+   the general encoder, if it is a plain one: :status 200, content-type
+   application/grpc, grpc-status and possibly grpc-message. Returns false,
+   having written nothing, for anything else, and when one of the headers
+   should be added to the decoder table, which only grpc_chttp2_encode_header
+   does. */
+bool grpc_chttp2_encode_trailers_only(grpc_chttp2_hpack_compressor* c,
+                                      grpc_mdelem** extra_headers,
+                                      size_t extra_headers_size,
+                                      grpc_metadata_batch* metadata,
+                                      const grpc_encode_header_options* options,
+                                      grpc_slice_buffer* outbuf);
+
 #endif /* GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_HPACK_ENCODER_H */
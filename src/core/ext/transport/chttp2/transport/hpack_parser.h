@@ -81,12 +81,14 @@ struct grpc_chttp2_hpack_parser {
   uint32_t strlen;
   /* number of source bytes read for the currently parsing string */
   uint32_t strgot;
-  /* huffman decoding state */
-  int16_t huff_state;
+  /* huffman decoding state: input bits not decoded yet, held in the low
+     huff_nbits bits of huff_buf */
+  uint64_t huff_buf;
   /* is the string being decoded binary? */
   uint8_t binary;
   /* is the current string huffman encoded? */
   uint8_t huff;
+  uint8_t huff_nbits;
   /* is a dynamic table update allowed? */
   uint8_t dynamic_table_update_allowed;
   /* set by higher layers, used by grpc_chttp2_header_parser_parse to signal
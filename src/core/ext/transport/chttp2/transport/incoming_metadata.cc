@@ -44,8 +44,9 @@ grpc_error* grpc_chttp2_incoming_metadata_buffer_add(
 
 grpc_error* grpc_chttp2_incoming_metadata_buffer_replace_or_add(
     grpc_chttp2_incoming_metadata_buffer* buffer, grpc_mdelem elem) {
-  for (grpc_linked_mdelem* l = buffer->batch.list.head; l != nullptr;
-       l = l->next) {
+  grpc_linked_mdelem* const* elems = grpc_metadata_batch_elems(&buffer->batch);
+  for (size_t i = 0; i < buffer->batch.list.count; i++) {
+    grpc_linked_mdelem* l = elems[i];
     if (grpc_slice_eq(GRPC_MDKEY(l->md), GRPC_MDKEY(elem))) {
       GRPC_MDELEM_UNREF(l->md);
       l->md = elem;
@@ -36,6 +36,7 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/ext/transport/chttp2/transport/incoming_metadata.h"
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
+#include "src/core/ext/transport/chttp2/transport/write_scheduler.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/compression/stream_compression.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
@@ -43,6 +44,7 @@
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/transport/connectivity_state.h"
+#include "src/core/lib/transport/rtt_estimator.h"
 #include "src/core/lib/transport/transport_impl.h"
 
 namespace grpc_core {
@@ -109,6 +111,11 @@ const char* grpc_chttp2_initiate_write_reason_string(
 typedef struct {
   grpc_closure_list lists[GRPC_CHTTP2_PCL_COUNT] = {};
   uint64_t inflight_id = 0;
+  /* when the inflight ping was written */
+  gpr_timespec inflight_start;
+  /* the inflight ping is in outbuf, and inflight_start is stamped when
+     outbuf is handed to the endpoint: a corked write must not count as rtt */
+  bool inflight_start_pending = false;
 } grpc_chttp2_ping_queue;
 
 typedef struct {
@@ -278,6 +285,16 @@ class Chttp2IncomingByteStream : public ByteStream {
   grpc_closure destroy_action_;
 };
 
+// A message that was received in full before being handed to the call: it is
+// read straight from its slices, without going back to the transport
+class Chttp2BufferedByteStream : public SliceBufferByteStream {
+ public:
+  Chttp2BufferedByteStream(grpc_slice_buffer* slice_buffer, uint32_t flags)
+      : SliceBufferByteStream(slice_buffer, flags) {}
+
+  void Orphan() override;
+};
+
 }  // namespace grpc_core
 
 typedef enum {
@@ -387,6 +404,8 @@ struct grpc_chttp2_transport {
   grpc_chttp2_repeated_ping_state ping_state;
   uint64_t ping_ctr = 0; /* unique id for pings */
   grpc_closure retry_initiate_ping_locked;
+  /** round trip times of our pings */
+  grpc_core::RttEstimator rtt_estimator;
 
   /** ping acks */
   size_t ping_ack_count = 0;
@@ -411,6 +430,12 @@ struct grpc_chttp2_transport {
       grpc_core::chttp2::TransportFlowControl,
       grpc_core::chttp2::TransportFlowControlDisabled>
       flow_control;
+  /** decides how much each writable stream may write per turn */
+  grpc_core::PolymorphicManualConstructor<
+      grpc_core::chttp2::WriteSchedulerBase,
+      grpc_core::chttp2::FifoWriteScheduler,
+      grpc_core::chttp2::WeightedDrrWriteScheduler>
+      write_scheduler;
   /** initial window change. This is tracked as we parse settings frames from
    * the remote peer. If there is a positive delta, then we will make all
    * streams readable since they may have become unstalled */
@@ -478,6 +503,11 @@ struct grpc_chttp2_transport {
   grpc_timer keepalive_watchdog_timer;
   /** time duration in between pings */
   grpc_millis keepalive_time;
+  /** time duration in between pings while there are no streams: it doubles
+      with each ping that finds the transport idle, up to keepalive_max_time,
+      and a new stream brings it back to keepalive_time */
+  grpc_millis keepalive_idle_time;
+  grpc_millis keepalive_max_time;
   /** grace period for a ping to complete before watchdog kicks in */
   grpc_millis keepalive_timeout;
   /** if keepalive pings are allowed when there's no outstanding streams */
@@ -489,6 +519,27 @@ struct grpc_chttp2_transport {
   grpc_core::ContextList* cl = nullptr;
   grpc_core::RefCountedPtr<grpc_core::channelz::SocketNode> channelz_socket;
   uint32_t num_messages_in_next_write = 0;
+  /** number of frames gathered into outbuf for the next endpoint write */
+  uint32_t num_frames_in_next_write = 0;
+  /** number of frames in qbuf that num_pending_induced_frames does not
+      count: GOAWAYs and the trailers-only HEADERS of close_from_api */
+  uint32_t num_queued_frames = 0;
+
+  /* write corking support */
+  /** how long (in microseconds) a write smaller than the target write size
+      may be held back so that frames becoming ready meanwhile can join it;
+      0 disables corking */
+  uint32_t write_cork_us = 0;
+  /** is a gathered write being held back? */
+  bool write_corked = false;
+  /** is write_cork_timer pending? */
+  bool have_write_cork_timer = false;
+  /** when the held back write was first gathered */
+  gpr_timespec write_cork_start;
+  /** timer to send a held back write once write_cork_us has passed */
+  grpc_timer write_cork_timer;
+  /** Closure to run when write_cork_timer fires */
+  grpc_closure write_cork_timer_fired_locked;
   /** The number of pending induced frames (SETTINGS_ACK, PINGS_ACK and
    * RST_STREAM) in the outgoing buffer (t->qbuf). If this number goes beyond
    * DEFAULT_MAX_PENDING_INDUCED_FRAMES, we pause reading new frames. We would
@@ -549,6 +600,7 @@ struct grpc_chttp2_stream {
   bool* trailing_metadata_available = nullptr;
   grpc_core::OrphanablePtr<grpc_core::ByteStream>* recv_message;
   grpc_closure* recv_message_ready = nullptr;
+  bool* next_message_available = nullptr;
   grpc_metadata_batch* recv_trailing_metadata;
   grpc_closure* recv_trailing_metadata_finished = nullptr;
 
@@ -624,6 +676,12 @@ struct grpc_chttp2_stream {
 
   grpc_slice_buffer flow_controlled_buffer;
 
+  /** share of the connection's writes this stream gets, relative to other
+      streams, if the write scheduler uses stream weights */
+  uint32_t write_weight = grpc_core::chttp2::kDefaultStreamWeight;
+  /** DATA bytes this stream may still write in its current turn */
+  uint32_t write_deficit = 0;
+
   grpc_chttp2_write_cb* on_flow_controlled_cbs = nullptr;
   grpc_chttp2_write_cb* on_write_finished_cbs = nullptr;
   grpc_chttp2_write_cb* finish_after_write = nullptr;
@@ -690,6 +748,8 @@ typedef struct {
 grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
     grpc_chttp2_transport* t);
 void grpc_chttp2_end_write(grpc_chttp2_transport* t, grpc_error* error);
+/** How many bytes would we like to put on the wire during a single syscall */
+uint32_t grpc_chttp2_target_write_size(grpc_chttp2_transport* t);
 
 /** Process one slice of incoming data; return 1 if the connection is still
     viable after reading, or 0 if the connection should be torn down */
@@ -704,6 +764,7 @@ bool grpc_chttp2_list_pop_writable_stream(grpc_chttp2_transport* t,
                                           grpc_chttp2_stream** s);
 bool grpc_chttp2_list_remove_writable_stream(grpc_chttp2_transport* t,
                                              grpc_chttp2_stream* s);
+bool grpc_chttp2_list_have_writable_streams(grpc_chttp2_transport* t);
 
 bool grpc_chttp2_list_add_writing_stream(grpc_chttp2_transport* t,
                                          grpc_chttp2_stream* s);
@@ -507,6 +507,9 @@ static grpc_error* on_initial_header(void* tp, grpc_mdelem md) {
     s->seen_error = true;
   } else if (md_key_cmp(md, GRPC_MDSTR_GRPC_TIMEOUT)) {
     return handle_timeout(s, md);
+  } else if (!t->is_client && t->write_scheduler->uses_stream_weights()) {
+    const uint32_t weight = grpc_core::chttp2::StreamWeightFromMetadata(md);
+    if (weight != 0) s->write_weight = weight;
   }
 
   const size_t new_size = s->metadata_buffer[0].size + GRPC_MDELEM_LENGTH(md);
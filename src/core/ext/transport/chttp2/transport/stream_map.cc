@@ -20,21 +20,55 @@
 
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+/* grow the table once more than 3/4 of its slots are in use */
+static bool over_max_load(size_t count, size_t capacity) {
+  return count > capacity - capacity / 4;
+}
+
+/* Fibonacci hashing: spreads the arithmetic sequences that stream ids come in
+   evenly over the table */
+static size_t home_slot(const grpc_chttp2_stream_map* map, uint32_t key) {
+  return static_cast<uint32_t>(key * 2654435769u) >> map->hash_shift;
+}
+
+static void alloc_table(grpc_chttp2_stream_map* map, size_t capacity) {
+  uint32_t hash_shift = 32;
+  for (size_t c = capacity; c > 1; c >>= 1) {
+    hash_shift--;
+  }
+  map->keys = static_cast<uint32_t*>(gpr_zalloc(sizeof(uint32_t) * capacity));
+  map->values = static_cast<void**>(gpr_malloc(sizeof(void*) * capacity));
+  map->capacity = capacity;
+  map->hash_shift = hash_shift;
+}
+
+/* place key, known to be absent, in the first free slot of its probe
+   sequence */
+static void insert(grpc_chttp2_stream_map* map, uint32_t key, void* value) {
+  const size_t mask = map->capacity - 1;
+  size_t i = home_slot(map, key);
+  while (map->keys[i] != 0) {
+    i = (i + 1) & mask;
+  }
+  map->keys[i] = key;
+  map->values[i] = value;
+}
+
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity) {
   GPR_DEBUG_ASSERT(initial_capacity > 1);
-  map->keys =
-      static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * initial_capacity));
-  map->values =
-      static_cast<void**>(gpr_malloc(sizeof(void*) * initial_capacity));
+  size_t capacity = 4;
+  while (capacity < initial_capacity) {
+    capacity *= 2;
+  }
+  alloc_table(map, capacity);
   map->count = 0;
-  map->free = 0;
-  map->capacity = initial_capacity;
 }
 
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
@@ -42,136 +76,113 @@ void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
   gpr_free(map->values);
 }
 
-static size_t compact(uint32_t* keys, void** values, size_t count) {
-  size_t i, out;
-
-  for (i = 0, out = 0; i < count; i++) {
-    if (values[i]) {
-      keys[out] = keys[i];
-      values[out] = values[i];
-      out++;
+static void grow(grpc_chttp2_stream_map* map) {
+  uint32_t* keys = map->keys;
+  void** values = map->values;
+  const size_t capacity = map->capacity;
+  alloc_table(map, 2 * capacity);
+  for (size_t i = 0; i < capacity; i++) {
+    if (keys[i] != 0) {
+      insert(map, keys[i], values[i]);
     }
   }
-
-  return out;
+  gpr_free(keys);
+  gpr_free(values);
 }
 
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
                                 void* value) {
-  size_t count = map->count;
-  size_t capacity = map->capacity;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-
-  // The first assertion ensures that the table is monotonically increasing.
-  GPR_ASSERT(count == 0 || keys[count - 1] < key);
+  GPR_ASSERT(key != 0);
   GPR_DEBUG_ASSERT(value);
-  // Asserting that the key is not already in the map can be a debug assertion.
-  // Why: we're already checking that the map elements are monotonically
-  // increasing. If we re-add a key, i.e. if the key is already present, then
-  // either it is the most recently added key in the map (in which case the
-  // first assertion fails due to key == last_key) or there is a more recently
-  // added (larger) key at the end of the map: in which case the first assertion
-  // still fails due to key < last_key.
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
-
-  if (count == capacity) {
-    if (map->free > capacity / 4) {
-      count = compact(keys, values, count);
-      map->free = 0;
-    } else {
-      /* resize when less than 25% of the table is free, because compaction
-         won't help much */
-      map->capacity = capacity = 2 * capacity;
-      map->keys = keys = static_cast<uint32_t*>(
-          gpr_realloc(keys, capacity * sizeof(uint32_t)));
-      map->values = values =
-          static_cast<void**>(gpr_realloc(values, capacity * sizeof(void*)));
-    }
+  if (over_max_load(map->count + 1, map->capacity)) {
+    grow(map);
   }
-
-  keys[count] = key;
-  values[count] = value;
-  map->count = count + 1;
+  insert(map, key, value);
+  map->count++;
 }
 
-template <bool strict_find>
-static void** find(grpc_chttp2_stream_map* map, uint32_t key) {
-  size_t min_idx = 0;
-  size_t max_idx = map->count;
-  size_t mid_idx;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-  uint32_t mid_key;
-
-  GPR_DEBUG_ASSERT(!strict_find || max_idx > 0);
-  if (!strict_find && max_idx == 0) return nullptr;
-
-  while (min_idx < max_idx) {
-    /* find the midpoint, avoiding overflow */
-    mid_idx = min_idx + ((max_idx - min_idx) / 2);
-    mid_key = keys[mid_idx];
-
-    if (mid_key < key) {
-      min_idx = mid_idx + 1;
-    } else if (mid_key > key) {
-      max_idx = mid_idx;
-    } else /* mid_key == key */
-    {
-      return &values[mid_idx];
-    }
+/* returns the slot holding key, or map->capacity if there is none */
+static size_t find(const grpc_chttp2_stream_map* map, uint32_t key) {
+  const size_t mask = map->capacity - 1;
+  for (size_t i = home_slot(map, key);; i = (i + 1) & mask) {
+    const uint32_t k = map->keys[i];
+    if (k == key) return i;
+    if (k == 0) return map->capacity;
   }
-
-  GPR_DEBUG_ASSERT(!strict_find);
-  return nullptr;
 }
 
 void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<true>(map, key);
-  GPR_DEBUG_ASSERT(pvalue != nullptr);
-  void* out = *pvalue;
-  GPR_DEBUG_ASSERT(out != nullptr);
-  *pvalue = nullptr;
-  map->free++;
-  /* recognize complete emptyness and ensure we can skip
-     defragmentation later */
-  if (map->free == map->count) {
-    map->free = map->count = 0;
+  if (key == 0) return nullptr;
+  size_t hole = find(map, key);
+  if (hole == map->capacity) return nullptr;
+  void* out = map->values[hole];
+  /* Shift back the entries that follow in the same run of occupied slots
+     and may live in the hole: those whose home slot is not cyclically in
+     (hole, i]. This keeps every entry reachable from its home slot. */
+  const size_t mask = map->capacity - 1;
+  for (size_t i = (hole + 1) & mask; map->keys[i] != 0; i = (i + 1) & mask) {
+    const size_t home = home_slot(map, map->keys[i]);
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      map->keys[hole] = map->keys[i];
+      map->values[hole] = map->values[i];
+      hole = i;
+    }
   }
+  map->keys[hole] = 0;
+  map->count--;
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
   return out;
 }
 
 void* grpc_chttp2_stream_map_find(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<false>(map, key);
-  return pvalue != nullptr ? *pvalue : nullptr;
+  if (key == 0) return nullptr;
+  const size_t i = find(map, key);
+  return i != map->capacity ? map->values[i] : nullptr;
 }
 
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map) {
-  return map->count - map->free;
+  return map->count;
 }
 
 void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map) {
-  if (map->count == map->free) {
+  if (map->count == 0) {
     return nullptr;
   }
-  if (map->free != 0) {
-    map->count = compact(map->keys, map->values, map->count);
-    map->free = 0;
-    GPR_ASSERT(map->count > 0);
+  const size_t mask = map->capacity - 1;
+  size_t i = static_cast<size_t>(rand()) & mask;
+  while (map->keys[i] == 0) {
+    i = (i + 1) & mask;
   }
-  return map->values[(static_cast<size_t>(rand())) % map->count];
+  return map->values[i];
 }
 
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
                                      void* user_data) {
-  size_t i;
-
-  for (i = 0; i < map->count; i++) {
-    if (map->values[i]) {
-      f(user_data, map->keys[i], map->values[i]);
+  if (map->count == 0) return;
+  /* Walk the table once, starting after an empty slot: no run of occupied
+     slots then spans the start. Deleting the entry f was called for only
+     shifts back entries that follow it in its run, so when its slot changes
+     it is visited again instead of moving on. */
+  const size_t mask = map->capacity - 1;
+  size_t start = 0;
+  while (map->keys[start] != 0) {
+    start++;
+  }
+  for (size_t n = 1; n < map->capacity;) {
+    const size_t i = (start + n) & mask;
+    const uint32_t key = map->keys[i];
+    if (key == 0) {
+      n++;
+      continue;
+    }
+    const size_t count = map->count;
+    f(user_data, key, map->values[i]);
+    GPR_DEBUG_ASSERT(map->count + 1 >= count);
+    if (map->keys[i] == key) {
+      n++;
     }
   }
 }
@@ -25,24 +25,27 @@
 
 /* Data structure to map a uint32_t to a data object (represented by a void*)
 
-   Represented as a sorted array of keys, and a corresponding array of values.
-   Lookups are performed with binary search.
-   Adds are restricted to strictly higher keys than previously seen (this is
-   guaranteed by http2). */
+   Represented as an open addressing hash table with linear probing: an array
+   of keys, where 0 marks an empty slot, and a corresponding array of values.
+   Probing only touches the densely packed keys until it finds a match, and
+   deletes shift later entries of the probe sequence back, so the table never
+   fills up with tombstones. Keys must be non-zero (stream ids always are). */
 typedef struct {
   uint32_t* keys;
   void** values;
   size_t count;
-  size_t free;
+  /* always a power of two */
   size_t capacity;
+  /* 32 - log2(capacity): turns a 32 bit hash into a slot index */
+  uint32_t hash_shift;
 } grpc_chttp2_stream_map;
 
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity);
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map);
 
-/* Add a new key: given http2 semantics, new keys must always be greater than
-   existing keys - this is asserted */
+/* Add a new key: given http2 semantics, the key must not be in the map yet -
+   this is asserted in debug builds */
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
                                 void* value);
 
@@ -59,7 +62,8 @@ void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map);
 /* How many (populated) entries are in the stream map? */
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map);
 
-/* Callback on each stream */
+/* Callback on each stream, in no particular order. f may delete the entry it
+   is called for, but no other entry */
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
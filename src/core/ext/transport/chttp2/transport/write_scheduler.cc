@@ -0,0 +1,60 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chttp2/transport/write_scheduler.h"
+
+#include <grpc/slice.h>
+
+#include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/slice/slice_string_helpers.h"
+
+namespace grpc_core {
+namespace chttp2 {
+
+uint32_t WeightedDrrWriteScheduler::BeginTurn(grpc_chttp2_stream* s) {
+  s->write_deficit += quantum_ * s->write_weight;
+  return s->write_deficit;
+}
+
+void WeightedDrrWriteScheduler::EndTurn(grpc_chttp2_stream* s,
+                                        uint32_t bytes_written,
+                                        bool backlogged) {
+  // A stream that runs out of data (or window) forfeits its deficit, as it
+  // would otherwise build up credit while idle.
+  s->write_deficit =
+      backlogged ? s->write_deficit - GPR_MIN(bytes_written, s->write_deficit)
+                 : 0;
+}
+
+uint32_t StreamWeightFromMetadata(grpc_mdelem md) {
+  if (grpc_slice_str_cmp(GRPC_MDKEY(md), "grpc-priority") != 0) {
+    return 0;
+  }
+  uint32_t weight;
+  if (!grpc_parse_slice_to_uint32(GRPC_MDVALUE(md), &weight) || weight == 0 ||
+      weight > kMaxStreamWeight) {
+    return 0;
+  }
+  return weight;
+}
+
+}  // namespace chttp2
+}  // namespace grpc_core
@@ -0,0 +1,103 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_WRITE_SCHEDULER_H
+#define GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_WRITE_SCHEDULER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "src/core/lib/transport/metadata.h"
+
+struct grpc_chttp2_stream;
+
+namespace grpc_core {
+namespace chttp2 {
+
+// Stream weights follow HTTP/2 stream priority weights (RFC 7540 5.3.2).
+static constexpr uint32_t kDefaultStreamWeight = 16;
+static constexpr uint32_t kMaxStreamWeight = 256;
+// DATA bytes a stream may write per turn, per unit of weight, when scheduled
+// by WeightedDrrWriteScheduler. A default weight stream writes one default
+// sized frame per turn.
+static constexpr uint32_t kDefaultWriteQuantum = 1024;
+
+// Decides how many DATA bytes each writable stream gets to write per turn.
+// Streams take turns in the order they became writable, and a stream that
+// still has data to write at the end of its turn goes back to the end of the
+// writable list, so this bounds how long one busy stream can hold up the
+// others on the connection.
+class WriteSchedulerBase {
+ public:
+  WriteSchedulerBase() {}
+  virtual ~WriteSchedulerBase() {}
+
+  // Should streams' write_weight be read from their grpc-priority metadata?
+  virtual bool uses_stream_weights() const { abort(); }
+
+  // Called when s starts a turn. Returns the number of DATA bytes s may write
+  // during the turn.
+  virtual uint32_t BeginTurn(grpc_chttp2_stream* /* s */) { abort(); }
+
+  // Called when s ends a turn in which it wrote bytes_written DATA bytes.
+  // backlogged is true if s is still waiting to write more.
+  virtual void EndTurn(grpc_chttp2_stream* /* s */,
+                       uint32_t /* bytes_written */, bool /* backlogged */) {
+    abort();
+  }
+};
+
+// Lets every stream write all it can on each turn.
+class FifoWriteScheduler final : public WriteSchedulerBase {
+ public:
+  bool uses_stream_weights() const override { return false; }
+  uint32_t BeginTurn(grpc_chttp2_stream* /* s */) override {
+    return UINT32_MAX;
+  }
+  void EndTurn(grpc_chttp2_stream* /* s */, uint32_t /* bytes_written */,
+               bool /* backlogged */) override {}
+};
+
+// Weighted deficit round robin: each turn adds quantum * write_weight bytes
+// to the stream's write_deficit, which caps what it writes in the turn. The
+// unused deficit of a backlogged stream carries over to its next turn, so
+// over a round every backlogged stream gets a share of the connection
+// proportional to its weight.
+class WeightedDrrWriteScheduler final : public WriteSchedulerBase {
+ public:
+  explicit WeightedDrrWriteScheduler(uint32_t quantum) : quantum_(quantum) {}
+
+  bool uses_stream_weights() const override { return true; }
+  uint32_t BeginTurn(grpc_chttp2_stream* s) override;
+  void EndTurn(grpc_chttp2_stream* s, uint32_t bytes_written,
+               bool backlogged) override;
+
+ private:
+  const uint32_t quantum_;
+};
+
+// Returns the stream weight carried by md if it is a grpc-priority header with
+// a value in [1, kMaxStreamWeight], or 0 otherwise.
+uint32_t StreamWeightFromMetadata(grpc_mdelem md);
+
+}  // namespace chttp2
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_WRITE_SCHEDULER_H */
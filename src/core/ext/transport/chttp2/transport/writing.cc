@@ -106,12 +106,14 @@ static void maybe_initiate_ping(grpc_chttp2_transport* t) {
   }
 
   pq->inflight_id = t->ping_ctr;
+  pq->inflight_start_pending = true;
   t->ping_ctr++;
   GRPC_CLOSURE_LIST_SCHED(&pq->lists[GRPC_CHTTP2_PCL_INITIATE]);
   grpc_closure_list_move(&pq->lists[GRPC_CHTTP2_PCL_NEXT],
                          &pq->lists[GRPC_CHTTP2_PCL_INFLIGHT]);
   grpc_slice_buffer_add(&t->outbuf,
                         grpc_chttp2_ping_create(false, pq->inflight_id));
+  t->num_frames_in_next_write++;
   GRPC_STATS_INC_HTTP2_PINGS_SENT();
   t->ping_state.last_ping_sent_time = now;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace) ||
@@ -175,8 +177,7 @@ static void report_stall(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
   }
 }
 
-/* How many bytes would we like to put on the wire during a single syscall */
-static uint32_t target_write_size(grpc_chttp2_transport* t) {
+uint32_t grpc_chttp2_target_write_size(grpc_chttp2_transport* /*t*/) {
   return 1024 * 1024;
 }
 
@@ -215,6 +216,7 @@ class WriteContext {
       t_->force_send_settings = false;
       t_->dirtied_local_settings = false;
       t_->sent_local_settings = true;
+      t_->num_frames_in_next_write++;
       GRPC_STATS_INC_HTTP2_SETTINGS_WRITES();
     }
   }
@@ -222,7 +224,12 @@ class WriteContext {
   void FlushQueuedBuffers() {
     /* simple writes are queued to qbuf, and flushed here */
     grpc_slice_buffer_move_into(&t_->qbuf, &t_->outbuf);
+    /* induced frames: settings acks, RST_STREAMs and the ping acks written
+       by FlushPingAcks; plus the GOAWAYs and trailers-only responses */
+    t_->num_frames_in_next_write +=
+        t_->num_pending_induced_frames + t_->num_queued_frames;
     t_->num_pending_induced_frames = 0;
+    t_->num_queued_frames = 0;
     GPR_ASSERT(t_->qbuf.count == 0);
   }
 
@@ -234,6 +241,7 @@ class WriteContext {
       grpc_slice_buffer_add(
           &t_->outbuf, grpc_chttp2_window_update_create(0, transport_announce,
                                                         &throwaway_stats));
+      t_->num_frames_in_next_write++;
       ResetPingClock();
     }
   }
@@ -266,7 +274,7 @@ class WriteContext {
   }
 
   grpc_chttp2_stream* NextStream() {
-    if (t_->outbuf.length > target_write_size(t_)) {
+    if (t_->outbuf.length > grpc_chttp2_target_write_size(t_)) {
       result_.partial = true;
       return nullptr;
     }
@@ -317,11 +325,12 @@ class WriteContext {
 class DataSendContext {
  public:
   DataSendContext(WriteContext* write_context, grpc_chttp2_transport* t,
-                  grpc_chttp2_stream* s)
+                  grpc_chttp2_stream* s, uint32_t turn_bytes_left)
       : write_context_(write_context),
         t_(t),
         s_(s),
-        sending_bytes_before_(s_->sending_bytes) {}
+        sending_bytes_before_(s_->sending_bytes),
+        turn_bytes_left_(turn_bytes_left) {}
 
   uint32_t stream_remote_window() const {
     return static_cast<uint32_t> GPR_MAX(
@@ -332,7 +341,9 @@ class DataSendContext {
 
   uint32_t max_outgoing() const {
     return static_cast<uint32_t> GPR_MIN(
-        t_->settings[GRPC_PEER_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
+        GPR_MIN(t_->settings[GRPC_PEER_SETTINGS]
+                            [GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
+                turn_bytes_left_),
         GPR_MIN(stream_remote_window(), t_->flow_control->remote_window()));
   }
 
@@ -347,8 +358,10 @@ class DataSendContext {
                      grpc_metadata_batch_is_empty(s_->send_trailing_metadata);
     grpc_chttp2_encode_data(s_->id, &s_->flow_controlled_buffer, send_bytes,
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
+    t_->num_frames_in_next_write++;
     s_->flow_control->SentData(send_bytes);
     s_->sending_bytes += send_bytes;
+    turn_bytes_left_ -= send_bytes;
   }
 
   void FlushCompressedBytes() {
@@ -382,7 +395,9 @@ class DataSendContext {
                      grpc_metadata_batch_is_empty(s_->send_trailing_metadata);
     grpc_chttp2_encode_data(s_->id, &s_->compressed_data_buffer, send_bytes,
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
+    t_->num_frames_in_next_write++;
     s_->flow_control->SentData(send_bytes);
+    turn_bytes_left_ -= send_bytes;
     if (s_->compressed_data_buffer.length == 0) {
       s_->sending_bytes += s_->uncompressed_data_size;
     }
@@ -407,6 +422,8 @@ class DataSendContext {
 
   bool is_last_frame() const { return is_last_frame_; }
 
+  uint32_t turn_bytes_left() const { return turn_bytes_left_; }
+
   void CallCallbacks() {
     if (update_list(
             t_, s_,
@@ -422,13 +439,24 @@ class DataSendContext {
   grpc_chttp2_transport* t_;
   grpc_chttp2_stream* s_;
   const size_t sending_bytes_before_;
+  uint32_t turn_bytes_left_;
   bool is_last_frame_ = false;
 };
 
 class StreamWriteContext {
  public:
   StreamWriteContext(WriteContext* write_context, grpc_chttp2_stream* s)
-      : write_context_(write_context), t_(write_context->transport()), s_(s) {
+      : write_context_(write_context),
+        t_(write_context->transport()),
+        s_(s),
+        // Under weighted scheduling, a stream that has the connection to
+        // itself need not take short turns, but is still held to one write's
+        // worth of data so that streams becoming writable meanwhile are not
+        // left waiting long. The fifo scheduler never limits a turn.
+        turn_quota_(!t_->write_scheduler->uses_stream_weights() ||
+                            grpc_chttp2_list_have_writable_streams(t_)
+                        ? t_->write_scheduler->BeginTurn(s)
+                        : grpc_chttp2_target_write_size(t_)) {
     GRPC_CHTTP2_IF_TRACING(
         gpr_log(GPR_INFO, "W:%p %s[%d] im-(sent,send)=(%d,%d) announce=%d", t_,
                 t_->is_client ? "CLIENT" : "SERVER", s->id,
@@ -464,8 +492,10 @@ class StreamWriteContext {
                       [GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],  // max_frame_size
           &s_->stats.outgoing                                 // stats
       };
+      const uint64_t framing_bytes_before = s_->stats.outgoing.framing_bytes;
       grpc_chttp2_encode_header(&t_->hpack_compressor, nullptr, 0,
                                 s_->send_initial_metadata, &hopt, &t_->outbuf);
+      CountHeaderFrames(framing_bytes_before);
       write_context_->ResetPingClock();
       write_context_->IncInitialMetadataWrites();
     }
@@ -493,6 +523,7 @@ class StreamWriteContext {
     grpc_slice_buffer_add(
         &t_->outbuf, grpc_chttp2_window_update_create(s_->id, stream_announce,
                                                       &s_->stats.outgoing));
+    t_->num_frames_in_next_write++;
     write_context_->ResetPingClock();
     write_context_->IncWindowUpdateWrites();
   }
@@ -505,7 +536,7 @@ class StreamWriteContext {
       return;  // early out: nothing to do
     }
 
-    DataSendContext data_send_context(write_context_, t_, s_);
+    DataSendContext data_send_context(write_context_, t_, s_, turn_quota_);
 
     if (!data_send_context.AnyOutgoing()) {
       if (t_->flow_control->remote_window() <= 0) {
@@ -535,6 +566,7 @@ class StreamWriteContext {
         }
       }
     }
+    turn_bytes_written_ = turn_quota_ - data_send_context.turn_bytes_left();
     write_context_->ResetPingClock();
     if (data_send_context.is_last_frame()) {
       SentLastFrame();
@@ -561,6 +593,7 @@ class StreamWriteContext {
     if (grpc_metadata_batch_is_empty(s_->send_trailing_metadata)) {
       grpc_chttp2_encode_data(s_->id, &s_->flow_controlled_buffer, 0, true,
                               &s_->stats.outgoing, &t_->outbuf);
+      t_->num_frames_in_next_write++;
     } else {
       grpc_encode_header_options hopt = {
           s_->id, true,
@@ -570,10 +603,18 @@ class StreamWriteContext {
 
           t_->settings[GRPC_PEER_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
           &s_->stats.outgoing};
-      grpc_chttp2_encode_header(&t_->hpack_compressor,
-                                extra_headers_for_trailing_metadata_,
-                                num_extra_headers_for_trailing_metadata_,
-                                s_->send_trailing_metadata, &hopt, &t_->outbuf);
+      const uint64_t framing_bytes_before = s_->stats.outgoing.framing_bytes;
+      if (num_extra_headers_for_trailing_metadata_ == 0 ||
+          !grpc_chttp2_encode_trailers_only(
+              &t_->hpack_compressor, extra_headers_for_trailing_metadata_,
+              num_extra_headers_for_trailing_metadata_,
+              s_->send_trailing_metadata, &hopt, &t_->outbuf)) {
+        grpc_chttp2_encode_header(
+            &t_->hpack_compressor, extra_headers_for_trailing_metadata_,
+            num_extra_headers_for_trailing_metadata_,
+            s_->send_trailing_metadata, &hopt, &t_->outbuf);
+      }
+      CountHeaderFrames(framing_bytes_before);
     }
     write_context_->IncTrailingMetadataWrites();
     write_context_->ResetPingClock();
@@ -587,6 +628,13 @@ class StreamWriteContext {
 
   bool stream_became_writable() { return stream_became_writable_; }
 
+  /* Tells the write scheduler how much DATA this turn wrote */
+  void EndTurn() {
+    t_->write_scheduler->EndTurn(
+        s_, turn_bytes_written_,
+        s_->included[GRPC_CHTTP2_LIST_WRITABLE] != 0);
+  }
+
  private:
   void ConvertInitialMetadataToTrailingMetadata() {
     GRPC_CHTTP2_IF_TRACING(
@@ -605,6 +653,13 @@ class StreamWriteContext {
     }
   }
 
+  /* The hpack encoder accounts 9 framing bytes for each HEADERS and
+     CONTINUATION frame it writes */
+  void CountHeaderFrames(uint64_t framing_bytes_before) {
+    t_->num_frames_in_next_write += static_cast<uint32_t>(
+        (s_->stats.outgoing.framing_bytes - framing_bytes_before) / 9);
+  }
+
   void SentLastFrame() {
     s_->send_trailing_metadata = nullptr;
     s_->sent_trailing_metadata = true;
@@ -614,6 +669,7 @@ class StreamWriteContext {
       grpc_slice_buffer_add(
           &t_->outbuf, grpc_chttp2_rst_stream_create(
                            s_->id, GRPC_HTTP2_NO_ERROR, &s_->stats.outgoing));
+      t_->num_frames_in_next_write++;
     }
     grpc_chttp2_mark_stream_closed(t_, s_, !t_->is_client, true,
                                    GRPC_ERROR_NONE);
@@ -622,6 +678,8 @@ class StreamWriteContext {
   WriteContext* const write_context_;
   grpc_chttp2_transport* const t_;
   grpc_chttp2_stream* const s_;
+  const uint32_t turn_quota_;
+  uint32_t turn_bytes_written_ = 0;
   bool stream_became_writable_ = false;
   grpc_mdelem* extra_headers_for_trailing_metadata_[2];
   size_t num_extra_headers_for_trailing_metadata_ = 0;
@@ -649,6 +707,7 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
     stream_ctx.FlushWindowUpdates();
     stream_ctx.FlushData();
     stream_ctx.FlushTrailingMetadata();
+    stream_ctx.EndTurn();
     if (t->outbuf.length > orig_len) {
       /* Add this stream to the list of the contexts to be traced at TCP */
       s->byte_counter += t->outbuf.length - orig_len;
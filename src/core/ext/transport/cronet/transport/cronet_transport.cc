@@ -722,13 +722,7 @@ static void convert_metadata_to_cronet_headers(
     grpc_metadata_batch* metadata, const char* host, char** pp_url,
     bidirectional_stream_header** pp_headers, size_t* p_num_headers,
     const char** method) {
-  grpc_linked_mdelem* curr = metadata->list.head;
-  /* Walk the linked list and get number of header fields */
-  size_t num_headers_available = 0;
-  while (curr != nullptr) {
-    curr = curr->next;
-    num_headers_available++;
-  }
+  size_t num_headers_available = metadata->list.count;
   grpc_millis deadline = metadata->deadline;
   if (deadline != GRPC_MILLIS_INF_FUTURE) {
     num_headers_available++;
@@ -740,16 +734,13 @@ static void convert_metadata_to_cronet_headers(
           sizeof(bidirectional_stream_header) * num_headers_available));
   *pp_headers = headers;
 
-  /* Walk the linked list again, this time copying the header fields.
-    s->num_headers can be less than num_headers_available, as some headers
-    are not used for cronet.
-    TODO (makdharma): Eliminate need to traverse the LL second time for perf.
+  /* Copy the header fields. s->num_headers can be less than
+    num_headers_available, as some headers are not used for cronet.
    */
-  curr = metadata->list.head;
+  grpc_linked_mdelem* const* elems = grpc_metadata_batch_elems(metadata);
   size_t num_headers = 0;
-  while (num_headers < num_headers_available) {
-    grpc_mdelem mdelem = curr->md;
-    curr = curr->next;
+  for (size_t i = 0; i < metadata->list.count; i++) {
+    grpc_mdelem mdelem = elems[i]->md;
     char* key = grpc_slice_to_c_string(GRPC_MDKEY(mdelem));
     char* value;
     if (grpc_is_binary_header_internal(GRPC_MDKEY(mdelem))) {
@@ -789,9 +780,6 @@ static void convert_metadata_to_cronet_headers(
     headers[num_headers].key = key;
     headers[num_headers].value = value;
     num_headers++;
-    if (curr == nullptr) {
-      break;
-    }
   }
   if (deadline != GRPC_MILLIS_INF_FUTURE) {
     char* key = grpc_slice_to_c_string(GRPC_MDSTR_GRPC_TIMEOUT);
@@ -820,13 +808,13 @@ static void parse_grpc_header(const uint8_t* data, int* length,
   *length |= (*p++);
 }
 
-static bool header_has_authority(grpc_linked_mdelem* head) {
-  while (head != nullptr) {
-    if (grpc_slice_eq_static_interned(GRPC_MDKEY(head->md),
+static bool header_has_authority(grpc_metadata_batch* metadata) {
+  grpc_linked_mdelem* const* elems = grpc_metadata_batch_elems(metadata);
+  for (size_t i = 0; i < metadata->list.count; i++) {
+    if (grpc_slice_eq_static_interned(GRPC_MDKEY(elems[i]->md),
                                       GRPC_MDSTR_AUTHORITY)) {
       return true;
     }
-    head = head->next;
   }
   return false;
 }
@@ -1428,8 +1416,8 @@ static void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
                               grpc_transport_stream_op_batch* op) {
   CRONET_LOG(GPR_DEBUG, "perform_stream_op");
   if (op->send_initial_metadata &&
-      header_has_authority(op->payload->send_initial_metadata
-                               .send_initial_metadata->list.head)) {
+      header_has_authority(
+          op->payload->send_initial_metadata.send_initial_metadata)) {
     /* Cronet does not support :authority header field. We cancel the call when
      this field is present in metadata */
     if (op->recv_initial_metadata) {
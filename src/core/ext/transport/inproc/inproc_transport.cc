@@ -283,10 +283,10 @@ struct inproc_stream {
 
 void log_metadata(const grpc_metadata_batch* md_batch, bool is_client,
                   bool is_initial) {
-  for (grpc_linked_mdelem* md = md_batch->list.head; md != nullptr;
-       md = md->next) {
-    char* key = grpc_slice_to_c_string(GRPC_MDKEY(md->md));
-    char* value = grpc_slice_to_c_string(GRPC_MDVALUE(md->md));
+  grpc_linked_mdelem* const* elems = grpc_metadata_batch_elems(md_batch);
+  for (size_t i = 0; i < md_batch->list.count; i++) {
+    char* key = grpc_slice_to_c_string(GRPC_MDKEY(elems[i]->md));
+    char* value = grpc_slice_to_c_string(GRPC_MDVALUE(elems[i]->md));
     gpr_log(GPR_INFO, "INPROC:%s:%s: %s: %s", is_initial ? "HDR" : "TRL",
             is_client ? "CLI" : "SVR", key, value);
     gpr_free(key);
@@ -309,15 +309,17 @@ grpc_error* fill_in_metadata(inproc_stream* s,
     *markfilled = true;
   }
   grpc_error* error = GRPC_ERROR_NONE;
-  for (grpc_linked_mdelem* elem = metadata->list.head;
-       (elem != nullptr) && (error == GRPC_ERROR_NONE); elem = elem->next) {
-    grpc_linked_mdelem* nelem =
-        static_cast<grpc_linked_mdelem*>(s->arena->Alloc(sizeof(*nelem)));
-    nelem->md =
-        grpc_mdelem_from_slices(grpc_slice_intern(GRPC_MDKEY(elem->md)),
-                                grpc_slice_intern(GRPC_MDVALUE(elem->md)));
-
-    error = grpc_metadata_batch_link_tail(out_md, nelem);
+  const size_t count = metadata->list.count;
+  if (count == 0) return error;
+  grpc_linked_mdelem* const* elems = grpc_metadata_batch_elems(metadata);
+  grpc_linked_mdelem* storage = static_cast<grpc_linked_mdelem*>(
+      s->arena->Alloc(sizeof(*storage) * count));
+  for (size_t i = 0; i < count && error == GRPC_ERROR_NONE; i++) {
+    storage[i].md =
+        grpc_mdelem_from_slices(grpc_slice_intern(GRPC_MDKEY(elems[i]->md)),
+                                grpc_slice_intern(GRPC_MDVALUE(elems[i]->md)));
+
+    error = grpc_metadata_batch_link_tail(out_md, &storage[i]);
   }
   return error;
 }
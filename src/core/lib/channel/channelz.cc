@@ -24,6 +24,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -311,6 +312,15 @@ void ChannelNode::RemoveChildSubchannel(intptr_t child_uuid) {
   child_subchannels_.erase(child_uuid);
 }
 
+InlinedVector<intptr_t, 8> ChannelNode::ChildSubchannels() {
+  MutexLock lock(&child_mu_);
+  InlinedVector<intptr_t, 8> uuids;
+  for (const auto& p : child_subchannels_) {
+    uuids.push_back(p.first);
+  }
+  return uuids;
+}
+
 //
 // ServerNode
 //
@@ -428,6 +438,20 @@ grpc_json* ServerNode::RenderJson() {
 
 namespace {
 
+// Adds a socket option holding a duration given in microseconds.
+void PopulateRttOptionJson(grpc_json* options, const char* name,
+                           int64_t rtt_us) {
+  grpc_json* json = grpc_json_create_child(nullptr, options, nullptr, nullptr,
+                                           GRPC_JSON_OBJECT, false);
+  grpc_json* json_iterator = grpc_json_create_child(
+      nullptr, json, "name", name, GRPC_JSON_STRING, false);
+  char* value;
+  gpr_asprintf(&value, "%" PRId64 ".%06" PRId64 "s", rtt_us / GPR_US_PER_SEC,
+               rtt_us % GPR_US_PER_SEC);
+  grpc_json_create_child(json_iterator, json, "value", value, GRPC_JSON_STRING,
+                         true);
+}
+
 void PopulateSocketAddressJson(grpc_json* json, const char* name,
                                const char* addr_str) {
   if (addr_str == nullptr) return;
@@ -598,6 +622,15 @@ grpc_json* SocketNode::RenderJson() {
     json_iterator = grpc_json_add_number_string_child(
         json, json_iterator, "keepAlivesSent", keepalives_sent);
   }
+  // The proto has no round trip time fields: they go in as socket options
+  gpr_atm smoothed_rtt_us = gpr_atm_no_barrier_load(&smoothed_rtt_us_);
+  if (smoothed_rtt_us != 0) {
+    grpc_json* options = grpc_json_create_child(
+        json_iterator, json, "option", nullptr, GRPC_JSON_ARRAY, false);
+    PopulateRttOptionJson(options, "grpc.smoothed_rtt", smoothed_rtt_us);
+    PopulateRttOptionJson(options, "grpc.min_rtt",
+                          gpr_atm_no_barrier_load(&min_rtt_us_));
+  }
   return top_level_json;
 }
 
@@ -202,6 +202,9 @@ class ChannelNode : public BaseNode {
   void AddChildSubchannel(intptr_t child_uuid);
   void RemoveChildSubchannel(intptr_t child_uuid);
 
+  // Returns the uuids of the child subchannels.
+  InlinedVector<intptr_t, 8> ChildSubchannels();
+
  private:
   void PopulateChildRefs(grpc_json* json);
 
@@ -288,6 +291,20 @@ class SocketNode : public BaseNode {
   void RecordKeepaliveSent() {
     gpr_atm_no_barrier_fetch_add(&keepalives_sent_, static_cast<gpr_atm>(1));
   }
+  // Records the transport's latest round trip time estimates.
+  void RecordRtt(int64_t smoothed_rtt_us, int64_t min_rtt_us) {
+    gpr_atm_no_barrier_store(&smoothed_rtt_us_,
+                             static_cast<gpr_atm>(smoothed_rtt_us));
+    gpr_atm_no_barrier_store(&min_rtt_us_, static_cast<gpr_atm>(min_rtt_us));
+  }
+
+  // Both 0 until the transport measured a round trip.
+  int64_t smoothed_rtt_us() {
+    return static_cast<int64_t>(gpr_atm_no_barrier_load(&smoothed_rtt_us_));
+  }
+  int64_t min_rtt_us() {
+    return static_cast<int64_t>(gpr_atm_no_barrier_load(&min_rtt_us_));
+  }
 
   const char* remote() { return remote_.get(); }
 
@@ -302,6 +319,8 @@ class SocketNode : public BaseNode {
   gpr_atm last_remote_stream_created_cycle_ = 0;
   gpr_atm last_message_sent_cycle_ = 0;
   gpr_atm last_message_received_cycle_ = 0;
+  gpr_atm smoothed_rtt_us_ = 0;
+  gpr_atm min_rtt_us_ = 0;
   UniquePtr<char> local_;
   UniquePtr<char> remote_;
 };
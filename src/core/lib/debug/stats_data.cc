@@ -28,12 +28,17 @@
 const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "client_calls_created",
     "server_calls_created",
+    "call_arena_pool_hits",
+    "call_arena_pool_misses",
     "cqs_created",
     "client_channels_created",
     "client_subchannels_created",
     "server_channels_created",
     "syscall_poll",
     "syscall_wait",
+    "syscall_io_uring_submit",
+    "poll_spin_hits",
+    "poll_spin_sleeps",
     "pollset_kick",
     "pollset_kicked_without_poller",
     "pollset_kicked_again",
@@ -47,6 +52,15 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "syscall_read",
     "tcp_backup_pollers_created",
     "tcp_backup_poller_polls",
+    "tcp_zerocopy_sends",
+    "tcp_zerocopy_fallbacks",
+    "tcp_read_allocs",
+    "tcp_read_alloc_bytes",
+    "tcp_read_used_bytes",
+    "tcp_read_slab_reuses",
+    "resource_quota_buffer_pool_hits",
+    "resource_quota_buffer_pool_misses",
+    "resource_quota_buffer_pool_flushes",
     "http2_op_batches",
     "http2_op_cancel",
     "http2_op_send_initial_metadata",
@@ -61,6 +75,7 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "http2_writes_offloaded",
     "http2_writes_continued",
     "http2_partial_writes",
+    "http2_writes_corked",
     "http2_initiate_write_due_to_initial_write",
     "http2_initiate_write_due_to_start_new_stream",
     "http2_initiate_write_due_to_send_message",
@@ -105,6 +120,9 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "hpack_send_huffman",
     "hpack_send_binary",
     "hpack_send_binary_base64",
+    "hpack_send_raw_bytes",
+    "hpack_send_encoded_bytes",
+    "hpack_send_index_rejected",
     "combiner_locks_initiated",
     "combiner_locks_scheduled_items",
     "combiner_locks_scheduled_final_items",
@@ -119,8 +137,11 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "executor_wakeup_initiated",
     "executor_queue_drained",
     "executor_push_retries",
+    "executor_steals",
+    "executor_stolen_items",
     "server_requested_calls",
     "server_slowpath_requests_queued",
+    "server_pending_calls_stolen",
     "cq_ev_queue_trylock_failures",
     "cq_ev_queue_trylock_successes",
     "cq_ev_queue_transient_pop_failures",
@@ -128,12 +149,21 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
 const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of client side calls created by this process",
     "Number of server side calls created by this process",
+    "Number of calls allocated from the arena of a finished call on the same "
+    "channel",
+    "Number of calls that had to allocate a new arena",
     "Number of completion queues created",
     "Number of client channels created",
     "Number of client subchannels created",
     "Number of server channels created",
     "Number of polling syscalls (epoll_wait, poll, etc) made by this process",
     "Number of sleeping syscalls made by this process",
+    "Number of io_uring_enter calls made only to submit requests, outside of "
+    "polling (iouring polling engine)",
+    "Number of times a poller spinning before sleep "
+    "(GRPC_POLL_SPIN_BUDGET_US) found events within its spin budget",
+    "Number of times a poller spinning before sleep "
+    "(GRPC_POLL_SPIN_BUDGET_US) exhausted its spin budget and blocked",
     "How many polling wakeups were performed by the process (only valid for "
     "epoll1 right now)",
     "How many times was a polling wakeup requested without an active poller "
@@ -156,6 +186,20 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of read syscalls (or equivalent - eg recvmsg) made by this process",
     "Number of times a backup poller has been created (this can be expensive)",
     "Number of polls performed on the backup poller",
+    "Number of write syscalls made with MSG_ZEROCOPY",
+    "Number of zerocopy-eligible writes that were copied instead (no free "
+    "send record, kernel out of option memory, or kernel-side copy)",
+    "Number of read slabs allocated by tcp endpoints",
+    "Number of bytes allocated for tcp endpoint read slabs",
+    "Number of bytes of tcp endpoint read slabs filled with received data",
+    "Number of times a tcp endpoint rewound a read slab no longer referenced "
+    "by the upper layers instead of allocating a new one",
+    "Number of resource user slices allocated from a resource quota's buffer "
+    "pool",
+    "Number of poolable resource user slices that had to be allocated because "
+    "the resource quota's buffer pool was empty",
+    "Number of times a non-empty resource quota's buffer pool was emptied "
+    "(memory pressure or quota destruction)",
     "Number of batches received by HTTP2 transport",
     "Number of cancelations received by HTTP2 transport",
     "Number of batches containing send initial metadata",
@@ -172,6 +216,8 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "written",
     "Number of HTTP2 writes that were made knowing there was still more data "
     "to be written (we cap maximum write size to syscall_write)",
+    "Number of HTTP2 writes held back to be coalesced with frames that became "
+    "ready shortly after",
     "Number of HTTP2 writes initiated due to 'initial_write'",
     "Number of HTTP2 writes initiated due to 'start_new_stream'",
     "Number of HTTP2 writes initiated due to 'send_message'",
@@ -223,6 +269,10 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of huffman encoded strings sent in metadata",
     "Number of binary strings received in metadata",
     "Number of binary strings received encoded in base64 in metadata",
+    "Number of bytes of header names and values given to the HPACK encoder",
+    "Number of bytes of HPACK header block produced by the encoder",
+    "Number of headers not added to the HPACK table because they were not "
+    "expected to save more bytes than the entries they would evict",
     "Number of combiner lock entries by process (first items queued to a "
     "combiner)",
     "Number of items scheduled against combiner locks",
@@ -242,9 +292,14 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of times an executor queue was drained",
     "Number of times we raced and were forced to retry pushing a closure to "
     "the executor",
+    "Number of times an executor thread stole closures queued on another "
+    "executor thread (work-stealing mode only)",
+    "Number of closures moved between executor threads by stealing",
     "How many calls were requested (not necessarily received) by the server",
     "How many times was the server slow path taken (indicates too few "
     "outstanding requests)",
+    "How many queued calls were matched with a request made on a completion "
+    "queue other than the one polling their channel",
     "Number of lock (trylock) acquisition failures on completion queue event "
     "queue. High value here indicates high contention on completion queues",
     "Number of lock (trylock) acquisition successes on completion queue event "
@@ -265,6 +320,9 @@ const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "http2_send_message_per_write",
     "http2_send_trailing_metadata_per_write",
     "http2_send_flowctl_per_write",
+    "http2_frames_per_write",
+    "http2_write_size",
+    "executor_queue_depth",
     "server_cqs_checked",
 };
 const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
@@ -280,6 +338,10 @@ const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Number of streams whose payload was written per TCP write",
     "Number of streams terminated per TCP write",
     "Number of flow control updates written per TCP write",
+    "Number of HTTP2 frames written per TCP write",
+    "Number of bytes handed to the endpoint per HTTP2 write",
+    "Number of closures queued or running on an executor thread when a new "
+    "closure is scheduled onto it",
     "How many completion queues were checked looking for a CQ that had "
     "requested the incoming call",
 };
@@ -638,6 +700,77 @@ void grpc_stats_inc_http2_send_flowctl_per_write(int value) {
       GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
       grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_6, 64));
 }
+void grpc_stats_inc_http2_frames_per_write(int value) {
+  value = GPR_CLAMP(value, 0, 1024);
+  if (value < 13) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4637863191261478912ull) {
+    int bucket =
+        grpc_stats_table_7[((_val.uint - 4623507967449235456ull) >> 48)] + 13;
+    _bkt.dbl = grpc_stats_table_6[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_6, 64));
+}
+void grpc_stats_inc_http2_write_size(int value) {
+  value = GPR_CLAMP(value, 0, 16777216);
+  if (value < 5) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_HTTP2_WRITE_SIZE, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4683743612465315840ull) {
+    int bucket =
+        grpc_stats_table_5[((_val.uint - 4617315517961601024ull) >> 50)] + 5;
+    _bkt.dbl = grpc_stats_table_4[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_HTTP2_WRITE_SIZE, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_HTTP2_WRITE_SIZE,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_4, 64));
+}
+void grpc_stats_inc_executor_queue_depth(int value) {
+  value = GPR_CLAMP(value, 0, 64);
+  if (value < 3) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DEPTH, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4625196817309499392ull) {
+    int bucket =
+        grpc_stats_table_9[((_val.uint - 4613937818241073152ull) >> 51)] + 3;
+    _bkt.dbl = grpc_stats_table_8[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DEPTH, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DEPTH,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_8, 8));
+}
 void grpc_stats_inc_server_cqs_checked(int value) {
   value = GPR_CLAMP(value, 0, 64);
   if (value < 3) {
@@ -661,17 +794,19 @@ void grpc_stats_inc_server_cqs_checked(int value) {
       GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
       grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_8, 8));
 }
-const int grpc_stats_histo_buckets[13] = {64, 128, 64, 64, 64, 64, 64,
-                                          64, 64,  64, 64, 64, 8};
-const int grpc_stats_histo_start[13] = {0,   64,  192, 256, 320, 384, 448,
-                                        512, 576, 640, 704, 768, 832};
-const int* const grpc_stats_histo_bucket_boundaries[13] = {
+const int grpc_stats_histo_buckets[16] = {64, 128, 64, 64, 64, 64, 64, 64,
+                                          64, 64,  64, 64, 64, 64, 8,  8};
+const int grpc_stats_histo_start[16] = {0,   64,  192, 256, 320, 384,
+                                        448, 512, 576, 640, 704, 768,
+                                        832, 896, 960, 968};
+const int* const grpc_stats_histo_bucket_boundaries[16] = {
     grpc_stats_table_0, grpc_stats_table_2, grpc_stats_table_4,
     grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_4,
     grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_6,
     grpc_stats_table_6, grpc_stats_table_6, grpc_stats_table_6,
+    grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_8,
     grpc_stats_table_8};
-void (*const grpc_stats_inc_histogram[13])(int x) = {
+void (*const grpc_stats_inc_histogram[16])(int x) = {
     grpc_stats_inc_call_initial_size,
     grpc_stats_inc_poll_events_returned,
     grpc_stats_inc_tcp_write_size,
@@ -684,4 +819,7 @@ void (*const grpc_stats_inc_histogram[13])(int x) = {
     grpc_stats_inc_http2_send_message_per_write,
     grpc_stats_inc_http2_send_trailing_metadata_per_write,
     grpc_stats_inc_http2_send_flowctl_per_write,
+    grpc_stats_inc_http2_frames_per_write,
+    grpc_stats_inc_http2_write_size,
+    grpc_stats_inc_executor_queue_depth,
     grpc_stats_inc_server_cqs_checked};
@@ -29,12 +29,17 @@
 typedef enum {
   GRPC_STATS_COUNTER_CLIENT_CALLS_CREATED,
   GRPC_STATS_COUNTER_SERVER_CALLS_CREATED,
+  GRPC_STATS_COUNTER_CALL_ARENA_POOL_HITS,
+  GRPC_STATS_COUNTER_CALL_ARENA_POOL_MISSES,
   GRPC_STATS_COUNTER_CQS_CREATED,
   GRPC_STATS_COUNTER_CLIENT_CHANNELS_CREATED,
   GRPC_STATS_COUNTER_CLIENT_SUBCHANNELS_CREATED,
   GRPC_STATS_COUNTER_SERVER_CHANNELS_CREATED,
   GRPC_STATS_COUNTER_SYSCALL_POLL,
   GRPC_STATS_COUNTER_SYSCALL_WAIT,
+  GRPC_STATS_COUNTER_SYSCALL_IO_URING_SUBMIT,
+  GRPC_STATS_COUNTER_POLL_SPIN_HITS,
+  GRPC_STATS_COUNTER_POLL_SPIN_SLEEPS,
   GRPC_STATS_COUNTER_POLLSET_KICK,
   GRPC_STATS_COUNTER_POLLSET_KICKED_WITHOUT_POLLER,
   GRPC_STATS_COUNTER_POLLSET_KICKED_AGAIN,
@@ -48,6 +53,15 @@ typedef enum {
   GRPC_STATS_COUNTER_SYSCALL_READ,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS,
+  GRPC_STATS_COUNTER_TCP_ZEROCOPY_SENDS,
+  GRPC_STATS_COUNTER_TCP_ZEROCOPY_FALLBACKS,
+  GRPC_STATS_COUNTER_TCP_READ_ALLOCS,
+  GRPC_STATS_COUNTER_TCP_READ_ALLOC_BYTES,
+  GRPC_STATS_COUNTER_TCP_READ_USED_BYTES,
+  GRPC_STATS_COUNTER_TCP_READ_SLAB_REUSES,
+  GRPC_STATS_COUNTER_RESOURCE_QUOTA_BUFFER_POOL_HITS,
+  GRPC_STATS_COUNTER_RESOURCE_QUOTA_BUFFER_POOL_MISSES,
+  GRPC_STATS_COUNTER_RESOURCE_QUOTA_BUFFER_POOL_FLUSHES,
   GRPC_STATS_COUNTER_HTTP2_OP_BATCHES,
   GRPC_STATS_COUNTER_HTTP2_OP_CANCEL,
   GRPC_STATS_COUNTER_HTTP2_OP_SEND_INITIAL_METADATA,
@@ -62,6 +76,7 @@ typedef enum {
   GRPC_STATS_COUNTER_HTTP2_WRITES_OFFLOADED,
   GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED,
   GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES,
+  GRPC_STATS_COUNTER_HTTP2_WRITES_CORKED,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_SEND_MESSAGE,
@@ -106,6 +121,9 @@ typedef enum {
   GRPC_STATS_COUNTER_HPACK_SEND_HUFFMAN,
   GRPC_STATS_COUNTER_HPACK_SEND_BINARY,
   GRPC_STATS_COUNTER_HPACK_SEND_BINARY_BASE64,
+  GRPC_STATS_COUNTER_HPACK_SEND_RAW_BYTES,
+  GRPC_STATS_COUNTER_HPACK_SEND_ENCODED_BYTES,
+  GRPC_STATS_COUNTER_HPACK_SEND_INDEX_REJECTED,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_INITIATED,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_ITEMS,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS,
@@ -120,8 +138,11 @@ typedef enum {
   GRPC_STATS_COUNTER_EXECUTOR_WAKEUP_INITIATED,
   GRPC_STATS_COUNTER_EXECUTOR_QUEUE_DRAINED,
   GRPC_STATS_COUNTER_EXECUTOR_PUSH_RETRIES,
+  GRPC_STATS_COUNTER_EXECUTOR_STEALS,
+  GRPC_STATS_COUNTER_EXECUTOR_STOLEN_ITEMS,
   GRPC_STATS_COUNTER_SERVER_REQUESTED_CALLS,
   GRPC_STATS_COUNTER_SERVER_SLOWPATH_REQUESTS_QUEUED,
+  GRPC_STATS_COUNTER_SERVER_PENDING_CALLS_STOLEN,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES,
@@ -142,6 +163,9 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
+  GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_SIZE,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DEPTH,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
   GRPC_STATS_HISTOGRAM_COUNT
 } grpc_stats_histograms;
@@ -172,15 +196,25 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE_BUCKETS = 64,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_FIRST_SLOT = 768,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 832,
+  GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE_FIRST_SLOT = 832,
+  GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_SIZE_FIRST_SLOT = 896,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_SIZE_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DEPTH_FIRST_SLOT = 960,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DEPTH_BUCKETS = 8,
+  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 968,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_BUCKETS = 8,
-  GRPC_STATS_HISTOGRAM_BUCKETS = 840
+  GRPC_STATS_HISTOGRAM_BUCKETS = 976
 } grpc_stats_histogram_constants;
 #if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_CALLS_CREATED)
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_CALLS_CREATED)
+#define GRPC_STATS_INC_CALL_ARENA_POOL_HITS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CALL_ARENA_POOL_HITS)
+#define GRPC_STATS_INC_CALL_ARENA_POOL_MISSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CALL_ARENA_POOL_MISSES)
 #define GRPC_STATS_INC_CQS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQS_CREATED)
 #define GRPC_STATS_INC_CLIENT_CHANNELS_CREATED() \
@@ -193,6 +227,12 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SYSCALL_POLL)
 #define GRPC_STATS_INC_SYSCALL_WAIT() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SYSCALL_WAIT)
+#define GRPC_STATS_INC_SYSCALL_IO_URING_SUBMIT() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SYSCALL_IO_URING_SUBMIT)
+#define GRPC_STATS_INC_POLL_SPIN_HITS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLL_SPIN_HITS)
+#define GRPC_STATS_INC_POLL_SPIN_SLEEPS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLL_SPIN_SLEEPS)
 #define GRPC_STATS_INC_POLLSET_KICK() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK)
 #define GRPC_STATS_INC_POLLSET_KICKED_WITHOUT_POLLER() \
@@ -219,6 +259,24 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED)
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS)
+#define GRPC_STATS_INC_TCP_ZEROCOPY_SENDS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_ZEROCOPY_SENDS)
+#define GRPC_STATS_INC_TCP_ZEROCOPY_FALLBACKS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_ZEROCOPY_FALLBACKS)
+#define GRPC_STATS_INC_TCP_READ_ALLOCS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_READ_ALLOCS)
+#define GRPC_STATS_INC_TCP_READ_ALLOC_BYTES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_READ_ALLOC_BYTES)
+#define GRPC_STATS_INC_TCP_READ_USED_BYTES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_READ_USED_BYTES)
+#define GRPC_STATS_INC_TCP_READ_SLAB_REUSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_READ_SLAB_REUSES)
+#define GRPC_STATS_INC_RESOURCE_QUOTA_BUFFER_POOL_HITS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_RESOURCE_QUOTA_BUFFER_POOL_HITS)
+#define GRPC_STATS_INC_RESOURCE_QUOTA_BUFFER_POOL_MISSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_RESOURCE_QUOTA_BUFFER_POOL_MISSES)
+#define GRPC_STATS_INC_RESOURCE_QUOTA_BUFFER_POOL_FLUSHES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_RESOURCE_QUOTA_BUFFER_POOL_FLUSHES)
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_OP_BATCHES)
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL() \
@@ -247,6 +305,8 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED)
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES)
+#define GRPC_STATS_INC_HTTP2_WRITES_CORKED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_CORKED)
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE() \
   GRPC_STATS_INC_COUNTER(                                          \
       GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE)
@@ -356,6 +416,12 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_BINARY)
 #define GRPC_STATS_INC_HPACK_SEND_BINARY_BASE64() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_BINARY_BASE64)
+#define GRPC_STATS_INC_HPACK_SEND_RAW_BYTES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_RAW_BYTES)
+#define GRPC_STATS_INC_HPACK_SEND_ENCODED_BYTES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_ENCODED_BYTES)
+#define GRPC_STATS_INC_HPACK_SEND_INDEX_REJECTED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_INDEX_REJECTED)
 #define GRPC_STATS_INC_COMBINER_LOCKS_INITIATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_COMBINER_LOCKS_INITIATED)
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_ITEMS() \
@@ -385,10 +451,16 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_EXECUTOR_QUEUE_DRAINED)
 #define GRPC_STATS_INC_EXECUTOR_PUSH_RETRIES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_EXECUTOR_PUSH_RETRIES)
+#define GRPC_STATS_INC_EXECUTOR_STEALS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_EXECUTOR_STEALS)
+#define GRPC_STATS_INC_EXECUTOR_STOLEN_ITEMS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_EXECUTOR_STOLEN_ITEMS)
 #define GRPC_STATS_INC_SERVER_REQUESTED_CALLS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_REQUESTED_CALLS)
 #define GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_SLOWPATH_REQUESTS_QUEUED)
+#define GRPC_STATS_INC_SERVER_PENDING_CALLS_STOLEN() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_PENDING_CALLS_STOLEN)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES() \
@@ -431,18 +503,32 @@ void grpc_stats_inc_http2_send_trailing_metadata_per_write(int x);
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value) \
   grpc_stats_inc_http2_send_flowctl_per_write((int)(value))
 void grpc_stats_inc_http2_send_flowctl_per_write(int x);
+#define GRPC_STATS_INC_HTTP2_FRAMES_PER_WRITE(value) \
+  grpc_stats_inc_http2_frames_per_write((int)(value))
+void grpc_stats_inc_http2_frames_per_write(int x);
+#define GRPC_STATS_INC_HTTP2_WRITE_SIZE(value) \
+  grpc_stats_inc_http2_write_size((int)(value))
+void grpc_stats_inc_http2_write_size(int x);
+#define GRPC_STATS_INC_EXECUTOR_QUEUE_DEPTH(value) \
+  grpc_stats_inc_executor_queue_depth((int)(value))
+void grpc_stats_inc_executor_queue_depth(int x);
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value) \
   grpc_stats_inc_server_cqs_checked((int)(value))
 void grpc_stats_inc_server_cqs_checked(int x);
 #else
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED()
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED()
+#define GRPC_STATS_INC_CALL_ARENA_POOL_HITS()
+#define GRPC_STATS_INC_CALL_ARENA_POOL_MISSES()
 #define GRPC_STATS_INC_CQS_CREATED()
 #define GRPC_STATS_INC_CLIENT_CHANNELS_CREATED()
 #define GRPC_STATS_INC_CLIENT_SUBCHANNELS_CREATED()
 #define GRPC_STATS_INC_SERVER_CHANNELS_CREATED()
 #define GRPC_STATS_INC_SYSCALL_POLL()
 #define GRPC_STATS_INC_SYSCALL_WAIT()
+#define GRPC_STATS_INC_SYSCALL_IO_URING_SUBMIT()
+#define GRPC_STATS_INC_POLL_SPIN_HITS()
+#define GRPC_STATS_INC_POLL_SPIN_SLEEPS()
 #define GRPC_STATS_INC_POLLSET_KICK()
 #define GRPC_STATS_INC_POLLSET_KICKED_WITHOUT_POLLER()
 #define GRPC_STATS_INC_POLLSET_KICKED_AGAIN()
@@ -456,6 +542,15 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_SYSCALL_READ()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLERS_CREATED()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS()
+#define GRPC_STATS_INC_TCP_ZEROCOPY_SENDS()
+#define GRPC_STATS_INC_TCP_ZEROCOPY_FALLBACKS()
+#define GRPC_STATS_INC_TCP_READ_ALLOCS()
+#define GRPC_STATS_INC_TCP_READ_ALLOC_BYTES()
+#define GRPC_STATS_INC_TCP_READ_USED_BYTES()
+#define GRPC_STATS_INC_TCP_READ_SLAB_REUSES()
+#define GRPC_STATS_INC_RESOURCE_QUOTA_BUFFER_POOL_HITS()
+#define GRPC_STATS_INC_RESOURCE_QUOTA_BUFFER_POOL_MISSES()
+#define GRPC_STATS_INC_RESOURCE_QUOTA_BUFFER_POOL_FLUSHES()
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES()
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL()
 #define GRPC_STATS_INC_HTTP2_OP_SEND_INITIAL_METADATA()
@@ -470,6 +565,7 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_WRITES_OFFLOADED()
 #define GRPC_STATS_INC_HTTP2_WRITES_CONTINUED()
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES()
+#define GRPC_STATS_INC_HTTP2_WRITES_CORKED()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_SEND_MESSAGE()
@@ -514,6 +610,9 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HPACK_SEND_HUFFMAN()
 #define GRPC_STATS_INC_HPACK_SEND_BINARY()
 #define GRPC_STATS_INC_HPACK_SEND_BINARY_BASE64()
+#define GRPC_STATS_INC_HPACK_SEND_RAW_BYTES()
+#define GRPC_STATS_INC_HPACK_SEND_ENCODED_BYTES()
+#define GRPC_STATS_INC_HPACK_SEND_INDEX_REJECTED()
 #define GRPC_STATS_INC_COMBINER_LOCKS_INITIATED()
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_ITEMS()
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS()
@@ -528,8 +627,11 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_EXECUTOR_WAKEUP_INITIATED()
 #define GRPC_STATS_INC_EXECUTOR_QUEUE_DRAINED()
 #define GRPC_STATS_INC_EXECUTOR_PUSH_RETRIES()
+#define GRPC_STATS_INC_EXECUTOR_STEALS()
+#define GRPC_STATS_INC_EXECUTOR_STOLEN_ITEMS()
 #define GRPC_STATS_INC_SERVER_REQUESTED_CALLS()
 #define GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED()
+#define GRPC_STATS_INC_SERVER_PENDING_CALLS_STOLEN()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES()
@@ -545,11 +647,14 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_SEND_MESSAGE_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_TRAILING_METADATA_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value)
+#define GRPC_STATS_INC_HTTP2_FRAMES_PER_WRITE(value)
+#define GRPC_STATS_INC_HTTP2_WRITE_SIZE(value)
+#define GRPC_STATS_INC_EXECUTOR_QUEUE_DEPTH(value)
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value)
 #endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
-extern const int grpc_stats_histo_buckets[13];
-extern const int grpc_stats_histo_start[13];
-extern const int* const grpc_stats_histo_bucket_boundaries[13];
-extern void (*const grpc_stats_inc_histogram[13])(int x);
+extern const int grpc_stats_histo_buckets[16];
+extern const int grpc_stats_histo_start[16];
+extern const int* const grpc_stats_histo_bucket_boundaries[16];
+extern void (*const grpc_stats_inc_histogram[16])(int x);
 
 #endif /* GRPC_CORE_LIB_DEBUG_STATS_DATA_H */
@@ -1,11 +1,16 @@
 client_calls_created_per_iteration:FLOAT,
 server_calls_created_per_iteration:FLOAT,
+call_arena_pool_hits_per_iteration:FLOAT,
+call_arena_pool_misses_per_iteration:FLOAT,
 cqs_created_per_iteration:FLOAT,
 client_channels_created_per_iteration:FLOAT,
 client_subchannels_created_per_iteration:FLOAT,
 server_channels_created_per_iteration:FLOAT,
 syscall_poll_per_iteration:FLOAT,
 syscall_wait_per_iteration:FLOAT,
+syscall_io_uring_submit_per_iteration:FLOAT,
+poll_spin_hits_per_iteration:FLOAT,
+poll_spin_sleeps_per_iteration:FLOAT,
 pollset_kick_per_iteration:FLOAT,
 pollset_kicked_without_poller_per_iteration:FLOAT,
 pollset_kicked_again_per_iteration:FLOAT,
@@ -19,6 +24,15 @@ syscall_write_per_iteration:FLOAT,
 syscall_read_per_iteration:FLOAT,
 tcp_backup_pollers_created_per_iteration:FLOAT,
 tcp_backup_poller_polls_per_iteration:FLOAT,
+tcp_zerocopy_sends_per_iteration:FLOAT,
+tcp_zerocopy_fallbacks_per_iteration:FLOAT,
+tcp_read_allocs_per_iteration:FLOAT,
+tcp_read_alloc_bytes_per_iteration:FLOAT,
+tcp_read_used_bytes_per_iteration:FLOAT,
+tcp_read_slab_reuses_per_iteration:FLOAT,
+resource_quota_buffer_pool_hits_per_iteration:FLOAT,
+resource_quota_buffer_pool_misses_per_iteration:FLOAT,
+resource_quota_buffer_pool_flushes_per_iteration:FLOAT,
 http2_op_batches_per_iteration:FLOAT,
 http2_op_cancel_per_iteration:FLOAT,
 http2_op_send_initial_metadata_per_iteration:FLOAT,
@@ -33,6 +47,7 @@ http2_writes_begun_per_iteration:FLOAT,
 http2_writes_offloaded_per_iteration:FLOAT,
 http2_writes_continued_per_iteration:FLOAT,
 http2_partial_writes_per_iteration:FLOAT,
+http2_writes_corked_per_iteration:FLOAT,
 http2_initiate_write_due_to_initial_write_per_iteration:FLOAT,
 http2_initiate_write_due_to_start_new_stream_per_iteration:FLOAT,
 http2_initiate_write_due_to_send_message_per_iteration:FLOAT,
@@ -77,6 +92,9 @@ hpack_send_uncompressed_per_iteration:FLOAT,
 hpack_send_huffman_per_iteration:FLOAT,
 hpack_send_binary_per_iteration:FLOAT,
 hpack_send_binary_base64_per_iteration:FLOAT,
+hpack_send_raw_bytes_per_iteration:FLOAT,
+hpack_send_encoded_bytes_per_iteration:FLOAT,
+hpack_send_index_rejected_per_iteration:FLOAT,
 combiner_locks_initiated_per_iteration:FLOAT,
 combiner_locks_scheduled_items_per_iteration:FLOAT,
 combiner_locks_scheduled_final_items_per_iteration:FLOAT,
@@ -91,8 +109,11 @@ executor_scheduled_to_self_per_iteration:FLOAT,
 executor_wakeup_initiated_per_iteration:FLOAT,
 executor_queue_drained_per_iteration:FLOAT,
 executor_push_retries_per_iteration:FLOAT,
+executor_steals_per_iteration:FLOAT,
+executor_stolen_items_per_iteration:FLOAT,
 server_requested_calls_per_iteration:FLOAT,
 server_slowpath_requests_queued_per_iteration:FLOAT,
+server_pending_calls_stolen_per_iteration:FLOAT,
 cq_ev_queue_trylock_failures_per_iteration:FLOAT,
 cq_ev_queue_trylock_successes_per_iteration:FLOAT,
 cq_ev_queue_transient_pop_failures_per_iteration:FLOAT
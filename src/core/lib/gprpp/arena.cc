@@ -25,10 +25,13 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
 #include "src/core/lib/gpr/alloc.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
 
 namespace {
@@ -46,18 +49,206 @@ void* ArenaStorage(size_t initial_size) {
   return gpr_malloc_aligned(alloc_size, alignment);
 }
 
+// Freed zones are cached per CPU, in size classes from 1KB to 64KB of usable
+// space, for the next zone of the same class allocated on that CPU. Smaller
+// zones are left to malloc, which caches them per thread already, and larger
+// ones are never cached. Only zones allocated while caching is enabled are
+// rounded up to a class.
+constexpr size_t kZoneSizeClasses = 7;
+constexpr size_t kLog2MinZoneSize = 10;
+// The zone header, which class sizes are on top of. Checked in AllocZone.
+constexpr size_t kZoneHeaderSize =
+    GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(void*) + sizeof(size_t));
+constexpr size_t kMinCachedZoneSize =
+    kZoneHeaderSize + (size_t(1) << (kLog2MinZoneSize - 1)) + 1;
+constexpr size_t kMaxCachedZoneSize =
+    kZoneHeaderSize + (size_t(1) << (kLog2MinZoneSize + kZoneSizeClasses - 1));
+// Per CPU and size class
+constexpr size_t kMaxCachedZonesPerClass = 8;
+// Over all CPUs, split evenly between them
+constexpr size_t kMaxCachedZoneBytes = 4 * 1024 * 1024;
+
+struct FreeZone {
+  FreeZone* next;
+};
+
+struct ZoneCache {
+  gpr_spinlock mu;
+  // Guarded by mu
+  FreeZone* zones[kZoneSizeClasses];
+  size_t counts[kZoneSizeClasses];
+  size_t bytes;
+  size_t hits;
+  size_t misses;
+};
+
+union ZoneCacheShard {
+  ZoneCache cache;
+  char pad[GPR_CACHELINE_SIZE *
+           ((sizeof(ZoneCache) + GPR_CACHELINE_SIZE - 1) / GPR_CACHELINE_SIZE)];
+};
+
+// Null while caching is disabled
+gpr_atm g_zone_cache_shards;
+size_t g_num_zone_cache_shards;
+size_t g_max_cached_zone_bytes_per_shard;
+
+ZoneCache* GetZoneCache() {
+  ZoneCacheShard* shards =
+      reinterpret_cast<ZoneCacheShard*>(gpr_atm_acq_load(&g_zone_cache_shards));
+  if (shards == nullptr) return nullptr;
+  return &shards[gpr_cpu_current_cpu() % g_num_zone_cache_shards].cache;
+}
+
+size_t ZoneSizeClass(size_t size) {
+  size_t size_class = 0;
+  while (kZoneHeaderSize + (size_t(1) << (kLog2MinZoneSize + size_class)) <
+         size) {
+    size_class++;
+  }
+  return size_class;
+}
+
+size_t ZoneClassSize(size_t size_class) {
+  return kZoneHeaderSize + (size_t(1) << (kLog2MinZoneSize + size_class));
+}
+
+// Returns storage for a zone of at least *size bytes, header included, and
+// sets *size to the bytes actually allocated
+void* AllocZoneStorage(size_t* size) {
+  if (*size < kMinCachedZoneSize || *size > kMaxCachedZoneSize) {
+    return gpr_malloc_aligned(*size, GPR_MAX_ALIGNMENT);
+  }
+  ZoneCache* cache = GetZoneCache();
+  if (cache == nullptr) return gpr_malloc_aligned(*size, GPR_MAX_ALIGNMENT);
+  size_t size_class = ZoneSizeClass(*size);
+  *size = ZoneClassSize(size_class);
+  gpr_spinlock_lock(&cache->mu);
+  FreeZone* z = cache->zones[size_class];
+  if (z != nullptr) {
+    cache->zones[size_class] = z->next;
+    cache->counts[size_class]--;
+    cache->bytes -= *size;
+    cache->hits++;
+    gpr_spinlock_unlock(&cache->mu);
+    return z;
+  }
+  cache->misses++;
+  gpr_spinlock_unlock(&cache->mu);
+  return gpr_malloc_aligned(*size, GPR_MAX_ALIGNMENT);
+}
+
+void FreeZoneStorage(void* storage, size_t size) {
+  // Zones allocated while caching was disabled may not be of a class size
+  if (size >= kMinCachedZoneSize && size <= kMaxCachedZoneSize) {
+    size_t size_class = ZoneSizeClass(size);
+    ZoneCache* cache = GetZoneCache();
+    if (cache != nullptr && ZoneClassSize(size_class) == size) {
+      gpr_spinlock_lock(&cache->mu);
+      if (cache->counts[size_class] < kMaxCachedZonesPerClass &&
+          cache->bytes + size <= g_max_cached_zone_bytes_per_shard) {
+        FreeZone* z = static_cast<FreeZone*>(storage);
+        z->next = cache->zones[size_class];
+        cache->zones[size_class] = z;
+        cache->counts[size_class]++;
+        cache->bytes += size;
+        gpr_spinlock_unlock(&cache->mu);
+        return;
+      }
+      gpr_spinlock_unlock(&cache->mu);
+    }
+  }
+  gpr_free_aligned(storage);
+}
+
+void TrimZoneCache(ZoneCache* cache) {
+  FreeZone* zones[kZoneSizeClasses];
+  gpr_spinlock_lock(&cache->mu);
+  for (size_t i = 0; i < kZoneSizeClasses; i++) {
+    zones[i] = cache->zones[i];
+    cache->zones[i] = nullptr;
+    cache->counts[i] = 0;
+  }
+  cache->bytes = 0;
+  gpr_spinlock_unlock(&cache->mu);
+  for (size_t i = 0; i < kZoneSizeClasses; i++) {
+    FreeZone* z = zones[i];
+    while (z != nullptr) {
+      FreeZone* next = z->next;
+      gpr_free_aligned(z);
+      z = next;
+    }
+  }
+}
+
 }  // namespace
 
 namespace grpc_core {
 
-Arena::~Arena() {
+Arena::~Arena() { FreeZones(); }
+
+void Arena::FreeZones() {
   Zone* z = last_zone_;
   while (z) {
     Zone* prev_z = z->prev;
+    size_t size = z->size;
     z->~Zone();
-    gpr_free_aligned(z);
+    FreeZoneStorage(z, size);
     z = prev_z;
   }
+  last_zone_ = nullptr;
+  zone_count_ = 0;
+  overflow_bytes_ = 0;
+}
+
+void Arena::GlobalInit() {
+  g_num_zone_cache_shards = GPR_MAX(1, gpr_cpu_num_cores());
+  g_max_cached_zone_bytes_per_shard =
+      kMaxCachedZoneBytes / g_num_zone_cache_shards;
+  ZoneCacheShard* shards = static_cast<ZoneCacheShard*>(gpr_malloc_aligned(
+      sizeof(ZoneCacheShard) * g_num_zone_cache_shards, GPR_CACHELINE_SIZE));
+  // Unlocked, empty caches
+  memset(shards, 0, sizeof(ZoneCacheShard) * g_num_zone_cache_shards);
+  gpr_atm_rel_store(&g_zone_cache_shards, reinterpret_cast<gpr_atm>(shards));
+}
+
+void Arena::GlobalShutdown() {
+  ZoneCacheShard* shards =
+      reinterpret_cast<ZoneCacheShard*>(gpr_atm_acq_load(&g_zone_cache_shards));
+  if (shards == nullptr) return;
+  gpr_atm_rel_store(&g_zone_cache_shards, 0);
+  for (size_t i = 0; i < g_num_zone_cache_shards; i++) {
+    TrimZoneCache(&shards[i].cache);
+  }
+  gpr_free_aligned(shards);
+}
+
+void Arena::TrimZoneCaches() {
+  ZoneCacheShard* shards =
+      reinterpret_cast<ZoneCacheShard*>(gpr_atm_acq_load(&g_zone_cache_shards));
+  if (shards == nullptr) return;
+  for (size_t i = 0; i < g_num_zone_cache_shards; i++) {
+    TrimZoneCache(&shards[i].cache);
+  }
+}
+
+Arena::ZoneCacheStats Arena::GetZoneCacheStats() {
+  ZoneCacheStats stats = {0, 0, 0, 0};
+  ZoneCacheShard* shards =
+      reinterpret_cast<ZoneCacheShard*>(gpr_atm_acq_load(&g_zone_cache_shards));
+  if (shards == nullptr) return stats;
+  for (size_t i = 0; i < g_num_zone_cache_shards; i++) {
+    ZoneCache* cache = &shards[i].cache;
+    gpr_spinlock_lock(&cache->mu);
+    for (size_t j = 0; j < kZoneSizeClasses; j++) {
+      stats.cached_zones += cache->counts[j];
+    }
+    stats.cached_bytes += cache->bytes;
+    stats.hits += cache->hits;
+    stats.misses += cache->misses;
+    gpr_spinlock_unlock(&cache->mu);
+  }
+  return stats;
 }
 
 Arena* Arena::Create(size_t initial_size) {
@@ -81,6 +272,20 @@ size_t Arena::Destroy() {
   return size;
 }
 
+size_t Arena::Reset() {
+  size_t size = total_used_.Load(MemoryOrder::RELAXED);
+  FreeZones();
+  total_used_.Store(0, MemoryOrder::RELAXED);
+  return size;
+}
+
+Arena::Stats Arena::GetStats() {
+  gpr_spinlock_lock(&arena_growth_spinlock_);
+  Stats stats = {zone_count_, overflow_bytes_};
+  gpr_spinlock_unlock(&arena_growth_spinlock_);
+  return stats;
+}
+
 void* Arena::AllocZone(size_t size) {
   // If the allocation isn't able to end in the initial zone, create a new
   // zone for this allocation, and any unused space in the initial zone is
@@ -89,12 +294,16 @@ void* Arena::AllocZone(size_t size) {
   // zone and will not need to grow the arena).
   static constexpr size_t zone_base_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Zone));
+  static_assert(zone_base_size == kZoneHeaderSize, "zone header size");
   size_t alloc_size = zone_base_size + size;
-  Zone* z = new (gpr_malloc_aligned(alloc_size, GPR_MAX_ALIGNMENT)) Zone();
+  Zone* z = new (AllocZoneStorage(&alloc_size)) Zone();
+  z->size = alloc_size;
   {
     gpr_spinlock_lock(&arena_growth_spinlock_);
     z->prev = last_zone_;
     last_zone_ = z;
+    zone_count_++;
+    overflow_bytes_ += size;
     gpr_spinlock_unlock(&arena_growth_spinlock_);
   }
   return reinterpret_cast<char*>(z) + zone_base_size;
@@ -43,6 +43,35 @@ namespace grpc_core {
 
 class Arena {
  public:
+  // What an arena allocated past its initial zone
+  struct Stats {
+    // Number of additional zones
+    size_t zone_count;
+    // Bytes allocated from additional zones
+    size_t overflow_bytes;
+  };
+
+  // State of the per-CPU caches of freed zones, summed over all CPUs
+  struct ZoneCacheStats {
+    size_t cached_zones;
+    size_t cached_bytes;
+    // Allocations of zones of a cacheable size served from a cache, and those
+    // that went to malloc
+    size_t hits;
+    size_t misses;
+  };
+
+  // Enable the zone caches. Called from grpc_init(); until then, and after
+  // GlobalShutdown(), zones are allocated and freed directly.
+  static void GlobalInit();
+  // Disable the zone caches and free the zones they hold. No other thread may
+  // be using arenas.
+  static void GlobalShutdown();
+  // Free the zones held by all the caches. The caches are bounded on their own,
+  // so this is only needed to start from empty caches, as tests do.
+  static void TrimZoneCaches();
+  static ZoneCacheStats GetZoneCacheStats();
+
   // Create an arena, with \a initial_size bytes in the first allocated buffer.
   static Arena* Create(size_t initial_size);
 
@@ -54,6 +83,16 @@ class Arena {
 
   // Destroy an arena, returning the total number of bytes allocated.
   size_t Destroy();
+  // Free any zones allocated past the initial one and rewind the arena so
+  // that its memory can be handed out again, returning the total number of
+  // bytes allocated. Everything previously allocated from the arena is
+  // invalidated, and there must be no concurrent calls to Alloc().
+  size_t Reset();
+  // The size of the initial zone, which survives Reset().
+  size_t initial_zone_size() const { return initial_zone_size_; }
+  // What this arena allocated past its initial zone since it was created or
+  // last Reset().
+  Stats GetStats();
   // Allocate \a size bytes from the arena.
   void* Alloc(size_t size) {
     static constexpr size_t base_size =
@@ -81,6 +120,8 @@ class Arena {
  private:
   struct Zone {
     Zone* prev;
+    // Size of the whole zone, header included
+    size_t size;
   };
 
   // Initialize an arena.
@@ -101,6 +142,7 @@ class Arena {
   ~Arena();
 
   void* AllocZone(size_t size);
+  void FreeZones();
 
   // Keep track of the total used size. We use this in our call sizing
   // hysteresis.
@@ -113,6 +155,9 @@ class Arena {
   // and (2) the allocated memory. The arena itself maintains a pointer to the
   // last zone; the zone list is reverse-walked during arena destruction only.
   Zone* last_zone_ = nullptr;
+  // Guarded by arena_growth_spinlock_
+  size_t zone_count_ = 0;
+  size_t overflow_bytes_ = 0;
 };
 
 }  // namespace grpc_core
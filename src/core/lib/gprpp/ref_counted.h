@@ -170,6 +170,10 @@ class RefCount {
     return value_.IncrementIfNonzero();
   }
 
+  // Returns true if the caller holds the only reference. The result can only
+  // be relied upon by a holder of a reference, and only while it holds it.
+  bool IsUnique() const { return value_.Load(MemoryOrder::ACQUIRE) == 1; }
+
   // Decrements the ref-count and returns true if the ref-count reaches 0.
   bool Unref() {
 #ifndef NDEBUG
@@ -38,6 +38,13 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#ifdef GRPC_LINUX_IO_URING
+#include <linux/io_uring.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/cpu.h>
 #include <grpc/support/string_util.h>
@@ -46,6 +53,7 @@
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/block_annotate.h"
 #include "src/core/lib/iomgr/ev_posix.h"
@@ -54,8 +62,19 @@
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
 #include "src/core/lib/profiling/timers.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_poll_spin_budget_us, 0,
+    "If positive, the designated poller of the epoll1 and iouring polling "
+    "engines keeps polling without blocking for up to this many microseconds "
+    "before it goes to sleep. This trades CPU time for wakeup latency and is "
+    "meant for latency critical servers running on dedicated cores.");
+
 static grpc_wakeup_fd global_wakeup_fd;
 
+/* Spin budget of the designated poller in microseconds, read from
+ * GRPC_POLL_SPIN_BUDGET_US at engine init. Zero disables spinning. */
+static int32_t g_poll_spin_budget_us;
+
 /*******************************************************************************
  * Singleton epoll set related fields
  */
@@ -151,10 +170,17 @@ struct grpc_fd {
 
   /* Only used when GRPC_ENABLE_FORK_SUPPORT=1 */
   grpc_fork_fd_list* fork_fd_list;
+
+  /* Only used by the iouring engine. Guarded by g_uring.mu */
+  uint64_t uring_user_data;
+  bool uring_registered;
+  bool uring_orphaned;
+  int uring_polls_in_flight;
 };
 
 static void fd_global_init(void);
 static void fd_global_shutdown(void);
+static void fd_freelist_add(grpc_fd* fd);
 
 /*******************************************************************************
  * Pollset Declarations
@@ -245,6 +271,428 @@ static bool append_error(grpc_error** composite, grpc_error* error,
   return false;
 }
 
+/*******************************************************************************
+ * io_uring backend
+ */
+
+/* The iouring engine (GRPC_POLL_STRATEGY=iouring) replaces the singleton epoll
+ * set with an io_uring instance and keeps everything else in this file: each
+ * fd gets a multishot IORING_OP_POLL_ADD request (the equivalent of the
+ * EPOLLIN | EPOLLOUT | EPOLLET registration) and the completions are
+ * translated into g_epoll_set.events, so the worker turnstile, kicks and
+ * event processing are shared by both engines.
+ *
+ * Requests are queued in the submission ring and submitted by the
+ * io_uring_enter() call the designated poller makes to wait for completions,
+ * so a busy server registers many new fds (e.g. after an accept storm) and
+ * reaps their readiness with a single syscall. Requests are submitted eagerly
+ * only when the poller is already blocked in the kernel (it would not see
+ * them until its next wakeup otherwise) and when an fd is handed back to its
+ * owner (release_fd), since the kernel holds a file reference as long as the
+ * poll request is alive. Closed fds were shut down beforehand, so their
+ * cancellation can wait for the next submission.
+ *
+ * The grpc_fd address is the user_data of its poll request, so a grpc_fd is
+ * only put back on the freelist once the kernel has posted the final
+ * completion of that request. This keeps user_data unique among live
+ * requests, so cancellations always hit the right one. */
+static bool g_use_io_uring = false;
+
+#ifdef GRPC_LINUX_IO_URING
+
+#define URING_SQ_ENTRIES 256
+#define URING_CQ_ENTRIES 4096
+
+/* user_data of requests whose completions carry no readiness information
+ * (timeouts and cancellations). */
+#define URING_INTERNAL_TAG 0
+
+#ifndef IORING_POLL_ADD_MULTI
+#define IORING_POLL_ADD_MULTI (1U << 0)
+#endif
+#ifndef IORING_CQE_F_MORE
+#define IORING_CQE_F_MORE (1U << 1)
+#endif
+
+/* NOTE ON SYNCHRONIZATION:
+ * - The submission queue has multiple producers (any thread creating or
+ *   orphaning an fd, and the designated poller) serialized by mu.
+ * - The completion queue is only consumed by the designated poller, the same
+ *   way g_epoll_set is only touched by it. */
+typedef struct uring_state {
+  int ring_fd;
+  gpr_mu mu;
+
+  unsigned* sq_head;
+  unsigned* sq_tail;
+  unsigned sq_mask;
+  unsigned sq_entries;
+  unsigned* sq_array;
+  struct io_uring_sqe* sqes;
+
+  unsigned* cq_head;
+  unsigned* cq_tail;
+  unsigned cq_mask;
+  struct io_uring_cqe* cqes;
+
+  void* sq_ring;
+  size_t sq_ring_size;
+  void* cq_ring;
+  size_t cq_ring_size;
+  size_t sqes_size;
+
+  /* True while the designated poller is (about to be) blocked in
+   * io_uring_enter(). Guarded by mu. */
+  bool poller_in_kernel;
+
+  /* Timeout of the blocking io_uring_enter(). It has to outlive the call that
+   * queued it, so it is kept here rather than on the poller's stack. */
+  struct __kernel_timespec timeout;
+} uring_state;
+
+static uring_state g_uring;
+
+static int uring_enter(unsigned to_submit, unsigned min_complete,
+                       unsigned flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, g_uring.ring_fd,
+                                  to_submit, min_complete, flags, nullptr, 0));
+}
+
+static void uring_unmap(void* addr, size_t size) {
+  if (addr != nullptr && addr != MAP_FAILED) munmap(addr, size);
+}
+
+static void uring_shutdown() {
+  if (g_uring.ring_fd < 0) return;
+  uring_unmap(g_uring.sqes, g_uring.sqes_size);
+  uring_unmap(g_uring.cq_ring, g_uring.cq_ring_size);
+  uring_unmap(g_uring.sq_ring, g_uring.sq_ring_size);
+  close(g_uring.ring_fd);
+  g_uring.ring_fd = -1;
+  gpr_mu_destroy(&g_uring.mu);
+}
+
+/* Must be called *only* once */
+static bool uring_init() {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = URING_CQ_ENTRIES;
+  int fd = static_cast<int>(
+      syscall(__NR_io_uring_setup, URING_SQ_ENTRIES, &params));
+  if (fd < 0) {
+    gpr_log(GPR_ERROR, "io_uring_setup unavailable: %s", strerror(errno));
+    return false;
+  }
+  memset(&g_uring, 0, sizeof(g_uring));
+  g_uring.ring_fd = fd;
+  gpr_mu_init(&g_uring.mu);
+  /* Without NODROP, completions (and hence fd readiness) could be lost when
+   * the completion queue overflows. */
+  if ((params.features & IORING_FEAT_NODROP) == 0) {
+    gpr_log(GPR_ERROR, "io_uring lacks IORING_FEAT_NODROP");
+    uring_shutdown();
+    return false;
+  }
+
+  g_uring.sq_ring_size =
+      params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  g_uring.cq_ring_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  g_uring.sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  g_uring.sq_ring =
+      mmap(nullptr, g_uring.sq_ring_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  g_uring.cq_ring =
+      mmap(nullptr, g_uring.cq_ring_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+  g_uring.sqes = static_cast<struct io_uring_sqe*>(
+      mmap(nullptr, g_uring.sqes_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+  if (g_uring.sq_ring == MAP_FAILED || g_uring.cq_ring == MAP_FAILED ||
+      g_uring.sqes == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "io_uring mmap failed: %s", strerror(errno));
+    uring_shutdown();
+    return false;
+  }
+
+  char* sq = static_cast<char*>(g_uring.sq_ring);
+  g_uring.sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  g_uring.sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  g_uring.sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  g_uring.sq_entries =
+      *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+  g_uring.sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  char* cq = static_cast<char*>(g_uring.cq_ring);
+  g_uring.cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  g_uring.cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  g_uring.cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  g_uring.cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  /* g_epoll_set only serves as the buffer for the translated completions */
+  g_epoll_set.epfd = -1;
+  gpr_atm_no_barrier_store(&g_epoll_set.num_events, 0);
+  gpr_atm_no_barrier_store(&g_epoll_set.cursor, 0);
+
+  gpr_log(GPR_INFO, "grpc io_uring fd: %d", fd);
+  return true;
+}
+
+/* Number of queued requests not yet consumed by the kernel. g_uring.mu must be
+ * held. */
+static unsigned uring_sq_pending_locked() {
+  return *g_uring.sq_tail - __atomic_load_n(g_uring.sq_head, __ATOMIC_ACQUIRE);
+}
+
+/* Submits all queued requests without waiting for completions. g_uring.mu
+ * must be held. */
+static void uring_submit_locked() {
+  unsigned pending = uring_sq_pending_locked();
+  if (pending == 0) return;
+  int r;
+  do {
+    GRPC_STATS_INC_SYSCALL_IO_URING_SUBMIT();
+    r = uring_enter(pending, 0, 0);
+  } while (r < 0 && errno == EINTR);
+  /* EBUSY/EAGAIN: the kernel refuses new requests until the completion
+   * backlog is reaped. They stay queued and the poller submits them. */
+  if (r < 0 && errno != EBUSY && errno != EAGAIN) {
+    gpr_log(GPR_ERROR, "io_uring_enter failed: %s", strerror(errno));
+  }
+}
+
+/* Returns a zeroed sqe at the tail of the submission queue; publish it with
+ * uring_queue_sqe_locked(). g_uring.mu must be held. */
+static struct io_uring_sqe* uring_get_sqe_locked() {
+  while (uring_sq_pending_locked() == g_uring.sq_entries) {
+    uring_submit_locked();
+    if (uring_sq_pending_locked() == g_uring.sq_entries) {
+      /* Let the designated poller drain the completion backlog */
+      gpr_mu_unlock(&g_uring.mu);
+      sched_yield();
+      gpr_mu_lock(&g_uring.mu);
+    }
+  }
+  unsigned idx = *g_uring.sq_tail & g_uring.sq_mask;
+  struct io_uring_sqe* sqe = &g_uring.sqes[idx];
+  memset(sqe, 0, sizeof(*sqe));
+  g_uring.sq_array[idx] = idx;
+  return sqe;
+}
+
+static void uring_queue_sqe_locked() {
+  __atomic_store_n(g_uring.sq_tail, *g_uring.sq_tail + 1, __ATOMIC_RELEASE);
+  if (g_uring.poller_in_kernel) uring_submit_locked();
+}
+
+static void uring_poll_add_locked(int fd, uint32_t events,
+                                  uint64_t user_data) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  events = (events << 16) | (events >> 16);
+#endif
+  struct io_uring_sqe* sqe = uring_get_sqe_locked();
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  sqe->poll32_events = events;
+  sqe->len = IORING_POLL_ADD_MULTI;
+  sqe->user_data = user_data;
+  uring_queue_sqe_locked();
+}
+
+static void uring_fd_poll_add_locked(grpc_fd* fd) {
+  fd->uring_polls_in_flight++;
+  uring_poll_add_locked(fd->fd, POLLIN | POLLPRI | POLLOUT,
+                        fd->uring_user_data);
+}
+
+/* user_data follows the epoll1 data.ptr encoding (see fd_create()) so that
+ * process_epoll_events() can handle both engines. */
+static void uring_add_fd(grpc_fd* fd, bool track_err) {
+  gpr_mu_lock(&g_uring.mu);
+  fd->uring_user_data = static_cast<uint64_t>(
+      reinterpret_cast<intptr_t>(fd) | (track_err ? 1 : 0));
+  fd->uring_registered = true;
+  fd->uring_orphaned = false;
+  uring_fd_poll_add_locked(fd);
+  gpr_mu_unlock(&g_uring.mu);
+}
+
+/* Cancels the poll request of fd. IORING_OP_ASYNC_CANCEL is used rather than
+ * IORING_OP_POLL_REMOVE: the latter fails with -EALREADY while a wakeup of
+ * the request is being processed, which is exactly what the shutdown()
+ * preceding most removals triggers. Might be called multiple times. */
+static void uring_del_fd(grpc_fd* fd, bool submit_now) {
+  gpr_mu_lock(&g_uring.mu);
+  if (fd->uring_registered) {
+    fd->uring_registered = false;
+    struct io_uring_sqe* sqe = uring_get_sqe_locked();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = fd->uring_user_data;
+    sqe->user_data = URING_INTERNAL_TAG;
+    uring_queue_sqe_locked();
+    if (submit_now) uring_submit_locked();
+  }
+  gpr_mu_unlock(&g_uring.mu);
+}
+
+/* Called at the end of fd_orphan(). Returns true if fd can go back on the
+ * freelist right away, otherwise the completion of its last poll request
+ * takes care of it. */
+static bool uring_orphan_fd(grpc_fd* fd) {
+  gpr_mu_lock(&g_uring.mu);
+  fd->uring_orphaned = true;
+  bool done = fd->uring_polls_in_flight == 0;
+  gpr_mu_unlock(&g_uring.mu);
+  return done;
+}
+
+/* Registers the global wakeup fd. The request is submitted right away so that
+ * kernels without multishot poll support are detected here: they fail it
+ * with -EINVAL on submission. */
+static grpc_error* uring_add_wakeup_fd() {
+  gpr_mu_lock(&g_uring.mu);
+  uring_poll_add_locked(global_wakeup_fd.read_fd, POLLIN,
+                        reinterpret_cast<uintptr_t>(&global_wakeup_fd));
+  uring_submit_locked();
+  gpr_mu_unlock(&g_uring.mu);
+  unsigned head = *g_uring.cq_head;
+  unsigned tail = __atomic_load_n(g_uring.cq_tail, __ATOMIC_ACQUIRE);
+  for (; head != tail; head++) {
+    struct io_uring_cqe* cqe = &g_uring.cqes[head & g_uring.cq_mask];
+    if (cqe->res < 0) return GRPC_OS_ERROR(-cqe->res, "io_uring poll");
+  }
+  return GRPC_ERROR_NONE;
+}
+
+/* A multishot poll request ended: it was cancelled by uring_del_fd() or the
+ * kernel could not post a completion for it. Re-arm it unless the fd is being
+ * orphaned, and recycle the fd if it was orphaned already. Returns false if
+ * the completion must be ignored. */
+static bool uring_poll_terminated(void* data_ptr) {
+  bool fd_alive = true;
+  gpr_mu_lock(&g_uring.mu);
+  if (data_ptr == &global_wakeup_fd) {
+    uring_poll_add_locked(global_wakeup_fd.read_fd, POLLIN,
+                          reinterpret_cast<uintptr_t>(&global_wakeup_fd));
+  } else {
+    grpc_fd* fd = reinterpret_cast<grpc_fd*>(
+        reinterpret_cast<intptr_t>(data_ptr) & ~static_cast<intptr_t>(1));
+    if (--fd->uring_polls_in_flight == 0) {
+      if (fd->uring_registered) {
+        uring_fd_poll_add_locked(fd);
+      } else if (fd->uring_orphaned) {
+        fd_alive = false;
+        fd_freelist_add(fd);
+      }
+    }
+  }
+  gpr_mu_unlock(&g_uring.mu);
+  return fd_alive;
+}
+
+/* Translates up to max_events completions into events (discarding them if
+ * events is null) and returns their number. Poll requests report the same
+ * event bits as epoll. */
+static int uring_reap_completions(struct epoll_event* events, int max_events) {
+  unsigned head = *g_uring.cq_head;
+  unsigned tail = __atomic_load_n(g_uring.cq_tail, __ATOMIC_ACQUIRE);
+  int num_events = 0;
+  while (head != tail && num_events < max_events) {
+    struct io_uring_cqe* cqe = &g_uring.cqes[head & g_uring.cq_mask];
+    head++;
+    if (cqe->user_data == URING_INTERNAL_TAG) continue;
+    void* data_ptr =
+        reinterpret_cast<void*>(static_cast<uintptr_t>(cqe->user_data));
+    if ((cqe->flags & IORING_CQE_F_MORE) == 0 &&
+        !uring_poll_terminated(data_ptr)) {
+      continue;
+    }
+    if (events == nullptr || cqe->res == 0 || cqe->res == -ECANCELED) {
+      continue;
+    }
+    struct epoll_event* ev = &events[num_events++];
+    ev->events = cqe->res > 0 ? static_cast<uint32_t>(cqe->res)
+                              : static_cast<uint32_t>(EPOLLERR | EPOLLHUP);
+    ev->data.ptr = data_ptr;
+  }
+  __atomic_store_n(g_uring.cq_head, head, __ATOMIC_RELEASE);
+  return num_events;
+}
+
+/* Called on engine shutdown, after all fds are orphaned: collects the final
+ * completions of their poll requests so that the grpc_fds make it back to the
+ * freelist before it is freed. */
+static void uring_drain() {
+  gpr_mu_lock(&g_uring.mu);
+  uring_submit_locked();
+  gpr_mu_unlock(&g_uring.mu);
+  /* Get pending task work (and hence cancellations) run */
+  uring_enter(0, 0, IORING_ENTER_GETEVENTS);
+  uring_reap_completions(nullptr, INT_MAX);
+}
+
+/* The io_uring counterpart of epoll_wait(): submits the queued requests,
+ * waits up to timeout ms for a completion and reaps the completions. Returns
+ * the number of events stored in g_epoll_set.events or -1 (setting errno). */
+static int uring_wait(int timeout) {
+  gpr_mu_lock(&g_uring.mu);
+  unsigned min_complete = 0;
+  if (timeout != 0 && *g_uring.cq_head == __atomic_load_n(g_uring.cq_tail,
+                                                          __ATOMIC_ACQUIRE)) {
+    min_complete = 1;
+    if (timeout > 0) {
+      g_uring.timeout.tv_sec = timeout / GPR_MS_PER_SEC;
+      g_uring.timeout.tv_nsec = (timeout % GPR_MS_PER_SEC) * GPR_NS_PER_MS;
+      struct io_uring_sqe* sqe = uring_get_sqe_locked();
+      sqe->opcode = IORING_OP_TIMEOUT;
+      sqe->fd = -1;
+      sqe->addr = reinterpret_cast<uintptr_t>(&g_uring.timeout);
+      sqe->len = 1;
+      /* Also complete (and go away) as soon as any other request does */
+      sqe->off = 1;
+      sqe->user_data = URING_INTERNAL_TAG;
+      uring_queue_sqe_locked();
+    }
+    g_uring.poller_in_kernel = true;
+  }
+  unsigned to_submit = uring_sq_pending_locked();
+  gpr_mu_unlock(&g_uring.mu);
+
+  int r = 0;
+  if (to_submit > 0 || min_complete > 0) {
+    do {
+      GRPC_STATS_INC_SYSCALL_POLL();
+      r = uring_enter(to_submit, min_complete, IORING_ENTER_GETEVENTS);
+    } while (r < 0 && errno == EINTR);
+  }
+  if (min_complete > 0) {
+    gpr_mu_lock(&g_uring.mu);
+    g_uring.poller_in_kernel = false;
+    gpr_mu_unlock(&g_uring.mu);
+  }
+  if (r < 0 && errno != EBUSY && errno != EAGAIN) return -1;
+  return uring_reap_completions(g_epoll_set.events, MAX_EPOLL_EVENTS);
+}
+
+#else /* defined(GRPC_LINUX_IO_URING) */
+
+static bool uring_init() { return false; }
+static void uring_shutdown() {}
+static void uring_add_fd(grpc_fd* /*fd*/, bool /*track_err*/) {}
+static void uring_del_fd(grpc_fd* /*fd*/, bool /*submit_now*/) {}
+static bool uring_orphan_fd(grpc_fd* /*fd*/) { return true; }
+static void uring_drain() {}
+static grpc_error* uring_add_wakeup_fd() {
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING("io_uring unavailable");
+}
+static int uring_wait(int /*timeout*/) {
+  errno = ENOSYS;
+  return -1;
+}
+
+#endif /* defined(GRPC_LINUX_IO_URING) */
+
 /*******************************************************************************
  * Fd Definitions
  */
@@ -338,6 +786,8 @@ static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
     new_fd->read_closure.Init();
     new_fd->write_closure.Init();
     new_fd->error_closure.Init();
+    /* Only ever non-zero for fds that are not on the freelist */
+    new_fd->uring_polls_in_flight = 0;
   }
   new_fd->fd = fd;
   new_fd->read_closure->InitEvent();
@@ -357,6 +807,11 @@ static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
 #endif
   gpr_free(fd_name);
 
+  if (g_use_io_uring) {
+    uring_add_fd(new_fd, track_err);
+    return new_fd;
+  }
+
   struct epoll_event ev;
   ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET);
   /* Use the least significant bit of ev.data.ptr to store track_err. We expect
@@ -383,7 +838,7 @@ static void fd_shutdown_internal(grpc_fd* fd, grpc_error* why,
   if (fd->read_closure->SetShutdown(GRPC_ERROR_REF(why))) {
     if (!releasing_fd) {
       shutdown(fd->fd, SHUT_RDWR);
-    } else {
+    } else if (!g_use_io_uring) {
       /* we need a dummy event for earlier linux versions. */
       epoll_event dummy_event;
       if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_DEL, fd->fd, &dummy_event) !=
@@ -412,6 +867,10 @@ static void fd_orphan(grpc_fd* fd, grpc_closure* on_done, int* release_fd,
                          is_release_fd);
   }
 
+  if (g_use_io_uring) {
+    uring_del_fd(fd, is_release_fd);
+  }
+
   /* If release_fd is not NULL, we should be relinquishing control of the file
      descriptor fd->fd (but we still own the grpc_fd structure). */
   if (is_release_fd) {
@@ -428,6 +887,12 @@ static void fd_orphan(grpc_fd* fd, grpc_closure* on_done, int* release_fd,
   fd->write_closure->DestroyEvent();
   fd->error_closure->DestroyEvent();
 
+  if (!g_use_io_uring || uring_orphan_fd(fd)) {
+    fd_freelist_add(fd);
+  }
+}
+
+static void fd_freelist_add(grpc_fd* fd) {
   gpr_mu_lock(&fd_freelist_mu);
   fd->freelist_next = fd_freelist;
   fd_freelist = fd;
@@ -517,12 +982,17 @@ static grpc_error* pollset_global_init(void) {
   global_wakeup_fd.read_fd = -1;
   grpc_error* err = grpc_wakeup_fd_init(&global_wakeup_fd);
   if (err != GRPC_ERROR_NONE) return err;
-  struct epoll_event ev;
-  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLET);
-  ev.data.ptr = &global_wakeup_fd;
-  if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, global_wakeup_fd.read_fd,
-                &ev) != 0) {
-    return GRPC_OS_ERROR(errno, "epoll_ctl");
+  if (g_use_io_uring) {
+    err = uring_add_wakeup_fd();
+    if (err != GRPC_ERROR_NONE) return err;
+  } else {
+    struct epoll_event ev;
+    ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLET);
+    ev.data.ptr = &global_wakeup_fd;
+    if (epoll_ctl(g_epoll_set.epfd, EPOLL_CTL_ADD, global_wakeup_fd.read_fd,
+                  &ev) != 0) {
+      return GRPC_OS_ERROR(errno, "epoll_ctl");
+    }
   }
   g_num_neighborhoods = GPR_CLAMP(gpr_cpu_num_cores(), 1, MAX_NEIGHBORHOODS);
   g_neighborhoods = static_cast<pollset_neighborhood*>(
@@ -703,31 +1173,85 @@ static grpc_error* process_epoll_events(grpc_pollset* /*pollset*/) {
   return error;
 }
 
+/* A single epoll_wait (or io_uring wait) filling g_epoll_set.events. Returns
+ * the number of events or -1 (setting errno). */
+static int poll_once(int timeout) {
+  int r;
+  if (g_use_io_uring) {
+    r = uring_wait(timeout);
+  } else {
+    do {
+      GRPC_STATS_INC_SYSCALL_POLL();
+      r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
+                     timeout);
+    } while (r < 0 && errno == EINTR);
+  }
+  return r;
+}
+
+/* Polls without blocking until events show up, the spin budget runs out or
+ * the deadline passes. Kicks reach the designated poller through the global
+ * wakeup fd, so they end the spin like any other event. Returns the result of
+ * the last poll. */
+static int spin_poll(grpc_millis deadline) {
+  GPR_TIMER_SCOPE("spin_poll", 0);
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_timespec spin_end = gpr_time_add(
+      now, gpr_time_from_micros(g_poll_spin_budget_us, GPR_TIMESPAN));
+  gpr_timespec deadline_ts =
+      grpc_millis_to_timespec(deadline, GPR_CLOCK_MONOTONIC);
+  if (gpr_time_cmp(deadline_ts, spin_end) < 0) {
+    spin_end = deadline_ts;
+  }
+  int r;
+  do {
+    r = poll_once(0);
+    if (r != 0) break;
+    now = gpr_now(GPR_CLOCK_MONOTONIC);
+  } while (gpr_time_cmp(now, spin_end) < 0);
+  grpc_core::ExecCtx::Get()->InvalidateNow();
+  return r;
+}
+
 /* Do epoll_wait and store the events in g_epoll_set.events field. This does not
    "process" any of the events yet; that is done in process_epoll_events().
    *See process_epoll_events() function for more details.
 
    NOTE ON SYNCHRONIZATION: At any point of time, only the g_active_poller
    (i.e the designated poller thread) will be calling this function. So there is
-   no need for any synchronization when accesing fields in g_epoll_set */
+   no need for any synchronization when accesing fields in g_epoll_set
+
+   With a spin budget configured, a blocking wait is preceded by non-blocking
+   polls for up to that budget (see spin_poll()). */
 static grpc_error* do_epoll_wait(grpc_pollset* ps, grpc_millis deadline) {
   GPR_TIMER_SCOPE("do_epoll_wait", 0);
 
-  int r;
+  int r = 0;
   int timeout = poll_deadline_to_millis_timeout(deadline);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_START_BLOCKING_REGION;
+  bool spin = timeout != 0 && g_poll_spin_budget_us > 0;
+  if (spin) {
+    r = spin_poll(deadline);
+    if (r != 0) {
+      GRPC_STATS_INC_POLL_SPIN_HITS();
+    } else {
+      timeout = poll_deadline_to_millis_timeout(deadline);
+    }
   }
-  do {
-    GRPC_STATS_INC_SYSCALL_POLL();
-    r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
-                   timeout);
-  } while (r < 0 && errno == EINTR);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_END_BLOCKING_REGION;
+  if (r == 0) {
+    if (timeout != 0) {
+      if (spin) GRPC_STATS_INC_POLL_SPIN_SLEEPS();
+      GRPC_SCHEDULING_START_BLOCKING_REGION;
+    }
+    r = poll_once(timeout);
+    if (timeout != 0) {
+      GRPC_SCHEDULING_END_BLOCKING_REGION;
+    }
   }
 
-  if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
+  if (r < 0) {
+    return GRPC_OS_ERROR(errno,
+                         g_use_io_uring ? "io_uring_enter" : "epoll_wait");
+  }
 
   GRPC_STATS_INC_POLL_EVENTS_RETURNED(r);
 
@@ -1261,9 +1785,16 @@ static bool add_closure_to_background_poller(grpc_closure* /*closure*/,
 }
 
 static void shutdown_engine(void) {
+  if (g_use_io_uring) {
+    uring_drain();
+  }
   fd_global_shutdown();
   pollset_global_shutdown();
-  epoll_set_shutdown();
+  if (g_use_io_uring) {
+    uring_shutdown();
+  } else {
+    epoll_set_shutdown();
+  }
   if (grpc_core::Fork::Enabled()) {
     gpr_mu_destroy(&fork_fd_list_mu);
     grpc_core::Fork::SetResetChildPollingEngineFunc(nullptr);
@@ -1309,6 +1840,8 @@ static const grpc_event_engine_vtable vtable = {
     add_closure_to_background_poller,
 };
 
+static const grpc_event_engine_vtable* init_engine(bool use_io_uring);
+
 /* Called by the child process's post-fork handler to close open fds, including
  * the global epoll fd. This allows gRPC to shutdown in the child process
  * without interfering with connections or RPCs ongoing in the parent. */
@@ -1321,20 +1854,22 @@ static void reset_event_manager_on_fork() {
   }
   gpr_mu_unlock(&fork_fd_list_mu);
   shutdown_engine();
-  grpc_init_epoll1_linux(true);
+  init_engine(g_use_io_uring);
 }
 
-/* It is possible that GLIBC has epoll but the underlying kernel doesn't.
- * Create epoll_fd (epoll_set_init() takes care of that) to make sure epoll
- * support is available */
-const grpc_event_engine_vtable* grpc_init_epoll1_linux(
-    bool /*explicit_request*/) {
+static const grpc_event_engine_vtable* init_engine(bool use_io_uring) {
   if (!grpc_has_wakeup_fd()) {
-    gpr_log(GPR_ERROR, "Skipping epoll1 because of no wakeup fd.");
+    gpr_log(GPR_ERROR, "Skipping %s because of no wakeup fd.",
+            use_io_uring ? "iouring" : "epoll1");
     return nullptr;
   }
 
-  if (!epoll_set_init()) {
+  g_poll_spin_budget_us =
+      GPR_MAX(GPR_GLOBAL_CONFIG_GET(grpc_poll_spin_budget_us), 0);
+
+  g_use_io_uring = use_io_uring;
+  if (!(use_io_uring ? uring_init() : epoll_set_init())) {
+    g_use_io_uring = false;
     return nullptr;
   }
 
@@ -1342,7 +1877,12 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(
 
   if (!GRPC_LOG_IF_ERROR("pollset_global_init", pollset_global_init())) {
     fd_global_shutdown();
-    epoll_set_shutdown();
+    if (use_io_uring) {
+      uring_shutdown();
+    } else {
+      epoll_set_shutdown();
+    }
+    g_use_io_uring = false;
     return nullptr;
   }
 
@@ -1354,6 +1894,24 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(
   return &vtable;
 }
 
+/* It is possible that GLIBC has epoll but the underlying kernel doesn't.
+ * Create epoll_fd (epoll_set_init() takes care of that) to make sure epoll
+ * support is available */
+const grpc_event_engine_vtable* grpc_init_epoll1_linux(
+    bool /*explicit_request*/) {
+  return init_engine(false);
+}
+
+/* io_uring is only used when asked for by name: it is not part of the "all"
+ * fallback order. Kernels without (multishot poll) io_uring support are
+ * detected by uring_init() and pollset_global_init(). */
+const grpc_event_engine_vtable* grpc_init_iouring_linux(bool explicit_request) {
+  if (!explicit_request) {
+    return nullptr;
+  }
+  return init_engine(true);
+}
+
 #else /* defined(GRPC_LINUX_EPOLL) */
 #if defined(GRPC_POSIX_SOCKET_EV_EPOLL1)
 #include "src/core/lib/iomgr/ev_epoll1_linux.h"
@@ -1363,5 +1921,9 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(
     bool /*explicit_request*/) {
   return nullptr;
 }
+const grpc_event_engine_vtable* grpc_init_iouring_linux(
+    bool /*explicit_request*/) {
+  return nullptr;
+}
 #endif /* defined(GRPC_POSIX_SOCKET_EV_EPOLL1) */
 #endif /* !defined(GRPC_LINUX_EPOLL) */
@@ -28,4 +28,8 @@
 
 const grpc_event_engine_vtable* grpc_init_epoll1_linux(bool explicit_request);
 
+// the same engine with the epoll set replaced by an io_uring instance; only
+// available when requested by name (GRPC_POLL_STRATEGY=iouring)
+const grpc_event_engine_vtable* grpc_init_iouring_linux(bool explicit_request);
+
 #endif /* GRPC_CORE_LIB_IOMGR_EV_EPOLL1_LINUX_H */
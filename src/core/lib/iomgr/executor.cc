@@ -30,12 +30,18 @@
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr.h"
 
 #define MAX_DEPTH 2
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_executor_work_stealing, false,
+    "If set, executor threads run closures off their own queues and idle "
+    "threads steal queued closures from busy ones.");
+
 #define EXECUTOR_TRACE(format, ...)                       \
   do {                                                    \
     if (GRPC_TRACE_FLAG_ENABLED(executor_trace)) {        \
@@ -108,6 +114,8 @@ Executor::Executor(const char* name) : name_(name) {
   adding_thread_lock_ = GPR_SPINLOCK_STATIC_INITIALIZER;
   gpr_atm_rel_store(&num_threads_, 0);
   max_threads_ = GPR_MAX(1, 2 * gpr_cpu_num_cores());
+  work_stealing_ = GPR_GLOBAL_CONFIG_GET(grpc_executor_work_stealing);
+  gpr_atm_rel_store(&num_idle_, 0);
 }
 
 void Executor::Init() { SetThreading(true); }
@@ -174,6 +182,8 @@ void Executor::SetThreading(bool threading) {
       thd_state_[i].name = name_;
       thd_state_[i].thd = grpc_core::Thread();
       thd_state_[i].elems = GRPC_CLOSURE_LIST_INIT;
+      thd_state_[i].executor = this;
+      thd_state_[i].rng = static_cast<uint32_t>(i + 1);
     }
 
     thd_state_[0].thd =
@@ -233,6 +243,12 @@ void Executor::ThreadMain(void* arg) {
 
   grpc_core::ExecCtx exec_ctx(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
 
+  if (ts->executor->work_stealing_) {
+    ts->executor->WorkStealingLoop(ts);
+    gpr_tls_set(&g_this_thread_state, reinterpret_cast<intptr_t>(nullptr));
+    return;
+  }
+
   size_t subtract_depth = 0;
   for (;;) {
     EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: step (sub_depth=%" PRIdPTR ")",
@@ -266,6 +282,143 @@ void Executor::ThreadMain(void* arg) {
   gpr_tls_set(&g_this_thread_state, reinterpret_cast<intptr_t>(nullptr));
 }
 
+void Executor::WorkStealingLoop(ThreadState* ts) {
+  size_t subtract_depth = 0;
+  for (;;) {
+    EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: step (sub_depth=%" PRIdPTR ")",
+                   ts->name, ts->id, subtract_depth);
+
+    // Take one closure at a time off our own queue, so that the rest stays
+    // available to idle threads.
+    grpc_closure_list closures = GRPC_CLOSURE_LIST_INIT;
+    gpr_mu_lock(&ts->mu);
+    ts->depth -= subtract_depth;
+    if (ts->shutdown) {
+      EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: shutdown", ts->name, ts->id);
+      gpr_mu_unlock(&ts->mu);
+      break;
+    }
+    if (!grpc_closure_list_empty(ts->elems)) {
+      grpc_closure* c = ts->elems.head;
+      ts->elems.head = c->next_data.next;
+      if (ts->elems.head == nullptr) {
+        ts->elems.tail = nullptr;
+        GRPC_STATS_INC_EXECUTOR_QUEUE_DRAINED();
+      }
+      c->next_data.next = nullptr;
+      closures.head = closures.tail = c;
+    } else {
+      ts->queued_long_job = false;
+    }
+    gpr_mu_unlock(&ts->mu);
+
+    if (grpc_closure_list_empty(closures) &&
+        StealClosures(ts, &closures) == 0) {
+      // Announce that we are about to go idle before looking for work one
+      // last time: an enqueue that we miss here will see num_idle_ > 0 and
+      // wake us up through steal_hint.
+      gpr_mu_lock(&ts->mu);
+      ts->idle = true;
+      gpr_mu_unlock(&ts->mu);
+      gpr_atm_full_fetch_add(&num_idle_, 1);
+      StealClosures(ts, &closures);
+      gpr_mu_lock(&ts->mu);
+      if (grpc_closure_list_empty(closures)) {
+        while (grpc_closure_list_empty(ts->elems) && !ts->shutdown &&
+               !ts->steal_hint) {
+          ts->queued_long_job = false;
+          gpr_cv_wait(&ts->cv, &ts->mu, gpr_inf_future(GPR_CLOCK_MONOTONIC));
+        }
+      }
+      ts->idle = false;
+      ts->steal_hint = false;
+      gpr_mu_unlock(&ts->mu);
+      gpr_atm_full_fetch_add(&num_idle_, -1);
+      if (grpc_closure_list_empty(closures)) {
+        subtract_depth = 0;
+        continue;
+      }
+    }
+
+    EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: execute", ts->name, ts->id);
+
+    grpc_core::ExecCtx::Get()->InvalidateNow();
+    subtract_depth = RunClosures(ts->name, closures);
+  }
+}
+
+size_t Executor::StealClosures(ThreadState* thief,
+                               grpc_closure_list* closures) {
+  size_t cur_thread_count = static_cast<size_t>(gpr_atm_acq_load(&num_threads_));
+  if (cur_thread_count < 2) return 0;
+  // Start at a random victim so that thieves spread out over busy threads.
+  thief->rng ^= thief->rng << 13;
+  thief->rng ^= thief->rng >> 17;
+  thief->rng ^= thief->rng << 5;
+  size_t start = thief->rng % cur_thread_count;
+  for (size_t i = 0; i < cur_thread_count; i++) {
+    ThreadState* victim = &thd_state_[(start + i) % cur_thread_count];
+    if (victim == thief) continue;
+    gpr_mu_lock(&victim->mu);
+    if (grpc_closure_list_empty(victim->elems) || victim->shutdown) {
+      gpr_mu_unlock(&victim->mu);
+      continue;
+    }
+    // Take the older half of the victim's queue (rounding up).
+    size_t queued = 0;
+    for (grpc_closure* c = victim->elems.head; c != nullptr;
+         c = c->next_data.next) {
+      queued++;
+    }
+    size_t n = (queued + 1) / 2;
+    grpc_closure* last = victim->elems.head;
+    for (size_t j = 1; j < n; j++) {
+      last = last->next_data.next;
+    }
+    closures->head = victim->elems.head;
+    closures->tail = last;
+    victim->elems.head = last->next_data.next;
+    if (victim->elems.head == nullptr) {
+      // Nothing is left queued behind a long job on the victim, so let
+      // Enqueue() use it again.
+      victim->elems.tail = nullptr;
+      victim->queued_long_job = false;
+    }
+    last->next_data.next = nullptr;
+    victim->depth -= n;
+    gpr_mu_unlock(&victim->mu);
+
+    gpr_mu_lock(&thief->mu);
+    thief->depth += n;
+    gpr_mu_unlock(&thief->mu);
+
+    EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: stole %" PRIdPTR
+                   " closures from thread %" PRIdPTR,
+                   thief->name, thief->id, n, victim->id);
+    GRPC_STATS_INC_EXECUTOR_STEALS();
+    GRPC_STATS_INC_COUNTER_BY(GRPC_STATS_COUNTER_EXECUTOR_STOLEN_ITEMS, n);
+    return n;
+  }
+  return 0;
+}
+
+void Executor::WakeIdleThread(ThreadState* busy_ts) {
+  size_t cur_thread_count = static_cast<size_t>(gpr_atm_acq_load(&num_threads_));
+  for (size_t i = 0; i < cur_thread_count; i++) {
+    ThreadState* ts = &thd_state_[i];
+    if (ts == busy_ts) continue;
+    gpr_mu_lock(&ts->mu);
+    if (ts->idle && !ts->steal_hint) {
+      ts->steal_hint = true;
+      GRPC_STATS_INC_EXECUTOR_WAKEUP_INITIATED();
+      gpr_cv_signal(&ts->cv);
+      gpr_mu_unlock(&ts->mu);
+      return;
+    }
+    gpr_mu_unlock(&ts->mu);
+  }
+}
+
 void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
                        bool is_short) {
   bool retry_push;
@@ -308,6 +461,7 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
 
     ThreadState* orig_ts = ts;
     bool try_new_thread = false;
+    bool try_wake_idle = false;
 
     for (;;) {
 #ifndef NDEBUG
@@ -365,15 +519,24 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error* error,
       // If we already queued more than MAX_DEPTH number of closures on this
       // thread, use this as a hint to create more threads
       ts->depth++;
+      GRPC_STATS_INC_EXECUTOR_QUEUE_DEPTH(static_cast<int>(ts->depth));
       try_new_thread = ts->depth > MAX_DEPTH &&
                        cur_thread_count < max_threads_ && !ts->shutdown;
 
       ts->queued_long_job = !is_short;
 
+      // In work-stealing mode, a closure queued behind a thread that is busy
+      // can be picked up by an idle thread instead of waiting its turn.
+      try_wake_idle = work_stealing_ && !ts->idle && !ts->shutdown;
+
       gpr_mu_unlock(&ts->mu);
       break;
     }
 
+    if (try_wake_idle && gpr_atm_acq_load(&num_idle_) > 0) {
+      WakeIdleThread(ts);
+    }
+
     if (try_new_thread && gpr_spinlock_trylock(&adding_thread_lock_)) {
       cur_thread_count = static_cast<size_t>(gpr_atm_acq_load(&num_threads_));
       if (cur_thread_count < max_threads_) {
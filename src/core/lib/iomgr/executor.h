@@ -27,6 +27,8 @@
 
 namespace grpc_core {
 
+class Executor;
+
 struct ThreadState {
   gpr_mu mu;
   size_t id;         // For debugging purposes
@@ -37,6 +39,11 @@ struct ThreadState {
   bool shutdown;
   bool queued_long_job;
   grpc_core::Thread thd;
+  // Work-stealing mode only
+  Executor* executor;
+  bool idle;        // Thread has found no work anywhere and is about to wait
+  bool steal_hint;  // Another thread has a backlog that this one could steal
+  uint32_t rng;     // State for picking random steal victims
 };
 
 enum class ExecutorType {
@@ -110,11 +117,23 @@ class Executor {
   static size_t RunClosures(const char* executor_name, grpc_closure_list list);
   static void ThreadMain(void* arg);
 
+  // Work-stealing mode: runs closures one at a time off the thread's own
+  // queue, stealing from other threads' queues once it is empty.
+  void WorkStealingLoop(ThreadState* ts);
+  // Moves about half of the closures queued on some other thread to
+  // *closures. Returns the number of closures stolen.
+  size_t StealClosures(ThreadState* thief, grpc_closure_list* closures);
+  // Wakes one idle thread (other than busy_ts) so that it steals from the
+  // backlog of busy_ts.
+  void WakeIdleThread(ThreadState* busy_ts);
+
   const char* name_;
   ThreadState* thd_state_;
   size_t max_threads_;
   gpr_atm num_threads_;
   gpr_spinlock adding_thread_lock_;
+  bool work_stealing_;  // Set by the GRPC_EXECUTOR_WORK_STEALING env var
+  gpr_atm num_idle_;    // Number of threads waiting in WorkStealingLoop()
 };
 
 // Global initializer for executor
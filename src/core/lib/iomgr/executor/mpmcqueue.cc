@@ -20,6 +20,9 @@
 
 #include "src/core/lib/iomgr/executor/mpmcqueue.h"
 
+#include <new>
+#include <thread>
+
 namespace grpc_core {
 
 DebugOnlyTraceFlag grpc_thread_pool_trace(false, "thread_pool");
@@ -180,4 +183,216 @@ void InfLenFIFOQueue::RemoveWaiter(Waiter* waiter) {
 
 InfLenFIFOQueue::Waiter* InfLenFIFOQueue::TopWaiter() { return waiters_.next; }
 
+InfLenLockFreeQueue::InfLenLockFreeQueue() {
+  ring_ = static_cast<Cell*>(gpr_malloc(sizeof(Cell) * kRingSize));
+  for (int i = 0; i < kRingSize; ++i) {
+    new (&ring_[i].sequence) Atomic<size_t>(static_cast<size_t>(i));
+    ring_[i].content = nullptr;
+  }
+}
+
+InfLenLockFreeQueue::~InfLenLockFreeQueue() {
+  GPR_ASSERT(count_.Load(MemoryOrder::RELAXED) == 0);
+  GPR_ASSERT(overflow_head_ == nullptr);
+  for (int i = 0; i < kRingSize; ++i) {
+    ring_[i].sequence.~Atomic<size_t>();
+  }
+  gpr_free(ring_);
+}
+
+bool InfLenLockFreeQueue::TryPushRing(void* elem, gpr_timespec insert_time) {
+  size_t pos = enqueue_pos_.Load(MemoryOrder::RELAXED);
+  Cell* cell;
+  for (;;) {
+    cell = &ring_[pos & (kRingSize - 1)];
+    size_t seq = cell->sequence.Load(MemoryOrder::ACQUIRE);
+    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      // Cell is free for this lap, try to claim it.
+      if (enqueue_pos_.CompareExchangeWeak(&pos, pos + 1, MemoryOrder::RELAXED,
+                                           MemoryOrder::RELAXED)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // Cell still holds an element from the previous lap: ring is full.
+      return false;
+    } else {
+      pos = enqueue_pos_.Load(MemoryOrder::RELAXED);
+    }
+  }
+  cell->content = elem;
+  cell->insert_time = insert_time;
+  cell->sequence.Store(pos + 1, MemoryOrder::RELEASE);
+  return true;
+}
+
+bool InfLenLockFreeQueue::TryPopRing(void** elem, gpr_timespec* insert_time) {
+  size_t pos = dequeue_pos_.Load(MemoryOrder::RELAXED);
+  Cell* cell;
+  for (;;) {
+    cell = &ring_[pos & (kRingSize - 1)];
+    size_t seq = cell->sequence.Load(MemoryOrder::ACQUIRE);
+    intptr_t diff =
+        static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+    if (diff == 0) {
+      // Cell has been published, try to claim it.
+      if (dequeue_pos_.CompareExchangeWeak(&pos, pos + 1, MemoryOrder::RELAXED,
+                                           MemoryOrder::RELAXED)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // Cell is empty or its producer has not published it yet.
+      return false;
+    } else {
+      pos = dequeue_pos_.Load(MemoryOrder::RELAXED);
+    }
+  }
+  *elem = cell->content;
+  *insert_time = cell->insert_time;
+  // Hand the cell to the producer of the next lap.
+  cell->sequence.Store(pos + kRingSize, MemoryOrder::RELEASE);
+  return true;
+}
+
+void InfLenLockFreeQueue::PushOverflow(void* elem, gpr_timespec insert_time) {
+  OverflowNode* node = New<OverflowNode>();
+  node->next = nullptr;
+  node->content = elem;
+  node->insert_time = insert_time;
+  MutexLock l(&overflow_mu_);
+  if (overflow_tail_ == nullptr) {
+    overflow_head_ = node;
+  } else {
+    overflow_tail_->next = node;
+  }
+  overflow_tail_ = node;
+  overflow_count_.FetchAdd(1, MemoryOrder::RELAXED);
+}
+
+bool InfLenLockFreeQueue::TryPopOverflow(void** elem,
+                                         gpr_timespec* insert_time) {
+  if (overflow_count_.Load(MemoryOrder::RELAXED) == 0) return false;
+  OverflowNode* node;
+  {
+    MutexLock l(&overflow_mu_);
+    node = overflow_head_;
+    if (node == nullptr) return false;
+    overflow_head_ = node->next;
+    if (overflow_head_ == nullptr) overflow_tail_ = nullptr;
+    overflow_count_.FetchSub(1, MemoryOrder::RELAXED);
+  }
+  *elem = node->content;
+  *insert_time = node->insert_time;
+  Delete(node);
+  return true;
+}
+
+void InfLenLockFreeQueue::Put(void* elem) {
+  gpr_timespec insert_time = gpr_inf_past(GPR_CLOCK_MONOTONIC);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_thread_pool_trace)) {
+    insert_time = gpr_now(GPR_CLOCK_MONOTONIC);
+  }
+  // Once elements have spilled into the overflow list, keep appending there
+  // until consumers drain it, so that newer elements do not overtake it.
+  if (overflow_count_.Load(MemoryOrder::RELAXED) > 0 ||
+      !TryPushRing(elem, insert_time)) {
+    PushOverflow(elem, insert_time);
+  }
+  // Sequentially consistent increment and load pair with the consumer's
+  // increment of num_waiters_ and load of count_ in Get(): either the
+  // consumer sees the new element, or we see the consumer waiting.
+  int prev_count = count_.FetchAdd(1, MemoryOrder::SEQ_CST);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_thread_pool_trace)) {
+    UpdatePutStats(prev_count);
+  }
+  if (num_waiters_.Load(MemoryOrder::SEQ_CST) > 0) {
+    MutexLock l(&wait_mu_);
+    wait_cv_.Signal();
+  }
+}
+
+void* InfLenLockFreeQueue::Get(gpr_timespec* wait_time) {
+  int curr_count = count_.Load(MemoryOrder::RELAXED);
+  for (;;) {
+    // Reserves one element.
+    if (curr_count > 0) {
+      if (count_.CompareExchangeWeak(&curr_count, curr_count - 1,
+                                     MemoryOrder::ACQ_REL,
+                                     MemoryOrder::RELAXED)) {
+        break;
+      }
+      continue;
+    }
+    gpr_timespec start_time;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_thread_pool_trace) &&
+        wait_time != nullptr) {
+      start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+    }
+    {
+      MutexLock l(&wait_mu_);
+      num_waiters_.FetchAdd(1, MemoryOrder::SEQ_CST);
+      while ((curr_count = count_.Load(MemoryOrder::SEQ_CST)) == 0) {
+        wait_cv_.Wait(&wait_mu_);
+      }
+      num_waiters_.FetchSub(1, MemoryOrder::RELAXED);
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_thread_pool_trace) &&
+        wait_time != nullptr) {
+      *wait_time = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start_time);
+    }
+  }
+  return PopReserved();
+}
+
+void* InfLenLockFreeQueue::PopReserved() {
+  void* elem;
+  gpr_timespec insert_time;
+  // The reserved element is either in the ring, in the overflow list, or in
+  // a ring cell whose producer has claimed but not yet published it. In the
+  // last case yield until it shows up.
+  while (!TryPopRing(&elem, &insert_time) &&
+         !TryPopOverflow(&elem, &insert_time)) {
+    std::this_thread::yield();
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_thread_pool_trace)) {
+    UpdateGetStats(insert_time, count_.Load(MemoryOrder::RELAXED));
+  }
+  return elem;
+}
+
+void InfLenLockFreeQueue::UpdatePutStats(int prev_count) {
+  MutexLock l(&stats_mu_);
+  stats_.num_started++;
+  gpr_log(GPR_INFO, "[InfLenLockFreeQueue Put] num_started:        %" PRIu64,
+          stats_.num_started);
+  if (prev_count == 0) {
+    busy_time = gpr_now(GPR_CLOCK_MONOTONIC);
+  }
+}
+
+void InfLenLockFreeQueue::UpdateGetStats(gpr_timespec insert_time,
+                                         int remaining) {
+  MutexLock l(&stats_mu_);
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  // Elements put before the trace flag was turned on have no insert time.
+  gpr_timespec wait_time = gpr_time_0(GPR_TIMESPAN);
+  if (gpr_time_cmp(insert_time, gpr_inf_past(GPR_CLOCK_MONOTONIC)) != 0) {
+    wait_time = gpr_time_sub(now, insert_time);
+  }
+  stats_.num_completed++;
+  stats_.total_queue_time = gpr_time_add(stats_.total_queue_time, wait_time);
+  stats_.max_queue_time = gpr_time_max(
+      gpr_convert_clock_type(stats_.max_queue_time, GPR_TIMESPAN), wait_time);
+  if (remaining == 0) {
+    stats_.busy_queue_time = gpr_time_add(stats_.busy_queue_time,
+                                          gpr_time_sub(now, busy_time));
+  }
+  gpr_log(GPR_INFO,
+          "[InfLenLockFreeQueue Get] num_completed:        %" PRIu64
+          " total_queue_time: %f max_queue_time:   %f busy_queue_time:   %f",
+          stats_.num_completed, gpr_timespec_to_micros(stats_.total_queue_time),
+          gpr_timespec_to_micros(stats_.max_queue_time),
+          gpr_timespec_to_micros(stats_.busy_queue_time));
+}
+
 }  // namespace grpc_core
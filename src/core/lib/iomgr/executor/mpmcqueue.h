@@ -48,6 +48,28 @@ class MPMCQueueInterface {
   virtual int count() const = 0;
 };
 
+// Stats of queue. This will only be collect when debug trace mode is on.
+// All printed stats info will have time measurement in microsecond.
+struct MPMCQueueStats {
+  uint64_t num_started;    // Number of elements have been added to queue
+  uint64_t num_completed;  // Number of elements have been removed from
+                           // the queue
+  gpr_timespec total_queue_time;  // Total waiting time that all the
+                                  // removed elements have spent in queue
+  gpr_timespec max_queue_time;    // Max waiting time among all removed
+                                  // elements
+  gpr_timespec busy_queue_time;   // Accumulated amount of time that queue
+                                  // was not empty
+
+  MPMCQueueStats() {
+    num_started = 0;
+    num_completed = 0;
+    total_queue_time = gpr_time_0(GPR_TIMESPAN);
+    max_queue_time = gpr_time_0(GPR_TIMESPAN);
+    busy_queue_time = gpr_time_0(GPR_TIMESPAN);
+  }
+};
+
 class InfLenFIFOQueue : public MPMCQueueInterface {
  public:
   // Creates a new MPMC Queue. The queue created will have infinite length.
@@ -99,28 +121,6 @@ class InfLenFIFOQueue : public MPMCQueueInterface {
   // callling.
   void* PopFront();
 
-  // Stats of queue. This will only be collect when debug trace mode is on.
-  // All printed stats info will have time measurement in microsecond.
-  struct Stats {
-    uint64_t num_started;    // Number of elements have been added to queue
-    uint64_t num_completed;  // Number of elements have been removed from
-                             // the queue
-    gpr_timespec total_queue_time;  // Total waiting time that all the
-                                    // removed elements have spent in queue
-    gpr_timespec max_queue_time;    // Max waiting time among all removed
-                                    // elements
-    gpr_timespec busy_queue_time;   // Accumulated amount of time that queue
-                                    // was not empty
-
-    Stats() {
-      num_started = 0;
-      num_completed = 0;
-      total_queue_time = gpr_time_0(GPR_TIMESPAN);
-      max_queue_time = gpr_time_0(GPR_TIMESPAN);
-      busy_queue_time = gpr_time_0(GPR_TIMESPAN);
-    }
-  };
-
   // Node for waiting thread queue. Stands for one waiting thread, should have
   // exact one thread waiting on its CondVar.
   // Using a doubly linked list for waiting thread queue to wake up waiting
@@ -160,7 +160,7 @@ class InfLenFIFOQueue : public MPMCQueueInterface {
   Atomic<int> count_{0};        // Number of elements in queue
   int num_nodes_ = 0;           // Number of nodes allocated
 
-  Stats stats_;            // Stats info
+  MPMCQueueStats stats_;  // Stats info
   gpr_timespec busy_time;  // Start time of busy queue
 
   // Internal Helper.
@@ -170,6 +170,109 @@ class InfLenFIFOQueue : public MPMCQueueInterface {
   Node* AllocateNodes(int num);
 };
 
+// Infinite length MPMC queue whose fast path is lock-free. Elements are
+// placed into a fixed-size ring of sequenced cells (Vyukov's bounded MPMC
+// queue), so producers and consumers only contend on one atomic position each
+// instead of a shared mutex. When the ring is full, elements spill into a
+// mutex-protected overflow list; producers keep using the overflow list until
+// it drains, so elements still come out in (roughly) insertion order.
+//
+// Get() blocks on an empty queue. Blocking uses an eventcount: producers only
+// take the wait mutex when a consumer has announced that it is going to sleep.
+class InfLenLockFreeQueue : public MPMCQueueInterface {
+ public:
+  // Creates a new MPMC Queue. The queue created will have infinite length.
+  InfLenLockFreeQueue();
+
+  // Releases all resources held by the queue. The queue must be empty, and no
+  // one waits on conditional variables.
+  ~InfLenLockFreeQueue();
+
+  // Puts elem into queue immediately at the end of queue. Since the queue has
+  // infinite length, this routine will never block and should never fail.
+  void Put(void* elem);
+
+  // Removes the oldest element from the queue and returns it.
+  // This routine will cause the thread to block if queue is currently empty.
+  // Argument wait_time should be passed in when trace flag turning on (for
+  // collecting stats info purpose.)
+  void* Get(gpr_timespec* wait_time = nullptr);
+
+  // Returns number of elements in queue currently.
+  // There might be concurrently add/remove on queue, so count might change
+  // quickly.
+  int count() const { return count_.Load(MemoryOrder::RELAXED); }
+
+  // For test purpose only. Returns the number of elements the lock-free ring
+  // holds before spilling into the overflow list.
+  int ring_size() const { return kRingSize; }
+
+  // For test purpose only. Returns the number of elements currently in the
+  // overflow list.
+  int overflow_count() const {
+    return overflow_count_.Load(MemoryOrder::RELAXED);
+  }
+
+ private:
+  struct Cell {
+    Atomic<size_t> sequence;
+    void* content;
+    gpr_timespec insert_time;  // Time for stats
+  };
+
+  struct OverflowNode {
+    OverflowNode* next;
+    void* content;
+    gpr_timespec insert_time;  // Time for stats
+  };
+
+  // Tries to put elem into the ring. Returns false if the ring is full.
+  bool TryPushRing(void* elem, gpr_timespec insert_time);
+  // Tries to take the oldest element from the ring. Returns false if the ring
+  // is empty, or if the oldest slot is claimed but not yet published.
+  bool TryPopRing(void** elem, gpr_timespec* insert_time);
+  void PushOverflow(void* elem, gpr_timespec insert_time);
+  bool TryPopOverflow(void** elem, gpr_timespec* insert_time);
+
+  // Takes one element out of the queue. Caller must have already reserved an
+  // element by decrementing count_, so an element is guaranteed to be (or to
+  // shortly become) available.
+  void* PopReserved();
+
+  // Updates and logs stats, only called when trace flag turned on.
+  void UpdatePutStats(int prev_count);
+  void UpdateGetStats(gpr_timespec insert_time, int remaining);
+
+  // Number of cells in ring, must be a power of 2.
+  static const int kRingSize = 1024;
+
+  Cell* ring_;
+  // Producer and consumer positions live on their own cache lines so they
+  // do not false share with each other or with the ring pointer.
+  char pad0_[GPR_CACHELINE_SIZE];
+  Atomic<size_t> enqueue_pos_{0};
+  char pad1_[GPR_CACHELINE_SIZE];
+  Atomic<size_t> dequeue_pos_{0};
+  char pad2_[GPR_CACHELINE_SIZE];
+  // Number of elements that may be taken by Get(). Incremented after an
+  // element is published, decremented by a consumer to reserve an element.
+  Atomic<int> count_{0};
+  Atomic<int> num_waiters_{0};  // Consumers (about to be) blocked in Get()
+  char pad3_[GPR_CACHELINE_SIZE];
+
+  Mutex overflow_mu_;  // Protects overflow list
+  OverflowNode* overflow_head_ = nullptr;
+  OverflowNode* overflow_tail_ = nullptr;
+  Atomic<int> overflow_count_{0};  // Number of elements in overflow list
+
+  Mutex wait_mu_;  // Only used to block consumers on empty queue
+  CondVar wait_cv_;
+
+  Mutex stats_mu_;  // Protects stats_ and busy_time
+  MPMCQueueStats stats_;
+  gpr_timespec busy_time;  // Start time of busy queue
+};
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_IOMGR_EXECUTOR_MPMCQUEUE_H */
@@ -54,7 +54,7 @@ void ThreadPool::SharedThreadPoolConstructor() {
   // Create at least 1 worker thread.
   if (num_threads_ <= 0) num_threads_ = 1;
 
-  queue_ = New<InfLenFIFOQueue>();
+  queue_ = New<InfLenLockFreeQueue>();
   threads_ = static_cast<ThreadPoolWorker**>(
       gpr_zalloc(num_threads_ * sizeof(ThreadPoolWorker*)));
   for (int i = 0; i < num_threads_; ++i) {
@@ -63,6 +63,22 @@ constexpr int SCM_TSTAMP_ACK = 2;
 #define SCM_TIMESTAMPING_OPT_STATS 54
 #endif
 
+/* Redefine MSG_ZEROCOPY related constants (Linux 4.14+) so that code compiles
+ * against older kernel headers. Setting SO_ZEROCOPY fails at runtime on
+ * kernels that do not support it. */
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+
 /* Redefine required constants from <linux/net_tstamp.h> */
 constexpr uint32_t SOF_TIMESTAMPING_TX_SOFTWARE = 1u << 1;
 constexpr uint32_t SOF_TIMESTAMPING_SOFTWARE = 1u << 4;
@@ -73,6 +73,11 @@
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0)
 #define GRPC_LINUX_ERRQUEUE 1
 #endif /* LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0) */
+/* The iouring polling engine relies on multishot IORING_OP_POLL_ADD (5.13).
+   Running kernels are probed at engine initialization. */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 13, 0)
+#define GRPC_LINUX_IO_URING 1
+#endif /* LINUX_VERSION_CODE >= KERNEL_VERSION(5, 13, 0) */
 #endif /* LINUX_VERSION_CODE */
 #define GRPC_LINUX_MULTIPOLL_WITH_EPOLL 1
 #define GRPC_POSIX_FORK 1
@@ -90,6 +95,9 @@
 #if __GLIBC_PREREQ(2, 10)
 #define GRPC_LINUX_SOCKETUTILS 1
 #endif
+#if __GLIBC_PREREQ(2, 14)
+#define GRPC_LINUX_MMSG 1
+#endif
 #endif
 #ifdef LINUX_VERSION_CODE
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 37)
@@ -109,6 +117,7 @@
 #define GRPC_LINUX_EPOLL 1
 #define GRPC_LINUX_EPOLL_CREATE1 1
 #define GRPC_LINUX_EVENTFD 1
+#define GRPC_LINUX_MMSG 1
 #define GRPC_MSG_IOVLEN_TYPE int
 #endif
 #ifndef GRPC_LINUX_EVENTFD
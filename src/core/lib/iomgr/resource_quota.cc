@@ -30,6 +30,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -38,6 +39,19 @@ grpc_core::TraceFlag grpc_resource_quota_trace(false, "resource_quota");
 
 #define MEMORY_USAGE_ESTIMATION_MAX 65536
 
+/* Slices allocated by grpc_resource_user_alloc_slices whose length is a power
+   of two between 1 << BUFFER_POOL_MIN_SHIFT and 1 << BUFFER_POOL_MAX_SHIFT are
+   recycled through a per-quota pool instead of going back to the allocator */
+#define BUFFER_POOL_MIN_SHIFT 10
+#define BUFFER_POOL_MAX_SHIFT 18
+#define BUFFER_POOL_CLASSES (BUFFER_POOL_MAX_SHIFT - BUFFER_POOL_MIN_SHIFT + 1)
+/* Upper bound on the memory kept idle in a quota's pool; the pool never keeps
+   more than 1/16th of the quota size either */
+#define BUFFER_POOL_MAX_BYTES (4 * 1024 * 1024)
+/* Memory pressure above which freed slices are not pooled and the pool is
+   emptied */
+#define BUFFER_POOL_MAX_PRESSURE 0.8
+
 /* Internal linked list pointers for a resource user */
 typedef struct {
   grpc_resource_user* next;
@@ -182,6 +196,15 @@ struct grpc_resource_quota {
   /* Roots of all resource user lists */
   grpc_resource_user* roots[GRPC_RULIST_COUNT];
 
+  /* Recycling pool of slice memory: one free list per size class, linked
+     through the first word of each block. Pooled memory stays charged to the
+     quota, in used and against free_pool, until it is rented out again or
+     flushed: the pool is flushed before an allocation is refused. */
+  gpr_mu buffer_pool_mu;
+  void* buffer_pool[BUFFER_POOL_CLASSES];
+  /* Written under buffer_pool_mu */
+  gpr_atm buffer_pool_bytes;
+
   char* name;
 };
 
@@ -273,13 +296,17 @@ static bool rq_alloc(grpc_resource_quota* resource_quota);
 static bool rq_reclaim_from_per_user_free_pool(
     grpc_resource_quota* resource_quota);
 static bool rq_reclaim(grpc_resource_quota* resource_quota, bool destructive);
+static bool rq_buffer_pool_flush(grpc_resource_quota* resource_quota);
 
 static void rq_step(void* rq, grpc_error* error) {
   grpc_resource_quota* resource_quota = static_cast<grpc_resource_quota*>(rq);
   resource_quota->step_scheduled = false;
+  /* When out of quota, stop keeping idle memory around before asking resource
+     users to give some back */
   do {
     if (rq_alloc(resource_quota)) goto done;
-  } while (rq_reclaim_from_per_user_free_pool(resource_quota));
+  } while (rq_reclaim_from_per_user_free_pool(resource_quota) ||
+           rq_buffer_pool_flush(resource_quota));
 
   if (!rq_reclaim(resource_quota, false)) {
     rq_reclaim(resource_quota, true);
@@ -297,13 +324,19 @@ static void rq_step_sched(grpc_resource_quota* resource_quota) {
                                        GRPC_ERROR_NONE);
 }
 
+/* free_pool, less the memory idle in the buffer pool */
+static int64_t rq_free_memory(grpc_resource_quota* resource_quota) {
+  return resource_quota->free_pool -
+         gpr_atm_no_barrier_load(&resource_quota->buffer_pool_bytes);
+}
+
 /* update the atomically available resource estimate - use no barriers since
    timeliness of delivery really doesn't matter much */
 static void rq_update_estimate(grpc_resource_quota* resource_quota) {
   gpr_atm memory_usage_estimation = MEMORY_USAGE_ESTIMATION_MAX;
   if (resource_quota->size != 0) {
     memory_usage_estimation =
-        GPR_CLAMP((gpr_atm)((1.0 - ((double)resource_quota->free_pool) /
+        GPR_CLAMP((gpr_atm)((1.0 - ((double)rq_free_memory(resource_quota)) /
                                        ((double)resource_quota->size)) *
                             MEMORY_USAGE_ESTIMATION_MAX),
                   0, MEMORY_USAGE_ESTIMATION_MAX);
@@ -339,7 +372,7 @@ static bool rq_alloc(grpc_resource_quota* resource_quota) {
       continue;
     }
     if (resource_user->free_pool < 0 &&
-        -resource_user->free_pool <= resource_quota->free_pool) {
+        -resource_user->free_pool <= rq_free_memory(resource_quota)) {
       int64_t amt = -resource_user->free_pool;
       resource_user->free_pool = 0;
       resource_quota->free_pool -= amt;
@@ -428,6 +461,109 @@ static bool rq_reclaim(grpc_resource_quota* resource_quota, bool destructive) {
   return true;
 }
 
+/*******************************************************************************
+ * buffer pool: recycles the memory backing ru_slices
+ */
+
+/* Returns the pool size class of a slice of length size, or -1 if such slices
+   are not pooled */
+static int rq_buffer_pool_class(size_t size) {
+  if (size < (size_t{1} << BUFFER_POOL_MIN_SHIFT) ||
+      size > (size_t{1} << BUFFER_POOL_MAX_SHIFT) || (size & (size - 1)) != 0) {
+    return -1;
+  }
+  int cls = 0;
+  while ((size_t{1} << (cls + BUFFER_POOL_MIN_SHIFT)) != size) cls++;
+  return cls;
+}
+
+static void* rq_buffer_pool_get(grpc_resource_quota* resource_quota,
+                                size_t size) {
+  int cls = rq_buffer_pool_class(size);
+  if (cls < 0) return nullptr;
+  gpr_mu_lock(&resource_quota->buffer_pool_mu);
+  void* block = resource_quota->buffer_pool[cls];
+  if (block != nullptr) {
+    resource_quota->buffer_pool[cls] = *static_cast<void**>(block);
+    gpr_atm_no_barrier_store(
+        &resource_quota->buffer_pool_bytes,
+        gpr_atm_no_barrier_load(&resource_quota->buffer_pool_bytes) - size);
+  }
+  gpr_mu_unlock(&resource_quota->buffer_pool_mu);
+  if (block != nullptr) {
+    /* the renting resource user has been charged for the block already */
+    gpr_atm_no_barrier_fetch_add(&resource_quota->used, -size);
+    GRPC_STATS_INC_RESOURCE_QUOTA_BUFFER_POOL_HITS();
+  } else {
+    GRPC_STATS_INC_RESOURCE_QUOTA_BUFFER_POOL_MISSES();
+  }
+  return block;
+}
+
+/* Takes ownership of block, which backed a slice of length size. A pooled
+   block is charged to the quota before its resource user is freed. */
+static void rq_buffer_pool_put(grpc_resource_quota* resource_quota, void* block,
+                               size_t size) {
+  int cls = rq_buffer_pool_class(size);
+  if (cls >= 0) {
+    if (grpc_resource_quota_get_memory_pressure(resource_quota) >
+        BUFFER_POOL_MAX_PRESSURE) {
+      rq_buffer_pool_flush(resource_quota);
+    } else {
+      size_t max_bytes =
+          GPR_MIN(BUFFER_POOL_MAX_BYTES,
+                  grpc_resource_quota_peek_size(resource_quota) / 16);
+      gpr_mu_lock(&resource_quota->buffer_pool_mu);
+      const size_t pool_bytes = static_cast<size_t>(
+          gpr_atm_no_barrier_load(&resource_quota->buffer_pool_bytes));
+      if (pool_bytes + size <= max_bytes) {
+        *static_cast<void**>(block) = resource_quota->buffer_pool[cls];
+        resource_quota->buffer_pool[cls] = block;
+        gpr_atm_no_barrier_fetch_add(&resource_quota->used, size);
+        gpr_atm_no_barrier_store(&resource_quota->buffer_pool_bytes,
+                                 pool_bytes + size);
+        block = nullptr;
+      }
+      gpr_mu_unlock(&resource_quota->buffer_pool_mu);
+      if (block == nullptr) return;
+    }
+  }
+  gpr_free(block);
+}
+
+/* Frees the memory idle in the pool, and uncharges it from the quota. Returns
+   true if there was any. */
+static bool rq_buffer_pool_flush(grpc_resource_quota* resource_quota) {
+  void* pool[BUFFER_POOL_CLASSES];
+  gpr_mu_lock(&resource_quota->buffer_pool_mu);
+  const gpr_atm pool_bytes =
+      gpr_atm_no_barrier_load(&resource_quota->buffer_pool_bytes);
+  if (pool_bytes == 0) {
+    gpr_mu_unlock(&resource_quota->buffer_pool_mu);
+    return false;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
+    gpr_log(GPR_INFO, "RQ %s: flush %" PRIdPTR " bytes from buffer pool",
+            resource_quota->name, pool_bytes);
+  }
+  for (int i = 0; i < BUFFER_POOL_CLASSES; i++) {
+    pool[i] = resource_quota->buffer_pool[i];
+    resource_quota->buffer_pool[i] = nullptr;
+  }
+  gpr_atm_no_barrier_fetch_add(&resource_quota->used, -pool_bytes);
+  gpr_atm_no_barrier_store(&resource_quota->buffer_pool_bytes, 0);
+  gpr_mu_unlock(&resource_quota->buffer_pool_mu);
+  GRPC_STATS_INC_RESOURCE_QUOTA_BUFFER_POOL_FLUSHES();
+  for (int i = 0; i < BUFFER_POOL_CLASSES; i++) {
+    while (pool[i] != nullptr) {
+      void* next = *static_cast<void**>(pool[i]);
+      gpr_free(pool[i]);
+      pool[i] = next;
+    }
+  }
+  return true;
+}
+
 /*******************************************************************************
  * ru_slice: a slice implementation that is backed by a grpc_resource_user
  */
@@ -438,8 +574,13 @@ class RuSliceRefcount {
  public:
   static void Destroy(void* p) {
     auto* rc = static_cast<RuSliceRefcount*>(p);
+    grpc_resource_user* resource_user = rc->resource_user_;
+    size_t size = rc->size_;
     rc->~RuSliceRefcount();
-    gpr_free(rc);
+    /* Recycle the memory before releasing the quota: the resource user (and
+       so the resource quota) may be destroyed once its last byte is freed */
+    rq_buffer_pool_put(resource_user->resource_quota, rc, size);
+    grpc_resource_user_free(resource_user, size);
   }
   RuSliceRefcount(grpc_resource_user* resource_user, size_t size)
       : base_(grpc_slice_refcount::Type::REGULAR, &refs_, Destroy, this,
@@ -448,7 +589,6 @@ class RuSliceRefcount {
         size_(size) {
     // Nothing to do here.
   }
-  ~RuSliceRefcount() { grpc_resource_user_free(resource_user_, size_); }
 
   grpc_slice_refcount* base_refcount() { return &base_; }
 
@@ -463,8 +603,11 @@ class RuSliceRefcount {
 
 static grpc_slice ru_slice_create(grpc_resource_user* resource_user,
                                   size_t size) {
-  auto* rc = static_cast<grpc_core::RuSliceRefcount*>(
-      gpr_malloc(sizeof(grpc_core::RuSliceRefcount) + size));
+  void* block = rq_buffer_pool_get(resource_user->resource_quota, size);
+  if (block == nullptr) {
+    block = gpr_malloc(sizeof(grpc_core::RuSliceRefcount) + size);
+  }
+  auto* rc = static_cast<grpc_core::RuSliceRefcount*>(block);
   new (rc) grpc_core::RuSliceRefcount(resource_user, size);
   grpc_slice slice;
 
@@ -662,6 +805,11 @@ grpc_resource_quota* grpc_resource_quota_create(const char* name) {
   for (int i = 0; i < GRPC_RULIST_COUNT; i++) {
     resource_quota->roots[i] = nullptr;
   }
+  gpr_mu_init(&resource_quota->buffer_pool_mu);
+  for (int i = 0; i < BUFFER_POOL_CLASSES; i++) {
+    resource_quota->buffer_pool[i] = nullptr;
+  }
+  gpr_atm_no_barrier_store(&resource_quota->buffer_pool_bytes, 0);
   return resource_quota;
 }
 
@@ -670,6 +818,8 @@ void grpc_resource_quota_unref_internal(grpc_resource_quota* resource_quota) {
     // No outstanding thread quota
     GPR_ASSERT(resource_quota->num_threads_allocated == 0);
     GRPC_COMBINER_UNREF(resource_quota->combiner, "resource_quota");
+    rq_buffer_pool_flush(resource_quota);
+    gpr_mu_destroy(&resource_quota->buffer_pool_mu);
     gpr_free(resource_quota->name);
     gpr_mu_destroy(&resource_quota->thread_count_mu);
     gpr_free(resource_quota);
@@ -727,6 +877,10 @@ size_t grpc_resource_quota_peek_size(grpc_resource_quota* resource_quota) {
       gpr_atm_no_barrier_load(&resource_quota->last_size));
 }
 
+size_t grpc_resource_quota_peek_used(grpc_resource_quota* resource_quota) {
+  return static_cast<size_t>(gpr_atm_no_barrier_load(&resource_quota->used));
+}
+
 /*******************************************************************************
  * grpc_resource_user channel args api
  */
@@ -914,6 +1068,11 @@ bool grpc_resource_user_safe_alloc(grpc_resource_user* resource_user,
     gpr_atm new_used = used + size;
     if (static_cast<size_t>(new_used) >
         grpc_resource_quota_peek_size(resource_quota)) {
+      /* make room by freeing idle pooled memory before refusing */
+      if (rq_buffer_pool_flush(resource_quota)) {
+        cas_success = false;
+        continue;
+      }
       gpr_mu_unlock(&resource_user->mu);
       return false;
     }
@@ -1008,3 +1167,10 @@ bool grpc_resource_user_alloc_slices(
   if (ret) ru_alloc_slices(slice_allocator);
   return ret;
 }
+
+size_t grpc_resource_quota_pooled_slice_size(size_t length) {
+  if (length > (size_t{1} << BUFFER_POOL_MAX_SHIFT)) return length;
+  size_t size = size_t{1} << BUFFER_POOL_MIN_SHIFT;
+  while (size < length) size <<= 1;
+  return size;
+}
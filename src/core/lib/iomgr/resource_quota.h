@@ -84,6 +84,18 @@ double grpc_resource_quota_get_memory_pressure(
 
 size_t grpc_resource_quota_peek_size(grpc_resource_quota* resource_quota);
 
+/* Returns the memory currently charged to the quota, including idle memory
+   held by its buffer pool */
+size_t grpc_resource_quota_peek_used(grpc_resource_quota* resource_quota);
+
+/* Returns the smallest slice length >= \a length for which slices allocated
+   with grpc_resource_user_alloc_slices are recycled through the resource
+   quota's buffer pool instead of the allocator, or \a length if such slices
+   are too large to be pooled. The pool keeps a bounded amount of idle memory,
+   which stays charged to the quota until the pool releases it under memory
+   pressure, or before refusing an allocation. */
+size_t grpc_resource_quota_pooled_slice_size(size_t length);
+
 typedef struct grpc_resource_user grpc_resource_user;
 
 grpc_resource_user* grpc_resource_user_create(
@@ -226,6 +226,21 @@ grpc_error* grpc_set_socket_low_latency(int fd, int low_latency) {
   return GRPC_ERROR_NONE;
 }
 
+grpc_error* grpc_set_socket_busy_poll(int fd, int busy_poll_us) {
+#ifndef SO_BUSY_POLL
+  (void)fd;
+  (void)busy_poll_us;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "SO_BUSY_POLL unavailable on compiling system");
+#else
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &busy_poll_us,
+                      sizeof(busy_poll_us))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(SO_BUSY_POLL)");
+  }
+  return GRPC_ERROR_NONE;
+#endif
+}
+
 /* The default values for TCP_USER_TIMEOUT are currently configured to be in
  * line with the default values of KEEPALIVE_TIMEOUT as proposed in
  * https://github.com/grpc/proposal/blob/master/A18-tcp-user-timeout.md */
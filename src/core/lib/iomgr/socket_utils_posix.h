@@ -50,6 +50,10 @@ bool grpc_is_socket_reuse_port_supported();
 /* disable nagle */
 grpc_error* grpc_set_socket_low_latency(int fd, int low_latency);
 
+/* set SO_BUSY_POLL to busy_poll_us microseconds (0 disables busy polling).
+   Fails on platforms without SO_BUSY_POLL. */
+grpc_error* grpc_set_socket_busy_poll(int fd, int busy_poll_us);
+
 /* set SO_REUSEPORT */
 grpc_error* grpc_set_socket_reuse_port(int fd, int reuse);
 
@@ -25,6 +25,7 @@
 #include "src/core/lib/iomgr/tcp_posix.h"
 
 #include <errno.h>
+#include <fcntl.h>
 #include <limits.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
@@ -49,9 +50,12 @@
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/inlined_vector.h"
+#include "src/core/lib/gprpp/map.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/executor.h"
+#include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
@@ -80,6 +84,133 @@ typedef size_t msg_iovlen_type;
 extern grpc_core::TraceFlag grpc_tcp_trace;
 
 namespace {
+
+/* A write handed to the kernel with MSG_ZEROCOPY. The kernel reads directly
+ * from the slices in buf, so they must stay referenced until the completion
+ * notification for every sendmsg call that used them arrives on the socket
+ * error queue. */
+struct zerocopy_send_record {
+  grpc_slice_buffer buf;
+  /* Position of the next byte to send in buf. */
+  size_t slice_idx;
+  size_t byte_idx;
+  /* One ref for the write in progress, plus one per sendmsg call that is
+   * waiting for its completion notification. */
+  gpr_atm refs;
+};
+
+/* Per-endpoint MSG_ZEROCOPY bookkeeping. The kernel numbers successful
+ * zerocopy sendmsg calls on a socket consecutively from zero, and reports
+ * completions as inclusive ranges of those sequence numbers. */
+class ZerocopySendCtx {
+ public:
+  ZerocopySendCtx(int max_sends, size_t threshold)
+      : max_sends_(max_sends), threshold_(threshold) {
+    gpr_mu_init(&mu_);
+    records_ = static_cast<zerocopy_send_record*>(
+        gpr_malloc(sizeof(*records_) * max_sends_));
+    for (int i = 0; i < max_sends_; i++) {
+      grpc_slice_buffer_init(&records_[i].buf);
+      free_records_.push_back(&records_[i]);
+    }
+  }
+
+  /* Only destroyed once AllSendsDone(): the kernel may still be transmitting
+   * from the slices of a pending record, even after the fd is closed. */
+  ~ZerocopySendCtx() {
+    for (int i = 0; i < max_sends_; i++) {
+      grpc_slice_buffer_destroy_internal(&records_[i].buf);
+    }
+    gpr_free(records_);
+    gpr_mu_destroy(&mu_);
+  }
+
+  size_t threshold() const { return threshold_; }
+
+  /* Whether the kernel has released every record. Only meaningful once no
+   * write is in progress. */
+  bool AllSendsDone() {
+    gpr_mu_lock(&mu_);
+    bool done = pending_.empty();
+    gpr_mu_unlock(&mu_);
+    return done;
+  }
+
+  /* Takes ownership of the slices in buf. Returns nullptr if all records are
+   * still held by the kernel, in which case the caller should copy. */
+  zerocopy_send_record* StartSend(grpc_slice_buffer* buf) {
+    gpr_mu_lock(&mu_);
+    if (free_records_.empty()) {
+      gpr_mu_unlock(&mu_);
+      return nullptr;
+    }
+    zerocopy_send_record* record = free_records_[free_records_.size() - 1];
+    free_records_.pop_back();
+    gpr_mu_unlock(&mu_);
+    grpc_slice_buffer_swap(buf, &record->buf);
+    record->slice_idx = 0;
+    record->byte_idx = 0;
+    gpr_atm_no_barrier_store(&record->refs, 1);
+    return record;
+  }
+
+  /* Must be called right before a zerocopy sendmsg using record's slices. */
+  void NoteSend(zerocopy_send_record* record) {
+    gpr_atm_no_barrier_fetch_add(&record->refs, 1);
+    gpr_mu_lock(&mu_);
+    pending_.emplace(next_seq_++, record);
+    gpr_mu_unlock(&mu_);
+  }
+
+  /* Undoes the last NoteSend when the sendmsg call did not go through. */
+  void UndoSend() {
+    gpr_mu_lock(&mu_);
+    auto it = pending_.find(--next_seq_);
+    GPR_ASSERT(it != pending_.end());
+    zerocopy_send_record* record = it->second;
+    pending_.erase(it);
+    gpr_mu_unlock(&mu_);
+    Unref(record);
+  }
+
+  /* Handles a completion notification for sequence numbers [lo, hi]. */
+  void ProcessCompletion(uint32_t lo, uint32_t hi) {
+    for (uint32_t seq = lo;; seq++) {
+      gpr_mu_lock(&mu_);
+      auto it = pending_.find(seq);
+      zerocopy_send_record* record = nullptr;
+      if (it != pending_.end()) {
+        record = it->second;
+        pending_.erase(it);
+      }
+      gpr_mu_unlock(&mu_);
+      if (record != nullptr) Unref(record);
+      if (seq == hi) break;
+    }
+  }
+
+  /* Drops a ref on record, recycling it once the kernel and the writer are
+   * both done with it. */
+  void Unref(zerocopy_send_record* record) {
+    if (gpr_atm_full_fetch_add(&record->refs, -1) == 1) {
+      grpc_slice_buffer_reset_and_unref_internal(&record->buf);
+      gpr_mu_lock(&mu_);
+      free_records_.push_back(record);
+      gpr_mu_unlock(&mu_);
+    }
+  }
+
+ private:
+  const int max_sends_;
+  const size_t threshold_;
+  zerocopy_send_record* records_;
+  gpr_mu mu_;
+  /* Guarded by mu_. */
+  grpc_core::InlinedVector<zerocopy_send_record*, 4> free_records_;
+  grpc_core::Map<uint32_t, zerocopy_send_record*> pending_;
+  uint32_t next_seq_ = 0;
+};
+
 struct grpc_tcp {
   grpc_endpoint base;
   grpc_fd* em_fd;
@@ -95,8 +226,12 @@ struct grpc_tcp {
   int min_read_chunk_size;
   int max_read_chunk_size;
 
-  /* garbage after the last read */
-  grpc_slice_buffer last_read_buffer;
+  /* Slab that reads are carved from. Holds at most one slice, of which the
+   * first read_slab_offset bytes have already been handed to the upper layers.
+   * Released whenever the socket is drained so that idle endpoints hold no
+   * read memory. */
+  grpc_slice_buffer read_slab;
+  size_t read_slab_offset;
 
   grpc_slice_buffer* incoming_buffer;
   int inq;          /* bytes pending on the socket from the last read. */
@@ -142,6 +277,12 @@ struct grpc_tcp {
   bool ts_capable;        /* Cache whether we can set timestamping options */
   gpr_atm stop_error_notification; /* Set to 1 if we do not want to be notified
                                       on errors anymore */
+
+  /* Non-null if MSG_ZEROCOPY sends are enabled on this endpoint. */
+  ZerocopySendCtx* zerocopy_ctx;
+  /* The zerocopy write in progress, if any. Used instead of outgoing_buffer
+   * while set. */
+  zerocopy_send_record* current_zerocopy_send;
 };
 
 struct backup_poller {
@@ -306,12 +447,25 @@ static void finish_estimate(grpc_tcp* tcp) {
 static size_t get_target_read_size(grpc_tcp* tcp) {
   grpc_resource_quota* rq = grpc_resource_user_quota(tcp->resource_user);
   double pressure = grpc_resource_quota_get_memory_pressure(rq);
-  double target =
-      tcp->target_length * (pressure > 0.8 ? (1.0 - pressure) / 0.2 : 1.0);
+  /* If the kernel reported how many bytes are still queued on the socket, size
+   * the read for exactly those instead of relying on the moving estimate.
+   * tcp->inq == 1 is also the 'unknown' value assumed before each read. */
+  const bool inq_known = tcp->inq_capable && tcp->inq > 1;
+  double target = inq_known ? tcp->inq : tcp->target_length;
+  target *= pressure > 0.8 ? (1.0 - pressure) / 0.2 : 1.0;
   size_t sz = ((static_cast<size_t> GPR_CLAMP(target, tcp->min_read_chunk_size,
                                               tcp->max_read_chunk_size)) +
                255) &
               ~static_cast<size_t>(255);
+  /* An estimate is only a guess, so prefer a size that the resource quota
+   * recycles rather than mallocs. An exact size is kept: rounding it up would
+   * charge the quota for up to twice what is queued. */
+  if (!inq_known) {
+    size_t pooled_sz = grpc_resource_quota_pooled_slice_size(sz);
+    if (pooled_sz <= static_cast<size_t>(tcp->max_read_chunk_size)) {
+      sz = pooled_sz;
+    }
+  }
   /* don't use more than 1/16th of the overall resource quota for a single read
    * alloc */
   size_t rqmax = grpc_resource_quota_peek_size(rq);
@@ -334,6 +488,7 @@ static grpc_error* tcp_annotate_error(grpc_error* src_error, grpc_tcp* tcp) {
 
 static void tcp_handle_read(void* arg /* grpc_tcp */, grpc_error* error);
 static void tcp_handle_write(void* arg /* grpc_tcp */, grpc_error* error);
+static void release_zerocopy_ctx(grpc_tcp* tcp);
 
 static void tcp_shutdown(grpc_endpoint* ep, grpc_error* why) {
   grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
@@ -342,9 +497,11 @@ static void tcp_shutdown(grpc_endpoint* ep, grpc_error* why) {
 }
 
 static void tcp_free(grpc_tcp* tcp) {
+  /* Must happen before the fd is orphaned, which may close it */
+  release_zerocopy_ctx(tcp);
   grpc_fd_orphan(tcp->em_fd, tcp->release_fd_cb, tcp->release_fd,
                  "tcp_unref_orphan");
-  grpc_slice_buffer_destroy_internal(&tcp->last_read_buffer);
+  grpc_slice_buffer_destroy_internal(&tcp->read_slab);
   grpc_resource_user_unref(tcp->resource_user);
   gpr_free(tcp->peer_string);
   /* The lock is not really necessary here, since all refs have been released */
@@ -386,7 +543,7 @@ static void tcp_ref(grpc_tcp* tcp) { tcp->refcount.Ref(); }
 
 static void tcp_destroy(grpc_endpoint* ep) {
   grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
-  grpc_slice_buffer_reset_and_unref_internal(&tcp->last_read_buffer);
+  grpc_slice_buffer_reset_and_unref_internal(&tcp->read_slab);
   if (grpc_event_engine_can_track_errors()) {
     gpr_atm_no_barrier_store(&tcp->stop_error_notification, true);
     grpc_fd_set_error(tcp->em_fd);
@@ -418,6 +575,21 @@ static void call_read_cb(grpc_tcp* tcp, grpc_error* error) {
   GRPC_CLOSURE_SCHED(cb, error);
 }
 
+static void release_read_slab(grpc_tcp* tcp) {
+  grpc_slice_buffer_reset_and_unref_internal(&tcp->read_slab);
+  tcp->read_slab_offset = 0;
+}
+
+/* Offers the unused tail of the read slab to the next read. */
+static void carve_read_slab(grpc_tcp* tcp) {
+  GPR_DEBUG_ASSERT(tcp->read_slab.count == 1);
+  GPR_DEBUG_ASSERT(tcp->incoming_buffer->length == 0);
+  grpc_slice slab = tcp->read_slab.slices[0];
+  grpc_slice tail = grpc_slice_sub_no_ref(slab, tcp->read_slab_offset,
+                                          GRPC_SLICE_LENGTH(slab));
+  grpc_slice_buffer_add(tcp->incoming_buffer, grpc_slice_ref_internal(tail));
+}
+
 #define MAX_READ_IOVEC 4
 static void tcp_do_read(grpc_tcp* tcp) {
   GPR_TIMER_SCOPE("tcp_do_read", 0);
@@ -480,6 +652,10 @@ static void tcp_do_read(grpc_tcp* tcp) {
       if (errno == EAGAIN) {
         finish_estimate(tcp);
         tcp->inq = 0;
+        /* The socket is drained: don't hold on to read memory while waiting
+         * for more data, a fresh slab is sized when it arrives. */
+        grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
+        release_read_slab(tcp);
         /* We've consumed the edge, request a new one */
         notify_on_read(tcp);
       } else {
@@ -559,8 +735,12 @@ static void tcp_do_read(grpc_tcp* tcp) {
   if (total_read_bytes < tcp->incoming_buffer->length) {
     grpc_slice_buffer_trim_end(tcp->incoming_buffer,
                                tcp->incoming_buffer->length - total_read_bytes,
-                               &tcp->last_read_buffer);
+                               nullptr);
   }
+  /* The unfilled tail stays in the slab for the next read. */
+  tcp->read_slab_offset += total_read_bytes;
+  GRPC_STATS_INC_COUNTER_BY(GRPC_STATS_COUNTER_TCP_READ_USED_BYTES,
+                            total_read_bytes);
   call_read_cb(tcp, GRPC_ERROR_NONE);
   TCP_UNREF(tcp, "read");
 }
@@ -573,28 +753,44 @@ static void tcp_read_allocation_done(void* tcpp, grpc_error* error) {
   }
   if (GPR_UNLIKELY(error != GRPC_ERROR_NONE)) {
     grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
-    grpc_slice_buffer_reset_and_unref_internal(&tcp->last_read_buffer);
+    release_read_slab(tcp);
     call_read_cb(tcp, GRPC_ERROR_REF(error));
     TCP_UNREF(tcp, "read");
   } else {
+    carve_read_slab(tcp);
     tcp_do_read(tcp);
   }
 }
 
 static void tcp_continue_read(grpc_tcp* tcp) {
-  size_t target_read_size = get_target_read_size(tcp);
   /* Wait for allocation only when there is no buffer left. */
-  if (tcp->incoming_buffer->length == 0 &&
-      tcp->incoming_buffer->count < MAX_READ_IOVEC) {
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
-      gpr_log(GPR_INFO, "TCP:%p alloc_slices", tcp);
+  if (tcp->incoming_buffer->length == 0) {
+    size_t target_read_size = get_target_read_size(tcp);
+    if (tcp->read_slab.count > 0 && tcp->read_slab_offset > 0 &&
+        tcp->read_slab.slices[0].refcount->IsUnique()) {
+      /* Everything read from the slab so far has been released by the upper
+       * layers: rewind it instead of allocating a new one. */
+      tcp->read_slab_offset = 0;
+      GRPC_STATS_INC_TCP_READ_SLAB_REUSES();
     }
-    if (GPR_UNLIKELY(!grpc_resource_user_alloc_slices(&tcp->slice_allocator,
-                                                      target_read_size, 1,
-                                                      tcp->incoming_buffer))) {
-      // Wait for allocation.
-      return;
+    if (tcp->read_slab.count == 0 ||
+        tcp->read_slab.length - tcp->read_slab_offset < target_read_size) {
+      release_read_slab(tcp);
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+        gpr_log(GPR_INFO, "TCP:%p alloc_slices %" PRIuPTR, tcp,
+                target_read_size);
+      }
+      GRPC_STATS_INC_TCP_READ_ALLOCS();
+      GRPC_STATS_INC_COUNTER_BY(GRPC_STATS_COUNTER_TCP_READ_ALLOC_BYTES,
+                                target_read_size);
+      if (GPR_UNLIKELY(!grpc_resource_user_alloc_slices(&tcp->slice_allocator,
+                                                        target_read_size, 1,
+                                                        &tcp->read_slab))) {
+        // Wait for allocation.
+        return;
+      }
     }
+    carve_read_slab(tcp);
   }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
     gpr_log(GPR_INFO, "TCP:%p do_read", tcp);
@@ -610,7 +806,7 @@ static void tcp_handle_read(void* arg /* grpc_tcp */, grpc_error* error) {
 
   if (GPR_UNLIKELY(error != GRPC_ERROR_NONE)) {
     grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
-    grpc_slice_buffer_reset_and_unref_internal(&tcp->last_read_buffer);
+    release_read_slab(tcp);
     call_read_cb(tcp, GRPC_ERROR_REF(error));
     TCP_UNREF(tcp, "read");
   } else {
@@ -625,7 +821,6 @@ static void tcp_read(grpc_endpoint* ep, grpc_slice_buffer* incoming_buffer,
   tcp->read_cb = cb;
   tcp->incoming_buffer = incoming_buffer;
   grpc_slice_buffer_reset_and_unref_internal(incoming_buffer);
-  grpc_slice_buffer_swap(incoming_buffer, &tcp->last_read_buffer);
   TCP_REF(tcp, "read");
   if (tcp->is_first_read) {
     /* Endpoint read called for the very first time. Register read callback with
@@ -648,14 +843,14 @@ static void tcp_read(grpc_endpoint* ep, grpc_slice_buffer* incoming_buffer,
 }
 
 /* A wrapper around sendmsg. It sends \a msg over \a fd and returns the number
- * of bytes sent. */
-ssize_t tcp_send(int fd, const struct msghdr* msg) {
+ * of bytes sent. \a additional_flags are or'ed into the sendmsg flags. */
+ssize_t tcp_send(int fd, const struct msghdr* msg, int additional_flags = 0) {
   GPR_TIMER_SCOPE("sendmsg", 1);
   ssize_t sent_length;
   do {
     /* TODO(klempner): Cork if this is a partial write */
     GRPC_STATS_INC_SYSCALL_WRITE();
-    sent_length = sendmsg(fd, msg, SENDMSG_FLAGS);
+    sent_length = sendmsg(fd, msg, SENDMSG_FLAGS | additional_flags);
   } while (sent_length < 0 && errno == EINTR);
   return sent_length;
 }
@@ -777,6 +972,121 @@ struct cmsghdr* process_timestamp(grpc_tcp* tcp, msghdr* msg,
   return next_cmsg;
 }
 
+/** If \a cmsg is a MSG_ZEROCOPY completion notification, releases the send
+ * records it covers and returns true. Returns false otherwise. */
+static bool process_zerocopy_completion(ZerocopySendCtx* ctx,
+                                        struct cmsghdr* cmsg) {
+  if (ctx == nullptr ||
+      !((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+        (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR))) {
+    return false;
+  }
+  auto serr = reinterpret_cast<struct sock_extended_err*>(CMSG_DATA(cmsg));
+  if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+    return false;
+  }
+  if (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+    /* The kernel had to copy the data anyway (e.g. loopback or a device
+     * without scatter-gather support). */
+    GRPC_STATS_INC_TCP_ZEROCOPY_FALLBACKS();
+  }
+  ctx->ProcessCompletion(serr->ee_info, serr->ee_data);
+  return true;
+}
+
+/* Keeps the send records of a destroyed endpoint alive until the kernel
+ * reports that it is done with all of them. Until then it may still transmit
+ * from their slices, whatever happens to the fd, so freeing them would let
+ * their memory be reused under it. Nothing polls the fd anymore, so its error
+ * queue is checked on a backoff timer, through a dup of the fd that keeps the
+ * socket around for that long. */
+struct zerocopy_reaper {
+  int fd;
+  ZerocopySendCtx* ctx;
+  grpc_millis backoff;
+  grpc_timer timer;
+  grpc_closure on_timer;
+};
+
+#define ZEROCOPY_REAPER_INITIAL_BACKOFF_MS 1
+#define ZEROCOPY_REAPER_MAX_BACKOFF_MS 1000
+
+/* Processes the completions in fd's error queue, dropping anything else */
+static void drain_zerocopy_completions(int fd, ZerocopySendCtx* ctx) {
+  for (;;) {
+    union {
+      char rbuf[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+      struct cmsghdr align;
+    } aligned_buf;
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = aligned_buf.rbuf;
+    msg.msg_controllen = sizeof(aligned_buf.rbuf);
+    int r;
+    do {
+      r = recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+    } while (r < 0 && errno == EINTR);
+    if (r < 0) return;
+    for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg && cmsg->cmsg_len;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      process_zerocopy_completion(ctx, cmsg);
+    }
+  }
+}
+
+static void zerocopy_reaper_on_timer(void* arg, grpc_error* error) {
+  zerocopy_reaper* reaper = static_cast<zerocopy_reaper*>(arg);
+  drain_zerocopy_completions(reaper->fd, reaper->ctx);
+  if (reaper->ctx->AllSendsDone()) {
+    grpc_core::Delete(reaper->ctx);
+  } else if (error != GRPC_ERROR_NONE) {
+    /* Timers are only cancelled at shutdown. Leaking the records is the only
+     * safe option left. */
+    gpr_log(GPR_ERROR,
+            "fd %d closed with zerocopy sends still held by the kernel: "
+            "leaking their slices",
+            reaper->fd);
+  } else {
+    reaper->backoff =
+        GPR_MIN(2 * reaper->backoff, ZEROCOPY_REAPER_MAX_BACKOFF_MS);
+    grpc_timer_init(&reaper->timer,
+                    grpc_core::ExecCtx::Get()->Now() + reaper->backoff,
+                    &reaper->on_timer);
+    return;
+  }
+  close(reaper->fd);
+  gpr_free(reaper);
+}
+
+static void release_zerocopy_ctx(grpc_tcp* tcp) {
+  ZerocopySendCtx* ctx = tcp->zerocopy_ctx;
+  if (ctx == nullptr) return;
+  tcp->zerocopy_ctx = nullptr;
+  drain_zerocopy_completions(tcp->fd, ctx);
+  if (ctx->AllSendsDone()) {
+    grpc_core::Delete(ctx);
+    return;
+  }
+  int fd = fcntl(tcp->fd, F_DUPFD_CLOEXEC, 0);
+  if (fd < 0) {
+    gpr_log(GPR_ERROR,
+            "cannot dup fd %d to wait for its zerocopy sends (errno=%d): "
+            "leaking their slices",
+            tcp->fd, errno);
+    return;
+  }
+  zerocopy_reaper* reaper =
+      static_cast<zerocopy_reaper*>(gpr_malloc(sizeof(*reaper)));
+  reaper->fd = fd;
+  reaper->ctx = ctx;
+  reaper->backoff = ZEROCOPY_REAPER_INITIAL_BACKOFF_MS;
+  GRPC_CLOSURE_INIT(&reaper->on_timer, zerocopy_reaper_on_timer, reaper,
+                    grpc_schedule_on_exec_ctx);
+  grpc_timer_init(&reaper->timer,
+                  grpc_core::ExecCtx::Get()->Now() + reaper->backoff,
+                  &reaper->on_timer);
+}
+
 /** For linux platforms, reads the socket's error queue and processes error
  * messages from the queue.
  */
@@ -831,6 +1141,10 @@ static void process_errors(grpc_tcp* tcp) {
     bool seen = false;
     for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg && cmsg->cmsg_len;
          cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (process_zerocopy_completion(tcp->zerocopy_ctx, cmsg)) {
+        seen = true;
+        continue;
+      }
       if (cmsg->cmsg_level != SOL_SOCKET ||
           cmsg->cmsg_type != SCM_TIMESTAMPING) {
         /* Got a control message that is not a timestamp. Don't know how to
@@ -889,6 +1203,11 @@ static void tcp_handle_error(void* /*arg*/ /* grpc_tcp */,
   gpr_log(GPR_ERROR, "Error handling is not supported for this platform");
   GPR_ASSERT(0);
 }
+
+/* Zerocopy is only enabled when errors can be tracked */
+static void release_zerocopy_ctx(grpc_tcp* tcp) {
+  GPR_ASSERT(tcp->zerocopy_ctx == nullptr);
+}
 #endif /* GRPC_LINUX_ERRQUEUE */
 
 /* If outgoing_buffer_arg is filled, shuts down the list early, so that any
@@ -1017,11 +1336,102 @@ static bool tcp_flush(grpc_tcp* tcp, grpc_error** error) {
   }
 }
 
+/* Like tcp_flush, but sends the slices held by tcp->current_zerocopy_send with
+ * MSG_ZEROCOPY. Slices are not released as they are written; the send record
+ * keeps them alive until the kernel reports it is done with them. */
+static bool tcp_flush_zerocopy(grpc_tcp* tcp, grpc_error** error) {
+  zerocopy_send_record* record = tcp->current_zerocopy_send;
+  struct msghdr msg;
+  struct iovec iov[MAX_WRITE_IOVEC];
+  msg_iovlen_type iov_size;
+  ssize_t sent_length;
+  size_t sending_length;
+
+  for (;;) {
+    sending_length = 0;
+    size_t slice_idx = record->slice_idx;
+    size_t byte_idx = record->byte_idx;
+    for (iov_size = 0;
+         slice_idx != record->buf.count && iov_size != MAX_WRITE_IOVEC;
+         iov_size++) {
+      iov[iov_size].iov_base =
+          GRPC_SLICE_START_PTR(record->buf.slices[slice_idx]) + byte_idx;
+      iov[iov_size].iov_len =
+          GRPC_SLICE_LENGTH(record->buf.slices[slice_idx]) - byte_idx;
+      sending_length += iov[iov_size].iov_len;
+      slice_idx++;
+      byte_idx = 0;
+    }
+    GPR_ASSERT(iov_size > 0);
+
+    msg.msg_name = nullptr;
+    msg.msg_namelen = 0;
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iov_size;
+    msg.msg_control = nullptr;
+    msg.msg_controllen = 0;
+    msg.msg_flags = 0;
+
+    GRPC_STATS_INC_TCP_WRITE_SIZE(sending_length);
+    GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(iov_size);
+
+    tcp->zerocopy_ctx->NoteSend(record);
+    sent_length = tcp_send(tcp->fd, &msg, MSG_ZEROCOPY);
+    if (sent_length < 0) {
+      /* No sequence number was consumed by a failed call. */
+      tcp->zerocopy_ctx->UndoSend();
+      if (errno == ENOBUFS) {
+        /* Out of socket option memory to track pinned pages: copy this
+         * chunk instead. */
+        GRPC_STATS_INC_TCP_ZEROCOPY_FALLBACKS();
+        sent_length = tcp_send(tcp->fd, &msg);
+      }
+    } else {
+      GRPC_STATS_INC_TCP_ZEROCOPY_SENDS();
+    }
+
+    if (sent_length < 0) {
+      if (errno == EAGAIN) {
+        return false;
+      }
+      *error = tcp_annotate_error(GRPC_OS_ERROR(errno, "sendmsg"), tcp);
+      tcp->current_zerocopy_send = nullptr;
+      tcp->zerocopy_ctx->Unref(record);
+      return true;
+    }
+
+    /* Advance past the bytes the kernel accepted. */
+    size_t remaining = static_cast<size_t>(sent_length);
+    while (remaining > 0) {
+      size_t left_in_slice =
+          GRPC_SLICE_LENGTH(record->buf.slices[record->slice_idx]) -
+          record->byte_idx;
+      if (remaining < left_in_slice) {
+        record->byte_idx += remaining;
+        break;
+      }
+      remaining -= left_in_slice;
+      record->slice_idx++;
+      record->byte_idx = 0;
+    }
+    if (record->slice_idx == record->buf.count) {
+      *error = GRPC_ERROR_NONE;
+      tcp->current_zerocopy_send = nullptr;
+      tcp->zerocopy_ctx->Unref(record);
+      return true;
+    }
+  }
+}
+
 static void tcp_handle_write(void* arg /* grpc_tcp */, grpc_error* error) {
   grpc_tcp* tcp = static_cast<grpc_tcp*>(arg);
   grpc_closure* cb;
 
   if (error != GRPC_ERROR_NONE) {
+    if (tcp->current_zerocopy_send != nullptr) {
+      tcp->zerocopy_ctx->Unref(tcp->current_zerocopy_send);
+      tcp->current_zerocopy_send = nullptr;
+    }
     cb = tcp->write_cb;
     tcp->write_cb = nullptr;
     GRPC_CLOSURE_SCHED(cb, GRPC_ERROR_REF(error));
@@ -1029,7 +1439,10 @@ static void tcp_handle_write(void* arg /* grpc_tcp */, grpc_error* error) {
     return;
   }
 
-  if (!tcp_flush(tcp, &error)) {
+  bool flush_result = tcp->current_zerocopy_send != nullptr
+                          ? tcp_flush_zerocopy(tcp, &error)
+                          : tcp_flush(tcp, &error);
+  if (!flush_result) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
       gpr_log(GPR_INFO, "write: delayed");
     }
@@ -1087,7 +1500,20 @@ static void tcp_write(grpc_endpoint* ep, grpc_slice_buffer* buf,
     GPR_ASSERT(grpc_event_engine_can_track_errors());
   }
 
-  if (!tcp_flush(tcp, &error)) {
+  bool flush_result;
+  if (tcp->zerocopy_ctx != nullptr && arg == nullptr &&
+      buf->length >= tcp->zerocopy_ctx->threshold()) {
+    tcp->current_zerocopy_send = tcp->zerocopy_ctx->StartSend(buf);
+    if (tcp->current_zerocopy_send == nullptr) {
+      GRPC_STATS_INC_TCP_ZEROCOPY_FALLBACKS();
+    }
+  }
+  if (tcp->current_zerocopy_send != nullptr) {
+    flush_result = tcp_flush_zerocopy(tcp, &error);
+  } else {
+    flush_result = tcp_flush(tcp, &error);
+  }
+  if (!flush_result) {
     TCP_REF(tcp, "write");
     tcp->write_cb = cb;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
@@ -1164,6 +1590,8 @@ static const grpc_endpoint_vtable vtable = {tcp_read,
                                             tcp_can_track_err};
 
 #define MAX_CHUNK_SIZE 32 * 1024 * 1024
+#define DEFAULT_ZEROCOPY_SEND_BYTES_THRESHOLD 16 * 1024
+#define DEFAULT_ZEROCOPY_MAX_SIMULT_SENDS 4
 
 grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
                                const grpc_channel_args* channel_args,
@@ -1171,6 +1599,10 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   int tcp_read_chunk_size = GRPC_TCP_DEFAULT_READ_SLICE_SIZE;
   int tcp_max_read_chunk_size = 4 * 1024 * 1024;
   int tcp_min_read_chunk_size = 256;
+  bool tcp_tx_zerocopy_enabled = false;
+  int tcp_tx_zerocopy_send_bytes_threshold =
+      DEFAULT_ZEROCOPY_SEND_BYTES_THRESHOLD;
+  int tcp_tx_zerocopy_max_simult_sends = DEFAULT_ZEROCOPY_MAX_SIMULT_SENDS;
   grpc_resource_quota* resource_quota = grpc_resource_quota_create(nullptr);
   if (channel_args != nullptr) {
     for (size_t i = 0; i < channel_args->num_args; i++) {
@@ -1195,6 +1627,22 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
         resource_quota =
             grpc_resource_quota_ref_internal(static_cast<grpc_resource_quota*>(
                 channel_args->args[i].value.pointer.p));
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED)) {
+        tcp_tx_zerocopy_enabled =
+            grpc_channel_arg_get_bool(&channel_args->args[i], false);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD)) {
+        grpc_integer_options options = {DEFAULT_ZEROCOPY_SEND_BYTES_THRESHOLD,
+                                        0, INT_MAX};
+        tcp_tx_zerocopy_send_bytes_threshold =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS)) {
+        grpc_integer_options options = {DEFAULT_ZEROCOPY_MAX_SIMULT_SENDS, 1,
+                                        INT_MAX};
+        tcp_tx_zerocopy_max_simult_sends =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
       }
     }
   }
@@ -1224,11 +1672,14 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   tcp->socket_ts_enabled = false;
   tcp->ts_capable = true;
   tcp->outgoing_buffer_arg = nullptr;
+  tcp->zerocopy_ctx = nullptr;
+  tcp->current_zerocopy_send = nullptr;
   /* paired with unref in grpc_tcp_destroy */
   new (&tcp->refcount) grpc_core::RefCount(1, &grpc_tcp_trace);
   gpr_atm_no_barrier_store(&tcp->shutdown_count, 0);
   tcp->em_fd = em_fd;
-  grpc_slice_buffer_init(&tcp->last_read_buffer);
+  grpc_slice_buffer_init(&tcp->read_slab);
+  tcp->read_slab_offset = 0;
   tcp->resource_user = grpc_resource_user_create(resource_quota, peer_string);
   grpc_resource_user_slice_allocator_init(
       &tcp->slice_allocator, tcp->resource_user, tcp_read_allocation_done, tcp);
@@ -1270,6 +1721,22 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
     GRPC_CLOSURE_INIT(&tcp->error_closure, tcp_handle_error, tcp,
                       grpc_schedule_on_exec_ctx);
     grpc_fd_notify_on_error(tcp->em_fd, &tcp->error_closure);
+#ifdef GRPC_LINUX_ERRQUEUE
+    /* Zerocopy completions are delivered on the error queue, so zerocopy can
+     * only be used when errors are being tracked. */
+    if (tcp_tx_zerocopy_enabled) {
+      int enable = 1;
+      if (setsockopt(tcp->fd, SOL_SOCKET, SO_ZEROCOPY, &enable,
+                     sizeof(enable)) == 0) {
+        tcp->zerocopy_ctx = grpc_core::New<ZerocopySendCtx>(
+            tcp_tx_zerocopy_max_simult_sends,
+            static_cast<size_t>(tcp_tx_zerocopy_send_bytes_threshold));
+      } else {
+        gpr_log(GPR_DEBUG, "cannot set zerocopy fd=%d errno=%d", tcp->fd,
+                errno);
+      }
+    }
+#endif /* GRPC_LINUX_ERRQUEUE */
   }
 
   return &tcp->base;
@@ -1287,7 +1754,7 @@ void grpc_tcp_destroy_and_release_fd(grpc_endpoint* ep, int* fd,
   GPR_ASSERT(ep->vtable == &vtable);
   tcp->release_fd = fd;
   tcp->release_fd_cb = done;
-  grpc_slice_buffer_reset_and_unref_internal(&tcp->last_read_buffer);
+  grpc_slice_buffer_reset_and_unref_internal(&tcp->read_slab);
   if (grpc_event_engine_can_track_errors()) {
     /* Stop errors notification. */
     gpr_atm_no_barrier_store(&tcp->stop_error_notification, true);
@@ -29,6 +29,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <string.h>
@@ -63,6 +64,7 @@ static grpc_error* tcp_server_create(grpc_closure* shutdown_complete,
       static_cast<grpc_tcp_server*>(gpr_zalloc(sizeof(grpc_tcp_server)));
   s->so_reuseport = grpc_is_socket_reuse_port_supported();
   s->expand_wildcard_addrs = false;
+  gpr_atm_no_barrier_store(&s->busy_poll_us, 0);
   for (size_t i = 0; i < (args == nullptr ? 0 : args->num_args); i++) {
     if (0 == strcmp(GRPC_ARG_ALLOW_REUSEPORT, args->args[i].key)) {
       if (args->args[i].type == GRPC_ARG_INTEGER) {
@@ -81,6 +83,11 @@ static grpc_error* tcp_server_create(grpc_closure* shutdown_complete,
         return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
             GRPC_ARG_EXPAND_WILDCARD_ADDRS " must be an integer");
       }
+    } else if (0 == strcmp(GRPC_ARG_TCP_BUSY_POLL_US, args->args[i].key)) {
+      grpc_integer_options options = {0, 0, INT_MAX};
+      gpr_atm_no_barrier_store(
+          &s->busy_poll_us,
+          grpc_channel_arg_get_integer(&args->args[i], options));
     }
   }
   gpr_ref_init(&s->refs, 1);
@@ -182,6 +189,22 @@ static void tcp_server_destroy(grpc_tcp_server* s) {
   }
 }
 
+/* apply GRPC_ARG_TCP_BUSY_POLL_US to an accepted socket. If that fails (e.g.
+   EPERM without CAP_NET_ADMIN), it would fail for every connection: log it
+   once and stop trying for this server */
+static void set_busy_poll_if_requested(grpc_tcp_server* s, int fd) {
+  const gpr_atm busy_poll_us = gpr_atm_no_barrier_load(&s->busy_poll_us);
+  if (busy_poll_us == 0) return;
+  grpc_error* err =
+      grpc_set_socket_busy_poll(fd, static_cast<int>(busy_poll_us));
+  if (err == GRPC_ERROR_NONE) return;
+  if (gpr_atm_no_barrier_cas(&s->busy_poll_us, busy_poll_us, 0)) {
+    const char* msg = grpc_error_string(err);
+    gpr_log(GPR_ERROR, "Disabling SO_BUSY_POLL on accepted sockets: %s", msg);
+  }
+  GRPC_ERROR_UNREF(err);
+}
+
 /* event manager callback when reads are ready */
 static void on_read(void* arg, grpc_error* err) {
   grpc_tcp_listener* sp = static_cast<grpc_tcp_listener*>(arg);
@@ -234,6 +257,7 @@ static void on_read(void* arg, grpc_error* err) {
     }
 
     grpc_set_socket_no_sigpipe_if_possible(fd);
+    set_busy_poll_if_requested(sp->server, fd);
 
     addr_str = grpc_sockaddr_to_uri(&addr);
     gpr_asprintf(&name, "tcp-server-connection:%s", addr_str);
@@ -588,6 +612,7 @@ class ExternalConnectionHandler : public grpc_core::TcpServerFdHandler {
       return;
     }
     grpc_set_socket_no_sigpipe_if_possible(fd);
+    set_busy_poll_if_requested(s_, fd);
     addr_str = grpc_sockaddr_to_uri(&addr);
     gpr_asprintf(&name, "tcp-server-connection:%s", addr_str);
     if (grpc_tcp_trace.enabled()) {
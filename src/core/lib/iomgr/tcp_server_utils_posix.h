@@ -70,6 +70,9 @@ struct grpc_tcp_server {
   bool so_reuseport;
   /* expand wildcard addresses to a list of all local addresses */
   bool expand_wildcard_addrs;
+  /* SO_BUSY_POLL value (usec) for accepted sockets, 0 to leave it unset.
+     Cleared when setting it fails, so that the failure is only logged once */
+  gpr_atm busy_poll_us;
 
   /* linked list of server ports */
   grpc_tcp_listener* head;
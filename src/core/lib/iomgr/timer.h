@@ -124,4 +124,9 @@ void grpc_kick_poller(void);
 /* Sets the timer implementation */
 void grpc_set_timer_impl(grpc_timer_vtable* vtable);
 
+/* Returns the timer implementation selected by the GRPC_TIMER_IMPL
+   environment variable: the sharded heaps of timer_generic.cc by default, or
+   the hierarchical timing wheels of timer_wheel.cc */
+grpc_timer_vtable* grpc_default_timer_impl(void);
+
 #endif /* GRPC_CORE_LIB_IOMGR_TIMER_H */
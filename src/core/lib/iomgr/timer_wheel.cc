@@ -0,0 +1,441 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "src/core/lib/iomgr/timer.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/atomic.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+/* Hierarchical timing wheels (Varghese & Lauck). Level 0 has one slot per
+ * millisecond, and each further level has slots WHEEL_SLOTS times as wide as
+ * the level below. A timer is placed in the lowest level whose current
+ * rotation contains its deadline, so adding and cancelling a timer is O(1).
+ * When the wheel time reaches a slot of a higher level, the timers in it are
+ * cascaded down into lower levels. Timers due further out than the top level
+ * can reach (about two years) wait in an unordered overflow list. */
+
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_LEVELS 6
+/* Value of grpc_timer.heap_index for timers in the overflow list. Other timers
+   store level * WHEEL_SLOTS + slot there. */
+#define OVERFLOW_INDEX 0xffffffffu
+
+extern grpc_core::TraceFlag grpc_timer_trace;
+extern grpc_core::TraceFlag grpc_timer_check_trace;
+
+typedef struct {
+  gpr_mu mu;
+  /* Time the wheel has been advanced to: every timer due before this has
+     fired. */
+  grpc_millis now;
+  /* Lower bound for the time the next timer in this shard is due. */
+  grpc_millis next_deadline;
+  /* Bit i of occupied[l] is set if and only if slots[l][i] is not empty. */
+  uint64_t occupied[WHEEL_LEVELS];
+  /* Doubly linked lists of timers, with a null prev for the first timer. */
+  grpc_timer* slots[WHEEL_LEVELS][WHEEL_SLOTS];
+  grpc_timer* overflow;
+  /* Lower bound for the deadlines in the overflow list. */
+  grpc_millis overflow_min_deadline;
+} wheel_shard;
+
+static size_t g_num_shards;
+
+/* Array of timer shards. Whenever a timer (grpc_timer *) is added, its address
+ * is hashed to select the timer shard to add the timer to */
+static wheel_shard* g_shards;
+
+static struct {
+  /* The minimum of the next_deadline of all shards */
+  grpc_core::Atomic<grpc_millis> min_deadline;
+  /* Allow only one timer check at once */
+  gpr_spinlock checker_mu;
+  bool initialized;
+  /* Protects min_deadline updates */
+  gpr_mu mu;
+} g_wheel;
+
+static int lowest_set_bit(uint64_t bits) {
+  uint32_t low = static_cast<uint32_t>(bits);
+  if (low != 0) {
+    return GPR_BITCOUNT((low & (~low + 1)) - 1);
+  }
+  uint32_t high = static_cast<uint32_t>(bits >> 32);
+  return 32 + GPR_BITCOUNT((high & (~high + 1)) - 1);
+}
+
+/* Returns the level of the wheel whose current rotation (as of now) contains
+   deadline, or WHEEL_LEVELS if it is beyond all of them. */
+static int level_for_deadline(grpc_millis now, grpc_millis deadline) {
+  uint64_t diff =
+      (static_cast<uint64_t>(deadline) ^ static_cast<uint64_t>(now)) >>
+      WHEEL_BITS;
+  int level = 0;
+  while (diff != 0 && level < WHEEL_LEVELS) {
+    diff >>= WHEEL_BITS;
+    level++;
+  }
+  return level;
+}
+
+static grpc_millis slot_start(grpc_millis now, int level, int slot) {
+  uint64_t rotation_mask =
+      ~((static_cast<uint64_t>(1) << (WHEEL_BITS * (level + 1))) - 1);
+  return static_cast<grpc_millis>(
+      (static_cast<uint64_t>(now) & rotation_mask) +
+      (static_cast<uint64_t>(slot) << (WHEEL_BITS * level)));
+}
+
+static void list_push(grpc_timer** head, grpc_timer* timer) {
+  timer->prev = nullptr;
+  timer->next = *head;
+  if (*head != nullptr) (*head)->prev = timer;
+  *head = timer;
+}
+
+static void list_remove(grpc_timer** head, grpc_timer* timer) {
+  if (timer->prev != nullptr) {
+    timer->prev->next = timer->next;
+  } else {
+    *head = timer->next;
+  }
+  if (timer->next != nullptr) timer->next->prev = timer->prev;
+}
+
+/* REQUIRES: shard->mu locked, timer->deadline >= shard->now */
+static void wheel_add(wheel_shard* shard, grpc_timer* timer) {
+  int level = level_for_deadline(shard->now, timer->deadline);
+  if (level == WHEEL_LEVELS) {
+    timer->heap_index = OVERFLOW_INDEX;
+    list_push(&shard->overflow, timer);
+    shard->overflow_min_deadline =
+        GPR_MIN(shard->overflow_min_deadline, timer->deadline);
+    return;
+  }
+  int slot = static_cast<int>(
+      (static_cast<uint64_t>(timer->deadline) >> (WHEEL_BITS * level)) &
+      (WHEEL_SLOTS - 1));
+  timer->heap_index = static_cast<uint32_t>(level * WHEEL_SLOTS + slot);
+  list_push(&shard->slots[level][slot], timer);
+  shard->occupied[level] |= static_cast<uint64_t>(1) << slot;
+}
+
+/* REQUIRES: shard->mu locked */
+static void wheel_remove(wheel_shard* shard, grpc_timer* timer) {
+  if (timer->heap_index == OVERFLOW_INDEX) {
+    list_remove(&shard->overflow, timer);
+    if (shard->overflow == nullptr) {
+      shard->overflow_min_deadline = GRPC_MILLIS_INF_FUTURE;
+    }
+    return;
+  }
+  int level = static_cast<int>(timer->heap_index / WHEEL_SLOTS);
+  int slot = static_cast<int>(timer->heap_index % WHEEL_SLOTS);
+  list_remove(&shard->slots[level][slot], timer);
+  if (shard->slots[level][slot] == nullptr) {
+    shard->occupied[level] &= ~(static_cast<uint64_t>(1) << slot);
+  }
+}
+
+/* Finds the non-empty slot that the wheel reaches first and returns the time
+   it does so. *level is set to WHEEL_LEVELS for the overflow list.
+   REQUIRES: shard->mu locked */
+static grpc_millis next_slot(wheel_shard* shard, int* level, int* slot) {
+  grpc_millis next = GRPC_MILLIS_INF_FUTURE;
+  for (int l = 0; l < WHEEL_LEVELS; l++) {
+    if (shard->occupied[l] == 0) continue;
+    int now_slot = static_cast<int>(
+        (static_cast<uint64_t>(shard->now) >> (WHEEL_BITS * l)) &
+        (WHEEL_SLOTS - 1));
+    /* Slots before now_slot have been processed for this rotation, and no
+       timer is ever placed in a later rotation of the same level. */
+    uint64_t ahead =
+        shard->occupied[l] & (~static_cast<uint64_t>(0) << now_slot);
+    GPR_DEBUG_ASSERT(ahead != 0);
+    int s = lowest_set_bit(ahead);
+    grpc_millis start = slot_start(shard->now, l, s);
+    if (start < next) {
+      next = start;
+      *level = l;
+      *slot = s;
+    }
+  }
+  if (shard->overflow != nullptr) {
+    grpc_millis start =
+        slot_start(shard->overflow_min_deadline, WHEEL_LEVELS - 1, 0);
+    if (start < next) {
+      next = start;
+      *level = WHEEL_LEVELS;
+      *slot = 0;
+    }
+  }
+  return next;
+}
+
+/* Fires every timer due at or before now, cascading the timers of the higher
+   level slots passed on the way. Returns the number of timers fired.
+   REQUIRES: shard->mu locked */
+static size_t wheel_advance(wheel_shard* shard, grpc_millis now,
+                            grpc_error* error) {
+  size_t n = 0;
+  int level = 0;
+  int slot = 0;
+  for (;;) {
+    grpc_millis start = next_slot(shard, &level, &slot);
+    if (start > now) break;
+    shard->now = GPR_MAX(shard->now, start);
+    grpc_timer* timer;
+    if (level == WHEEL_LEVELS) {
+      timer = shard->overflow;
+      shard->overflow = nullptr;
+      shard->overflow_min_deadline = GRPC_MILLIS_INF_FUTURE;
+    } else {
+      timer = shard->slots[level][slot];
+      shard->slots[level][slot] = nullptr;
+      shard->occupied[level] &= ~(static_cast<uint64_t>(1) << slot);
+    }
+    while (timer != nullptr) {
+      grpc_timer* next = timer->next;
+      if (timer->deadline <= now) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+          gpr_log(GPR_INFO,
+                  "TIMER %p: FIRE %" PRId64 "ms late via %s scheduler", timer,
+                  now - timer->deadline,
+                  timer->closure->scheduler->vtable->name);
+        }
+        timer->pending = false;
+        GRPC_CLOSURE_SCHED(timer->closure, GRPC_ERROR_REF(error));
+        n++;
+      } else {
+        wheel_add(shard, timer);
+      }
+      timer = next;
+    }
+  }
+  shard->now = GPR_MAX(shard->now, now);
+  return n;
+}
+
+/* Fires every timer in the shard with the given error.
+   REQUIRES: shard->mu locked */
+static void wheel_drain(wheel_shard* shard, grpc_error* error) {
+  for (int l = 0; l <= WHEEL_LEVELS; l++) {
+    for (int s = 0; s < (l == WHEEL_LEVELS ? 1 : WHEEL_SLOTS); s++) {
+      grpc_timer** head =
+          l == WHEEL_LEVELS ? &shard->overflow : &shard->slots[l][s];
+      for (grpc_timer* timer = *head; timer != nullptr;) {
+        grpc_timer* next = timer->next;
+        timer->pending = false;
+        GRPC_CLOSURE_SCHED(timer->closure, GRPC_ERROR_REF(error));
+        timer = next;
+      }
+      *head = nullptr;
+    }
+  }
+  memset(shard->occupied, 0, sizeof(shard->occupied));
+  shard->overflow_min_deadline = GRPC_MILLIS_INF_FUTURE;
+  shard->next_deadline = GRPC_MILLIS_INF_FUTURE;
+}
+
+static void timer_list_init() {
+  g_num_shards = GPR_CLAMP(2 * gpr_cpu_num_cores(), 1, 32);
+  g_shards =
+      static_cast<wheel_shard*>(gpr_zalloc(g_num_shards * sizeof(*g_shards)));
+
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  g_wheel.initialized = true;
+  g_wheel.checker_mu = GPR_SPINLOCK_INITIALIZER;
+  gpr_mu_init(&g_wheel.mu);
+  g_wheel.min_deadline.Store(GRPC_MILLIS_INF_FUTURE,
+                             grpc_core::MemoryOrder::RELAXED);
+
+  for (size_t i = 0; i < g_num_shards; i++) {
+    wheel_shard* shard = &g_shards[i];
+    gpr_mu_init(&shard->mu);
+    shard->now = now;
+    shard->next_deadline = GRPC_MILLIS_INF_FUTURE;
+    shard->overflow_min_deadline = GRPC_MILLIS_INF_FUTURE;
+  }
+}
+
+static void timer_list_shutdown() {
+  grpc_error* error =
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Timer list shutdown");
+  for (size_t i = 0; i < g_num_shards; i++) {
+    wheel_shard* shard = &g_shards[i];
+    gpr_mu_lock(&shard->mu);
+    wheel_drain(shard, error);
+    gpr_mu_unlock(&shard->mu);
+    gpr_mu_destroy(&shard->mu);
+  }
+  GRPC_ERROR_UNREF(error);
+  gpr_mu_destroy(&g_wheel.mu);
+  gpr_free(g_shards);
+  g_wheel.initialized = false;
+}
+
+static void timer_init(grpc_timer* timer, grpc_millis deadline,
+                       grpc_closure* closure) {
+  wheel_shard* shard = &g_shards[GPR_HASH_POINTER(timer, g_num_shards)];
+  timer->closure = closure;
+  timer->deadline = deadline;
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: SET %" PRId64 " now %" PRId64 " call %p[%p]",
+            timer, deadline, grpc_core::ExecCtx::Get()->Now(), closure,
+            closure->cb);
+  }
+
+  if (!g_wheel.initialized) {
+    timer->pending = false;
+    GRPC_CLOSURE_SCHED(timer->closure,
+                       GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                           "Attempt to create timer before initialization"));
+    return;
+  }
+
+  gpr_mu_lock(&shard->mu);
+  timer->pending = true;
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  /* The wheel may have been advanced past this thread's view of now */
+  if (deadline <= now || deadline < shard->now) {
+    timer->pending = false;
+    GRPC_CLOSURE_SCHED(timer->closure, GRPC_ERROR_NONE);
+    gpr_mu_unlock(&shard->mu);
+    /* early out */
+    return;
+  }
+  wheel_add(shard, timer);
+  bool is_first_timer = deadline < shard->next_deadline;
+  if (is_first_timer) shard->next_deadline = deadline;
+  gpr_mu_unlock(&shard->mu);
+
+  /* As in timer_generic.cc, a concurrent timer_check may recompute the global
+     minimum in between; g_wheel.mu makes sure the lower deadline sticks. */
+  if (is_first_timer) {
+    gpr_mu_lock(&g_wheel.mu);
+    if (deadline <
+        g_wheel.min_deadline.Load(grpc_core::MemoryOrder::RELAXED)) {
+      g_wheel.min_deadline.Store(deadline, grpc_core::MemoryOrder::RELAXED);
+      grpc_kick_poller();
+    }
+    gpr_mu_unlock(&g_wheel.mu);
+  }
+}
+
+static void timer_cancel(grpc_timer* timer) {
+  if (!g_wheel.initialized) {
+    /* must have already been cancelled, also the shard mutex is invalid */
+    return;
+  }
+
+  wheel_shard* shard = &g_shards[GPR_HASH_POINTER(timer, g_num_shards)];
+  gpr_mu_lock(&shard->mu);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=%s", timer,
+            timer->pending ? "true" : "false");
+  }
+
+  if (timer->pending) {
+    GRPC_CLOSURE_SCHED(timer->closure, GRPC_ERROR_CANCELLED);
+    timer->pending = false;
+    wheel_remove(shard, timer);
+  }
+  gpr_mu_unlock(&shard->mu);
+}
+
+static grpc_timer_check_result timer_check(grpc_millis* next) {
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  grpc_millis min_deadline =
+      g_wheel.min_deadline.Load(grpc_core::MemoryOrder::RELAXED);
+
+  if (now < min_deadline) {
+    if (next != nullptr) *next = GPR_MIN(*next, min_deadline);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+      gpr_log(GPR_INFO, "TIMER CHECK SKIP: now=%" PRId64 " min_timer=%" PRId64,
+              now, min_deadline);
+    }
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  if (!gpr_spinlock_trylock(&g_wheel.checker_mu)) {
+    return GRPC_TIMERS_NOT_CHECKED;
+  }
+
+  grpc_error* error =
+      now != GRPC_MILLIS_INF_FUTURE
+          ? GRPC_ERROR_NONE
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shutting down timer system");
+  grpc_timer_check_result result = GRPC_TIMERS_CHECKED_AND_EMPTY;
+  grpc_millis new_min_deadline = GRPC_MILLIS_INF_FUTURE;
+  gpr_mu_lock(&g_wheel.mu);
+  for (size_t i = 0; i < g_num_shards; i++) {
+    wheel_shard* shard = &g_shards[i];
+    gpr_mu_lock(&shard->mu);
+    if (shard->next_deadline <= now) {
+      size_t fired;
+      if (now == GRPC_MILLIS_INF_FUTURE) {
+        fired = 1;
+        wheel_drain(shard, error);
+      } else {
+        fired = wheel_advance(shard, now, error);
+        int level;
+        int slot;
+        shard->next_deadline = next_slot(shard, &level, &slot);
+      }
+      if (fired > 0) result = GRPC_TIMERS_FIRED;
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+        gpr_log(GPR_INFO,
+                "  .. shard[%d] popped %" PRIdPTR ", next_deadline=%" PRId64,
+                static_cast<int>(i), fired, shard->next_deadline);
+      }
+    }
+    new_min_deadline = GPR_MIN(new_min_deadline, shard->next_deadline);
+    gpr_mu_unlock(&shard->mu);
+  }
+  g_wheel.min_deadline.Store(new_min_deadline,
+                             grpc_core::MemoryOrder::RELAXED);
+  gpr_mu_unlock(&g_wheel.mu);
+  gpr_spinlock_unlock(&g_wheel.checker_mu);
+  GRPC_ERROR_UNREF(error);
+
+  if (next != nullptr) *next = GPR_MIN(*next, new_min_deadline);
+  return result;
+}
+
+static void timer_consume_kick(void) {}
+
+grpc_timer_vtable grpc_wheel_timer_vtable = {
+    timer_init,      timer_cancel,        timer_check,
+    timer_list_init, timer_list_shutdown, timer_consume_kick};
@@ -52,6 +52,7 @@
 #include <grpc/support/time.h>
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/inlined_vector.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/error.h"
@@ -746,4 +747,113 @@ void GrpcUdpListener::OnDestroy() {
   }
 }
 
+#ifdef GRPC_LINUX_MMSG
+struct GrpcUdpBatchIo::Message : public mmsghdr {};
+#else
+struct GrpcUdpBatchIo::Message {
+  struct msghdr msg_hdr;
+  unsigned int msg_len;
+};
+#endif
+
+GrpcUdpBatchIo::GrpcUdpBatchIo(size_t batch_size, size_t max_datagram_size)
+    : batch_size_(batch_size), max_datagram_size_(max_datagram_size) {
+  GPR_ASSERT(batch_size > 0);
+  buffers_ = static_cast<uint8_t*>(gpr_malloc(batch_size * max_datagram_size));
+  received_ = static_cast<GrpcUdpDatagram*>(
+      gpr_zalloc(batch_size * sizeof(*received_)));
+  messages_ =
+      static_cast<Message*>(gpr_zalloc(batch_size * sizeof(*messages_)));
+  iovs_ = static_cast<struct iovec*>(gpr_zalloc(batch_size * sizeof(*iovs_)));
+  for (size_t i = 0; i < batch_size; i++) {
+    received_[i].data = buffers_ + i * max_datagram_size;
+  }
+}
+
+GrpcUdpBatchIo::~GrpcUdpBatchIo() {
+  gpr_free(iovs_);
+  gpr_free(messages_);
+  gpr_free(received_);
+  gpr_free(buffers_);
+}
+
+int GrpcUdpBatchIo::RecvBatch(int fd) {
+  for (size_t i = 0; i < batch_size_; i++) {
+    iovs_[i].iov_base = received_[i].data;
+    iovs_[i].iov_len = max_datagram_size_;
+    struct msghdr* hdr = &messages_[i].msg_hdr;
+    memset(hdr, 0, sizeof(*hdr));
+    hdr->msg_name = received_[i].addr.addr;
+    hdr->msg_namelen = sizeof(received_[i].addr.addr);
+    hdr->msg_iov = &iovs_[i];
+    hdr->msg_iovlen = 1;
+  }
+  int count;
+#ifdef GRPC_LINUX_MMSG
+  do {
+    count = recvmmsg(fd, messages_, static_cast<unsigned int>(batch_size_), 0,
+                     nullptr);
+  } while (count < 0 && errno == EINTR);
+#else
+  for (count = 0; static_cast<size_t>(count) < batch_size_; count++) {
+    ssize_t bytes;
+    do {
+      bytes = recvmsg(fd, &messages_[count].msg_hdr, 0);
+    } while (bytes < 0 && errno == EINTR);
+    if (bytes < 0) {
+      if (count == 0) count = -1;
+      break;
+    }
+    messages_[count].msg_len = static_cast<unsigned int>(bytes);
+  }
+#endif
+  if (count < 0) {
+    return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+  }
+  for (int i = 0; i < count; i++) {
+    received_[i].addr.len = messages_[i].msg_hdr.msg_namelen;
+    received_[i].length =
+        GPR_MIN(static_cast<size_t>(messages_[i].msg_len), max_datagram_size_);
+  }
+  return count;
+}
+
+int GrpcUdpBatchIo::SendBatch(int fd, const GrpcUdpDatagram* datagrams,
+                              size_t count) {
+  count = GPR_MIN(count, batch_size_);
+  for (size_t i = 0; i < count; i++) {
+    iovs_[i].iov_base = datagrams[i].data;
+    iovs_[i].iov_len = datagrams[i].length;
+    struct msghdr* hdr = &messages_[i].msg_hdr;
+    memset(hdr, 0, sizeof(*hdr));
+    if (datagrams[i].addr.len > 0) {
+      hdr->msg_name = const_cast<char*>(datagrams[i].addr.addr);
+      hdr->msg_namelen = datagrams[i].addr.len;
+    }
+    hdr->msg_iov = &iovs_[i];
+    hdr->msg_iovlen = 1;
+  }
+  int sent;
+#ifdef GRPC_LINUX_MMSG
+  do {
+    sent = sendmmsg(fd, messages_, static_cast<unsigned int>(count), 0);
+  } while (sent < 0 && errno == EINTR);
+#else
+  for (sent = 0; static_cast<size_t>(sent) < count; sent++) {
+    ssize_t bytes;
+    do {
+      bytes = sendmsg(fd, &messages_[sent].msg_hdr, 0);
+    } while (bytes < 0 && errno == EINTR);
+    if (bytes < 0) {
+      if (sent == 0) sent = -1;
+      break;
+    }
+  }
+#endif
+  if (sent < 0) {
+    return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+  }
+  return sent;
+}
+
 #endif
@@ -45,7 +45,8 @@ class GrpcUdpHandler {
   // or I/O.
 
   // Called when data is available to read from the socket. Returns true if
-  // there is more data to read after this call.
+  // there is more data to read after this call. Implementations can use
+  // GrpcUdpBatchIo to read several datagrams per call.
   virtual bool Read() = 0;
   // Called when socket becomes write unblocked. The given closure should be
   // scheduled when the socket becomes blocked next time.
@@ -58,6 +59,50 @@ class GrpcUdpHandler {
                                  void* user_data) = 0;
 };
 
+/* A datagram received or to be sent through GrpcUdpBatchIo. */
+struct GrpcUdpDatagram {
+  /* Source address of a received datagram. Destination address of a datagram
+   * to send, or empty (len == 0) to send on a connected socket. */
+  grpc_resolved_address addr;
+  uint8_t* data;
+  size_t length;
+};
+
+/* Batched datagram I/O for GrpcUdpHandler implementations: receives and sends
+ * up to batch_size datagrams per syscall with recvmmsg/sendmmsg where the
+ * platform has them, or with one recvmsg/sendmsg per datagram otherwise.
+ * Received datagrams land in a ring of batch_size buffers of max_datagram_size
+ * bytes each, allocated once and reused by every RecvBatch() call. */
+class GrpcUdpBatchIo {
+ public:
+  GrpcUdpBatchIo(size_t batch_size, size_t max_datagram_size);
+  ~GrpcUdpBatchIo();
+
+  /* Receives up to batch_size pending datagrams from the non-blocking socket
+   * fd. Returns how many were received, 0 if none was pending or -1 on error
+   * (with errno set). Received datagrams can be accessed with datagram() until
+   * the next call; datagrams longer than max_datagram_size are truncated. */
+  int RecvBatch(int fd);
+  const GrpcUdpDatagram& datagram(size_t i) const { return received_[i]; }
+
+  /* Sends up to batch_size of the count given datagrams on the non-blocking
+   * socket fd. Returns how many were sent, 0 if the socket would block or -1
+   * on error (with errno set). */
+  int SendBatch(int fd, const GrpcUdpDatagram* datagrams, size_t count);
+
+  size_t batch_size() const { return batch_size_; }
+
+ private:
+  struct Message;
+
+  size_t batch_size_;
+  size_t max_datagram_size_;
+  uint8_t* buffers_;
+  GrpcUdpDatagram* received_;
+  Message* messages_;
+  struct iovec* iovs_;
+};
+
 class GrpcUdpHandlerFactory {
  public:
   virtual ~GrpcUdpHandlerFactory() {}
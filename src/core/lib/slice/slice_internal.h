@@ -161,6 +161,10 @@ struct grpc_slice_refcount {
     }
   }
 
+  // Returns true if the caller holds the only reference to a refcounted slice,
+  // meaning that nobody else can be reading its bytes.
+  bool IsUnique() const { return ref_ != nullptr && ref_->IsUnique(); }
+
   grpc_slice_refcount* sub_refcount() const { return sub_refcount_; }
 
  private:
@@ -110,6 +110,13 @@ struct batch_control {
   }
 };
 
+/* A recv_message op that the call starts by itself, to receive the messages
+   after the first one of a batch with GRPC_RECV_MESSAGE_BATCH */
+struct next_message_op {
+  grpc_transport_stream_op_batch op;
+  grpc_closure start_batch;
+};
+
 struct parent_call {
   parent_call() { gpr_mu_init(&child_list_mu); }
   ~parent_call() { gpr_mu_destroy(&child_list_mu); }
@@ -219,6 +226,14 @@ struct grpc_call {
 
   grpc_core::OrphanablePtr<grpc_core::ByteStream> receiving_stream;
   grpc_byte_buffer** receiving_buffer = nullptr;
+  /* With GRPC_RECV_MESSAGE_BATCH: the array receiving_buffer moves along,
+     where the number of messages received goes, room for how many more there
+     is, and whether the transport holds the next one in full already */
+  grpc_byte_buffer** receiving_buffers = nullptr;
+  size_t* receiving_message_count = nullptr;
+  size_t receiving_buffers_left = 0;
+  bool receiving_next_message_available = false;
+  next_message_op* receiving_next_message_op = nullptr;
   grpc_slice receiving_slice = grpc_empty_slice();
   grpc_closure receiving_slice_ready;
   grpc_closure receiving_stream_ready;
@@ -342,7 +357,8 @@ grpc_error* grpc_call_create(const grpc_call_create_args* args,
       call_and_stack_size + (args->parent ? sizeof(child_call) : 0);
 
   std::pair<grpc_core::Arena*, void*> arena_with_call =
-      grpc_core::Arena::CreateWithAlloc(initial_size, call_alloc_size);
+      grpc_channel_create_call_arena(args->channel, initial_size,
+                                     call_alloc_size);
   arena = arena_with_call.first;
   call = new (arena_with_call.second) grpc_call(arena, *args);
   *out_call = call;
@@ -516,7 +532,7 @@ static void release_call(void* call, grpc_error* error) {
   grpc_channel* channel = c->channel;
   grpc_core::Arena* arena = c->arena;
   c->~grpc_call();
-  grpc_channel_update_call_size_estimate(channel, arena->Destroy());
+  grpc_channel_release_call_arena(channel, arena);
   GRPC_CHANNEL_INTERNAL_UNREF(channel, "call");
 }
 
@@ -901,7 +917,7 @@ static int prepare_application_metadata(grpc_call* call, int count,
     const grpc_metadata* md =
         get_md_elem(metadata, additional_metadata, i, count);
     grpc_linked_mdelem* l = linked_from_md(md);
-    GPR_ASSERT(sizeof(grpc_linked_mdelem) == sizeof(md->internal_data));
+    GPR_ASSERT(sizeof(grpc_linked_mdelem) <= sizeof(md->internal_data));
     if (!GRPC_LOG_IF_ERROR("validate_metadata",
                            grpc_validate_header_key_is_legal(md->key))) {
       break;
@@ -997,11 +1013,12 @@ static void publish_app_metadata(grpc_call* call, grpc_metadata_batch* b,
     dest->metadata = static_cast<grpc_metadata*>(
         gpr_realloc(dest->metadata, sizeof(grpc_metadata) * dest->capacity));
   }
-  for (grpc_linked_mdelem* l = b->list.head; l != nullptr; l = l->next) {
+  grpc_linked_mdelem* const* elems = grpc_metadata_batch_elems(b);
+  for (size_t i = 0; i < b->list.count; i++) {
     mdusr = &dest->metadata[dest->count++];
     /* we pass back borrowed slices that are valid whilst the call is valid */
-    mdusr->key = GRPC_MDKEY(l->md);
-    mdusr->value = GRPC_MDVALUE(l->md);
+    mdusr->key = GRPC_MDKEY(elems[i]->md);
+    mdusr->value = GRPC_MDVALUE(elems[i]->md);
   }
 }
 
@@ -1218,6 +1235,17 @@ static void post_batch_completion(batch_control* bctl) {
     grpc_byte_buffer_destroy(*call->receiving_buffer);
     *call->receiving_buffer = nullptr;
   }
+  if (error != GRPC_ERROR_NONE && bctl->op.recv_message &&
+      call->receiving_message_count != nullptr) {
+    /* nor are the messages received before it in a batch */
+    for (size_t i = 0; i < *call->receiving_message_count; i++) {
+      if (call->receiving_buffers[i] != nullptr) {
+        grpc_byte_buffer_destroy(call->receiving_buffers[i]);
+        call->receiving_buffers[i] = nullptr;
+      }
+    }
+    *call->receiving_message_count = 0;
+  }
   reset_batch_errors(bctl);
 
   if (bctl->completion_data.notify_tag.is_closure) {
@@ -1244,6 +1272,36 @@ static void finish_batch_step(batch_control* bctl) {
   }
 }
 
+// With GRPC_RECV_MESSAGE_BATCH, goes on to receive the message after the one
+// that was just received if the transport holds it in full already. Returns
+// false if the batch is done receiving.
+static bool receive_next_message_in_batch(batch_control* bctl) {
+  grpc_call* call = bctl->call;
+  if (call->receiving_message_count == nullptr) return false;
+  ++*call->receiving_message_count;
+  if (!call->receiving_next_message_available ||
+      call->receiving_buffers_left == 0) {
+    return false;
+  }
+  call->receiving_next_message_available = false;
+  --call->receiving_buffers_left;
+  ++call->receiving_buffer;
+  if (call->receiving_next_message_op == nullptr) {
+    call->receiving_next_message_op = call->arena->New<next_message_op>();
+  }
+  grpc_transport_stream_op_batch* op = &call->receiving_next_message_op->op;
+  *op = grpc_transport_stream_op_batch();
+  op->payload = &call->stream_op_payload;
+  op->recv_message = true;
+  /* filters below may have hooked the previous op's callback */
+  op->payload->recv_message.recv_message = &call->receiving_stream;
+  op->payload->recv_message.recv_message_ready = &call->receiving_stream_ready;
+  op->payload->recv_message.next_message_available =
+      &call->receiving_next_message_available;
+  execute_batch(call, op, &call->receiving_next_message_op->start_batch);
+  return true;
+}
+
 static void continue_receiving_slices(batch_control* bctl) {
   grpc_error* error;
   grpc_call* call = bctl->call;
@@ -1251,8 +1309,9 @@ static void continue_receiving_slices(batch_control* bctl) {
     size_t remaining = call->receiving_stream->length() -
                        (*call->receiving_buffer)->data.raw.slice_buffer.length;
     if (remaining == 0) {
-      call->receiving_message = 0;
       call->receiving_stream.reset();
+      if (receive_next_message_in_batch(bctl)) return;
+      call->receiving_message = 0;
       finish_batch_step(bctl);
       return;
     }
@@ -1824,8 +1883,8 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
         break;
       }
       case GRPC_OP_RECV_MESSAGE: {
-        /* Flag validation: currently allow no flags */
-        if (op->flags != 0) {
+        /* Flag validation: currently allow only GRPC_RECV_MESSAGE_BATCH */
+        if (op->flags & ~GRPC_RECV_MESSAGE_USED_MASK) {
           error = GRPC_CALL_ERROR_INVALID_FLAGS;
           goto done_with_error;
         }
@@ -1833,6 +1892,24 @@ static grpc_call_error call_start_batch(grpc_call* call, const grpc_op* ops,
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
         }
+        if (op->flags & GRPC_RECV_MESSAGE_BATCH) {
+          if (op->data.recv_message.max_messages == 0 ||
+              op->data.recv_message.message_count == nullptr) {
+            error = GRPC_CALL_ERROR;
+            goto done_with_error;
+          }
+          call->receiving_buffers = op->data.recv_message.recv_message;
+          call->receiving_message_count = op->data.recv_message.message_count;
+          *call->receiving_message_count = 0;
+          call->receiving_buffers_left =
+              op->data.recv_message.max_messages - 1;
+          call->receiving_next_message_available = false;
+          stream_op_payload->recv_message.next_message_available =
+              &call->receiving_next_message_available;
+        } else {
+          call->receiving_message_count = nullptr;
+          stream_op_payload->recv_message.next_message_available = nullptr;
+        }
         call->receiving_message = true;
         stream_op->recv_message = true;
         call->receiving_buffer = op->data.recv_message.recv_message;
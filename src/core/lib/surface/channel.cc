@@ -54,6 +54,8 @@
  *  (OK, Cancelled, Unknown). */
 #define NUM_CACHED_STATUS_ELEMS 3
 
+#define GRPC_CHANNEL_DEFAULT_CALL_ARENA_POOL_SIZE 4
+
 typedef struct registered_call {
   grpc_mdelem path;
   grpc_mdelem authority;
@@ -97,6 +99,9 @@ grpc_channel* grpc_channel_create_with_builder(
       &channel->call_size_estimate,
       (gpr_atm)CHANNEL_STACK_FROM_CHANNEL(channel)->call_stack_size +
           grpc_call_get_initial_size_estimate());
+  channel->call_arena_pool_lock = GPR_SPINLOCK_INITIALIZER;
+  channel->call_arena_pool_size = GRPC_CHANNEL_DEFAULT_CALL_ARENA_POOL_SIZE;
+  channel->call_arena_pool_count = 0;
 
   grpc_compression_options_init(&channel->compression_options);
   for (size_t i = 0; i < args->num_args; i++) {
@@ -121,6 +126,11 @@ grpc_channel* grpc_channel_create_with_builder(
       channel->compression_options.enabled_algorithms_bitset =
           static_cast<uint32_t>(args->args[i].value.integer) |
           0x1; /* always support no compression */
+    } else if (0 ==
+               strcmp(args->args[i].key, GRPC_ARG_CALL_ARENA_POOL_SIZE)) {
+      channel->call_arena_pool_size = grpc_channel_arg_get_integer(
+          &args->args[i], {GRPC_CHANNEL_DEFAULT_CALL_ARENA_POOL_SIZE, 0,
+                           GRPC_CHANNEL_MAX_CALL_ARENA_POOL_SIZE});
     } else if (0 == strcmp(args->args[i].key, GRPC_ARG_CHANNELZ_CHANNEL_NODE)) {
       GPR_ASSERT(args->args[i].type == GRPC_ARG_POINTER);
       GPR_ASSERT(args->args[i].value.pointer.p != nullptr);
@@ -325,6 +335,46 @@ void grpc_channel_update_call_size_estimate(grpc_channel* channel,
   }
 }
 
+std::pair<grpc_core::Arena*, void*> grpc_channel_create_call_arena(
+    grpc_channel* channel, size_t initial_size, size_t alloc_size) {
+  grpc_core::Arena* arena = nullptr;
+  if (channel->call_arena_pool_size > 0) {
+    gpr_spinlock_lock(&channel->call_arena_pool_lock);
+    if (channel->call_arena_pool_count > 0) {
+      arena = channel->call_arena_pool[--channel->call_arena_pool_count];
+    }
+    gpr_spinlock_unlock(&channel->call_arena_pool_lock);
+  }
+  if (arena != nullptr) {
+    /* only reuse arenas that fit the current estimate without wasting more
+       than the estimate itself */
+    size_t arena_size = arena->initial_zone_size();
+    if (arena_size >= initial_size && arena_size <= 2 * initial_size) {
+      GRPC_STATS_INC_CALL_ARENA_POOL_HITS();
+      return std::make_pair(arena, arena->Alloc(alloc_size));
+    }
+    arena->Destroy();
+  }
+  GRPC_STATS_INC_CALL_ARENA_POOL_MISSES();
+  return grpc_core::Arena::CreateWithAlloc(initial_size, alloc_size);
+}
+
+void grpc_channel_release_call_arena(grpc_channel* channel,
+                                     grpc_core::Arena* arena) {
+  grpc_channel_update_call_size_estimate(channel, arena->Reset());
+  /* an arena that overflowed is too small for the next call */
+  if (arena->initial_zone_size() >=
+      grpc_channel_get_call_size_estimate(channel)) {
+    gpr_spinlock_lock(&channel->call_arena_pool_lock);
+    if (channel->call_arena_pool_count < channel->call_arena_pool_size) {
+      channel->call_arena_pool[channel->call_arena_pool_count++] = arena;
+      arena = nullptr;
+    }
+    gpr_spinlock_unlock(&channel->call_arena_pool_lock);
+  }
+  if (arena != nullptr) arena->Destroy();
+}
+
 char* grpc_channel_get_target(grpc_channel* channel) {
   GRPC_API_TRACE("grpc_channel_get_target(channel=%p)", 1, (channel));
   return gpr_strdup(channel->target);
@@ -423,11 +473,15 @@ void* grpc_channel_register_call(grpc_channel* channel, const char* method,
   GPR_ASSERT(!reserved);
   grpc_core::ExecCtx exec_ctx;
 
-  rc->path = grpc_mdelem_from_slices(GRPC_MDSTR_PATH,
-                                     grpc_core::ExternallyManagedSlice(method));
+  // Interned, so that transports can index the headers of each registered
+  // method, and cache their encoding.
+  rc->path = grpc_mdelem_from_slices(
+      GRPC_MDSTR_PATH,
+      grpc_slice_intern(grpc_core::ExternallyManagedSlice(method)));
   rc->authority =
-      host ? grpc_mdelem_from_slices(GRPC_MDSTR_AUTHORITY,
-                                     grpc_core::ExternallyManagedSlice(host))
+      host ? grpc_mdelem_from_slices(
+                 GRPC_MDSTR_AUTHORITY,
+                 grpc_slice_intern(grpc_core::ExternallyManagedSlice(host)))
            : GRPC_MDNULL;
   gpr_mu_lock(&channel->registered_call_mu);
   rc->next = channel->registered_calls;
@@ -493,6 +547,9 @@ static void destroy_channel(void* arg, grpc_error* error) {
     grpc_resource_user_free(channel->resource_user,
                             GRPC_RESOURCE_QUOTA_CHANNEL_SIZE);
   }
+  for (size_t i = 0; i < channel->call_arena_pool_count; i++) {
+    channel->call_arena_pool[i]->Destroy();
+  }
   gpr_mu_destroy(&channel->registered_call_mu);
   gpr_free(channel->target);
   gpr_free(channel);
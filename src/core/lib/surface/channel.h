@@ -21,9 +21,13 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <utility>
+
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gprpp/arena.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 
 grpc_channel* grpc_channel_create(const char* target,
@@ -77,12 +81,30 @@ inline grpc_mdelem grpc_channel_get_reffed_status_elem(grpc_channel* channel,
 size_t grpc_channel_get_call_size_estimate(grpc_channel* channel);
 void grpc_channel_update_call_size_estimate(grpc_channel* channel, size_t size);
 
+/** Get an arena of at least \a initial_size bytes for a new call on \a
+    channel, along with the first \a alloc_size bytes allocated from it.
+    The arena of a finished call is reused when one is pooled. */
+std::pair<grpc_core::Arena*, void*> grpc_channel_create_call_arena(
+    grpc_channel* channel, size_t initial_size, size_t alloc_size);
+/** Give back the arena of a finished call: it feeds the call size estimate,
+    and is then pooled for a later call or destroyed. */
+void grpc_channel_release_call_arena(grpc_channel* channel,
+                                     grpc_core::Arena* arena);
+
+/** Upper bound of GRPC_ARG_CALL_ARENA_POOL_SIZE */
+#define GRPC_CHANNEL_MAX_CALL_ARENA_POOL_SIZE 16
+
 struct registered_call;
 struct grpc_channel {
   int is_client;
   grpc_compression_options compression_options;
 
   gpr_atm call_size_estimate;
+  /* arenas of finished calls, most recently released last */
+  gpr_spinlock call_arena_pool_lock;
+  size_t call_arena_pool_size;
+  size_t call_arena_pool_count;
+  grpc_core::Arena* call_arena_pool[GRPC_CHANNEL_MAX_CALL_ARENA_POOL_SIZE];
   grpc_resource_user* resource_user;
 
   gpr_mu registered_call_mu;
@@ -32,6 +32,7 @@
 #include "src/core/lib/channel/handshaker_registry.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/arena.h"
 #include "src/core/lib/gprpp/fork.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/http/parser.h"
@@ -143,6 +144,7 @@ void grpc_init(void) {
     grpc_security_pre_init();
     grpc_core::ApplicationCallbackExecCtx::GlobalInit();
     grpc_core::ExecCtx::GlobalInit();
+    grpc_core::Arena::GlobalInit();
     grpc_iomgr_init();
     gpr_timers_global_init();
     grpc_core::HandshakerRegistry::Init();
@@ -191,6 +193,7 @@ void grpc_shutdown_internal_locked(void) {
   }
   grpc_core::ExecCtx::GlobalShutdown();
   grpc_core::ApplicationCallbackExecCtx::GlobalShutdown();
+  grpc_core::Arena::GlobalShutdown();
   g_shutting_down = false;
   gpr_cv_broadcast(g_shutting_down_cv);
   // Absolute last action will be to delete static metadata context.
@@ -196,11 +196,31 @@ struct call_data {
   grpc_core::CallCombiner* call_combiner;
 };
 
+/* Requests made on one completion queue, and the calls that arrived on
+   channels polled by it and found no request to match. Each shard has its own
+   lock so that matching on different completion queues does not contend. */
+struct request_matcher_shard {
+  request_matcher_shard() { gpr_mu_init(&mu); }
+  ~request_matcher_shard() {
+    GPR_ASSERT(pending_head == nullptr);
+    gpr_mu_destroy(&mu);
+  }
+
+  LockedMultiProducerSingleConsumerQueue requests;
+  /* protects the pending list */
+  gpr_mu mu;
+  call_data* pending_head = nullptr;
+  call_data* pending_tail = nullptr;
+  /* number of calls on the pending list: read without the lock so that
+     request producers can skip idle shards */
+  gpr_atm pending_count = 0;
+  char padding[GPR_CACHELINE_SIZE];
+};
+
 struct request_matcher {
   grpc_server* server;
-  call_data* pending_head;
-  call_data* pending_tail;
-  LockedMultiProducerSingleConsumerQueue* requests_per_cq;
+  /* one shard per completion queue */
+  request_matcher_shard* shards;
 };
 
 struct registered_method {
@@ -232,7 +252,9 @@ struct grpc_server {
 
   /* The two following mutexes control access to server-state
      mu_global controls access to non-call-related state (e.g., channel state)
-     mu_call controls access to call-related state (e.g., the call lists)
+     mu_call serializes failing the call lists on shutdown (matching calls
+     with requests only takes the per completion queue request_matcher_shard
+     locks)
 
      If they are ever required to be nested, you must lock mu_global
      before mu_call. This is currently used in shutdown processing
@@ -351,20 +373,19 @@ static void channel_broadcaster_shutdown(channel_broadcaster* cb,
 
 static void request_matcher_init(request_matcher* rm, grpc_server* server) {
   rm->server = server;
-  rm->pending_head = rm->pending_tail = nullptr;
-  rm->requests_per_cq = static_cast<LockedMultiProducerSingleConsumerQueue*>(
-      gpr_malloc(sizeof(*rm->requests_per_cq) * server->cq_count));
+  rm->shards = static_cast<request_matcher_shard*>(
+      gpr_malloc(sizeof(*rm->shards) * server->cq_count));
   for (size_t i = 0; i < server->cq_count; i++) {
-    new (&rm->requests_per_cq[i]) LockedMultiProducerSingleConsumerQueue();
+    new (&rm->shards[i]) request_matcher_shard();
   }
 }
 
 static void request_matcher_destroy(request_matcher* rm) {
   for (size_t i = 0; i < rm->server->cq_count; i++) {
-    GPR_ASSERT(rm->requests_per_cq[i].Pop() == nullptr);
-    rm->requests_per_cq[i].~LockedMultiProducerSingleConsumerQueue();
+    GPR_ASSERT(rm->shards[i].requests.Pop() == nullptr);
+    rm->shards[i].~request_matcher_shard();
   }
-  gpr_free(rm->requests_per_cq);
+  gpr_free(rm->shards);
 }
 
 static void kill_zombie(void* elem, grpc_error* error) {
@@ -373,15 +394,21 @@ static void kill_zombie(void* elem, grpc_error* error) {
 }
 
 static void request_matcher_zombify_all_pending_calls(request_matcher* rm) {
-  while (rm->pending_head) {
-    call_data* calld = rm->pending_head;
-    rm->pending_head = calld->pending_next;
-    gpr_atm_no_barrier_store(&calld->state, ZOMBIED);
-    GRPC_CLOSURE_INIT(
-        &calld->kill_zombie_closure, kill_zombie,
-        grpc_call_stack_element(grpc_call_get_call_stack(calld->call), 0),
-        grpc_schedule_on_exec_ctx);
-    GRPC_CLOSURE_SCHED(&calld->kill_zombie_closure, GRPC_ERROR_NONE);
+  for (size_t i = 0; i < rm->server->cq_count; i++) {
+    request_matcher_shard* shard = &rm->shards[i];
+    gpr_mu_lock(&shard->mu);
+    while (shard->pending_head) {
+      call_data* calld = shard->pending_head;
+      shard->pending_head = calld->pending_next;
+      gpr_atm_no_barrier_fetch_add(&shard->pending_count, -1);
+      gpr_atm_no_barrier_store(&calld->state, ZOMBIED);
+      GRPC_CLOSURE_INIT(
+          &calld->kill_zombie_closure, kill_zombie,
+          grpc_call_stack_element(grpc_call_get_call_stack(calld->call), 0),
+          grpc_schedule_on_exec_ctx);
+      GRPC_CLOSURE_SCHED(&calld->kill_zombie_closure, GRPC_ERROR_NONE);
+    }
+    gpr_mu_unlock(&shard->mu);
   }
 }
 
@@ -391,7 +418,7 @@ static void request_matcher_kill_requests(grpc_server* server,
   requested_call* rc;
   for (size_t i = 0; i < server->cq_count; i++) {
     while ((rc = reinterpret_cast<requested_call*>(
-                rm->requests_per_cq[i].Pop())) != nullptr) {
+                rm->shards[i].requests.Pop())) != nullptr) {
       fail_call(server, i, rc, GRPC_ERROR_REF(error));
     }
   }
@@ -514,6 +541,39 @@ static void publish_call(grpc_server* server, call_data* calld, size_t cq_idx,
                  rc, &rc->completion, true);
 }
 
+/* Matches calls pending on shard with requests queued on cq_idx, until one of
+   them runs out. Returns the number of calls matched. */
+static size_t match_pending_calls(request_matcher* rm,
+                                  request_matcher_shard* shard,
+                                  size_t cq_idx) {
+  LockedMultiProducerSingleConsumerQueue* requests =
+      &rm->shards[cq_idx].requests;
+  size_t matched = 0;
+  gpr_mu_lock(&shard->mu);
+  call_data* calld;
+  while ((calld = shard->pending_head) != nullptr) {
+    requested_call* rc = reinterpret_cast<requested_call*>(requests->Pop());
+    if (rc == nullptr) break;
+    shard->pending_head = calld->pending_next;
+    gpr_atm_no_barrier_fetch_add(&shard->pending_count, -1);
+    gpr_mu_unlock(&shard->mu);
+    matched++;
+    if (!gpr_atm_full_cas(&calld->state, PENDING, ACTIVATED)) {
+      // Zombied Call
+      GRPC_CLOSURE_INIT(
+          &calld->kill_zombie_closure, kill_zombie,
+          grpc_call_stack_element(grpc_call_get_call_stack(calld->call), 0),
+          grpc_schedule_on_exec_ctx);
+      GRPC_CLOSURE_SCHED(&calld->kill_zombie_closure, GRPC_ERROR_NONE);
+    } else {
+      publish_call(rm->server, calld, cq_idx, rc);
+    }
+    gpr_mu_lock(&shard->mu);
+  }
+  gpr_mu_unlock(&shard->mu);
+  return matched;
+}
+
 static void publish_new_rpc(void* arg, grpc_error* error) {
   grpc_call_element* call_elem = static_cast<grpc_call_element*>(arg);
   call_data* calld = static_cast<call_data*>(call_elem->call_data);
@@ -534,7 +594,7 @@ static void publish_new_rpc(void* arg, grpc_error* error) {
   for (size_t i = 0; i < server->cq_count; i++) {
     size_t cq_idx = (chand->cq_idx + i) % server->cq_count;
     requested_call* rc =
-        reinterpret_cast<requested_call*>(rm->requests_per_cq[cq_idx].TryPop());
+        reinterpret_cast<requested_call*>(rm->shards[cq_idx].requests.TryPop());
     if (rc == nullptr) {
       continue;
     } else {
@@ -545,38 +605,44 @@ static void publish_new_rpc(void* arg, grpc_error* error) {
     }
   }
 
-  /* no cq to take the request found: queue it on the slow list */
+  /* no cq to take the request found: queue it on the slow list of the shard
+     this channel is polled by */
   GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED();
-  gpr_mu_lock(&server->mu_call);
+  const size_t home_cq_idx = chand->cq_idx;
+  request_matcher_shard* shard = &rm->shards[home_cq_idx];
+  // Once the call is on the list another thread may publish it: keep the
+  // server alive on our own until we are done looking for requests
+  server_ref(server);
+  gpr_atm_no_barrier_store(&calld->state, PENDING);
+  calld->pending_next = nullptr;
+  gpr_mu_lock(&shard->mu);
+  if (shard->pending_head == nullptr) {
+    shard->pending_tail = shard->pending_head = calld;
+  } else {
+    shard->pending_tail->pending_next = calld;
+    shard->pending_tail = calld;
+  }
+  gpr_atm_no_barrier_fetch_add(&shard->pending_count, 1);
+  gpr_mu_unlock(&shard->mu);
 
-  // We need to ensure that all the queues are empty.  We do this under
-  // the server mu_call lock to ensure that if something is added to
-  // an empty request queue, it will block until the call is actually
-  // added to the pending list.
+  // A request may have been queued on any shard since we last looked, by a
+  // producer that checked our pending count before the call was added.
+  // Either that producer sees the call, or we see its request here: the
+  // barrier pairs with the one in queue_call_request.
+  gpr_atm_full_barrier();
   for (size_t i = 0; i < server->cq_count; i++) {
-    size_t cq_idx = (chand->cq_idx + i) % server->cq_count;
-    requested_call* rc =
-        reinterpret_cast<requested_call*>(rm->requests_per_cq[cq_idx].Pop());
-    if (rc == nullptr) {
-      continue;
-    } else {
-      gpr_mu_unlock(&server->mu_call);
+    size_t cq_idx = (home_cq_idx + i) % server->cq_count;
+    size_t matched = match_pending_calls(rm, shard, cq_idx);
+    if (matched > 0) {
       GRPC_STATS_INC_SERVER_CQS_CHECKED(i + server->cq_count);
-      gpr_atm_no_barrier_store(&calld->state, ACTIVATED);
-      publish_call(server, calld, cq_idx, rc);
-      return; /* early out */
+      if (i != 0) {
+        GRPC_STATS_INC_COUNTER_BY(
+            GRPC_STATS_COUNTER_SERVER_PENDING_CALLS_STOLEN, matched);
+      }
     }
+    if (gpr_atm_no_barrier_load(&shard->pending_count) == 0) break;
   }
-
-  gpr_atm_no_barrier_store(&calld->state, PENDING);
-  if (rm->pending_head == nullptr) {
-    rm->pending_tail = rm->pending_head = calld;
-  } else {
-    rm->pending_tail->pending_next = calld;
-    rm->pending_tail = calld;
-  }
-  calld->pending_next = nullptr;
-  gpr_mu_unlock(&server->mu_call);
+  server_unref(server);
 }
 
 static void finish_start_new_rpc(
@@ -1417,7 +1483,6 @@ void grpc_server_add_listener(
 
 static grpc_call_error queue_call_request(grpc_server* server, size_t cq_idx,
                                           requested_call* rc) {
-  call_data* calld = nullptr;
   request_matcher* rm = nullptr;
   if (gpr_atm_acq_load(&server->shutdown_flag)) {
     fail_call(server, cq_idx, rc,
@@ -1432,28 +1497,20 @@ static grpc_call_error queue_call_request(grpc_server* server, size_t cq_idx,
       rm = &rc->data.registered.method->matcher;
       break;
   }
-  if (rm->requests_per_cq[cq_idx].Push(rc->mpscq_node.get())) {
-    /* this was the first queued request: we need to lock and start
-       matching calls */
-    gpr_mu_lock(&server->mu_call);
-    while ((calld = rm->pending_head) != nullptr) {
-      rc = reinterpret_cast<requested_call*>(rm->requests_per_cq[cq_idx].Pop());
-      if (rc == nullptr) break;
-      rm->pending_head = calld->pending_next;
-      gpr_mu_unlock(&server->mu_call);
-      if (!gpr_atm_full_cas(&calld->state, PENDING, ACTIVATED)) {
-        // Zombied Call
-        GRPC_CLOSURE_INIT(
-            &calld->kill_zombie_closure, kill_zombie,
-            grpc_call_stack_element(grpc_call_get_call_stack(calld->call), 0),
-            grpc_schedule_on_exec_ctx);
-        GRPC_CLOSURE_SCHED(&calld->kill_zombie_closure, GRPC_ERROR_NONE);
-      } else {
-        publish_call(server, calld, cq_idx, rc);
+  if (rm->shards[cq_idx].requests.Push(rc->mpscq_node.get())) {
+    /* this was the first queued request: match it against calls pending on
+       this completion queue, then steal calls pending on the others */
+    gpr_atm_full_barrier();
+    for (size_t i = 0; i < server->cq_count; i++) {
+      request_matcher_shard* shard =
+          &rm->shards[(cq_idx + i) % server->cq_count];
+      if (gpr_atm_no_barrier_load(&shard->pending_count) == 0) continue;
+      size_t matched = match_pending_calls(rm, shard, cq_idx);
+      if (i != 0) {
+        GRPC_STATS_INC_COUNTER_BY(
+            GRPC_STATS_COUNTER_SERVER_PENDING_CALLS_STOLEN, matched);
       }
-      gpr_mu_lock(&server->mu_call);
     }
-    gpr_mu_unlock(&server->mu_call);
   }
   return GRPC_CALL_OK;
 }
@@ -37,6 +37,8 @@ BdpEstimator::BdpEstimator(const char* name)
       inter_ping_delay_(100.0),  // start at 100ms
       stable_estimate_count_(0),
       bw_est_(0),
+      last_ping_bytes_(0),
+      last_ping_rtt_(0),
       name_(name) {}
 
 grpc_millis BdpEstimator::CompletePing() {
@@ -80,6 +82,8 @@ grpc_millis BdpEstimator::CompletePing() {
     }
   }
   ping_state_ = PingState::UNSCHEDULED;
+  last_ping_bytes_ = accumulator_;
+  last_ping_rtt_ = dt;
   accumulator_ = 0;
   return grpc_core::ExecCtx::Get()->Now() + inter_ping_delay_;
 }
@@ -75,6 +75,11 @@ class BdpEstimator {
   // Completes a previously started ping, returns when to schedule the next one
   grpc_millis CompletePing();
 
+  // Bytes received while the last completed ping was in flight, and how long
+  // (in seconds) it took to be acked
+  int64_t last_ping_bytes() const { return last_ping_bytes_; }
+  double last_ping_rtt() const { return last_ping_rtt_; }
+
  private:
   enum class PingState { UNSCHEDULED, SCHEDULED, STARTED };
 
@@ -86,6 +91,8 @@ class BdpEstimator {
   int inter_ping_delay_;
   int stable_estimate_count_;
   double bw_est_;
+  int64_t last_ping_bytes_;
+  double last_ping_rtt_;
   const char* name_;
 };
 
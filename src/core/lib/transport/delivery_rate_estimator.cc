@@ -0,0 +1,177 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/transport/delivery_rate_estimator.h"
+
+#include <inttypes.h>
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/transport/bdp_estimator.h"
+
+namespace grpc_core {
+
+namespace {
+// 2/ln(2): the smallest gain that doubles the delivery rate every round trip
+constexpr double kStartupGain = 2.885;
+// Headroom on top of the BDP once the pipe is full, so that the peer is not
+// stalled waiting for our window updates
+constexpr double kWindowGain = 2;
+constexpr int kGainCycleLength = 8;
+constexpr double kProbeGains[kGainCycleLength] = {1.25, 0.75, 1, 1,
+                                                  1,    1,    1, 1};
+constexpr double kFullBandwidthGrowth = 1.25;
+constexpr int kFullBandwidthCount = 3;
+constexpr grpc_millis kMinRttExpiry = 10000;
+// BDP assumed before the first sample, matching BdpEstimator
+constexpr int64_t kInitialBdp = 65536;
+constexpr int64_t kMinWindow = 65535;
+constexpr int64_t kMaxWindow = (1u << 31) - 1;
+constexpr grpc_millis kMinPingDelay = 100;
+constexpr grpc_millis kMaxPingDelay = 10000;
+}  // namespace
+
+const char* DeliveryRateEstimator::ModeString(Mode mode) {
+  switch (mode) {
+    case Mode::kStartup:
+      return "startup";
+    case Mode::kProbeBandwidth:
+      return "probe_bw";
+    case Mode::kProbeRtt:
+      return "probe_rtt";
+  }
+  GPR_UNREACHABLE_CODE(return "unknown");
+}
+
+DeliveryRateEstimator::DeliveryRateEstimator(const char* name)
+    : idle_ping_delay_(kMinPingDelay), name_(name) {}
+
+void DeliveryRateEstimator::AddSample(int64_t bytes, double rtt,
+                                      int64_t window) {
+  if (rtt <= 0) return;
+  // The peer had more than twice what it sent available: whatever held it
+  // back, it was not the window
+  const bool app_limited = 2 * bytes < window;
+  const double bw = static_cast<double>(bytes) / rtt;
+  const double prev_max_bw = max_bw_;
+  const grpc_millis now = ExecCtx::Get()->Now();
+  UpdateMaxBandwidth(bw, app_limited);
+  if (min_rtt_ == 0 || rtt <= min_rtt_) {
+    min_rtt_ = rtt;
+    min_rtt_stamp_ = now;
+  }
+  switch (mode_) {
+    case Mode::kStartup:
+      CheckFullPipe();
+      break;
+    case Mode::kProbeRtt:
+      // The window was down to its minimum for this sample, so the data the
+      // peer queued ahead of our ping acks is gone
+      min_rtt_ = rtt;
+      min_rtt_stamp_ = now;
+      mode_ = Mode::kProbeBandwidth;
+      break;
+    case Mode::kProbeBandwidth:
+      if (!app_limited && bw >= prev_max_bw * kFullBandwidthGrowth) {
+        // The window held back a path faster than we knew of, typically on a
+        // connection that had little to send so far: grow it quickly again
+        mode_ = Mode::kStartup;
+        full_bw_ = max_bw_;
+        full_bw_count_ = 0;
+      } else if (now - min_rtt_stamp_ > kMinRttExpiry) {
+        // A window above the BDP keeps a queue in front of our pings, which
+        // inflates every round trip sample
+        mode_ = Mode::kProbeRtt;
+      } else {
+        cycle_index_ = (cycle_index_ + 1) % kGainCycleLength;
+        idle_ping_delay_ =
+            app_limited ? GPR_MIN(2 * idle_ping_delay_, kMaxPingDelay)
+                        : kMinPingDelay;
+      }
+      break;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace)) {
+    gpr_log(GPR_INFO,
+            "delivery_rate[%s]: bytes=%" PRId64 " rtt=%lfms window=%" PRId64
+            "%s max_bw=%lfMbs min_rtt=%lfms mode=%s target=%" PRId64,
+            name_, bytes, rtt * 1e3, window,
+            app_limited ? " (app limited)" : "", max_bw_ / 125000.0,
+            min_rtt_ * 1e3, ModeString(mode_), TargetWindow());
+  }
+}
+
+void DeliveryRateEstimator::UpdateMaxBandwidth(double bw, bool app_limited) {
+  if (app_limited && bw < max_bw_) return;
+  bw_samples_[bw_sample_index_] = bw;
+  bw_sample_index_ = (bw_sample_index_ + 1) % kBandwidthWindow;
+  max_bw_ = 0;
+  for (double sample : bw_samples_) {
+    max_bw_ = GPR_MAX(max_bw_, sample);
+  }
+}
+
+void DeliveryRateEstimator::CheckFullPipe() {
+  if (max_bw_ >= full_bw_ * kFullBandwidthGrowth) {
+    full_bw_ = max_bw_;
+    full_bw_count_ = 0;
+    return;
+  }
+  if (++full_bw_count_ < kFullBandwidthCount) return;
+  mode_ = Mode::kProbeBandwidth;
+  // start cruising: probing right away would only add to the queue that
+  // startup built up
+  cycle_index_ = 2;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_bdp_estimator_trace)) {
+    gpr_log(GPR_INFO, "delivery_rate[%s]: pipe full at %lfMbs", name_,
+            max_bw_ / 125000.0);
+  }
+}
+
+int64_t DeliveryRateEstimator::EstimateBdp() const {
+  if (max_bw_ == 0) return kInitialBdp;
+  return static_cast<int64_t>(max_bw_ * min_rtt_);
+}
+
+int64_t DeliveryRateEstimator::TargetWindow() const {
+  double gain;
+  switch (mode_) {
+    case Mode::kStartup:
+      gain = kStartupGain;
+      break;
+    case Mode::kProbeBandwidth:
+      gain = kWindowGain * kProbeGains[cycle_index_];
+      break;
+    case Mode::kProbeRtt:
+      // The BDP estimate may itself be inflated: only the smallest window
+      // is sure to drain the queue
+      return kMinWindow;
+  }
+  const double window = gain * static_cast<double>(EstimateBdp());
+  return static_cast<int64_t>(GPR_CLAMP(window, kMinWindow, kMaxWindow));
+}
+
+grpc_millis DeliveryRateEstimator::NextPingDelay() const {
+  // Startup needs a sample every round trip to grow the window quickly
+  if (mode_ == Mode::kStartup) return 0;
+  return GPR_MAX(idle_ping_delay_, static_cast<grpc_millis>(min_rtt_ * 1e3));
+}
+
+}  // namespace grpc_core
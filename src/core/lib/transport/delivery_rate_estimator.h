@@ -0,0 +1,102 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_TRANSPORT_DELIVERY_RATE_ESTIMATOR_H
+#define GRPC_CORE_LIB_TRANSPORT_DELIVERY_RATE_ESTIMATOR_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+/* \file Receive window model in the style of BBR congestion control.
+   Fed with round trip samples (how many bytes arrived while a ping was in
+   flight, and how long the ping took), it keeps the max delivery rate over
+   the last few samples and the min round trip time over the last few
+   seconds. Their product is the bandwidth-delay product of the path, which
+   is scaled by a gain that depends on the phase the model is in:
+   - startup: the window grows by 2/ln(2) each round trip until the delivery
+     rate stops growing by at least 25% for three round trips in a row
+   - probe bandwidth: the gain cycles through 8 phases, one per sample, that
+     briefly offer a bigger window to discover more bandwidth, then a smaller
+     one to drain the queue that probing built up. A sample showing that the
+     window held back 25% more bandwidth than known goes back to startup.
+   - probe rtt: a window above the BDP keeps data queued ahead of our ping
+     acks, so round trip samples only come out right after the window has
+     been lowered to its minimum for a sample. This happens when the min
+     round trip time is 10 seconds old.
+   Samples in which the peer did not use most of the window it was offered
+   are application limited: they can raise the delivery rate estimate but
+   never lower it. */
+
+namespace grpc_core {
+
+class DeliveryRateEstimator {
+ public:
+  // Number of samples the max delivery rate is taken over
+  static constexpr int kBandwidthWindow = 10;
+
+  explicit DeliveryRateEstimator(const char* name);
+
+  // Adds the sample of a ping that took rtt seconds to be acked, during which
+  // bytes arrived while the peer was allowed to send window bytes
+  void AddSample(int64_t bytes, double rtt, int64_t window);
+
+  // Max delivery rate (bytes per second) over the last kBandwidthWindow
+  // samples
+  double MaxBandwidth() const { return max_bw_; }
+  // Min round trip time (seconds) over the last 10 seconds
+  double MinRtt() const { return min_rtt_; }
+  int64_t EstimateBdp() const;
+
+  // Window the peer should be allowed to fill
+  int64_t TargetWindow() const;
+
+  // How long to wait before starting the next ping
+  grpc_millis NextPingDelay() const;
+
+  bool in_startup() const { return mode_ == Mode::kStartup; }
+
+ private:
+  enum class Mode { kStartup, kProbeBandwidth, kProbeRtt };
+
+  static const char* ModeString(Mode mode);
+  void UpdateMaxBandwidth(double bw, bool app_limited);
+  void CheckFullPipe();
+
+  Mode mode_ = Mode::kStartup;
+  // ring buffer of the delivery rate of recent samples
+  double bw_samples_[kBandwidthWindow] = {};
+  int bw_sample_index_ = 0;
+  double max_bw_ = 0;
+  double min_rtt_ = 0;
+  grpc_millis min_rtt_stamp_ = 0;
+  // max delivery rate when startup last saw it grow by 25%
+  double full_bw_ = 0;
+  int full_bw_count_ = 0;
+  // position in the probe bandwidth gain cycle
+  int cycle_index_ = 0;
+  // spacing of pings on a connection that stays application limited
+  grpc_millis idle_ping_delay_;
+  const char* name_;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_TRANSPORT_DELIVERY_RATE_ESTIMATOR_H */
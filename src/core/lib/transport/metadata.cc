@@ -29,6 +29,7 @@
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 #include <grpc/support/time.h>
@@ -197,17 +198,194 @@ InternedMetadata::~InternedMetadata() {
   }
 }
 
+/* Memory unlinked from a shard that lock-free lookups may still be reading:
+   an InternedMetadata, or a bucket array replaced by grow_mdtab */
+typedef struct mdtab_retired {
+  void* ptr;
+  bool is_md;
+} mdtab_retired;
+
+typedef struct mdtab_retired_list {
+  mdtab_retired* items;
+  size_t count;
+  size_t capacity;
+} mdtab_retired_list;
+
+typedef struct mdtab_shard {
+  gpr_mu mu;
+  /* The bucket array and its capacity, read by lock-free lookups: grow_mdtab
+     publishes the new array before its capacity, so a lookup that reads the
+     capacity first never indexes past the end of the array it then reads */
+  gpr_atm elems;
+  gpr_atm capacity;
+  size_t count;
+  /** Estimate of the number of unreferenced mdelems in the hash table.
+      This will eventually converge to the exact number, but it's instantaneous
+      accuracy is not guaranteed */
+  gpr_atm free_estimate;
+  /* unlinked since the shard last requested a grace period */
+  mdtab_retired_list retired;
+  /* freed once grace period waiting_grace_period has completed */
+  mdtab_retired_list waiting;
+  uint64_t waiting_grace_period;
+} mdtab_shard;
+
+static mdtab_shard g_shards[SHARD_COUNT];
+
+/* Lock-free lookups announce themselves in one of the two reader counts of
+   the CPU they start on, picked by the parity of g_read_epoch. A grace period
+   waits until each count of the other parity has been seen at zero, flips the
+   epoch, then waits the same way for each count of the old parity. Lookups
+   that start after a count was seen at zero cannot reach memory unlinked
+   before the grace period started, so that memory is freed once it ends. New
+   lookups only join the counts of the current parity, so the counts waited on
+   drain even if lookups never stop. */
+typedef union mdtab_reader_slot {
+  char pad[GPR_CACHELINE_SIZE];
+  gpr_atm readers[2];
+} mdtab_reader_slot;
+
+static mdtab_reader_slot* g_reader_slots;
+static size_t g_num_reader_slots;
+static gpr_atm g_read_epoch;
+
+/* Grace periods are shared by all shards. They only advance when a shard
+   with memory waiting on them tries to free it. */
+typedef struct mdtab_grace_period {
+  gpr_mu mu;
+  uint64_t requested;
+  uint64_t started;
+  uint64_t completed;
+  /* counts of the other parity drained so far by the running grace period:
+     one before the epoch flip, two after */
+  int drained;
+  /* counts of the parity being drained that have been seen at zero */
+  bool* seen_idle;
+  size_t num_unseen;
+} mdtab_grace_period;
+
+static mdtab_grace_period g_grace_period;
+
+/* Set when the last lookup of an element with a hash in the slot found it
+   unreferenced. Elements that come and go with each call would fail the
+   lock-free lookup, so they go straight to the locked one. Only a hint: it
+   is shared by colliding hashes, and updated without synchronization. */
+#define UNREFERENCED_HINT_COUNT 64
+static gpr_atm g_unreferenced_hints[UNREFERENCED_HINT_COUNT];
+
+static void set_unreferenced_hint(gpr_atm* hint, bool unreferenced) {
+  if (gpr_atm_no_barrier_load(hint) != unreferenced) {
+    gpr_atm_no_barrier_store(hint, unreferenced);
+  }
+}
+
+static InternedMetadata::BucketLink* shard_elems(mdtab_shard* shard) {
+  return reinterpret_cast<InternedMetadata::BucketLink*>(
+      gpr_atm_acq_load(&shard->elems));
+}
+
+static size_t shard_capacity(mdtab_shard* shard) {
+  return static_cast<size_t>(gpr_atm_acq_load(&shard->capacity));
+}
+
+static void retire(mdtab_shard* shard, void* ptr, bool is_md) {
+  mdtab_retired_list* list = &shard->retired;
+  if (list->count == list->capacity) {
+    list->capacity = GPR_MAX(8, 2 * list->capacity);
+    list->items = static_cast<mdtab_retired*>(
+        gpr_realloc(list->items, list->capacity * sizeof(*list->items)));
+  }
+  list->items[list->count++] = {ptr, is_md};
+}
+
+static void free_retired(mdtab_retired_list* list) {
+  for (size_t i = 0; i < list->count; i++) {
+    if (list->items[i].is_md) {
+      grpc_core::Delete(static_cast<InternedMetadata*>(list->items[i].ptr));
+    } else {
+      gpr_free(list->items[i].ptr);
+    }
+  }
+  list->count = 0;
+}
+
+static void start_draining_locked(mdtab_grace_period* gp) {
+  memset(gp->seen_idle, 0, sizeof(*gp->seen_idle) * g_num_reader_slots);
+  gp->num_unseen = g_num_reader_slots;
+}
+
+/* Returns true once each reader count of the parity not in use has been seen
+   at zero since start_draining_locked() */
+static bool drain_readers_locked(mdtab_grace_period* gp) {
+  const size_t parity = (gpr_atm_no_barrier_load(&g_read_epoch) & 1) ^ 1;
+  /* pairs with the barrier in begin_lock_free_read(): a lookup that may have
+     seen the unlinked memory has announced itself before we look for it */
+  gpr_atm_full_barrier();
+  for (size_t i = 0; i < g_num_reader_slots && gp->num_unseen > 0; i++) {
+    if (!gp->seen_idle[i] &&
+        gpr_atm_acq_load(&g_reader_slots[i].readers[parity]) == 0) {
+      gp->seen_idle[i] = true;
+      gp->num_unseen--;
+    }
+  }
+  return gp->num_unseen == 0;
+}
+
+/* Moves grace periods along as far as the reader counts allow */
+static void advance_grace_period_locked(mdtab_grace_period* gp) {
+  for (;;) {
+    if (gp->started == gp->completed) {
+      if (gp->started == gp->requested) return;
+      gp->started++;
+      gp->drained = 0;
+      start_draining_locked(gp);
+    }
+    /* the first drain waits out lookups that read the epoch before the
+       previous flip, and joined the counts of the other parity late */
+    if (!drain_readers_locked(gp)) return;
+    if (++gp->drained == 1) {
+      gpr_atm_full_fetch_add(&g_read_epoch, 1);
+      start_draining_locked(gp);
+    } else {
+      gp->completed = gp->started;
+    }
+  }
+}
+
+/* Frees the memory retired by the shard once no lock-free lookup can still be
+   reading it. Until then it is left for the next locked operation on the
+   shard, which tries again. */
+static void maybe_free_retired_locked(mdtab_shard* shard) {
+  if (shard->retired.count == 0 && shard->waiting.count == 0) return;
+  mdtab_grace_period* gp = &g_grace_period;
+  gpr_mu_lock(&gp->mu);
+  if (shard->waiting.count == 0) {
+    /* the emptied list keeps its storage for the next unlinks */
+    const mdtab_retired_list empty = shard->waiting;
+    shard->waiting = shard->retired;
+    shard->retired = empty;
+    /* a grace period already running may have started before the unlinks */
+    shard->waiting_grace_period = gp->started + 1;
+    gp->requested = GPR_MAX(gp->requested, shard->waiting_grace_period);
+  }
+  advance_grace_period_locked(gp);
+  const bool done = gp->completed >= shard->waiting_grace_period;
+  gpr_mu_unlock(&gp->mu);
+  if (done) free_retired(&shard->waiting);
+}
+
 size_t InternedMetadata::CleanupLinkedMetadata(
-    InternedMetadata::BucketLink* head) {
+    InternedMetadata::BucketLink* head, mdtab_shard* shard) {
   size_t num_freed = 0;
   InternedMetadata::BucketLink* prev_next = head;
   InternedMetadata *md, *next;
 
-  for (md = head->next; md; md = next) {
-    next = md->link_.next;
+  for (md = head->next.Load(grpc_core::MemoryOrder::RELAXED); md; md = next) {
+    next = md->bucket_next();
     if (md->AllRefsDropped()) {
-      prev_next->next = next;
-      grpc_core::Delete(md);
+      prev_next->next.Store(next, grpc_core::MemoryOrder::RELEASE);
+      /* md keeps its link for lookups that are walking past it */
+      retire(shard, md, true);
       num_freed++;
     } else {
       prev_next = &md->link_;
@@ -216,31 +394,29 @@ size_t InternedMetadata::CleanupLinkedMetadata(
   return num_freed;
 }
 
-typedef struct mdtab_shard {
-  gpr_mu mu;
-  InternedMetadata::BucketLink* elems;
-  size_t count;
-  size_t capacity;
-  /** Estimate of the number of unreferenced mdelems in the hash table.
-      This will eventually converge to the exact number, but it's instantaneous
-      accuracy is not guaranteed */
-  gpr_atm free_estimate;
-} mdtab_shard;
-
-static mdtab_shard g_shards[SHARD_COUNT];
-
 static void gc_mdtab(mdtab_shard* shard);
 
 void grpc_mdctx_global_init(void) {
+  g_num_reader_slots = GPR_MAX(1, gpr_cpu_num_cores());
+  g_reader_slots = static_cast<mdtab_reader_slot*>(
+      gpr_zalloc(sizeof(*g_reader_slots) * g_num_reader_slots));
+  mdtab_grace_period* gp = &g_grace_period;
+  gpr_mu_init(&gp->mu);
+  gp->requested = gp->started = gp->completed = 0;
+  gp->seen_idle = static_cast<bool*>(
+      gpr_malloc(sizeof(*gp->seen_idle) * g_num_reader_slots));
   /* initialize shards */
   for (size_t i = 0; i < SHARD_COUNT; i++) {
     mdtab_shard* shard = &g_shards[i];
     gpr_mu_init(&shard->mu);
     shard->count = 0;
     gpr_atm_no_barrier_store(&shard->free_estimate, 0);
-    shard->capacity = INITIAL_SHARD_CAPACITY;
-    shard->elems = static_cast<InternedMetadata::BucketLink*>(
-        gpr_zalloc(sizeof(*shard->elems) * shard->capacity));
+    gpr_atm_no_barrier_store(&shard->capacity, INITIAL_SHARD_CAPACITY);
+    void* elems = gpr_zalloc(sizeof(InternedMetadata::BucketLink) *
+                             INITIAL_SHARD_CAPACITY);
+    gpr_atm_no_barrier_store(&shard->elems, reinterpret_cast<gpr_atm>(elems));
+    shard->retired = {nullptr, 0, 0};
+    shard->waiting = {nullptr, 0, 0};
   }
 }
 
@@ -262,8 +438,16 @@ void grpc_mdctx_global_shutdown() {
 #ifndef GRPC_ASAN_ENABLED
     GPR_DEBUG_ASSERT(shard->count == 0);
 #endif
-    gpr_free(shard->elems);
+    /* no lookups run past shutdown */
+    free_retired(&shard->waiting);
+    free_retired(&shard->retired);
+    gpr_free(shard->waiting.items);
+    gpr_free(shard->retired.items);
+    gpr_free(shard_elems(shard));
   }
+  gpr_mu_destroy(&g_grace_period.mu);
+  gpr_free(g_grace_period.seen_idle);
+  gpr_free(g_reader_slots);
 }
 
 #ifndef NDEBUG
@@ -275,7 +459,7 @@ static int is_mdelem_static(grpc_mdelem e) {
 }
 #endif
 
-void InternedMetadata::RefWithShardLocked(mdtab_shard* shard) {
+bool InternedMetadata::RefWithShardLocked(mdtab_shard* shard) {
 #ifndef NDEBUG
   if (grpc_trace_metadata.enabled()) {
     char* key_str = grpc_slice_to_c_string(key());
@@ -290,14 +474,18 @@ void InternedMetadata::RefWithShardLocked(mdtab_shard* shard) {
 #endif
   if (FirstRef()) {
     gpr_atm_no_barrier_fetch_add(&shard->free_estimate, -1);
+    return true;
   }
+  return false;
 }
 
 static void gc_mdtab(mdtab_shard* shard) {
   GPR_TIMER_SCOPE("gc_mdtab", 0);
   size_t num_freed = 0;
-  for (size_t i = 0; i < shard->capacity; ++i) {
-    intptr_t freed = InternedMetadata::CleanupLinkedMetadata(&shard->elems[i]);
+  InternedMetadata::BucketLink* elems = shard_elems(shard);
+  const size_t capacity = shard_capacity(shard);
+  for (size_t i = 0; i < capacity; ++i) {
+    intptr_t freed = InternedMetadata::CleanupLinkedMetadata(&elems[i], shard);
     num_freed += freed;
     shard->count -= freed;
   }
@@ -308,7 +496,9 @@ static void gc_mdtab(mdtab_shard* shard) {
 static void grow_mdtab(mdtab_shard* shard) {
   GPR_TIMER_SCOPE("grow_mdtab", 0);
 
-  size_t capacity = shard->capacity * 2;
+  InternedMetadata::BucketLink* old_elems = shard_elems(shard);
+  const size_t old_capacity = shard_capacity(shard);
+  size_t capacity = old_capacity * 2;
   size_t i;
   InternedMetadata::BucketLink* mdtab;
   InternedMetadata *md, *next;
@@ -317,24 +507,28 @@ static void grow_mdtab(mdtab_shard* shard) {
   mdtab = static_cast<InternedMetadata::BucketLink*>(
       gpr_zalloc(sizeof(InternedMetadata::BucketLink) * capacity));
 
-  for (i = 0; i < shard->capacity; i++) {
-    for (md = shard->elems[i].next; md; md = next) {
+  /* lookups racing with the relinking below may be steered into the wrong
+     bucket: they miss, and retry under the lock */
+  for (i = 0; i < old_capacity; i++) {
+    for (md = old_elems[i].next.Load(grpc_core::MemoryOrder::RELAXED); md;
+         md = next) {
       size_t idx;
       hash = md->hash();
       next = md->bucket_next();
       idx = TABLE_IDX(hash, capacity);
-      md->set_bucket_next(mdtab[idx].next);
-      mdtab[idx].next = md;
+      md->set_bucket_next(
+          mdtab[idx].next.Load(grpc_core::MemoryOrder::RELAXED));
+      mdtab[idx].next.Store(md, grpc_core::MemoryOrder::RELAXED);
     }
   }
-  gpr_free(shard->elems);
-  shard->elems = mdtab;
-  shard->capacity = capacity;
+  gpr_atm_rel_store(&shard->elems, reinterpret_cast<gpr_atm>(mdtab));
+  gpr_atm_rel_store(&shard->capacity, static_cast<gpr_atm>(capacity));
+  retire(shard, old_elems, false);
 }
 
 static void rehash_mdtab(mdtab_shard* shard) {
   if (gpr_atm_no_barrier_load(&shard->free_estimate) >
-      static_cast<gpr_atm>(shard->capacity / 4)) {
+      static_cast<gpr_atm>(shard_capacity(shard) / 4)) {
     gc_mdtab(shard);
   } else {
     grow_mdtab(shard);
@@ -424,6 +618,73 @@ static grpc_mdelem md_create_maybe_static(const grpc_slice& key,
   return md_create_must_intern<key_definitely_static>(key, value, hash);
 }
 
+static bool md_matches(InternedMetadata* md, const grpc_slice& key,
+                       const grpc_slice& value) {
+  return grpc_slice_static_interned_equal(key, md->key()) &&
+         grpc_slice_static_interned_equal(value, md->value());
+}
+
+/* Announces a lock-free lookup, until end_lock_free_read() */
+static gpr_atm* begin_lock_free_read() {
+  mdtab_reader_slot* slot =
+      g_num_reader_slots == 1
+          ? g_reader_slots
+          : &g_reader_slots[gpr_cpu_current_cpu() % g_num_reader_slots];
+  gpr_atm* readers = &slot->readers[gpr_atm_acq_load(&g_read_epoch) & 1];
+  /* pairs with the barrier in drain_readers_locked() */
+  gpr_atm_full_fetch_add(readers, 1);
+  return readers;
+}
+
+static void end_lock_free_read(gpr_atm* readers) {
+  gpr_atm_full_fetch_add(readers, -1);
+}
+
+void* grpc_mdctx_begin_read_for_testing() { return begin_lock_free_read(); }
+
+void grpc_mdctx_end_read_for_testing(void* read) {
+  end_lock_free_read(static_cast<gpr_atm*>(read));
+}
+
+size_t grpc_mdctx_count_retired_for_testing() {
+  size_t count = 0;
+  for (size_t i = 0; i < SHARD_COUNT; i++) {
+    mdtab_shard* shard = &g_shards[i];
+    gpr_mu_lock(&shard->mu);
+    count += shard->retired.count + shard->waiting.count;
+    gpr_mu_unlock(&shard->mu);
+  }
+  return count;
+}
+
+/* Finds an existing pair without taking the shard lock. The result may have
+   no refs, and is only valid until the end of the read. Returns null if the
+   pair is missing, or if the lookup raced with a rehash. */
+static InternedMetadata* find_lock_free(mdtab_shard* shard,
+                                        const grpc_slice& key,
+                                        const grpc_slice& value,
+                                        uint32_t hash) {
+  const size_t capacity = shard_capacity(shard);
+  InternedMetadata::BucketLink* elems = shard_elems(shard);
+  for (InternedMetadata* md = elems[TABLE_IDX(hash, capacity)].next.Load(
+           grpc_core::MemoryOrder::ACQUIRE);
+       md != nullptr; md = md->bucket_next()) {
+    if (md_matches(md, key, value)) return md;
+  }
+  return nullptr;
+}
+
+static bool is_in_list(const mdtab_retired_list* list, void* ptr) {
+  for (size_t i = 0; i < list->count; i++) {
+    if (list->items[i].ptr == ptr) return true;
+  }
+  return false;
+}
+
+static bool is_retired_locked(mdtab_shard* shard, void* ptr) {
+  return is_in_list(&shard->retired, ptr) || is_in_list(&shard->waiting, ptr);
+}
+
 template <bool key_definitely_static>
 static grpc_mdelem md_create_must_intern(const grpc_slice& key,
                                          const grpc_slice& value,
@@ -441,33 +702,64 @@ static grpc_mdelem md_create_must_intern(const grpc_slice& key,
 
   GPR_TIMER_SCOPE("grpc_mdelem_from_metadata_strings", 0);
 
-  gpr_mu_lock(&shard->mu);
-
-  idx = TABLE_IDX(hash, shard->capacity);
-  /* search for an existing pair */
-  for (md = shard->elems[idx].next; md; md = md->bucket_next()) {
-    if (grpc_slice_static_interned_equal(key, md->key()) &&
-        grpc_slice_static_interned_equal(value, md->value())) {
-      md->RefWithShardLocked(shard);
+  gpr_atm* hint = &g_unreferenced_hints[(hash >> LOG2_SHARD_COUNT) %
+                                        UNREFERENCED_HINT_COUNT];
+  if (!gpr_atm_no_barrier_load(hint)) {
+    gpr_atm* readers = begin_lock_free_read();
+    md = find_lock_free(shard, key, value, hash);
+    if (md != nullptr && md->RefIfNonZero()) {
+      end_lock_free_read(readers);
+      return GRPC_MAKE_MDELEM(md, GRPC_MDELEM_STORAGE_INTERNED);
+    }
+    gpr_mu_lock(&shard->mu);
+    /* md has no refs. The read kept it from being freed, and unless a gc
+       retired it in the meantime it is still in the table. */
+    if (md != nullptr && !is_retired_locked(shard, md)) {
+      set_unreferenced_hint(hint, md->RefWithShardLocked(shard));
+      end_lock_free_read(readers);
+      maybe_free_retired_locked(shard);
       gpr_mu_unlock(&shard->mu);
       return GRPC_MAKE_MDELEM(md, GRPC_MDELEM_STORAGE_INTERNED);
     }
+    end_lock_free_read(readers);
+  } else {
+    gpr_mu_lock(&shard->mu);
   }
 
-  /* not found: create a new pair */
-  md = key_definitely_static
-           ? grpc_core::New<InternedMetadata>(
-                 key, value, hash, shard->elems[idx].next,
-                 static_cast<const InternedMetadata::NoRefKey*>(nullptr))
-           : grpc_core::New<InternedMetadata>(key, value, hash,
-                                              shard->elems[idx].next);
-  shard->elems[idx].next = md;
-  shard->count++;
+  InternedMetadata::BucketLink* elems = shard_elems(shard);
+  idx = TABLE_IDX(hash, shard_capacity(shard));
+  /* search for an existing pair: it may have been moved by a rehash while the
+     lock-free lookup was walking its bucket */
+  for (md = elems[idx].next.Load(grpc_core::MemoryOrder::RELAXED); md;
+       md = md->bucket_next()) {
+    if (md_matches(md, key, value)) {
+      set_unreferenced_hint(hint, md->RefWithShardLocked(shard));
+      break;
+    }
+  }
 
-  if (shard->count > shard->capacity * 2) {
-    rehash_mdtab(shard);
+  if (md == nullptr) {
+    set_unreferenced_hint(hint, false);
+    /* not found: create a new pair */
+    InternedMetadata* next =
+        elems[idx].next.Load(grpc_core::MemoryOrder::RELAXED);
+    md = key_definitely_static
+             ? grpc_core::New<InternedMetadata>(
+                   key, value, hash, next,
+                   static_cast<const InternedMetadata::NoRefKey*>(nullptr))
+             : grpc_core::New<InternedMetadata>(key, value, hash, next);
+    /* publishes md, fully constructed, to lock-free lookups */
+    elems[idx].next.Store(md, grpc_core::MemoryOrder::RELEASE);
+    shard->count++;
+
+    if (shard->count > shard_capacity(shard) * 2) {
+      rehash_mdtab(shard);
+    }
   }
 
+  /* retry whatever an earlier attempt could not free */
+  maybe_free_retired_locked(shard);
+
   gpr_mu_unlock(&shard->mu);
 
   return GRPC_MAKE_MDELEM(md, GRPC_MDELEM_STORAGE_INTERNED);
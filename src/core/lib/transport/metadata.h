@@ -263,6 +263,9 @@ class RefcountedMdBase {
     GPR_DEBUG_ASSERT(prior > 0);
     return prior == 1;
   }
+  /* Refs the element unless all of its refs have already been dropped; used
+     by lookups that may race with the element being collected */
+  bool RefIfNonZero() { return refcnt_.IncrementIfNonzero(); }
 
  protected:
 #ifndef NDEBUG
@@ -288,7 +291,9 @@ class InternedMetadata : public RefcountedMdBase {
   struct BucketLink {
     explicit BucketLink(InternedMetadata* md) : next(md) {}
 
-    InternedMetadata* next = nullptr;
+    /* Lookups walk the buckets without holding the shard lock, so links are
+       published with release stores */
+    grpc_core::Atomic<InternedMetadata*> next;
   };
   InternedMetadata(const grpc_slice& key, const grpc_slice& value,
                    uint32_t hash, InternedMetadata* next);
@@ -296,12 +301,19 @@ class InternedMetadata : public RefcountedMdBase {
                    uint32_t hash, InternedMetadata* next, const NoRefKey*);
 
   ~InternedMetadata();
-  void RefWithShardLocked(mdtab_shard* shard);
+  /* Returns true if this was the first ref since all refs were dropped */
+  bool RefWithShardLocked(mdtab_shard* shard);
   UserData* user_data() { return &user_data_; }
-  InternedMetadata* bucket_next() { return link_.next; }
-  void set_bucket_next(InternedMetadata* md) { link_.next = md; }
+  InternedMetadata* bucket_next() {
+    return link_.next.Load(grpc_core::MemoryOrder::ACQUIRE);
+  }
+  void set_bucket_next(InternedMetadata* md) {
+    link_.next.Store(md, grpc_core::MemoryOrder::RELEASE);
+  }
 
-  static size_t CleanupLinkedMetadata(BucketLink* head);
+  /* Unlinks the unreferenced elements of a bucket and retires them to the
+     shard, returning how many there were */
+  static size_t CleanupLinkedMetadata(BucketLink* head, mdtab_shard* shard);
 
  private:
   UserData user_data_;
@@ -415,6 +427,12 @@ inline void grpc_mdelem_unref(grpc_mdelem gmd) {
 void grpc_mdctx_global_init(void);
 void grpc_mdctx_global_shutdown();
 
+/* For testing: announce and end a lock-free lookup of interned metadata, and
+   count the unlinked memory that waits for such lookups to end */
+void* grpc_mdctx_begin_read_for_testing();
+void grpc_mdctx_end_read_for_testing(void* read);
+size_t grpc_mdctx_count_retired_for_testing();
+
 /* Like grpc_mdelem_from_slices, but we know that key is a static or interned
    slice and value is not static or interned. This gives us an inlinable
    fastpath - we know we must allocate metadata now, and that we do not need to
@@ -21,6 +21,7 @@
 #include "src/core/lib/transport/metadata_batch.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <string.h>
 
 #include <grpc/support/alloc.h>
@@ -30,32 +31,30 @@
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 
+static grpc_linked_mdelem** list_elems(grpc_mdelem_list* list) {
+  return list->overflow != nullptr ? list->overflow : list->inline_elems;
+}
+
 static void assert_valid_list(grpc_mdelem_list* list) {
 #ifndef NDEBUG
-  grpc_linked_mdelem* l;
-
-  GPR_ASSERT((list->head == nullptr) == (list->tail == nullptr));
-  if (!list->head) return;
-  GPR_ASSERT(list->head->prev == nullptr);
-  GPR_ASSERT(list->tail->next == nullptr);
-  GPR_ASSERT((list->head == list->tail) == (list->head->next == nullptr));
-
-  size_t verified_count = 0;
-  for (l = list->head; l; l = l->next) {
-    GPR_ASSERT(!GRPC_MDISNULL(l->md));
-    GPR_ASSERT((l->prev == nullptr) == (l == list->head));
-    GPR_ASSERT((l->next == nullptr) == (l == list->tail));
-    if (l->next) GPR_ASSERT(l->next->prev == l);
-    if (l->prev) GPR_ASSERT(l->prev->next == l);
-    verified_count++;
+  if (list->overflow == nullptr) {
+    GPR_ASSERT(list->count <= GRPC_MDELEM_LIST_INLINE_ELEMS);
+  } else {
+    GPR_ASSERT(list->count <= list->overflow_capacity);
+  }
+  grpc_linked_mdelem** elems = list_elems(list);
+  for (size_t i = 0; i < list->count; i++) {
+    GPR_ASSERT(elems[i] != nullptr);
+    GPR_ASSERT(!GRPC_MDISNULL(elems[i]->md));
   }
-  GPR_ASSERT(list->count == verified_count);
 #endif /* NDEBUG */
 }
 
 static void assert_valid_callouts(grpc_metadata_batch* batch) {
 #ifndef NDEBUG
-  for (grpc_linked_mdelem* l = batch->list.head; l != nullptr; l = l->next) {
+  grpc_linked_mdelem** elems = list_elems(&batch->list);
+  for (size_t i = 0; i < batch->list.count; i++) {
+    grpc_linked_mdelem* l = elems[i];
     grpc_slice key_interned = grpc_slice_intern(GRPC_MDKEY(l->md));
     grpc_metadata_batch_callouts_index callout_idx =
         GRPC_BATCH_INDEX_OF(key_interned);
@@ -74,15 +73,18 @@ void grpc_metadata_batch_assert_ok(grpc_metadata_batch* batch) {
 #endif /* NDEBUG */
 
 void grpc_metadata_batch_init(grpc_metadata_batch* batch) {
-  memset(batch, 0, sizeof(*batch));
+  /* inline_elems is only read below count, so it is left uninitialized */
+  memset(&batch->list, 0, offsetof(grpc_mdelem_list, inline_elems));
+  memset(&batch->idx, 0, sizeof(batch->idx));
   batch->deadline = GRPC_MILLIS_INF_FUTURE;
 }
 
 void grpc_metadata_batch_destroy(grpc_metadata_batch* batch) {
-  grpc_linked_mdelem* l;
-  for (l = batch->list.head; l; l = l->next) {
-    GRPC_MDELEM_UNREF(l->md);
+  grpc_linked_mdelem** elems = list_elems(&batch->list);
+  for (size_t i = 0; i < batch->list.count; i++) {
+    GRPC_MDELEM_UNREF(elems[i]->md);
   }
+  gpr_free(batch->list.overflow);
 }
 
 grpc_error* grpc_attach_md_to_error(grpc_error* src, grpc_mdelem md) {
@@ -144,19 +146,39 @@ grpc_error* grpc_metadata_batch_add_head(grpc_metadata_batch* batch,
   return grpc_metadata_batch_link_head(batch, storage);
 }
 
+/* Makes room for one more element, moving the elements to the heap once they
+   outgrow inline_elems */
+static grpc_linked_mdelem** reserve_one(grpc_mdelem_list* list) {
+  if (list->overflow == nullptr) {
+    if (GPR_LIKELY(list->count < GRPC_MDELEM_LIST_INLINE_ELEMS)) {
+      return list->inline_elems;
+    }
+    list->overflow_capacity = 2 * GRPC_MDELEM_LIST_INLINE_ELEMS;
+    list->overflow = static_cast<grpc_linked_mdelem**>(
+        gpr_malloc(list->overflow_capacity * sizeof(*list->overflow)));
+    memcpy(list->overflow, list->inline_elems,
+           list->count * sizeof(*list->overflow));
+  } else if (list->count == list->overflow_capacity) {
+    list->overflow_capacity *= 2;
+    list->overflow = static_cast<grpc_linked_mdelem**>(gpr_realloc(
+        list->overflow, list->overflow_capacity * sizeof(*list->overflow)));
+  }
+  return list->overflow;
+}
+
 static void link_head(grpc_mdelem_list* list, grpc_linked_mdelem* storage) {
   assert_valid_list(list);
   GPR_DEBUG_ASSERT(!GRPC_MDISNULL(storage->md));
-  storage->prev = nullptr;
-  storage->next = list->head;
-  storage->reserved = nullptr;
-  if (list->head != nullptr) {
-    list->head->prev = storage;
-  } else {
-    list->tail = storage;
+  grpc_linked_mdelem** elems = reserve_one(list);
+  /* Rotating the elements up by hand beats a call out to memmove for the
+     handful of elements a batch usually holds */
+  grpc_linked_mdelem* carry = storage;
+  for (size_t i = 0; i < list->count; i++) {
+    grpc_linked_mdelem* displaced = elems[i];
+    elems[i] = carry;
+    carry = displaced;
   }
-  list->head = storage;
-  list->count++;
+  elems[list->count++] = carry;
   assert_valid_list(list);
 }
 
@@ -202,16 +224,8 @@ grpc_error* grpc_metadata_batch_add_tail(grpc_metadata_batch* batch,
 static void link_tail(grpc_mdelem_list* list, grpc_linked_mdelem* storage) {
   assert_valid_list(list);
   GPR_DEBUG_ASSERT(!GRPC_MDISNULL(storage->md));
-  storage->prev = list->tail;
-  storage->next = nullptr;
-  storage->reserved = nullptr;
-  if (list->tail != nullptr) {
-    list->tail->next = storage;
-  } else {
-    list->head = storage;
-  }
-  list->tail = storage;
-  list->count++;
+  grpc_linked_mdelem** elems = reserve_one(list);
+  elems[list->count++] = storage;
   assert_valid_list(list);
 }
 
@@ -246,15 +260,16 @@ grpc_error* grpc_metadata_batch_link_tail(
 static void unlink_storage(grpc_mdelem_list* list,
                            grpc_linked_mdelem* storage) {
   assert_valid_list(list);
-  if (storage->prev != nullptr) {
-    storage->prev->next = storage->next;
-  } else {
-    list->head = storage->next;
-  }
-  if (storage->next != nullptr) {
-    storage->next->prev = storage->prev;
-  } else {
-    list->tail = storage->prev;
+  grpc_linked_mdelem** elems = list_elems(list);
+  /* Rotate the elements after storage down over it, as in link_head */
+  size_t i = list->count - 1;
+  grpc_linked_mdelem* carry = elems[i];
+  while (carry != storage) {
+    GPR_DEBUG_ASSERT(i > 0);
+    i--;
+    grpc_linked_mdelem* displaced = elems[i];
+    elems[i] = carry;
+    carry = displaced;
   }
   list->count--;
   assert_valid_list(list);
@@ -318,15 +333,14 @@ void grpc_metadata_batch_clear(grpc_metadata_batch* batch) {
 }
 
 bool grpc_metadata_batch_is_empty(grpc_metadata_batch* batch) {
-  return batch->list.head == nullptr &&
-         batch->deadline == GRPC_MILLIS_INF_FUTURE;
+  return batch->list.count == 0 && batch->deadline == GRPC_MILLIS_INF_FUTURE;
 }
 
 size_t grpc_metadata_batch_size(grpc_metadata_batch* batch) {
   size_t size = 0;
-  for (grpc_linked_mdelem* elem = batch->list.head; elem != nullptr;
-       elem = elem->next) {
-    size += GRPC_MDELEM_LENGTH(elem->md);
+  grpc_linked_mdelem** elems = list_elems(&batch->list);
+  for (size_t i = 0; i < batch->list.count; i++) {
+    size += GRPC_MDELEM_LENGTH(elems[i]->md);
   }
   return size;
 }
@@ -344,18 +358,26 @@ grpc_error* grpc_metadata_batch_filter(grpc_metadata_batch* batch,
                                        grpc_metadata_batch_filter_func func,
                                        void* user_data,
                                        const char* composite_error_string) {
-  grpc_linked_mdelem* l = batch->list.head;
   grpc_error* error = GRPC_ERROR_NONE;
-  while (l) {
-    grpc_linked_mdelem* next = l->next;
+  grpc_linked_mdelem** elems = list_elems(&batch->list);
+  size_t i = 0;
+  while (i < batch->list.count) {
+    grpc_linked_mdelem* l = elems[i];
     grpc_filtered_mdelem new_mdelem = func(user_data, l->md);
     add_error(&error, new_mdelem.error, composite_error_string);
     if (GRPC_MDISNULL(new_mdelem.md)) {
+      // the following elements shift down to i
       grpc_metadata_batch_remove(batch, l);
-    } else if (new_mdelem.md.payload != l->md.payload) {
-      grpc_metadata_batch_substitute(batch, l, new_mdelem.md);
+      continue;
     }
-    l = next;
+    if (new_mdelem.md.payload != l->md.payload) {
+      const size_t count = batch->list.count;
+      GRPC_ERROR_UNREF(
+          grpc_metadata_batch_substitute(batch, l, new_mdelem.md));
+      // a failed substitution removes l
+      if (batch->list.count != count) continue;
+    }
+    i++;
   }
   return error;
 }
@@ -365,12 +387,11 @@ void grpc_metadata_batch_copy(grpc_metadata_batch* src,
                               grpc_linked_mdelem* storage) {
   grpc_metadata_batch_init(dst);
   dst->deadline = src->deadline;
-  size_t i = 0;
-  for (grpc_linked_mdelem* elem = src->list.head; elem != nullptr;
-       elem = elem->next) {
+  grpc_linked_mdelem** elems = list_elems(&src->list);
+  for (size_t i = 0; i < src->list.count; i++) {
     // Error unused in non-debug builds.
     grpc_error* GRPC_UNUSED error = grpc_metadata_batch_add_tail(
-        dst, &storage[i++], GRPC_MDELEM_REF(elem->md));
+        dst, &storage[i], GRPC_MDELEM_REF(elems[i]->md));
     // The only way that grpc_metadata_batch_add_tail() can fail is if
     // there's a duplicate entry for a callout.  However, that can't be
     // the case here, because we would not have been allowed to create
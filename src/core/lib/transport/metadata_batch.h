@@ -34,16 +34,21 @@ typedef struct grpc_linked_mdelem {
   grpc_linked_mdelem() {}
 
   grpc_mdelem md;
-  struct grpc_linked_mdelem* next = nullptr;
-  struct grpc_linked_mdelem* prev = nullptr;
-  void* reserved;
 } grpc_linked_mdelem;
 
+/* Number of elements a batch holds without a heap allocation: enough for the
+   initial metadata of a typical call */
+#define GRPC_MDELEM_LIST_INLINE_ELEMS 12
+
+/* The elements of a batch, in order, as a small vector of pointers to their
+   storage */
 typedef struct grpc_mdelem_list {
   size_t count;
   size_t default_count;  // Number of default keys.
-  grpc_linked_mdelem* head;
-  grpc_linked_mdelem* tail;
+  /* Once count outgrows inline_elems, all elements live in overflow */
+  grpc_linked_mdelem** overflow;
+  size_t overflow_capacity;
+  grpc_linked_mdelem* inline_elems[GRPC_MDELEM_LIST_INLINE_ELEMS];
 } grpc_mdelem_list;
 
 typedef struct grpc_metadata_batch {
@@ -56,6 +61,14 @@ typedef struct grpc_metadata_batch {
   grpc_millis deadline;
 } grpc_metadata_batch;
 
+/** Returns the batch->list.count elements of \a batch, in order. Adding or
+    removing elements invalidates the returned array. */
+inline grpc_linked_mdelem* const* grpc_metadata_batch_elems(
+    const grpc_metadata_batch* batch) {
+  return batch->list.overflow != nullptr ? batch->list.overflow
+                                         : batch->list.inline_elems;
+}
+
 void grpc_metadata_batch_init(grpc_metadata_batch* batch);
 void grpc_metadata_batch_destroy(grpc_metadata_batch* batch);
 void grpc_metadata_batch_clear(grpc_metadata_batch* batch);
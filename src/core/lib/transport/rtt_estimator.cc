@@ -0,0 +1,45 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/transport/rtt_estimator.h"
+
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc_core {
+
+namespace {
+// weight of a new sample in the smoothed round trip time (RFC 6298)
+constexpr double kSmoothingGain = 0.125;
+}  // namespace
+
+void RttEstimator::AddSample(double rtt) {
+  if (rtt <= 0) return;
+  smoothed_rtt_ = sample_count_ == 0
+                      ? rtt
+                      : smoothed_rtt_ + kSmoothingGain * (rtt - smoothed_rtt_);
+  samples_[sample_index_] = rtt;
+  sample_index_ = (sample_index_ + 1) % kMinRttWindow;
+  sample_count_ = GPR_MIN(sample_count_ + 1, kMinRttWindow);
+  min_rtt_ = rtt;
+  for (int i = 0; i < sample_count_; i++) {
+    min_rtt_ = GPR_MIN(min_rtt_, samples_[i]);
+  }
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,53 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GRPC_CORE_LIB_TRANSPORT_RTT_ESTIMATOR_H
+#define GRPC_CORE_LIB_TRANSPORT_RTT_ESTIMATOR_H
+
+#include <grpc/support/port_platform.h>
+
+/* \file Round trip time estimates from samples such as ping round trips: a
+   smoothed round trip time that follows the samples the way TCP's does
+   (RFC 6298), and the min round trip time over the last few samples, which
+   leaves out the time samples spent queued behind other data. */
+
+namespace grpc_core {
+
+class RttEstimator {
+ public:
+  // Number of samples the min round trip time is taken over
+  static constexpr int kMinRttWindow = 10;
+
+  // Adds a sample that took rtt seconds
+  void AddSample(double rtt);
+
+  // Both in seconds, 0 before the first sample
+  double SmoothedRtt() const { return smoothed_rtt_; }
+  double MinRtt() const { return min_rtt_; }
+
+ private:
+  // ring buffer of recent samples
+  double samples_[kMinRttWindow] = {};
+  int sample_index_ = 0;
+  int sample_count_ = 0;
+  double smoothed_rtt_ = 0;
+  double min_rtt_ = 0;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_TRANSPORT_RTT_ESTIMATOR_H */
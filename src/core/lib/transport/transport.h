@@ -291,6 +291,10 @@ struct grpc_transport_stream_op_batch_payload {
     grpc_core::OrphanablePtr<grpc_core::ByteStream>* recv_message = nullptr;
     /** Should be enqueued when one message is ready to be processed. */
     grpc_closure* recv_message_ready = nullptr;
+    // If not NULL, will be set to true if the message after this one has
+    // already been received in full, so that a recv_message op started
+    // right away completes without waiting for the peer.
+    bool* next_message_available = nullptr;
   } recv_message;
 
   struct {
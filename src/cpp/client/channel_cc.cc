@@ -39,7 +39,9 @@
 #include <grpcpp/support/channel_arguments.h>
 #include <grpcpp/support/config.h>
 #include <grpcpp/support/status.h>
+#include "src/core/ext/filters/client_channel/client_channel_channelz.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/completion_queue.h"
 
 void ::grpc::experimental::ChannelResetConnectionBackoff(Channel* channel) {
@@ -99,6 +101,22 @@ grpc::string Channel::GetServiceConfigJSON() const {
                              &channel_info.service_config_json);
 }
 
+bool Channel::GetRoundTripTimes(std::chrono::microseconds* smoothed_rtt,
+                                std::chrono::microseconds* min_rtt) const {
+  grpc_core::channelz::ChannelNode* channel_node =
+      grpc_channel_get_channelz_node(c_channel_);
+  int64_t smoothed_rtt_us;
+  int64_t min_rtt_us;
+  if (channel_node == nullptr ||
+      !grpc_core::channelz::GetRoundTripTimes(channel_node, &smoothed_rtt_us,
+                                              &min_rtt_us)) {
+    return false;
+  }
+  *smoothed_rtt = std::chrono::microseconds(smoothed_rtt_us);
+  *min_rtt = std::chrono::microseconds(min_rtt_us);
+  return true;
+}
+
 namespace experimental {
 
 void ChannelResetConnectionBackoff(Channel* channel) {
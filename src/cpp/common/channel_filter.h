@@ -59,11 +59,11 @@ class MetadataBatch {
   class const_iterator : public std::iterator<std::bidirectional_iterator_tag,
                                               const grpc_mdelem> {
    public:
-    const grpc_mdelem& operator*() const { return elem_->md; }
-    const grpc_mdelem operator->() const { return elem_->md; }
+    const grpc_mdelem& operator*() const { return (*elem_)->md; }
+    const grpc_mdelem operator->() const { return (*elem_)->md; }
 
     const_iterator& operator++() {
-      elem_ = elem_->next;
+      ++elem_;
       return *this;
     }
     const_iterator operator++(int) {
@@ -72,7 +72,7 @@ class MetadataBatch {
       return tmp;
     }
     const_iterator& operator--() {
-      elem_ = elem_->prev;
+      --elem_;
       return *this;
     }
     const_iterator operator--(int) {
@@ -90,13 +90,18 @@ class MetadataBatch {
 
    private:
     friend class MetadataBatch;
-    explicit const_iterator(grpc_linked_mdelem* elem) : elem_(elem) {}
+    explicit const_iterator(grpc_linked_mdelem* const* elem) : elem_(elem) {}
 
-    grpc_linked_mdelem* elem_;
+    grpc_linked_mdelem* const* elem_;
   };
 
-  const_iterator begin() const { return const_iterator(batch_->list.head); }
-  const_iterator end() const { return const_iterator(nullptr); }
+  const_iterator begin() const {
+    return const_iterator(grpc_metadata_batch_elems(batch_));
+  }
+  const_iterator end() const {
+    return const_iterator(grpc_metadata_batch_elems(batch_) +
+                          batch_->list.count);
+  }
 
  private:
   grpc_metadata_batch* batch_;  // Not owned.
@@ -29,6 +29,7 @@ BAD_CLIENT_TESTS = {
     'badreq': default_test_options,
     'bad_streaming_id': default_test_options,
     'connection_prefix': default_test_options._replace(cpu_cost=0.2),
+    'data_frames': default_test_options,
     'duplicate_header': default_test_options,
     'headers': default_test_options._replace(cpu_cost=0.2),
     'initial_settings_frame': default_test_options._replace(cpu_cost=0.2),
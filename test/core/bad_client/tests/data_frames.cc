@@ -0,0 +1,280 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Exercises how the chttp2 DATA parser hands received messages to the call:
+ * messages that arrive whole in one read, messages fragmented across reads
+ * and DATA frames, and messages that complete before their DATA frame does. */
+
+#include "test/core/bad_client/bad_client.h"
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/surface/server.h"
+#include "test/core/end2end/cq_verifier.h"
+
+#define PFX_STR                                               \
+  "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"                          \
+  "\x00\x00\x00\x04\x00\x00\x00\x00\x00" /* settings frame */ \
+  "\x00\x00\xd0\x01\x04\x00\x00\x00\x01"                      \
+  "\x10\x05:path\x0f/registered/bar"                          \
+  "\x10\x07:scheme\x04http"                                   \
+  "\x10\x07:method\x04POST"                                   \
+  "\x10\x0a:authority\x09localhost"                           \
+  "\x10\x0c"                                                  \
+  "content-type\x10"                                          \
+  "application/grpc"                                          \
+  "\x10\x14grpc-accept-encoding\x15identity,deflate,gzip"     \
+  "\x10\x02te\x08trailers"                                    \
+  "\x10\x0auser-agent\"bad-client grpc-c/0.12.0.0 (linux)"
+
+#define MAX_DATA_FRAME_SIZE 16384
+
+/* the message the server is expected to receive first on stream 1 */
+static std::string g_expected_message;
+/* the message the server is expected to receive next, if any */
+static std::string g_expected_second_message;
+/* set by the server once it has received (and checked) each message */
+static gpr_event g_message_received;
+static gpr_event g_second_message_received;
+
+static void* tag(intptr_t t) { return (void*)t; }
+
+static std::string make_payload(size_t length) {
+  std::string payload;
+  for (size_t i = 0; i < length; i++) {
+    payload.push_back(static_cast<char>('a' + i % 26));
+  }
+  return payload;
+}
+
+/* Returns \a payload with the 5 byte gRPC message header prepended */
+static std::string make_grpc_message(const std::string& payload) {
+  const uint32_t length = static_cast<uint32_t>(payload.size());
+  std::string message;
+  message.push_back('\x00');
+  message.push_back(static_cast<char>(length >> 24));
+  message.push_back(static_cast<char>(length >> 16));
+  message.push_back(static_cast<char>(length >> 8));
+  message.push_back(static_cast<char>(length));
+  return message + payload;
+}
+
+static std::string make_data_frame_header(size_t length) {
+  std::string header;
+  header.push_back(static_cast<char>(length >> 16));
+  header.push_back(static_cast<char>(length >> 8));
+  header.push_back(static_cast<char>(length));
+  /* type DATA, no flags, stream 1 */
+  header.append("\x00\x00\x00\x00\x00\x01", 6);
+  return header;
+}
+
+/* Splits \a bytes into DATA frames on stream 1 of at most
+ * MAX_DATA_FRAME_SIZE bytes each */
+static std::string make_data_frames(const std::string& bytes) {
+  std::string frames;
+  for (size_t i = 0; i < bytes.size(); i += MAX_DATA_FRAME_SIZE) {
+    const std::string chunk = bytes.substr(i, MAX_DATA_FRAME_SIZE);
+    frames += make_data_frame_header(chunk.size()) + chunk;
+  }
+  return frames;
+}
+
+static void verifier_receives_message(grpc_server* server,
+                                      grpc_completion_queue* cq,
+                                      void* registered_method) {
+  grpc_call_error error;
+  grpc_call* s;
+  cq_verifier* cqv = cq_verifier_create(cq);
+  grpc_metadata_array request_metadata_recv;
+  gpr_timespec deadline;
+  grpc_byte_buffer* payload = nullptr;
+
+  grpc_metadata_array_init(&request_metadata_recv);
+
+  error = grpc_server_request_registered_call(server, registered_method, &s,
+                                              &deadline, &request_metadata_recv,
+                                              &payload, cq, cq, tag(101));
+  GPR_ASSERT(GRPC_CALL_OK == error);
+  CQ_EXPECT_COMPLETION(cqv, tag(101), 1);
+  cq_verify(cqv);
+
+  GPR_ASSERT(payload != nullptr);
+  GPR_ASSERT(byte_buffer_eq_slice(
+      payload, grpc_slice_from_copied_buffer(g_expected_message.data(),
+                                             g_expected_message.size())));
+  gpr_event_set(&g_message_received, (void*)1);
+
+  grpc_metadata_array_destroy(&request_metadata_recv);
+  grpc_call_unref(s);
+  grpc_byte_buffer_destroy(payload);
+  cq_verifier_destroy(cqv);
+}
+
+/* Client side validator that waits for the server to set the gpr_event
+ * \a arg, so that the bytes of the next arg are only sent after that */
+static bool wait_for_server_validator(grpc_slice_buffer* /*incoming*/,
+                                      void* arg) {
+  GPR_ASSERT(gpr_event_wait(static_cast<gpr_event*>(arg),
+                            grpc_timeout_seconds_to_deadline(5)));
+  return true;
+}
+
+/* Sends \a bytes after PFX_STR, split at each offset in \a splits, as a
+ * separate endpoint write per piece */
+static void run_test(const std::string& bytes,
+                     const std::vector<size_t>& splits) {
+  std::vector<std::string> pieces;
+  size_t start = 0;
+  for (size_t split : splits) {
+    pieces.push_back(bytes.substr(start, split - start));
+    start = split;
+  }
+  pieces.push_back(bytes.substr(start));
+  pieces.front().insert(0, PFX_STR, sizeof(PFX_STR) - 1);
+
+  std::vector<grpc_bad_client_arg> args;
+  for (const std::string& piece : pieces) {
+    args.push_back({nullptr, nullptr, piece.data(), piece.size()});
+  }
+  gpr_event_init(&g_message_received);
+  grpc_run_bad_client_test(verifier_receives_message, args.data(),
+                           static_cast<int>(args.size()), 0);
+  GPR_ASSERT(gpr_event_get(&g_message_received) != nullptr);
+}
+
+/* A whole message in one DATA frame, in one read: the fast path */
+static void test_single_read() {
+  g_expected_message = make_payload(100);
+  run_test(make_data_frames(make_grpc_message(g_expected_message)), {});
+}
+
+/* The same frame split inside the frame header, the gRPC message header and
+ * the payload */
+static void test_fragmented_reads() {
+  g_expected_message = make_payload(100);
+  const std::string frames =
+      make_data_frames(make_grpc_message(g_expected_message));
+  run_test(frames, {4, 9, 11, 14, 50, 108});
+}
+
+/* A message spanning several maximum size DATA frames, read in chunks that
+ * do not line up with the frames */
+static void test_multi_frame_message() {
+  g_expected_message = make_payload(60000);
+  const std::string frames =
+      make_data_frames(make_grpc_message(g_expected_message));
+  std::vector<size_t> splits;
+  for (size_t split = 7000; split < frames.size(); split += 7000) {
+    splits.push_back(split);
+  }
+  run_test(frames, splits);
+}
+
+static void verifier_receives_two_messages(grpc_server* server,
+                                           grpc_completion_queue* cq,
+                                           void* registered_method) {
+  grpc_call_error error;
+  grpc_call* s;
+  cq_verifier* cqv = cq_verifier_create(cq);
+  grpc_metadata_array request_metadata_recv;
+  gpr_timespec deadline;
+  grpc_byte_buffer* payload = nullptr;
+  grpc_byte_buffer* second_payload = nullptr;
+  grpc_op op;
+
+  grpc_metadata_array_init(&request_metadata_recv);
+
+  error = grpc_server_request_registered_call(server, registered_method, &s,
+                                              &deadline, &request_metadata_recv,
+                                              &payload, cq, cq, tag(101));
+  GPR_ASSERT(GRPC_CALL_OK == error);
+  CQ_EXPECT_COMPLETION(cqv, tag(101), 1);
+  cq_verify(cqv);
+  GPR_ASSERT(byte_buffer_eq_slice(
+      payload, grpc_slice_from_copied_buffer(g_expected_message.data(),
+                                             g_expected_message.size())));
+
+  memset(&op, 0, sizeof(op));
+  op.op = GRPC_OP_RECV_MESSAGE;
+  op.data.recv_message.recv_message = &second_payload;
+  error = grpc_call_start_batch(s, &op, 1, tag(102), nullptr);
+  GPR_ASSERT(GRPC_CALL_OK == error);
+  gpr_event_set(&g_message_received, (void*)1);
+  CQ_EXPECT_COMPLETION(cqv, tag(102), 1);
+  cq_verify(cqv);
+  GPR_ASSERT(byte_buffer_eq_slice(
+      second_payload,
+      grpc_slice_from_copied_buffer(g_expected_second_message.data(),
+                                    g_expected_second_message.size())));
+  gpr_event_set(&g_second_message_received, (void*)1);
+
+  grpc_metadata_array_destroy(&request_metadata_recv);
+  grpc_call_unref(s);
+  grpc_byte_buffer_destroy(payload);
+  grpc_byte_buffer_destroy(second_payload);
+  cq_verifier_destroy(cqv);
+}
+
+/* A message that completes within the first part of a DATA frame is delivered
+ * to a pending recv_message without waiting for the rest of the frame. */
+static void test_message_before_end_of_frame() {
+  g_expected_message = make_payload(10);
+  g_expected_second_message = make_payload(20);
+  const std::string second = make_grpc_message(g_expected_second_message);
+  const std::string third = make_grpc_message(make_payload(30));
+  const std::string head = std::string(PFX_STR, sizeof(PFX_STR) - 1) +
+                           make_data_frames(make_grpc_message(
+                               g_expected_message));
+  /* the server answers the ping, which gives the client side validator
+   * something to read */
+  const std::string middle =
+      std::string("\x00\x00\x08\x06\x00\x00\x00\x00\x00"
+                  "\x00\x00\x00\x00\x00\x00\x00\x01",
+                  17) +
+      make_data_frame_header(second.size() + third.size()) + second;
+
+  grpc_bad_client_arg args[3];
+  args[0] = {wait_for_server_validator, &g_message_received, head.data(),
+             head.size()};
+  args[1] = {wait_for_server_validator, &g_second_message_received,
+             middle.data(), middle.size()};
+  args[2] = {nullptr, nullptr, third.data(), third.size()};
+  gpr_event_init(&g_message_received);
+  gpr_event_init(&g_second_message_received);
+  grpc_run_bad_client_test(verifier_receives_two_messages, args, 3, 0);
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+
+  test_single_read();
+  test_fragmented_reads();
+  test_multi_frame_message();
+  test_message_before_end_of_frame();
+
+  grpc_shutdown();
+  return 0;
+}
@@ -243,6 +243,28 @@ void ChannelzSleep(int64_t sleep_us) {
   grpc_core::ExecCtx::Get()->InvalidateNow();
 }
 
+void ValidateSocketRtt(SocketNode* socket, const char* smoothed_rtt,
+                      const char* min_rtt) {
+  char* json_str = socket->RenderJsonString();
+  grpc::testing::ValidateSocketProtoJsonTranslation(json_str);
+  grpc_json* parsed_json = grpc_json_parse_string(json_str);
+  grpc_json* data = GetJsonChild(parsed_json, "data");
+  ASSERT_NE(data, nullptr);
+  if (smoothed_rtt == nullptr) {
+    ValidateJsonArraySize(data, "option", 0);
+  } else {
+    ValidateJsonArraySize(data, "option", 2);
+    grpc_json* option = GetJsonChild(data, "option")->child;
+    EXPECT_STREQ(GetJsonChild(option, "name")->value, "grpc.smoothed_rtt");
+    EXPECT_STREQ(GetJsonChild(option, "value")->value, smoothed_rtt);
+    option = option->next;
+    EXPECT_STREQ(GetJsonChild(option, "name")->value, "grpc.min_rtt");
+    EXPECT_STREQ(GetJsonChild(option, "value")->value, min_rtt);
+  }
+  grpc_json_destroy(parsed_json);
+  gpr_free(json_str);
+}
+
 }  // anonymous namespace
 
 class ChannelzChannelTest : public ::testing::TestWithParam<size_t> {};
@@ -533,6 +555,18 @@ TEST_F(ChannelzRegistryBasedTest, ManyServersTest) {
   ValidateGetServers(10);
 }
 
+TEST(ChannelzSocketTest, RoundTripTimeOptions) {
+  grpc_core::ExecCtx exec_ctx;
+  RefCountedPtr<SocketNode> socket = MakeRefCounted<SocketNode>(
+      nullptr, nullptr, UniquePtr<char>(gpr_strdup("test socket")));
+  // no options until a round trip was measured
+  ValidateSocketRtt(socket.get(), nullptr, nullptr);
+  socket->RecordRtt(1500, 1200);
+  ValidateSocketRtt(socket.get(), "0.001500s", "0.001200s");
+  socket->RecordRtt(2 * GPR_US_PER_SEC + 5, 999999);
+  ValidateSocketRtt(socket.get(), "2.000005s", "0.999999s");
+}
+
 INSTANTIATE_TEST_SUITE_P(ChannelzChannelTestSweep, ChannelzChannelTest,
                          ::testing::Values(0, 8, 64, 1024, 1024 * 1024));
 
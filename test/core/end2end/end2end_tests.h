@@ -34,6 +34,7 @@ typedef struct grpc_end2end_test_config grpc_end2end_test_config;
 #define FEATURE_MASK_DOES_NOT_SUPPORT_RESOURCE_QUOTA_SERVER 64
 #define FEATURE_MASK_DOES_NOT_SUPPORT_NETWORK_STATUS_CHANGE 128
 #define FEATURE_MASK_SUPPORTS_WORKAROUNDS 256
+#define FEATURE_MASK_DOES_NOT_SUPPORT_MESSAGE_BUFFERING 512
 
 #define FAIL_AUTH_CHECK_SERVER_ARG_NAME "fail_auth_check"
 
@@ -74,7 +74,10 @@ void inproc_tear_down(grpc_end2end_test_fixture* f) {
 
 /* All test configurations */
 static grpc_end2end_test_config configs[] = {
-    {"inproc", FEATURE_MASK_SUPPORTS_AUTHORITY_HEADER, nullptr,
+    {"inproc",
+     FEATURE_MASK_SUPPORTS_AUTHORITY_HEADER |
+         FEATURE_MASK_DOES_NOT_SUPPORT_MESSAGE_BUFFERING,
+     nullptr,
      inproc_create_fixture, inproc_init_client, inproc_init_server,
      inproc_tear_down},
 };
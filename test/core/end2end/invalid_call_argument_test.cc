@@ -338,7 +338,7 @@ static void test_receive_message_with_invalid_flags() {
   op = g_state.ops;
   op->op = GRPC_OP_RECV_MESSAGE;
   op->data.recv_message.recv_message = &payload;
-  op->flags = 1;
+  op->flags = 2;
   op->reserved = nullptr;
   op++;
   GPR_ASSERT(GRPC_CALL_ERROR_INVALID_FLAGS ==
@@ -348,6 +348,27 @@ static void test_receive_message_with_invalid_flags() {
   cleanup_test();
 }
 
+static void test_receive_message_batch_without_count() {
+  gpr_log(GPR_INFO, "test_receive_message_batch_without_count");
+
+  grpc_op* op;
+  grpc_byte_buffer* payloads[4];
+  prepare_test(1);
+  op = g_state.ops;
+  op->op = GRPC_OP_RECV_MESSAGE;
+  op->data.recv_message.recv_message = payloads;
+  op->data.recv_message.max_messages = 4;
+  op->data.recv_message.message_count = nullptr;
+  op->flags = GRPC_RECV_MESSAGE_BATCH;
+  op->reserved = nullptr;
+  op++;
+  GPR_ASSERT(GRPC_CALL_ERROR ==
+             grpc_call_start_batch(g_state.call, g_state.ops,
+                                   (size_t)(op - g_state.ops), tag(1),
+                                   nullptr));
+  cleanup_test();
+}
+
 static void test_receive_two_messages_at_the_same_time() {
   gpr_log(GPR_INFO, "test_receive_two_messages_at_the_same_time");
 
@@ -620,6 +641,7 @@ int main(int argc, char** argv) {
   test_send_server_status_from_client();
   test_receive_initial_metadata_twice_at_client();
   test_receive_message_with_invalid_flags();
+  test_receive_message_batch_without_count();
   test_receive_two_messages_at_the_same_time();
   test_recv_close_on_server_from_client();
   test_recv_status_on_client_twice();
@@ -18,6 +18,7 @@
 
 #include "test/core/end2end/end2end_tests.h"
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -28,6 +29,7 @@
 
 #include "src/core/ext/transport/chttp2/transport/frame_ping.h"
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr.h"
@@ -436,9 +438,180 @@ static void test_read_delays_keepalive(grpc_end2end_test_config config) {
   config.tear_down_data(&f);
 }
 
+/* Starts a call, holds it open for \a hold_sec seconds, then finishes it.
+   The completion queue is polled meanwhile so that ping acks get read. */
+static void run_held_call(grpc_end2end_test_fixture* f, cq_verifier* cqv,
+                          int hold_sec) {
+  grpc_call* c;
+  grpc_call* s;
+  grpc_op ops[6];
+  grpc_op* op;
+  grpc_metadata_array trailing_metadata_recv;
+  grpc_metadata_array request_metadata_recv;
+  grpc_call_details call_details;
+  grpc_status_code status;
+  grpc_call_error error;
+  grpc_slice details;
+  int was_cancelled = 2;
+
+  gpr_timespec deadline = n_seconds_from_now(hold_sec + 5);
+  c = grpc_channel_create_call(f->client, nullptr, GRPC_PROPAGATE_DEFAULTS,
+                               f->cq, grpc_slice_from_static_string("/foo"),
+                               nullptr, deadline, nullptr);
+  GPR_ASSERT(c);
+
+  grpc_metadata_array_init(&trailing_metadata_recv);
+  grpc_metadata_array_init(&request_metadata_recv);
+  grpc_call_details_init(&call_details);
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op->data.send_initial_metadata.count = 0;
+  op->flags = 0;
+  op->reserved = nullptr;
+  op++;
+  op->op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  op->flags = 0;
+  op->reserved = nullptr;
+  op++;
+  op->op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  op->data.recv_status_on_client.trailing_metadata = &trailing_metadata_recv;
+  op->data.recv_status_on_client.status = &status;
+  op->data.recv_status_on_client.status_details = &details;
+  op->flags = 0;
+  op->reserved = nullptr;
+  op++;
+  error = grpc_call_start_batch(c, ops, static_cast<size_t>(op - ops), tag(1),
+                                nullptr);
+  GPR_ASSERT(GRPC_CALL_OK == error);
+
+  error =
+      grpc_server_request_call(f->server, &s, &call_details,
+                               &request_metadata_recv, f->cq, f->cq, tag(100));
+  GPR_ASSERT(GRPC_CALL_OK == error);
+  CQ_EXPECT_COMPLETION(cqv, tag(100), 1);
+  cq_verify(cqv);
+
+  if (hold_sec > 0) {
+    cq_verify_empty_timeout(cqv, hold_sec);
+  }
+
+  memset(ops, 0, sizeof(ops));
+  op = ops;
+  op->op = GRPC_OP_SEND_INITIAL_METADATA;
+  op->data.send_initial_metadata.count = 0;
+  op->flags = 0;
+  op->reserved = nullptr;
+  op++;
+  op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  op->data.send_status_from_server.trailing_metadata_count = 0;
+  op->data.send_status_from_server.status = GRPC_STATUS_OK;
+  grpc_slice status_details = grpc_slice_from_static_string("xyz");
+  op->data.send_status_from_server.status_details = &status_details;
+  op->flags = 0;
+  op->reserved = nullptr;
+  op++;
+  op->op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  op->data.recv_close_on_server.cancelled = &was_cancelled;
+  op->flags = 0;
+  op->reserved = nullptr;
+  op++;
+  error = grpc_call_start_batch(s, ops, static_cast<size_t>(op - ops), tag(102),
+                                nullptr);
+  GPR_ASSERT(GRPC_CALL_OK == error);
+
+  CQ_EXPECT_COMPLETION(cqv, tag(102), 1);
+  CQ_EXPECT_COMPLETION(cqv, tag(1), 1);
+  cq_verify(cqv);
+
+  GPR_ASSERT(status == GRPC_STATUS_OK);
+  GPR_ASSERT(was_cancelled == 0);
+
+  grpc_call_unref(c);
+  grpc_call_unref(s);
+
+  grpc_metadata_array_destroy(&trailing_metadata_recv);
+  grpc_metadata_array_destroy(&request_metadata_recv);
+  grpc_call_details_destroy(&call_details);
+  grpc_slice_unref(details);
+}
+
+/* Verify that GRPC_ARG_KEEPALIVE_MAX_TIME_MS backs keepalive off on an idle
+ * connection, and that a call brings it back to GRPC_ARG_KEEPALIVE_TIME_MS.
+ * With a 100ms keepalive time and a 400ms maximum, an idle connection sends
+ * about 8 pings in 3 seconds instead of 30, while a call held open for 2
+ * seconds sees close to 20. */
+static void test_keepalive_idle_backoff(grpc_end2end_test_config config) {
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_arg client_arg_elems[6];
+  client_arg_elems[0] = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_KEEPALIVE_TIME_MS), 100);
+  client_arg_elems[1] = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_KEEPALIVE_MAX_TIME_MS), 400);
+  client_arg_elems[2] = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS), 1);
+  client_arg_elems[3] = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA), 0);
+  client_arg_elems[4] = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_HTTP2_MIN_SENT_PING_INTERVAL_WITHOUT_DATA_MS),
+      0);
+  client_arg_elems[5] = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_HTTP2_BDP_PROBE), 0);
+  grpc_channel_args client_args = {GPR_ARRAY_SIZE(client_arg_elems),
+                                   client_arg_elems};
+  /* the server must tolerate the pings: it sends none itself, so every ping
+     counted below is a client keepalive ping */
+  grpc_arg server_arg_elems[2];
+  server_arg_elems[0] = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_HTTP2_MAX_PING_STRIKES), 0);
+  server_arg_elems[1] = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_HTTP2_BDP_PROBE), 0);
+  grpc_channel_args server_args = {GPR_ARRAY_SIZE(server_arg_elems),
+                                   server_arg_elems};
+  grpc_end2end_test_fixture f = begin_test(
+      config, "test_keepalive_idle_backoff", &client_args, &server_args);
+  cq_verifier* cqv = cq_verifier_create(f.cq);
+  grpc_stats_data before;
+  grpc_stats_data after;
+  /* the tests above leave ping acks disabled */
+  grpc_set_disable_ping_ack(false);
+
+  /* connect */
+  run_held_call(&f, cqv, 0);
+
+  grpc_stats_collect(&before);
+  cq_verify_empty_timeout(cqv, 3);
+  grpc_stats_collect(&after);
+  const gpr_atm idle_pings =
+      after.counters[GRPC_STATS_COUNTER_HTTP2_PINGS_SENT] -
+      before.counters[GRPC_STATS_COUNTER_HTTP2_PINGS_SENT];
+
+  grpc_stats_collect(&before);
+  run_held_call(&f, cqv, 2);
+  grpc_stats_collect(&after);
+  const gpr_atm call_pings =
+      after.counters[GRPC_STATS_COUNTER_HTTP2_PINGS_SENT] -
+      before.counters[GRPC_STATS_COUNTER_HTTP2_PINGS_SENT];
+
+  gpr_log(GPR_INFO, "keepalive pings: %" PRIdPTR " idle, %" PRIdPTR " in call",
+          idle_pings, call_pings);
+  GPR_ASSERT(idle_pings >= 2);
+  GPR_ASSERT(idle_pings < 15);
+  GPR_ASSERT(call_pings >= 10);
+
+  cq_verifier_destroy(cqv);
+  end_test(&f);
+  config.tear_down_data(&f);
+#else
+  (void)config;
+#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+}
+
 void keepalive_timeout(grpc_end2end_test_config config) {
   test_keepalive_timeout(config);
   test_read_delays_keepalive(config);
+  test_keepalive_idle_backoff(config);
 }
 
 void keepalive_timeout_pre_init(void) {}
@@ -73,6 +73,115 @@ static void test(const char* name, size_t init_size, const size_t* allocs,
   static const size_t allocs_##name[] = {__VA_ARGS__}; \
   test(#name, init_size, allocs_##name, GPR_ARRAY_SIZE(allocs_##name))
 
+static void test_reset(void) {
+  gpr_log(GPR_DEBUG, "test_reset");
+
+  Arena* a = Arena::Create(64);
+  char* first = static_cast<char*>(a->Alloc(48));
+  memset(first, 1, 48);
+  // overflow into an additional zone
+  memset(a->Alloc(128), 1, 128);
+  GPR_ASSERT(a->Reset() == 48 + 128);
+  GPR_ASSERT(a->initial_zone_size() == 64);
+  // the initial zone is handed out again from its start
+  GPR_ASSERT(a->Alloc(64) == first);
+  GPR_ASSERT(a->Destroy() == 64);
+}
+
+// Overflows an arena into a zone of the 2KB class, frees it, and returns
+// whether the next such zone reuses it. That may fail if the thread moved to
+// another CPU in between, so callers retry.
+static bool zone_reused(void) {
+  Arena* a = Arena::Create(16);
+  a->Alloc(16);
+  void* zone_alloc = a->Alloc(1500);
+  a->Destroy();
+  a = Arena::Create(16);
+  a->Alloc(16);
+  bool reused = a->Alloc(2000) == zone_alloc;
+  a->Destroy();
+  return reused;
+}
+
+static bool zone_eventually_reused(void) {
+  for (int i = 0; i < 100; i++) {
+    if (zone_reused()) return true;
+  }
+  return false;
+}
+
+static void test_zone_cache(void) {
+  gpr_log(GPR_DEBUG, "test_zone_cache");
+
+  // zones allocated before caching is enabled are not of a class size, and
+  // are not cached
+  Arena* uncached = Arena::Create(16);
+  uncached->Alloc(16);
+  uncached->Alloc(1500);
+  Arena::GlobalInit();
+  uncached->Destroy();
+  GPR_ASSERT(Arena::GetZoneCacheStats().cached_zones == 0);
+
+  Arena* a = Arena::Create(16);
+  a->Alloc(16);
+  a->Alloc(1500);
+  Arena::Stats stats = a->GetStats();
+  GPR_ASSERT(stats.zone_count == 1);
+  GPR_ASSERT(stats.overflow_bytes == 1504);
+  GPR_ASSERT(a->Reset() == 16 + 1504);
+  GPR_ASSERT(a->GetStats().zone_count == 0);
+  GPR_ASSERT(Arena::GetZoneCacheStats().cached_zones == 1);
+  a->Destroy();
+
+  // small zones are left to malloc
+  a = Arena::Create(16);
+  a->Alloc(16);
+  a->Alloc(100);
+  a->Destroy();
+  GPR_ASSERT(Arena::GetZoneCacheStats().cached_zones == 1);
+
+  const size_t hits = Arena::GetZoneCacheStats().hits;
+  GPR_ASSERT(zone_eventually_reused());
+  GPR_ASSERT(Arena::GetZoneCacheStats().hits > hits);
+
+  Arena::TrimZoneCaches();
+  Arena::ZoneCacheStats cache_stats = Arena::GetZoneCacheStats();
+  GPR_ASSERT(cache_stats.cached_zones == 0);
+  GPR_ASSERT(cache_stats.cached_bytes == 0);
+  Arena::GlobalShutdown();
+}
+
+#define ZONE_CACHE_CHURN_THREADS 256
+
+static void zone_cache_churn_body(void* /*arg*/) {
+  // Leave zones of several classes cached behind
+  for (size_t size = 1000; size < 64 * 1024; size *= 2) {
+    Arena* a = Arena::Create(16);
+    a->Alloc(16);
+    a->Alloc(size);
+    a->Destroy();
+  }
+}
+
+// Threads that cache zones and exit must not use up the cache for everyone
+// else
+static void test_zone_cache_thread_churn(void) {
+  gpr_log(GPR_DEBUG, "test_zone_cache_thread_churn");
+
+  Arena::GlobalInit();
+  for (int i = 0; i < ZONE_CACHE_CHURN_THREADS; i++) {
+    grpc_core::Thread thd("grpc_zone_cache_churn", zone_cache_churn_body,
+                          nullptr);
+    thd.Start();
+    thd.Join();
+  }
+  GPR_ASSERT(Arena::GetZoneCacheStats().cached_bytes <= 4 * 1024 * 1024);
+  GPR_ASSERT(zone_eventually_reused());
+  Arena::TrimZoneCaches();
+  GPR_ASSERT(Arena::GetZoneCacheStats().cached_bytes == 0);
+  Arena::GlobalShutdown();
+}
+
 #define CONCURRENT_TEST_THREADS 10
 
 size_t concurrent_test_iterations() {
@@ -127,6 +236,9 @@ int main(int argc, char* argv[]) {
   TEST(1_3, 1, 3);
   TEST(1_inc, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
   TEST(6_123, 6, 1, 2, 3);
+  test_reset();
+  test_zone_cache();
+  test_zone_cache_thread_churn();
   concurrent_test();
 
   return 0;
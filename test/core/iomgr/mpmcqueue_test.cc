@@ -38,7 +38,7 @@ struct WorkItem {
 // produced items on destructing.
 class ProducerThread {
  public:
-  ProducerThread(grpc_core::InfLenFIFOQueue* queue, int start_index,
+  ProducerThread(grpc_core::MPMCQueueInterface* queue, int start_index,
                  int num_items)
       : start_index_(start_index), num_items_(num_items), queue_(queue) {
     items_ = nullptr;
@@ -69,7 +69,7 @@ class ProducerThread {
 
   int start_index_;
   int num_items_;
-  grpc_core::InfLenFIFOQueue* queue_;
+  grpc_core::MPMCQueueInterface* queue_;
   grpc_core::Thread thd_;
   WorkItem** items_;
 };
@@ -77,7 +77,7 @@ class ProducerThread {
 // Thread to pull out items from queue
 class ConsumerThread {
  public:
-  ConsumerThread(grpc_core::InfLenFIFOQueue* queue) : queue_(queue) {
+  ConsumerThread(grpc_core::MPMCQueueInterface* queue) : queue_(queue) {
     thd_ = grpc_core::Thread(
         "mpmcq_test_consumer_thd",
         [](void* th) { static_cast<ConsumerThread*>(th)->Run(); }, this);
@@ -101,7 +101,7 @@ class ConsumerThread {
 
     gpr_log(GPR_DEBUG, "ConsumerThread: %d times of Get() called.", count);
   }
-  grpc_core::InfLenFIFOQueue* queue_;
+  grpc_core::MPMCQueueInterface* queue_;
   grpc_core::Thread thd_;
 };
 
@@ -170,11 +170,9 @@ static void test_space_efficiency(void) {
   gpr_log(GPR_DEBUG, "Done.");
 }
 
-static void test_many_thread(void) {
-  gpr_log(GPR_INFO, "test_many_thread");
+static void test_many_thread(grpc_core::MPMCQueueInterface* queue) {
   const int num_producer_threads = 10;
   const int num_consumer_threads = 20;
-  grpc_core::InfLenFIFOQueue queue;
   ProducerThread** producer_threads = static_cast<ProducerThread**>(
       gpr_zalloc(num_producer_threads * sizeof(ProducerThread*)));
   ConsumerThread** consumer_threads = static_cast<ConsumerThread**>(
@@ -183,13 +181,13 @@ static void test_many_thread(void) {
   gpr_log(GPR_DEBUG, "Fork ProducerThreads...");
   for (int i = 0; i < num_producer_threads; ++i) {
     producer_threads[i] = grpc_core::New<ProducerThread>(
-        &queue, i * TEST_NUM_ITEMS, TEST_NUM_ITEMS);
+        queue, i * TEST_NUM_ITEMS, TEST_NUM_ITEMS);
     producer_threads[i]->Start();
   }
   gpr_log(GPR_DEBUG, "ProducerThreads Started.");
   gpr_log(GPR_DEBUG, "Fork ConsumerThreads...");
   for (int i = 0; i < num_consumer_threads; ++i) {
-    consumer_threads[i] = grpc_core::New<ConsumerThread>(&queue);
+    consumer_threads[i] = grpc_core::New<ConsumerThread>(queue);
     consumer_threads[i]->Start();
   }
   gpr_log(GPR_DEBUG, "ConsumerThreads Started.");
@@ -200,7 +198,7 @@ static void test_many_thread(void) {
   gpr_log(GPR_DEBUG, "All ProducerThreads Terminated.");
   gpr_log(GPR_DEBUG, "Terminating ConsumerThreads...");
   for (int i = 0; i < num_consumer_threads; ++i) {
-    queue.Put(nullptr);
+    queue->Put(nullptr);
   }
   for (int i = 0; i < num_consumer_threads; ++i) {
     consumer_threads[i]->Join();
@@ -219,12 +217,65 @@ static void test_many_thread(void) {
   gpr_log(GPR_DEBUG, "Done.");
 }
 
+static void test_lock_free_FIFO(void) {
+  gpr_log(GPR_INFO, "test_lock_free_FIFO");
+  grpc_core::InfLenLockFreeQueue large_queue;
+  // Fills the ring and spills the rest into the overflow list.
+  for (int i = 0; i < TEST_NUM_ITEMS; ++i) {
+    large_queue.Put(static_cast<void*>(grpc_core::New<WorkItem>(i)));
+  }
+  GPR_ASSERT(large_queue.count() == TEST_NUM_ITEMS);
+  GPR_ASSERT(large_queue.overflow_count() ==
+             TEST_NUM_ITEMS - large_queue.ring_size());
+  for (int i = 0; i < TEST_NUM_ITEMS / 2; ++i) {
+    WorkItem* item = static_cast<WorkItem*>(large_queue.Get());
+    GPR_ASSERT(i == item->index);
+    grpc_core::Delete(item);
+  }
+  // The ring has free cells again, but new elements must queue up behind the
+  // overflow list rather than overtake it.
+  for (int i = TEST_NUM_ITEMS; i < TEST_NUM_ITEMS * 2; ++i) {
+    large_queue.Put(static_cast<void*>(grpc_core::New<WorkItem>(i)));
+  }
+  for (int i = TEST_NUM_ITEMS / 2; i < TEST_NUM_ITEMS * 2; ++i) {
+    WorkItem* item = static_cast<WorkItem*>(large_queue.Get());
+    GPR_ASSERT(i == item->index);
+    grpc_core::Delete(item);
+  }
+  GPR_ASSERT(large_queue.count() == 0);
+  GPR_ASSERT(large_queue.overflow_count() == 0);
+  // With the overflow list drained, elements go back through the ring.
+  for (int i = 0; i < large_queue.ring_size(); ++i) {
+    large_queue.Put(static_cast<void*>(grpc_core::New<WorkItem>(i)));
+  }
+  GPR_ASSERT(large_queue.overflow_count() == 0);
+  for (int i = 0; i < large_queue.ring_size(); ++i) {
+    WorkItem* item = static_cast<WorkItem*>(large_queue.Get());
+    GPR_ASSERT(i == item->index);
+    grpc_core::Delete(item);
+  }
+}
+
+static void test_many_thread_fifo_queue(void) {
+  gpr_log(GPR_INFO, "test_many_thread_fifo_queue");
+  grpc_core::InfLenFIFOQueue queue;
+  test_many_thread(&queue);
+}
+
+static void test_many_thread_lock_free_queue(void) {
+  gpr_log(GPR_INFO, "test_many_thread_lock_free_queue");
+  grpc_core::InfLenLockFreeQueue queue;
+  test_many_thread(&queue);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
   test_FIFO();
   test_space_efficiency();
-  test_many_thread();
+  test_lock_free_FIFO();
+  test_many_thread_fifo_queue();
+  test_many_thread_lock_free_queue();
   grpc_shutdown();
   return 0;
 }
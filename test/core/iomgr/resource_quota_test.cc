@@ -750,6 +750,123 @@ static void test_one_slice_deleted_late(void) {
   }
 }
 
+static void test_pooled_slice_is_recycled(void) {
+  gpr_log(GPR_INFO, "** test_pooled_slice_is_recycled **");
+
+  grpc_resource_quota* q =
+      grpc_resource_quota_create("test_pooled_slice_is_recycled");
+  grpc_resource_quota_resize(q, 1024 * 1024);
+
+  grpc_resource_user* usr = grpc_resource_user_create(q, "usr");
+
+  grpc_resource_user_slice_allocator alloc;
+  int num_allocs = 0;
+  grpc_resource_user_slice_allocator_init(&alloc, usr, inc_int_cb, &num_allocs);
+
+  const size_t size = grpc_resource_quota_pooled_slice_size(4000);
+  GPR_ASSERT(size >= 4000);
+  GPR_ASSERT(grpc_resource_quota_pooled_slice_size(size) == size);
+
+  grpc_slice_buffer buffer;
+  grpc_slice_buffer_init(&buffer);
+
+  uint8_t* first_bytes;
+  {
+    const int start_allocs = num_allocs;
+    grpc_core::ExecCtx exec_ctx;
+    if (!grpc_resource_user_alloc_slices(&alloc, size, 1, &buffer)) {
+      grpc_core::ExecCtx::Get()->Flush();
+      assert_counter_becomes(&num_allocs, start_allocs + 1);
+    }
+    GPR_ASSERT(buffer.count == 1);
+    GPR_ASSERT(GRPC_SLICE_LENGTH(buffer.slices[0]) == size);
+    first_bytes = GRPC_SLICE_START_PTR(buffer.slices[0]);
+    grpc_slice_buffer_reset_and_unref_internal(&buffer);
+  }
+  {
+    const int start_allocs = num_allocs;
+    grpc_core::ExecCtx exec_ctx;
+    if (!grpc_resource_user_alloc_slices(&alloc, size, 1, &buffer)) {
+      grpc_core::ExecCtx::Get()->Flush();
+      assert_counter_becomes(&num_allocs, start_allocs + 1);
+    }
+    GPR_ASSERT(buffer.count == 1);
+    GPR_ASSERT(GRPC_SLICE_START_PTR(buffer.slices[0]) == first_bytes);
+    GPR_ASSERT(grpc_resource_quota_peek_used(q) == size);
+    grpc_slice_buffer_destroy_internal(&buffer);
+  }
+  destroy_user(usr);
+  grpc_resource_quota_unref(q);
+}
+
+static void test_warm_pool_stays_charged(void) {
+  gpr_log(GPR_INFO, "** test_warm_pool_stays_charged **");
+
+  grpc_resource_quota* q =
+      grpc_resource_quota_create("test_warm_pool_stays_charged");
+  grpc_resource_quota_resize(q, 1024 * 1024);
+
+  grpc_resource_user* usr = grpc_resource_user_create(q, "usr");
+
+  grpc_resource_user_slice_allocator alloc;
+  int num_allocs = 0;
+  grpc_resource_user_slice_allocator_init(&alloc, usr, inc_int_cb, &num_allocs);
+
+  const size_t size = grpc_resource_quota_pooled_slice_size(4096);
+  const size_t count = 4;
+
+  grpc_slice_buffer buffer;
+  grpc_slice_buffer_init(&buffer);
+
+  for (int i = 0; i < 2; i++) {
+    const int start_allocs = num_allocs;
+    grpc_core::ExecCtx exec_ctx;
+    if (!grpc_resource_user_alloc_slices(&alloc, size, count, &buffer)) {
+      grpc_core::ExecCtx::Get()->Flush();
+      assert_counter_becomes(&num_allocs, start_allocs + 1);
+    }
+    /* renting from a warm pool charges the quota only once */
+    GPR_ASSERT(grpc_resource_quota_peek_used(q) == count * size);
+    grpc_slice_buffer_reset_and_unref_internal(&buffer);
+    /* the idle pooled memory is still charged */
+    GPR_ASSERT(grpc_resource_quota_peek_used(q) == count * size);
+  }
+
+  {
+    /* the pool is flushed before an allocation is refused */
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(grpc_resource_user_safe_alloc(usr, 1024 * 1024));
+    GPR_ASSERT(grpc_resource_quota_peek_used(q) == 1024 * 1024);
+    grpc_resource_user_free(usr, 1024 * 1024);
+    GPR_ASSERT(grpc_resource_quota_peek_used(q) == 0);
+  }
+
+  {
+    const int start_allocs = num_allocs;
+    grpc_core::ExecCtx exec_ctx;
+    if (!grpc_resource_user_alloc_slices(&alloc, size, count, &buffer)) {
+      grpc_core::ExecCtx::Get()->Flush();
+      assert_counter_becomes(&num_allocs, start_allocs + 1);
+    }
+    grpc_slice_buffer_reset_and_unref_internal(&buffer);
+    GPR_ASSERT(grpc_resource_quota_peek_used(q) == count * size);
+  }
+  {
+    /* ... and before an allocation waits for reclamation */
+    gpr_event ev;
+    gpr_event_init(&ev);
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(!grpc_resource_user_alloc(usr, 1024 * 1024, set_event(&ev)));
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(gpr_event_wait(&ev, grpc_timeout_seconds_to_deadline(5)) !=
+               nullptr);
+    GPR_ASSERT(grpc_resource_quota_peek_used(q) == 1024 * 1024);
+    grpc_resource_user_free(usr, 1024 * 1024);
+  }
+  destroy_user(usr);
+  grpc_resource_quota_unref(q);
+}
+
 static void test_resize_to_zero(void) {
   gpr_log(GPR_INFO, "** test_resize_to_zero **");
   grpc_resource_quota* q = grpc_resource_quota_create("test_resize_to_zero");
@@ -915,6 +1032,8 @@ int main(int argc, char** argv) {
   test_reclaimers_can_be_posted_repeatedly();
   test_one_slice();
   test_one_slice_deleted_late();
+  test_pooled_slice_is_recycled();
+  test_warm_pool_stays_charged();
   test_resize_to_zero();
   test_negative_rq_free_pool();
   gpr_mu_destroy(&g_mu);
@@ -102,6 +102,11 @@ int main(int argc, char** argv) {
                                grpc_set_socket_low_latency(sock, 1)));
   GPR_ASSERT(GRPC_LOG_IF_ERROR("set_socket_low_latency",
                                grpc_set_socket_low_latency(sock, 0)));
+#ifdef SO_BUSY_POLL
+  /* Positive values above net.core.busy_poll need CAP_NET_ADMIN. */
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("set_socket_busy_poll",
+                               grpc_set_socket_busy_poll(sock, 0)));
+#endif
 
   struct test_socket_mutator mutator;
   grpc_socket_mutator_init(&mutator.base, &mutator_vtable);
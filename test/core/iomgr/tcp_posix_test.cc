@@ -25,6 +25,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <netinet/tcp.h>
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -35,6 +36,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/ev_posix.h"
@@ -299,6 +301,86 @@ static void large_read_test(size_t slice_size) {
   grpc_endpoint_destroy(ep);
 }
 
+/* Write to a TCP socket, then read from it using the grpc_tcp API. Once the
+   kernel has reported how many bytes are queued, reads are sized for those
+   rather than for a recycled size class, which could be twice as large. */
+static void inq_read_test(size_t num_bytes, size_t slice_size) {
+#if defined(GRPC_HAVE_TCP_INQ) && \
+    (defined(GRPC_COLLECT_STATS) || !defined(NDEBUG))
+  int sv[2];
+  grpc_endpoint* ep;
+  struct read_socket_state state;
+  size_t written_bytes;
+  grpc_millis deadline =
+      grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "INQ read test of size %" PRIuPTR ", slice size %" PRIuPTR,
+          num_bytes, slice_size);
+
+  create_inet_sockets(sv);
+  int one = 1;
+  if (setsockopt(sv[1], SOL_TCP, TCP_INQ, &one, sizeof(one)) != 0) {
+    gpr_log(GPR_INFO, "TCP_INQ is not supported: skipping");
+    close(sv[0]);
+    close(sv[1]);
+    return;
+  }
+
+  grpc_arg a[1];
+  a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
+  a[0].type = GRPC_ARG_INTEGER;
+  a[0].value.integer = static_cast<int>(slice_size);
+  grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  ep = grpc_tcp_create(grpc_fd_create(sv[1], "inq_read_test", false), &args,
+                       "test");
+  grpc_endpoint_add_to_pollset(ep, g_pollset);
+
+  written_bytes = fill_socket_partial(sv[0], num_bytes);
+  gpr_log(GPR_INFO, "Wrote %" PRIuPTR " bytes", written_bytes);
+
+  grpc_stats_data before;
+  grpc_stats_collect(&before);
+
+  state.ep = ep;
+  state.read_bytes = 0;
+  state.target_read_bytes = written_bytes;
+  grpc_slice_buffer_init(&state.incoming);
+  GRPC_CLOSURE_INIT(&state.read_cb, read_cb, &state, grpc_schedule_on_exec_ctx);
+
+  grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false);
+
+  gpr_mu_lock(g_mu);
+  while (state.read_bytes < state.target_read_bytes) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+
+    gpr_mu_lock(g_mu);
+  }
+  GPR_ASSERT(state.read_bytes == state.target_read_bytes);
+  gpr_mu_unlock(g_mu);
+
+  grpc_stats_data after;
+  grpc_stats_collect(&after);
+  int64_t alloc_bytes =
+      after.counters[GRPC_STATS_COUNTER_TCP_READ_ALLOC_BYTES] -
+      before.counters[GRPC_STATS_COUNTER_TCP_READ_ALLOC_BYTES];
+  gpr_log(GPR_INFO, "Allocated %" PRId64 " bytes to read %" PRIuPTR,
+          alloc_bytes, written_bytes);
+  GPR_ASSERT(static_cast<size_t>(alloc_bytes) <
+             written_bytes + written_bytes / 4);
+
+  grpc_slice_buffer_destroy_internal(&state.incoming);
+  grpc_endpoint_destroy(ep);
+  close(sv[0]);
+#else
+  (void)num_bytes;
+  (void)slice_size;
+#endif
+}
+
 struct write_socket_state {
   grpc_endpoint* ep;
   int write_done;
@@ -395,9 +477,10 @@ void timestamps_verifier(void* arg, grpc_core::Timestamps* ts,
 /* Write to a socket using the grpc_tcp API, then drain it directly.
    Note that if the write does not complete immediately we need to drain the
    socket in parallel with the read. If collect_timestamps is true, it will
-   try to get timestamps for the write. */
+   try to get timestamps for the write. If zerocopy is true, the write is sent
+   with MSG_ZEROCOPY where the kernel supports it. */
 static void write_test(size_t num_bytes, size_t slice_size,
-                       bool collect_timestamps) {
+                       bool collect_timestamps, bool zerocopy = false) {
   int sv[2];
   grpc_endpoint* ep;
   struct write_socket_state state;
@@ -410,27 +493,36 @@ static void write_test(size_t num_bytes, size_t slice_size,
       grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
   grpc_core::ExecCtx exec_ctx;
 
-  if (collect_timestamps && !grpc_event_engine_can_track_errors()) {
+  if ((collect_timestamps || zerocopy) &&
+      !grpc_event_engine_can_track_errors()) {
     return;
   }
 
   gpr_log(GPR_INFO,
-          "Start write test with %" PRIuPTR " bytes, slice size %" PRIuPTR,
-          num_bytes, slice_size);
+          "Start write test with %" PRIuPTR " bytes, slice size %" PRIuPTR
+          ", zerocopy %d",
+          num_bytes, slice_size, zerocopy);
 
-  if (collect_timestamps) {
+  if (collect_timestamps || zerocopy) {
     create_inet_sockets(sv);
   } else {
     create_sockets(sv);
   }
 
-  grpc_arg a[1];
+  grpc_arg a[3];
   a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
   a[0].type = GRPC_ARG_INTEGER,
   a[0].value.integer = static_cast<int>(slice_size);
+  a[1].key = const_cast<char*>(GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED);
+  a[1].type = GRPC_ARG_INTEGER;
+  a[1].value.integer = zerocopy;
+  a[2].key = const_cast<char*>(GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD);
+  a[2].type = GRPC_ARG_INTEGER;
+  a[2].value.integer = 0;
   grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
-  ep = grpc_tcp_create(grpc_fd_create(sv[1], "write_test", collect_timestamps),
-                       &args, "test");
+  ep = grpc_tcp_create(
+      grpc_fd_create(sv[1], "write_test", collect_timestamps || zerocopy),
+      &args, "test");
   grpc_endpoint_add_to_pollset(ep, g_pollset);
 
   state.ep = ep;
@@ -472,6 +564,157 @@ static void write_test(size_t num_bytes, size_t slice_size,
   gpr_free(slices);
 }
 
+static gpr_atm g_zerocopy_slices_freed;
+
+static void zerocopy_destroy_write_done(void* arg, grpc_error* error) {
+  GPR_ASSERT(error != GRPC_ERROR_NONE);
+  int* done = static_cast<int*>(arg);
+  gpr_mu_lock(g_mu);
+  *done = 1;
+  GPR_ASSERT(
+      GRPC_LOG_IF_ERROR("pollset_kick", grpc_pollset_kick(g_pollset, nullptr)));
+  gpr_mu_unlock(g_mu);
+}
+
+/* Scribbles over the slice, so that releasing it while the kernel still sends
+   from it corrupts what the peer reads. */
+static void zerocopy_destroy_free_slice(void* p, size_t len) {
+  memset(p, 0xff, len);
+  gpr_free(p);
+  gpr_atm_full_fetch_add(&g_zerocopy_slices_freed, 1);
+}
+
+/* Destroy a zerocopy endpoint while the kernel still holds the pages of a
+   write that the peer has not read yet. The slices must stay alive and intact
+   until the peer has received everything, and be released after. */
+static void zerocopy_destroy_in_flight_test(size_t num_bytes,
+                                            size_t slice_size) {
+  int sv[2];
+  grpc_endpoint* ep;
+  int write_done = 0;
+  grpc_slice_buffer outgoing;
+  grpc_closure write_done_closure;
+  grpc_millis deadline =
+      grpc_timespec_to_millis_round_up(grpc_timeout_seconds_to_deadline(20));
+  grpc_core::ExecCtx exec_ctx;
+
+  if (!grpc_event_engine_can_track_errors()) return;
+#ifdef SO_ZEROCOPY
+  gpr_log(GPR_INFO,
+          "Start zerocopy destroy in flight test with %" PRIuPTR
+          " bytes, slice size %" PRIuPTR,
+          num_bytes, slice_size);
+
+  create_inet_sockets(sv);
+  int enable = 1;
+  if (setsockopt(sv[1], SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) !=
+      0) {
+    gpr_log(GPR_INFO, "MSG_ZEROCOPY is not supported, skipping");
+    close(sv[0]);
+    close(sv[1]);
+    return;
+  }
+  /* Keep the socket buffers small so that the write cannot complete */
+  int buffer_size = 65536;
+  GPR_ASSERT(setsockopt(sv[0], SOL_SOCKET, SO_RCVBUF, &buffer_size,
+                        sizeof(buffer_size)) == 0);
+  GPR_ASSERT(setsockopt(sv[1], SOL_SOCKET, SO_SNDBUF, &buffer_size,
+                        sizeof(buffer_size)) == 0);
+
+  grpc_arg a[2];
+  a[0].key = const_cast<char*>(GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED);
+  a[0].type = GRPC_ARG_INTEGER;
+  a[0].value.integer = 1;
+  a[1].key = const_cast<char*>(GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD);
+  a[1].type = GRPC_ARG_INTEGER;
+  a[1].value.integer = 0;
+  grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  ep = grpc_tcp_create(grpc_fd_create(sv[1], "zerocopy_destroy_test", true),
+                       &args, "test");
+  grpc_endpoint_add_to_pollset(ep, g_pollset);
+
+  uint8_t current_data = 0;
+  size_t num_blocks;
+  grpc_slice* blocks =
+      allocate_blocks(num_bytes, slice_size, &num_blocks, &current_data);
+  grpc_slice_buffer_init(&outgoing);
+  for (size_t i = 0; i < num_blocks; i++) {
+    size_t len = GRPC_SLICE_LENGTH(blocks[i]);
+    void* buf = gpr_malloc(len);
+    memcpy(buf, GRPC_SLICE_START_PTR(blocks[i]), len);
+    grpc_slice slice =
+        grpc_slice_new_with_len(buf, len, zerocopy_destroy_free_slice);
+    grpc_slice_buffer_add(&outgoing, slice);
+    grpc_slice_unref(blocks[i]);
+  }
+  gpr_free(blocks);
+  gpr_atm_no_barrier_store(&g_zerocopy_slices_freed, 0);
+
+  GRPC_CLOSURE_INIT(&write_done_closure, zerocopy_destroy_write_done,
+                    &write_done, grpc_schedule_on_exec_ctx);
+  grpc_endpoint_write(ep, &outgoing, &write_done_closure, nullptr);
+  exec_ctx.Flush();
+  grpc_endpoint_shutdown(ep,
+                         GRPC_ERROR_CREATE_FROM_STATIC_STRING("Test Shutdown"));
+  exec_ctx.Flush();
+  gpr_mu_lock(g_mu);
+  while (!write_done) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    exec_ctx.Flush();
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+  grpc_slice_buffer_destroy_internal(&outgoing);
+  grpc_endpoint_destroy(ep);
+  exec_ctx.Flush();
+  GPR_ASSERT(gpr_atm_full_fetch_add(&g_zerocopy_slices_freed, 0) == 0);
+
+  /* Everything queued before the shutdown still reaches the peer intact,
+     followed by EOF. */
+  int flags = fcntl(sv[0], F_GETFL, 0);
+  GPR_ASSERT(fcntl(sv[0], F_SETFL, flags & ~O_NONBLOCK) == 0);
+  uint8_t buf[65536];
+  uint8_t expected = 0;
+  size_t bytes_read = 0;
+  for (;;) {
+    ssize_t r;
+    do {
+      r = read(sv[0], buf, sizeof(buf));
+    } while (r < 0 && errno == EINTR);
+    GPR_ASSERT(r >= 0);
+    if (r == 0) break;
+    for (ssize_t i = 0; i < r; i++) {
+      GPR_ASSERT(buf[i] == expected);
+      expected++;
+    }
+    bytes_read += static_cast<size_t>(r);
+  }
+  gpr_log(GPR_INFO, "Peer read %" PRIuPTR " bytes", bytes_read);
+  GPR_ASSERT(bytes_read > 0 && bytes_read < num_bytes);
+  close(sv[0]);
+
+  /* Once the kernel is done with them, every slice is released */
+  gpr_timespec release_deadline = grpc_timeout_seconds_to_deadline(20);
+  while (gpr_atm_full_fetch_add(&g_zerocopy_slices_freed, 0) !=
+         static_cast<gpr_atm>(num_blocks)) {
+    GPR_ASSERT(gpr_time_cmp(gpr_now(release_deadline.clock_type),
+                            release_deadline) < 0);
+    grpc_pollset_worker* worker = nullptr;
+    gpr_mu_lock(g_mu);
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(g_pollset, &worker,
+                          grpc_timespec_to_millis_round_up(
+                              grpc_timeout_milliseconds_to_deadline(10)))));
+    gpr_mu_unlock(g_mu);
+    exec_ctx.Flush();
+  }
+#endif /* SO_ZEROCOPY */
+}
+
 void on_fd_released(void* arg, grpc_error* /*errors*/) {
   int* done = static_cast<int*>(arg);
   *done = 1;
@@ -566,6 +809,7 @@ void run_tests(void) {
   read_test(10000, 1);
   large_read_test(8192);
   large_read_test(1);
+  inq_read_test(100000, 1024);
 
   write_test(100, 8192, false);
   write_test(100, 1, false);
@@ -579,6 +823,12 @@ void run_tests(void) {
   write_test(100000, 1, true);
   write_test(100, 137, true);
 
+  write_test(100, 8192, false, true);
+  write_test(100000, 8192, false, true);
+  write_test(100000, 137, false, true);
+  write_test(10000000, 65536, false, true);
+  zerocopy_destroy_in_flight_test(10000000, 65536);
+
   for (i = 1; i < 1000; i = GPR_MAX(i + 1, i * 5 / 4)) {
     write_test(40320, i, false);
     write_test(40320, i, true);
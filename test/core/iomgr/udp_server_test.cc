@@ -359,6 +359,74 @@ static void test_receive(int number_of_clients) {
   shutdown_and_destroy_pollset();
 }
 
+static int bind_loopback_udp_socket(grpc_resolved_address* resolved_addr) {
+  struct sockaddr_in* addr =
+      reinterpret_cast<struct sockaddr_in*>(resolved_addr->addr);
+  memset(resolved_addr, 0, sizeof(*resolved_addr));
+  resolved_addr->len = static_cast<socklen_t>(sizeof(struct sockaddr_in));
+  addr->sin_family = AF_INET;
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  GPR_ASSERT(fd >= 0);
+  GPR_ASSERT(grpc_set_socket_nonblocking(fd, 1) == GRPC_ERROR_NONE);
+  GPR_ASSERT(bind(fd, reinterpret_cast<struct sockaddr*>(addr),
+                  resolved_addr->len) == 0);
+  GPR_ASSERT(getsockname(fd, reinterpret_cast<struct sockaddr*>(addr),
+                         &resolved_addr->len) == 0);
+  return fd;
+}
+
+static void test_batch_io(void) {
+  LOG_TEST("test_batch_io");
+  const size_t kBatchSize = 8;
+  const size_t kDatagrams = 3 * kBatchSize + 3;
+  grpc_resolved_address sender_addr;
+  grpc_resolved_address receiver_addr;
+  int sender_fd = bind_loopback_udp_socket(&sender_addr);
+  int receiver_fd = bind_loopback_udp_socket(&receiver_addr);
+  GrpcUdpBatchIo sender(kBatchSize, 64);
+  /* Only the first 16 bytes of each datagram fit in the receive buffers. */
+  GrpcUdpBatchIo receiver(kBatchSize, 16);
+
+  GPR_ASSERT(receiver.RecvBatch(receiver_fd) == 0);
+
+  uint8_t payloads[kDatagrams][32];
+  GrpcUdpDatagram datagrams[kDatagrams];
+  for (size_t i = 0; i < kDatagrams; i++) {
+    memset(payloads[i], static_cast<int>('a' + i), sizeof(payloads[i]));
+    datagrams[i].addr = receiver_addr;
+    datagrams[i].data = payloads[i];
+    datagrams[i].length = 1 + i;
+  }
+  size_t sent = 0;
+  while (sent < kDatagrams) {
+    int n = sender.SendBatch(sender_fd, datagrams + sent, kDatagrams - sent);
+    GPR_ASSERT(n > 0);
+    GPR_ASSERT(static_cast<size_t>(n) <= kBatchSize);
+    sent += n;
+  }
+
+  size_t received = 0;
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  while (received < kDatagrams) {
+    GPR_ASSERT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0);
+    int n = receiver.RecvBatch(receiver_fd);
+    GPR_ASSERT(n >= 0);
+    GPR_ASSERT(static_cast<size_t>(n) <= kBatchSize);
+    for (int i = 0; i < n; i++, received++) {
+      const GrpcUdpDatagram& d = receiver.datagram(i);
+      GPR_ASSERT(d.length == GPR_MIN(1 + received, 16));
+      GPR_ASSERT(d.data[0] == 'a' + received);
+      GPR_ASSERT(d.addr.len == sender_addr.len);
+      GPR_ASSERT(memcmp(d.addr.addr, sender_addr.addr, sender_addr.len) == 0);
+    }
+  }
+  GPR_ASSERT(receiver.RecvBatch(receiver_fd) == 0);
+
+  close(sender_fd);
+  close(receiver_fd);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(argc, argv);
   grpc_init();
@@ -376,6 +444,7 @@ int main(int argc, char** argv) {
     test_no_op_with_port_and_start();
     test_receive(1);
     test_receive(10);
+    test_batch_io();
 
     gpr_free(g_pollset);
   }
@@ -26,6 +26,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gpr/env.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
@@ -201,12 +202,16 @@ int main(int argc, char** argv) {
 
   int warmup_iterations = 100;
   int benchmark_iterations = 1000;
+  int call_arena_pool_size = -1;
 
   cl = gpr_cmdline_create("memory profiling client");
   gpr_cmdline_add_string(cl, "target", "Target host:port", &target);
   gpr_cmdline_add_int(cl, "warmup", "Warmup iterations", &warmup_iterations);
   gpr_cmdline_add_int(cl, "benchmark", "Benchmark iterations",
                       &benchmark_iterations);
+  gpr_cmdline_add_int(cl, "call_arena_pool_size",
+                      "GRPC_ARG_CALL_ARENA_POOL_SIZE (-1 for the default)",
+                      &call_arena_pool_size);
   gpr_cmdline_parse(cl, argc, argv);
   gpr_cmdline_destroy(cl);
 
@@ -218,7 +223,11 @@ int main(int argc, char** argv) {
 
   struct grpc_memory_counters client_channel_start =
       grpc_memory_counters_snapshot();
-  channel = grpc_insecure_channel_create(target, nullptr, nullptr);
+  grpc_arg pool_size_arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_CALL_ARENA_POOL_SIZE), call_arena_pool_size);
+  grpc_channel_args channel_args = {1, &pool_size_arg};
+  channel = grpc_insecure_channel_create(
+      target, call_arena_pool_size < 0 ? nullptr : &channel_args, nullptr);
 
   int call_idx = 0;
 
@@ -233,6 +242,17 @@ int main(int argc, char** argv) {
         0, grpc_slice_from_static_string("Reflector/SimpleSnapshot"));
   }
 
+  // one call at a time, so that each call can reuse what the previous one
+  // freed
+  struct grpc_memory_counters client_sequential_calls_start =
+      grpc_memory_counters_snapshot();
+  for (int i = 0; i < benchmark_iterations; i++) {
+    send_snapshot_request(
+        0, grpc_slice_from_static_string("Reflector/SimpleSnapshot"));
+  }
+  struct grpc_memory_counters client_sequential_calls_end =
+      grpc_memory_counters_snapshot();
+
   for (call_idx = 0; call_idx < warmup_iterations; ++call_idx) {
     init_ping_pong_request(call_idx + 1);
   }
@@ -293,6 +313,16 @@ int main(int argc, char** argv) {
       static_cast<double>(client_calls_inflight.total_size_relative -
                           client_benchmark_calls_start.total_size_relative) /
           benchmark_iterations);
+  gpr_log(GPR_INFO,
+          "client sequential calls: %f allocations, %f bytes per call",
+          static_cast<double>(
+              client_sequential_calls_end.total_allocs_absolute -
+              client_sequential_calls_start.total_allocs_absolute) /
+              benchmark_iterations,
+          static_cast<double>(
+              client_sequential_calls_end.total_size_absolute -
+              client_sequential_calls_start.total_size_absolute) /
+              benchmark_iterations);
   gpr_log(GPR_INFO, "client channel memory usage %zi bytes",
           client_channel_end.total_size_relative -
               client_channel_start.total_size_relative);
@@ -0,0 +1,246 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Drives the per channel pool of call arenas directly, checking which arenas
+ * are handed out again through the call_arena_pool_hits and
+ * call_arena_pool_misses counters. */
+
+#include <inttypes.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gprpp/arena.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/surface/channel.h"
+#include "test/core/util/memory_counters.h"
+#include "test/core/util/test_config.h"
+
+/* What every arena taken from the pool allocates up front, as a call would */
+#define FIRST_ALLOC_SIZE 64
+
+static grpc_channel* create_channel(int pool_size) {
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_CALL_ARENA_POOL_SIZE), pool_size);
+  grpc_channel_args args = {1, &arg};
+  /* nothing ever connects to the target: only the arenas are used */
+  return grpc_insecure_channel_create(
+      "localhost:1", pool_size < 0 ? nullptr : &args, nullptr);
+}
+
+static grpc_core::Arena* create_arena(grpc_channel* channel, size_t size) {
+  return grpc_channel_create_call_arena(channel, size, FIRST_ALLOC_SIZE).first;
+}
+
+struct pool_counts {
+  int64_t hits;
+  int64_t misses;
+};
+
+static pool_counts get_pool_counts() {
+  pool_counts counts = {0, 0};
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data data;
+  grpc_stats_collect(&data);
+  counts.hits = data.counters[GRPC_STATS_COUNTER_CALL_ARENA_POOL_HITS];
+  counts.misses = data.counters[GRPC_STATS_COUNTER_CALL_ARENA_POOL_MISSES];
+#endif
+  return counts;
+}
+
+/* Checks the hits and misses counted since \a start, when stats are built in */
+static void check_pool_counts(const pool_counts& start, int64_t hits,
+                              int64_t misses) {
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  pool_counts now = get_pool_counts();
+  gpr_log(GPR_DEBUG, "hits: %" PRId64 " misses: %" PRId64,
+          now.hits - start.hits, now.misses - start.misses);
+  GPR_ASSERT(now.hits - start.hits == hits);
+  GPR_ASSERT(now.misses - start.misses == misses);
+#else
+  (void)start;
+  (void)hits;
+  (void)misses;
+#endif
+}
+
+/* The arena of a finished call goes to the next call of the same size */
+static void test_reuse() {
+  gpr_log(GPR_INFO, "test_reuse");
+  grpc_core::ExecCtx exec_ctx;
+  grpc_channel* channel = create_channel(-1);
+  pool_counts start = get_pool_counts();
+  grpc_core::Arena* arena =
+      create_arena(channel, grpc_channel_get_call_size_estimate(channel));
+  grpc_channel_release_call_arena(channel, arena);
+  grpc_core::Arena* reused =
+      create_arena(channel, grpc_channel_get_call_size_estimate(channel));
+  GPR_ASSERT(reused == arena);
+  check_pool_counts(start, 1, 1);
+  grpc_channel_release_call_arena(channel, reused);
+  grpc_channel_destroy(channel);
+}
+
+/* A pooled arena smaller than the next call asks for is destroyed */
+static void test_discard_too_small() {
+  gpr_log(GPR_INFO, "test_discard_too_small");
+  grpc_core::ExecCtx exec_ctx;
+  grpc_channel* channel = create_channel(-1);
+  pool_counts start = get_pool_counts();
+  grpc_core::Arena* arena =
+      create_arena(channel, grpc_channel_get_call_size_estimate(channel));
+  const size_t arena_size = arena->initial_zone_size();
+  grpc_channel_release_call_arena(channel, arena);
+  arena = create_arena(channel, arena_size + 256);
+  GPR_ASSERT(arena->initial_zone_size() == arena_size + 256);
+  check_pool_counts(start, 0, 2);
+  grpc_channel_release_call_arena(channel, arena);
+  grpc_channel_destroy(channel);
+}
+
+/* A pooled arena more than twice the size the next call asks for is
+ * destroyed rather than wasted on it */
+static void test_discard_too_large() {
+  gpr_log(GPR_INFO, "test_discard_too_large");
+  grpc_core::ExecCtx exec_ctx;
+  grpc_channel* channel = create_channel(-1);
+  pool_counts start = get_pool_counts();
+  const size_t size = grpc_channel_get_call_size_estimate(channel);
+  grpc_core::Arena* arena = create_arena(channel, 4 * size);
+  grpc_channel_release_call_arena(channel, arena);
+  /* the estimate only shrinks when an arena is released */
+  GPR_ASSERT(grpc_channel_get_call_size_estimate(channel) <= size);
+  arena = create_arena(channel, size);
+  GPR_ASSERT(arena->initial_zone_size() == size);
+  check_pool_counts(start, 0, 2);
+  /* at exactly twice the size the arena is still reused */
+  grpc_core::Arena* large = create_arena(channel, 2 * size);
+  grpc_channel_release_call_arena(channel, large);
+  grpc_core::Arena* reused = create_arena(channel, size);
+  GPR_ASSERT(reused == large);
+  check_pool_counts(start, 1, 3);
+  grpc_channel_release_call_arena(channel, reused);
+  grpc_channel_release_call_arena(channel, arena);
+  grpc_channel_destroy(channel);
+}
+
+/* An arena that overflowed its initial zone raised the estimate past its own
+ * size, so it is not pooled */
+static void test_discard_overflowed() {
+  gpr_log(GPR_INFO, "test_discard_overflowed");
+  grpc_core::ExecCtx exec_ctx;
+  grpc_channel* channel = create_channel(-1);
+  pool_counts start = get_pool_counts();
+  const size_t size = grpc_channel_get_call_size_estimate(channel);
+  grpc_core::Arena* arena = create_arena(channel, size);
+  arena->Alloc(2 * size);
+  grpc_channel_release_call_arena(channel, arena);
+  GPR_ASSERT(grpc_channel_get_call_size_estimate(channel) > size);
+  arena = create_arena(channel, grpc_channel_get_call_size_estimate(channel));
+  check_pool_counts(start, 0, 2);
+  grpc_channel_release_call_arena(channel, arena);
+  grpc_channel_destroy(channel);
+}
+
+/* No more than GRPC_ARG_CALL_ARENA_POOL_SIZE arenas are kept */
+static void test_pool_size() {
+  gpr_log(GPR_INFO, "test_pool_size");
+  grpc_core::ExecCtx exec_ctx;
+  grpc_channel* channel = create_channel(2);
+  pool_counts start = get_pool_counts();
+  const size_t size = grpc_channel_get_call_size_estimate(channel);
+  grpc_core::Arena* arenas[3];
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(arenas); i++) {
+    arenas[i] = create_arena(channel, size);
+  }
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(arenas); i++) {
+    grpc_channel_release_call_arena(channel, arenas[i]);
+  }
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(arenas); i++) {
+    arenas[i] = create_arena(channel, size);
+  }
+  check_pool_counts(start, 2, 4);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(arenas); i++) {
+    grpc_channel_release_call_arena(channel, arenas[i]);
+  }
+  grpc_channel_destroy(channel);
+}
+
+/* GRPC_ARG_CALL_ARENA_POOL_SIZE of 0 turns pooling off */
+static void test_pool_disabled() {
+  gpr_log(GPR_INFO, "test_pool_disabled");
+  grpc_core::ExecCtx exec_ctx;
+  grpc_channel* channel = create_channel(0);
+  pool_counts start = get_pool_counts();
+  for (int i = 0; i < 3; i++) {
+    grpc_core::Arena* arena =
+        create_arena(channel, grpc_channel_get_call_size_estimate(channel));
+    grpc_channel_release_call_arena(channel, arena);
+  }
+  check_pool_counts(start, 0, 3);
+  grpc_channel_destroy(channel);
+}
+
+/* Fills the pool of a new channel and destroys the channel */
+static void fill_pool_and_destroy_channel() {
+  grpc_channel* channel = create_channel(GRPC_CHANNEL_MAX_CALL_ARENA_POOL_SIZE);
+  const size_t size = grpc_channel_get_call_size_estimate(channel);
+  grpc_core::Arena* arenas[GRPC_CHANNEL_MAX_CALL_ARENA_POOL_SIZE];
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(arenas); i++) {
+    arenas[i] = create_arena(channel, size);
+  }
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(arenas); i++) {
+    grpc_channel_release_call_arena(channel, arenas[i]);
+  }
+  grpc_channel_destroy(channel);
+  grpc_core::ExecCtx::Get()->Flush();
+}
+
+/* Pooled arenas are freed with their channel */
+static void test_freed_on_channel_destroy() {
+  gpr_log(GPR_INFO, "test_freed_on_channel_destroy");
+  grpc_core::ExecCtx exec_ctx;
+  /* the first channel sets up state that lives until shutdown */
+  fill_pool_and_destroy_channel();
+  grpc_memory_counters before = grpc_memory_counters_snapshot();
+  fill_pool_and_destroy_channel();
+  grpc_memory_counters after = grpc_memory_counters_snapshot();
+  gpr_log(GPR_DEBUG, "allocations: %" PRIdPTR " bytes: %" PRIdPTR,
+          after.total_allocs_relative - before.total_allocs_relative,
+          after.total_size_relative - before.total_size_relative);
+  GPR_ASSERT(after.total_allocs_relative == before.total_allocs_relative);
+  GPR_ASSERT(after.total_size_relative == before.total_size_relative);
+}
+
+int main(int argc, char** argv) {
+  grpc_memory_counters_init();
+  grpc::testing::TestEnvironment env(argc, argv);
+  grpc_init();
+  test_reuse();
+  test_discard_too_small();
+  test_discard_too_large();
+  test_discard_overflowed();
+  test_pool_size();
+  test_pool_disabled();
+  test_freed_on_channel_destroy();
+  grpc_shutdown_blocking();
+  grpc_memory_counters_destroy();
+  return 0;
+}
@@ -16,12 +16,17 @@
  *
  */
 
+#include <inttypes.h>
+#include <string.h>
+
 #include <grpc/grpc.h>
 #include <grpc/grpc_security.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gprpp/host_port.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/security/credentials/fake/fake_credentials.h"
@@ -129,6 +134,173 @@ void test_bind_server_to_addr(const char* host, bool secure) {
   grpc_completion_queue_destroy(cq);
 }
 
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+#define NUM_SERVER_CQS 8
+
+static void* tag(intptr_t t) { return (void*)t; }
+
+static int64_t get_counter(grpc_stats_counters counter) {
+  grpc_stats_data data;
+  grpc_stats_collect(&data);
+  return data.counters[counter];
+}
+
+/* Each client channel gets its own connection, accepted on the next server
+   completion queue in turn. Calls on all of them are queued before any
+   request is made, and are then all requested on the first queue, which has
+   to take them from the shards of the other queues. */
+static void test_pending_calls_stolen_across_cqs(void) {
+  gpr_log(GPR_INFO, "test_pending_calls_stolen_across_cqs");
+  int port = grpc_pick_unused_port_or_die();
+  grpc_core::UniquePtr<char> addr;
+  grpc_core::JoinHostPort(&addr, "localhost", port);
+
+  grpc_server* server = grpc_server_create(nullptr, nullptr);
+  GPR_ASSERT(grpc_server_add_insecure_http2_port(server, addr.get()));
+  grpc_completion_queue* server_cqs[NUM_SERVER_CQS];
+  for (size_t i = 0; i < NUM_SERVER_CQS; i++) {
+    server_cqs[i] = grpc_completion_queue_create_for_next(nullptr);
+    grpc_server_register_completion_queue(server, server_cqs[i], nullptr);
+  }
+  grpc_server_start(server);
+
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL), 1);
+  grpc_channel_args args = {1, &arg};
+  grpc_completion_queue* client_cq =
+      grpc_completion_queue_create_for_next(nullptr);
+  grpc_channel* channels[NUM_SERVER_CQS];
+  grpc_call* client_calls[NUM_SERVER_CQS];
+  grpc_metadata_array trailing_metadata_recv[NUM_SERVER_CQS];
+  grpc_status_code status[NUM_SERVER_CQS];
+  grpc_slice details[NUM_SERVER_CQS];
+  const int64_t queued_before =
+      get_counter(GRPC_STATS_COUNTER_SERVER_SLOWPATH_REQUESTS_QUEUED);
+  for (size_t i = 0; i < NUM_SERVER_CQS; i++) {
+    channels[i] = grpc_insecure_channel_create(addr.get(), &args, nullptr);
+    client_calls[i] = grpc_channel_create_call(
+        channels[i], nullptr, GRPC_PROPAGATE_DEFAULTS, client_cq,
+        grpc_slice_from_static_string("/foo"), nullptr,
+        grpc_timeout_seconds_to_deadline(30), nullptr);
+    grpc_metadata_array_init(&trailing_metadata_recv[i]);
+    grpc_op ops[3];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[0].flags = GRPC_INITIAL_METADATA_WAIT_FOR_READY;
+    ops[1].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+    ops[2].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+    ops[2].data.recv_status_on_client.trailing_metadata =
+        &trailing_metadata_recv[i];
+    ops[2].data.recv_status_on_client.status = &status[i];
+    ops[2].data.recv_status_on_client.status_details = &details[i];
+    GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(client_calls[i], ops, 3,
+                                                     tag(i), nullptr));
+  }
+
+  /* with no request made yet, every call is queued on the shard of the
+     completion queue polling its channel */
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  while (get_counter(GRPC_STATS_COUNTER_SERVER_SLOWPATH_REQUESTS_QUEUED) -
+             queued_before <
+         NUM_SERVER_CQS) {
+    GPR_ASSERT(gpr_time_cmp(gpr_now(deadline.clock_type), deadline) < 0);
+    GPR_ASSERT(grpc_completion_queue_next(
+                   client_cq, grpc_timeout_milliseconds_to_deadline(1), nullptr)
+                   .type == GRPC_QUEUE_TIMEOUT);
+    for (size_t i = 0; i < NUM_SERVER_CQS; i++) {
+      GPR_ASSERT(grpc_completion_queue_next(
+                     server_cqs[i], grpc_timeout_milliseconds_to_deadline(1),
+                     nullptr)
+                     .type == GRPC_QUEUE_TIMEOUT);
+    }
+  }
+
+  const int64_t stolen_before =
+      get_counter(GRPC_STATS_COUNTER_SERVER_PENDING_CALLS_STOLEN);
+  grpc_call* server_calls[NUM_SERVER_CQS];
+  grpc_call_details call_details[NUM_SERVER_CQS];
+  grpc_metadata_array request_metadata_recv[NUM_SERVER_CQS];
+  for (size_t i = 0; i < NUM_SERVER_CQS; i++) {
+    grpc_call_details_init(&call_details[i]);
+    grpc_metadata_array_init(&request_metadata_recv[i]);
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_server_request_call(
+                   server, &server_calls[i], &call_details[i],
+                   &request_metadata_recv[i], server_cqs[0], server_cqs[0],
+                   tag(100 + i)));
+  }
+  for (size_t i = 0; i < NUM_SERVER_CQS; i++) {
+    grpc_event ev = grpc_completion_queue_next(
+        server_cqs[0], grpc_timeout_seconds_to_deadline(5), nullptr);
+    GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+    GPR_ASSERT(ev.success);
+  }
+  /* only the calls on the connection polled by the first queue were not
+     stolen */
+  const int64_t stolen =
+      get_counter(GRPC_STATS_COUNTER_SERVER_PENDING_CALLS_STOLEN) -
+      stolen_before;
+  gpr_log(GPR_INFO, "%" PRId64 " of %d calls stolen", stolen, NUM_SERVER_CQS);
+  GPR_ASSERT(stolen == NUM_SERVER_CQS - 1);
+
+  for (size_t i = 0; i < NUM_SERVER_CQS; i++) {
+    int was_cancelled = 2;
+    grpc_op ops[3];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[1].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+    ops[1].data.send_status_from_server.status = GRPC_STATUS_OK;
+    ops[2].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+    ops[2].data.recv_close_on_server.cancelled = &was_cancelled;
+    GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(server_calls[i], ops, 3,
+                                                     tag(200 + i), nullptr));
+    grpc_event ev = grpc_completion_queue_next(
+        server_cqs[0], grpc_timeout_seconds_to_deadline(5), nullptr);
+    GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+    GPR_ASSERT(ev.success);
+    GPR_ASSERT(was_cancelled == 0);
+  }
+  for (size_t i = 0; i < NUM_SERVER_CQS; i++) {
+    grpc_event ev = grpc_completion_queue_next(
+        client_cq, grpc_timeout_seconds_to_deadline(5), nullptr);
+    GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+    GPR_ASSERT(ev.success);
+  }
+
+  for (size_t i = 0; i < NUM_SERVER_CQS; i++) {
+    GPR_ASSERT(status[i] == GRPC_STATUS_OK);
+    grpc_call_unref(server_calls[i]);
+    grpc_call_details_destroy(&call_details[i]);
+    grpc_metadata_array_destroy(&request_metadata_recv[i]);
+    grpc_call_unref(client_calls[i]);
+    grpc_metadata_array_destroy(&trailing_metadata_recv[i]);
+    grpc_slice_unref(details[i]);
+    grpc_channel_destroy(channels[i]);
+  }
+  grpc_server_shutdown_and_notify(server, server_cqs[0], tag(1000));
+  GPR_ASSERT(grpc_completion_queue_next(server_cqs[0],
+                                        grpc_timeout_seconds_to_deadline(5),
+                                        nullptr)
+                 .type == GRPC_OP_COMPLETE);
+  grpc_server_destroy(server);
+  for (size_t i = 0; i < NUM_SERVER_CQS; i++) {
+    grpc_completion_queue_shutdown(server_cqs[i]);
+    while (grpc_completion_queue_next(server_cqs[i],
+                                      gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(server_cqs[i]);
+  }
+  grpc_completion_queue_shutdown(client_cq);
+  while (grpc_completion_queue_next(client_cq,
+                                    gpr_inf_future(GPR_CLOCK_REALTIME), nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(client_cq);
+}
+#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+
 static int external_dns_works(const char* host) {
   grpc_resolved_addresses* res = nullptr;
   grpc_error* error = grpc_blocking_resolve_address(host, "80", &res);
@@ -152,6 +324,9 @@ int main(int argc, char** argv) {
   grpc_init();
   test_register_method_fail();
   test_request_call_on_no_server_cq();
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  test_pending_calls_stolen_across_cqs();
+#endif
 #ifndef GRPC_UV
   test_bind_server_twice();
 #endif
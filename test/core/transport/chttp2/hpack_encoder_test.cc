@@ -30,6 +30,7 @@
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/transport/metadata.h"
+#include "src/core/lib/transport/static_metadata.h"
 #include "test/core/util/parse_hexstring.h"
 #include "test/core/util/slice_splitter.h"
 #include "test/core/util/test_config.h"
@@ -68,25 +69,16 @@ static void verify(const verify_params params, const char* expected,
   for (i = 0; i < nheaders; i++) {
     char* key = va_arg(l, char*);
     char* value = va_arg(l, char*);
-    if (i) {
-      e[i - 1].next = &e[i];
-      e[i].prev = &e[i - 1];
-    }
     grpc_slice value_slice = grpc_slice_from_static_string(value);
     if (!params.only_intern_key) {
       value_slice = grpc_slice_intern(value_slice);
     }
     e[i].md = grpc_mdelem_from_slices(
         grpc_slice_intern(grpc_slice_from_static_string(key)), value_slice);
+    GPR_ASSERT(grpc_metadata_batch_link_tail(&b, &e[i]) == GRPC_ERROR_NONE);
   }
-  e[0].prev = nullptr;
-  e[nheaders - 1].next = nullptr;
   va_end(l);
 
-  b.list.head = &e[0];
-  b.list.tail = &e[nheaders - 1];
-  b.list.count = nheaders;
-
   if (cap_to_delete == num_to_delete) {
     cap_to_delete = GPR_MAX(2 * cap_to_delete, 1000);
     to_delete = static_cast<void**>(
@@ -146,9 +138,11 @@ static void test_basic_headers() {
            "d");
   }
 
-  verify(params, "000006 0104 deadbeef c0 00 016b 0176", 2, "a", "a", "k", "v");
-  /* this could be 000004 0104 deadbeef 0f 30 0176 also */
-  verify(params, "000004 0104 deadbeef 0f 2f 0176", 1, "a", "v");
+  /* the table has room to spare: even rare values get added */
+  verify(params, "000006 0104 deadbeef c0 40 016b 0176", 2, "a", "a", "k", "v");
+  verify(params, "000004 0104 deadbeef 7f 00 0176", 1, "a", "v");
+  GPR_ASSERT(grpc_chttp2_hpack_compressor_compression_ratio(&g_compressor) >
+             1);
 }
 
 static void encode_int_to_str(int i, char* p) {
@@ -182,17 +176,29 @@ static void test_decode_table_overflow() {
                    key[0], key[1], value[0], value[1]);
       verify(params, expect, 1, key, value);
     } else {
+      /* once the table is full, a pair seen once is not worth evicting the
+         oldest entry, aa:ba, which is seen every time */
       gpr_asprintf(&expect,
-                   "000008 0104 deadbeef %02x 40 02%02x%02x 02%02x%02x",
-                   0x80 + 61 + i, key[0], key[1], value[0], value[1]);
+                   "000008 0104 deadbeef %02x %02x 02%02x%02x 02%02x%02x",
+                   0x80 + 61 + i, i < 28 ? 0x40 : 0x00, key[0], key[1],
+                   value[0], value[1]);
       verify(params, expect, 2, "aa", "ba", key, value);
     }
     gpr_free(expect);
   }
+  verify(params, "000001 0104 deadbeef d9", 1, "aa", "ba");
+
+  /* a pair gets indexed once it has been seen as often as aa:ba */
+  for (i = 0; i < 29; i++) {
+    verify(params, "000007 0104 deadbeef 00 027a7a 027979", 1, "zz", "yy");
+  }
+  verify(params, "000007 0104 deadbeef 40 027a7a 027979", 1, "zz", "yy");
+  verify(params, "000001 0104 deadbeef be", 1, "zz", "yy");
 
-  /* if the above passes, then we must have just knocked this pair out of the
-     decoder stack, and so we'll be forced to re-encode it */
+  /* which evicted aa:ba, but that is still worth more than the pairs that
+     were seen once */
   verify(params, "000007 0104 deadbeef 40 026161 026261", 1, "aa", "ba");
+  GPR_ASSERT(g_compressor.stats.index_rejected == 30);
 }
 
 static void verify_table_size_change_match_elem_size(const char* key,
@@ -209,11 +215,7 @@ static void verify_table_size_change_match_elem_size(const char* key,
   grpc_metadata_batch b;
   grpc_metadata_batch_init(&b);
   e[0].md = elem;
-  e[0].prev = nullptr;
-  e[0].next = nullptr;
-  b.list.head = &e[0];
-  b.list.tail = &e[0];
-  b.list.count = 1;
+  GPR_ASSERT(grpc_metadata_batch_link_tail(&b, &e[0]) == GRPC_ERROR_NONE);
   grpc_slice_buffer_init(&output);
 
   grpc_transport_one_way_stats stats;
@@ -250,6 +252,137 @@ static void test_interned_key_indexed() {
   }
 }
 
+static void test_fragments() {
+  verify_params params = {false, false, false};
+  verify(params, "000005 0104 deadbeef 40 0161 0161", 1, "a", "a");
+  /* fragments are only kept from batches that left the table as it was */
+  verify(params, "000001 0104 deadbeef be", 1, "a", "a");
+  GPR_ASSERT(g_compressor.stats.fragment_hits == 0);
+  /* the fragment covers the leading headers that are in the table */
+  verify(params, "000006 0104 deadbeef be 40 0162 0163", 2, "a", "a", "b", "c");
+  GPR_ASSERT(g_compressor.stats.fragment_hits == 1);
+  /* adding b: c shifted the index of a: a */
+  verify(params, "000002 0104 deadbeef bf be", 2, "a", "a", "b", "c");
+  GPR_ASSERT(g_compressor.stats.fragment_hits == 1);
+  verify(params, "000002 0104 deadbeef bf be", 2, "a", "a", "b", "c");
+  GPR_ASSERT(g_compressor.stats.fragment_hits == 2);
+  /* a batch with other headers uses what it has in common with it */
+  verify(params, "000006 0104 deadbeef bf 40 0164 0165", 2, "a", "a", "d", "e");
+  GPR_ASSERT(g_compressor.stats.fragment_hits == 3);
+  verify(params, "000002 0104 deadbeef c0 bf", 2, "a", "a", "b", "c");
+  verify(params, "000002 0104 deadbeef c0 bf", 2, "a", "a", "b", "c");
+  GPR_ASSERT(g_compressor.stats.fragment_hits == 4);
+}
+
+/* encodes a trailers-only response carrying the given grpc-status, and
+   grpc-message and an extra trailer if not null. With slow_path, that is done
+   by the general encoder; otherwise checks that the fast path takes it iff
+   expected is not null, and then produces expected */
+static void verify_trailers_only(const char* expected, bool slow_path,
+                                 grpc_mdelem status, const char* message,
+                                 const char* extra_key) {
+  grpc_mdelem status_200 = GRPC_MDELEM_STATUS_200;
+  grpc_mdelem content_type = GRPC_MDELEM_CONTENT_TYPE_APPLICATION_SLASH_GRPC;
+  grpc_mdelem* extra_headers[] = {&status_200, &content_type};
+  grpc_linked_mdelem storage[3];
+  grpc_metadata_batch b;
+  grpc_metadata_batch_init(&b);
+  GPR_ASSERT(grpc_metadata_batch_add_tail(&b, &storage[0], status) ==
+             GRPC_ERROR_NONE);
+  if (message != nullptr) {
+    GPR_ASSERT(grpc_metadata_batch_add_tail(
+                   &b, &storage[1],
+                   grpc_mdelem_from_slices(
+                       GRPC_MDSTR_GRPC_MESSAGE,
+                       grpc_slice_from_static_string(message))) ==
+               GRPC_ERROR_NONE);
+  }
+  if (extra_key != nullptr) {
+    GPR_ASSERT(grpc_metadata_batch_add_tail(
+                   &b, &storage[2],
+                   grpc_mdelem_from_slices(
+                       grpc_slice_intern(
+                           grpc_slice_from_static_string(extra_key)),
+                       grpc_slice_from_static_string("v"))) ==
+               GRPC_ERROR_NONE);
+  }
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&output);
+  grpc_transport_one_way_stats stats;
+  stats = {};
+  grpc_encode_header_options hopt = {
+      0xdeadbeef, /* stream_id */
+      true,       /* is_eof */
+      false,      /* use_true_binary_metadata */
+      16384,      /* max_frame_size */
+      &stats      /* stats */
+  };
+  if (slow_path) {
+    grpc_chttp2_encode_header(&g_compressor, extra_headers, 2, &b, &hopt,
+                              &output);
+  } else if (grpc_chttp2_encode_trailers_only(&g_compressor, extra_headers, 2,
+                                              &b, &hopt, &output)) {
+    GPR_ASSERT(expected != nullptr);
+    grpc_slice expect = parse_hexstring(expected);
+    grpc_slice merged = grpc_slice_merge(output.slices, output.count);
+    if (!grpc_slice_eq(merged, expect)) {
+      char* got_str = grpc_dump_slice(merged, GPR_DUMP_HEX | GPR_DUMP_ASCII);
+      gpr_log(GPR_ERROR, "mismatched trailers-only output for %s", expected);
+      gpr_log(GPR_ERROR, "GOT:    %s", got_str);
+      gpr_free(got_str);
+      g_failure = 1;
+    }
+    GPR_ASSERT(stats.framing_bytes == 9);
+    GPR_ASSERT(stats.header_bytes == GRPC_SLICE_LENGTH(expect) - 9);
+    grpc_slice_unref_internal(merged);
+    grpc_slice_unref_internal(expect);
+  } else {
+    GPR_ASSERT(expected == nullptr);
+    GPR_ASSERT(output.length == 0);
+  }
+  grpc_slice_buffer_destroy_internal(&output);
+  grpc_metadata_batch_destroy(&b);
+}
+
+static void test_trailers_only() {
+  /* headers worth adding to the decoder table are left to the general
+     encoder */
+  verify_trailers_only(nullptr, false, GRPC_MDELEM_GRPC_STATUS_0, nullptr,
+                       nullptr);
+  verify_trailers_only(nullptr, true, GRPC_MDELEM_GRPC_STATUS_0, nullptr,
+                       nullptr);
+  /* ... after which they are sent by index */
+  verify_trailers_only("000003 0105 deadbeef 88 bf be", false,
+                       GRPC_MDELEM_GRPC_STATUS_0, nullptr, nullptr);
+  verify_trailers_only(nullptr, false, GRPC_MDELEM_GRPC_STATUS_0, "oops",
+                       nullptr);
+  verify_trailers_only(nullptr, true, GRPC_MDELEM_GRPC_STATUS_0, "oops",
+                       nullptr);
+  /* the value of grpc-message is not interned: only its key is indexed */
+  verify_trailers_only("00000a 0105 deadbeef 88 c0 bf 0f2f 04 6f6f7073", false,
+                       GRPC_MDELEM_GRPC_STATUS_0, "oops", nullptr);
+  /* anything but grpc-status and grpc-message goes to the general encoder */
+  verify_trailers_only(nullptr, false, GRPC_MDELEM_GRPC_STATUS_0, nullptr,
+                       "x-extra");
+  /* without a decoder table, everything is a literal */
+  grpc_chttp2_hpack_compressor_set_max_table_size(&g_compressor, 0);
+  verify_trailers_only(nullptr, false, GRPC_MDELEM_GRPC_STATUS_0, nullptr,
+                       nullptr);
+  verify_trailers_only(nullptr, true, GRPC_MDELEM_GRPC_STATUS_0, nullptr,
+                       nullptr);
+  verify_trailers_only(
+      "000023 0105 deadbeef 88"
+      " 0f10 10 6170706c69636174696f6e2f67727063"
+      " 00 0b 677270632d737461747573 01 30",
+      false, GRPC_MDELEM_GRPC_STATUS_0, nullptr, nullptr);
+  verify_trailers_only(
+      "000036 0105 deadbeef 88"
+      " 0f10 10 6170706c69636174696f6e2f67727063"
+      " 00 0b 677270632d737461747573 01 31"
+      " 00 0c 677270632d6d657373616765 04 6f6f7073",
+      false, GRPC_MDELEM_GRPC_STATUS_1, "oops", nullptr);
+}
+
 static void run_test(void (*test)(), const char* name) {
   gpr_log(GPR_INFO, "RUN TEST: %s", name);
   grpc_core::ExecCtx exec_ctx;
@@ -267,6 +400,8 @@ int main(int argc, char** argv) {
   TEST(test_decode_table_overflow);
   TEST(test_encode_header_size);
   TEST(test_interned_key_indexed);
+  TEST(test_fragments);
+  TEST(test_trailers_only);
   grpc_shutdown();
   for (i = 0; i < num_to_delete; i++) {
     gpr_free(to_delete[i]);
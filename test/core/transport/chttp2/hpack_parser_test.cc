@@ -19,12 +19,14 @@
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 
 #include <stdarg.h>
+#include <string.h>
 
 #include <grpc/grpc.h>
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/chttp2/transport/huffsyms.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "test/core/util/parse_hexstring.h"
 #include "test/core/util/slice_splitter.h"
@@ -47,19 +49,15 @@ static grpc_error* onhdr(void* ud, grpc_mdelem md) {
   return GRPC_ERROR_NONE;
 }
 
-static void test_vector(grpc_chttp2_hpack_parser* parser,
-                        grpc_slice_split_mode mode, const char* hexstring,
-                        ... /* char *key, char *value */) {
-  grpc_slice input = parse_hexstring(hexstring);
+static void test_input(grpc_chttp2_hpack_parser* parser,
+                       grpc_slice_split_mode mode, grpc_slice input,
+                       test_checker* chk) {
   grpc_slice* slices;
   size_t nslices;
   size_t i;
-  test_checker chk;
-
-  va_start(chk.args, hexstring);
 
   parser->on_header = onhdr;
-  parser->on_header_user_data = &chk;
+  parser->on_header_user_data = chk;
 
   grpc_split_slices(mode, &input, 1, &slices, &nslices);
   grpc_slice_unref(input);
@@ -75,11 +73,80 @@ static void test_vector(grpc_chttp2_hpack_parser* parser,
   }
   gpr_free(slices);
 
-  GPR_ASSERT(nullptr == va_arg(chk.args, char*));
+  GPR_ASSERT(nullptr == va_arg(chk->args, char*));
+}
+
+static void test_vector(grpc_chttp2_hpack_parser* parser,
+                        grpc_slice_split_mode mode, const char* hexstring,
+                        ... /* char *key, char *value */) {
+  test_checker chk;
+  va_start(chk.args, hexstring);
+  test_input(parser, mode, parse_hexstring(hexstring), &chk);
+  va_end(chk.args);
+}
 
+/* takes ownership of input */
+static void test_slice(grpc_chttp2_hpack_parser* parser,
+                       grpc_slice_split_mode mode, grpc_slice input,
+                       ... /* char *key, char *value */) {
+  test_checker chk;
+  va_start(chk.args, input);
+  test_input(parser, mode, input, &chk);
   va_end(chk.args);
 }
 
+/* Huffman codes are 5 to 30 bits long: check that every byte value decodes,
+   however the encoded string is split */
+static void test_huffman_all_symbols(grpc_slice_split_mode mode) {
+  char value[256];
+  for (int i = 0; i < 255; i++) {
+    value[i] = static_cast<char>(255 - i);
+  }
+  value[255] = 0;
+  /* grpc_chttp2_huffman_compress only handles codes of up to 24 bits (it is
+     meant for base64 text), so encode here */
+  uint8_t huff[256 * 30 / 8 + 1];
+  size_t huff_len = 0;
+  uint64_t bits = 0;
+  uint32_t nbits = 0;
+  for (int i = 0; i < 255; i++) {
+    const grpc_chttp2_huffsym& sym =
+        grpc_chttp2_huffsyms[static_cast<uint8_t>(value[i])];
+    bits = (bits << sym.length) | sym.bits;
+    nbits += sym.length;
+    while (nbits >= 8) {
+      nbits -= 8;
+      huff[huff_len++] = static_cast<uint8_t>(bits >> nbits);
+    }
+  }
+  if (nbits > 0) {
+    /* pad with the most significant bits of EOS */
+    huff[huff_len++] =
+        static_cast<uint8_t>((bits << (8 - nbits)) | (0xff >> nbits));
+  }
+  GPR_ASSERT(huff_len >= 127 && huff_len - 127 < 128 * 128);
+  /* literal header field without indexing, new name "key", huffman value
+     whose length takes a two byte continuation */
+  const uint8_t prefix[] = {
+      0x00,
+      0x03,
+      'k',
+      'e',
+      'y',
+      0xff,
+      static_cast<uint8_t>(0x80 | ((huff_len - 127) & 0x7f)),
+      static_cast<uint8_t>((huff_len - 127) >> 7)};
+  grpc_slice input = grpc_slice_malloc(sizeof(prefix) + huff_len);
+  memcpy(GRPC_SLICE_START_PTR(input), prefix, sizeof(prefix));
+  memcpy(GRPC_SLICE_START_PTR(input) + sizeof(prefix), huff, huff_len);
+
+  grpc_chttp2_hpack_parser parser;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_chttp2_hpack_parser_init(&parser);
+  test_slice(&parser, mode, input, "key", value, NULL);
+  grpc_chttp2_hpack_parser_destroy(&parser);
+}
+
 static void test_vectors(grpc_slice_split_mode mode) {
   grpc_chttp2_hpack_parser parser;
   grpc_core::ExecCtx exec_ctx;
@@ -217,6 +284,8 @@ int main(int argc, char** argv) {
   grpc_init();
   test_vectors(GRPC_SLICE_SPLIT_MERGE_ALL);
   test_vectors(GRPC_SLICE_SPLIT_ONE_BYTE);
+  test_huffman_all_symbols(GRPC_SLICE_SPLIT_MERGE_ALL);
+  test_huffman_all_symbols(GRPC_SLICE_SPLIT_ONE_BYTE);
   grpc_shutdown();
   return 0;
 }
@@ -17,6 +17,7 @@
  */
 
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
+#include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include "test/core/util/test_config.h"
 
@@ -67,16 +68,26 @@ static void test_basic_add_find(uint32_t n) {
   grpc_chttp2_stream_map_destroy(&map);
 }
 
-/* verify that for_each gets the right values during test_delete_evens_XXX */
+typedef struct {
+  /* indexed by stream id */
+  bool* visited;
+  uint32_t visits;
+} for_each_check;
+
+/* verify that for_each gets the right values during test_delete_evens_XXX:
+   each odd key, once */
 static void verify_for_each(void* user_data, uint32_t stream_id, void* ptr) {
-  uint32_t* for_each_check = static_cast<uint32_t*>(user_data);
-  GPR_ASSERT(ptr);
-  GPR_ASSERT(*for_each_check == stream_id);
-  *for_each_check += 2;
+  for_each_check* check = static_cast<for_each_check*>(user_data);
+  GPR_ASSERT(stream_id == (uintptr_t)ptr);
+  GPR_ASSERT(stream_id & 1);
+  GPR_ASSERT(!check->visited[stream_id]);
+  check->visited[stream_id] = true;
+  check->visits++;
 }
 
 static void check_delete_evens(grpc_chttp2_stream_map* map, uint32_t n) {
-  uint32_t for_each_check = 1;
+  for_each_check check = {
+      static_cast<bool*>(gpr_zalloc(sizeof(bool) * (n + 1))), 0};
   uint32_t i;
   size_t got;
 
@@ -91,12 +102,9 @@ static void check_delete_evens(grpc_chttp2_stream_map* map, uint32_t n) {
     }
   }
 
-  grpc_chttp2_stream_map_for_each(map, verify_for_each, &for_each_check);
-  if (n & 1) {
-    GPR_ASSERT(for_each_check == n + 2);
-  } else {
-    GPR_ASSERT(for_each_check == n + 1);
-  }
+  grpc_chttp2_stream_map_for_each(map, verify_for_each, &check);
+  GPR_ASSERT(check.visits == (n + 1) / 2);
+  gpr_free(check.visited);
 }
 
 /* add a bunch of keys, delete the even ones, and make sure the map is
@@ -141,6 +149,37 @@ static void test_delete_evens_incremental(uint32_t n) {
   grpc_chttp2_stream_map_destroy(&map);
 }
 
+typedef struct {
+  grpc_chttp2_stream_map* map;
+  uint32_t visits;
+} delete_check;
+
+static void delete_visited(void* user_data, uint32_t stream_id, void* ptr) {
+  delete_check* check = static_cast<delete_check*>(user_data);
+  GPR_ASSERT(ptr == grpc_chttp2_stream_map_delete(check->map, stream_id));
+  check->visits++;
+}
+
+/* delete every key from for_each, as closing a transport does, and make sure
+   each is visited once */
+static void test_delete_in_for_each(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  uint32_t i;
+
+  LOG_TEST("test_delete_in_for_each");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, i, (void*)static_cast<uintptr_t>(i));
+  }
+  delete_check check = {&map, 0};
+  grpc_chttp2_stream_map_for_each(&map, delete_visited, &check);
+  GPR_ASSERT(check.visits == n);
+  GPR_ASSERT(0 == grpc_chttp2_stream_map_size(&map));
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
 /* add a bunch of keys, delete old ones after some time, ensure the
    backing array does not grow */
 static void test_periodic_compaction(uint32_t n) {
@@ -180,6 +219,7 @@ int main(int argc, char** argv) {
     test_delete_evens_sweep(n);
     test_delete_evens_incremental(n);
     test_periodic_compaction(n);
+    test_delete_in_for_each(n);
 
     tmp = n;
     n += prev;
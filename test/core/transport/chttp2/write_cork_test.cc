@@ -0,0 +1,329 @@
+/*
+ *
+ * Copyright 2020 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Tests GRPC_ARG_HTTP2_WRITE_CORK_US: when chttp2 holds small writes back,
+ * and what makes it send them early. */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/ext/transport/chttp2/transport/frame.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/transport/http2_errors.h"
+#include "src/core/lib/transport/transport.h"
+#include "test/core/util/mock_endpoint.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+const char kClientPreface[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+// Cork long enough that any write seen during a test was not sent by the
+// cork timer
+const int kForeverUs = 60 * GPR_US_PER_SEC;
+
+// Endpoint writes seen so far, one string per grpc_endpoint_write()
+gpr_mu g_mu;
+std::vector<std::string> g_writes;
+gpr_timespec g_first_write_time;
+
+const grpc_endpoint_vtable* g_mock_vtable;
+grpc_endpoint_vtable g_recording_vtable;
+
+void DiscardWrite(grpc_slice /*slice*/) {}
+
+// Records each write whole, then hands it to the mock endpoint
+void RecordingWrite(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                    grpc_closure* cb, void* arg) {
+  std::string bytes;
+  for (size_t i = 0; i < slices->count; i++) {
+    bytes.append(reinterpret_cast<const char*>(
+                     GRPC_SLICE_START_PTR(slices->slices[i])),
+                 GRPC_SLICE_LENGTH(slices->slices[i]));
+  }
+  gpr_mu_lock(&g_mu);
+  if (g_writes.empty()) g_first_write_time = gpr_now(GPR_CLOCK_MONOTONIC);
+  g_writes.push_back(std::move(bytes));
+  gpr_mu_unlock(&g_mu);
+  g_mock_vtable->write(ep, slices, cb, arg);
+}
+
+std::vector<std::string> Writes() {
+  gpr_mu_lock(&g_mu);
+  std::vector<std::string> writes = g_writes;
+  gpr_mu_unlock(&g_mu);
+  return writes;
+}
+
+size_t NumWrites() {
+  gpr_mu_lock(&g_mu);
+  size_t n = g_writes.size();
+  gpr_mu_unlock(&g_mu);
+  return n;
+}
+
+// Waits up to 5 seconds for the transport to make a write
+bool WaitForWrite() {
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(5);
+  while (NumWrites() == 0) {
+    if (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) > 0) return false;
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+  }
+  return true;
+}
+
+struct Frame {
+  uint8_t type;
+  uint8_t flags;
+};
+
+// Splits the bytes of a write into HTTP/2 frames
+std::vector<Frame> ParseFrames(const std::string& bytes) {
+  std::vector<Frame> frames;
+  size_t pos = 0;
+  if (bytes.compare(0, sizeof(kClientPreface) - 1, kClientPreface) == 0) {
+    pos = sizeof(kClientPreface) - 1;
+  }
+  while (pos + 9 <= bytes.size()) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(bytes.data()) + pos;
+    const size_t length = (p[0] << 16) | (p[1] << 8) | p[2];
+    frames.push_back({p[3], p[4]});
+    pos += 9 + length;
+  }
+  EXPECT_EQ(pos, bytes.size());
+  return frames;
+}
+
+size_t CountFrames(const std::vector<Frame>& frames, uint8_t type,
+                   uint8_t flags) {
+  size_t n = 0;
+  for (const Frame& frame : frames) {
+    if (frame.type == type && frame.flags == flags) n++;
+  }
+  return n;
+}
+
+std::string FrameHeader(size_t length, uint8_t type, uint8_t flags) {
+  std::string header;
+  header.push_back(static_cast<char>(length >> 16));
+  header.push_back(static_cast<char>(length >> 8));
+  header.push_back(static_cast<char>(length));
+  header.push_back(static_cast<char>(type));
+  header.push_back(static_cast<char>(flags));
+  header.append(4, '\0');  // stream 0
+  return header;
+}
+
+class WriteCorkTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    gpr_mu_lock(&g_mu);
+    g_writes.clear();
+    gpr_mu_unlock(&g_mu);
+  }
+
+  void TearDown() override {
+    ExecCtx exec_ctx;
+    if (transport_ != nullptr) {
+      grpc_transport_destroy(transport_);
+      exec_ctx.Flush();
+    }
+    if (resource_quota_ != nullptr) {
+      grpc_resource_quota_unref(resource_quota_);
+    }
+  }
+
+  // Creates a client transport, which gathers the connection preface and
+  // its SETTINGS frame into a first (small) write at once
+  void CreateTransport(int write_cork_us) {
+    grpc_arg args[] = {
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_HTTP2_WRITE_CORK_US), write_cork_us),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_HTTP2_BDP_PROBE), 0),
+        // let SendPing() ping without calls or data
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS), 1),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA), 0),
+    };
+    grpc_channel_args channel_args = {GPR_ARRAY_SIZE(args), args};
+    resource_quota_ = grpc_resource_quota_create("write_cork_test");
+    endpoint_ = grpc_mock_endpoint_create(DiscardWrite, resource_quota_);
+    g_mock_vtable = endpoint_->vtable;
+    g_recording_vtable = *g_mock_vtable;
+    g_recording_vtable.write = RecordingWrite;
+    endpoint_->vtable = &g_recording_vtable;
+    transport_ = grpc_create_chttp2_transport(&channel_args, endpoint_, true);
+    grpc_chttp2_transport_start_reading(transport_, nullptr, nullptr);
+    ExecCtx::Get()->Flush();
+  }
+
+  void PerformOp(grpc_transport_op* op) {
+    grpc_transport_perform_op(transport_, op);
+    ExecCtx::Get()->Flush();
+  }
+
+  void SendPing() {
+    grpc_transport_op* op = grpc_make_transport_op(nullptr);
+    op->send_ping.on_ack = GRPC_CLOSURE_CREATE(
+        [](void* /*arg*/, grpc_error* /*error*/) {}, nullptr,
+        grpc_schedule_on_exec_ctx);
+    PerformOp(op);
+  }
+
+  void Disconnect() {
+    grpc_transport_op* op = grpc_make_transport_op(nullptr);
+    op->disconnect_with_error =
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("write_cork_test disconnect");
+    PerformOp(op);
+  }
+
+  grpc_resource_quota* resource_quota_ = nullptr;
+  grpc_endpoint* endpoint_ = nullptr;
+  grpc_transport* transport_ = nullptr;
+};
+
+TEST_F(WriteCorkTest, TimerSendsCorkedWrite) {
+  ExecCtx exec_ctx;
+  const int kCorkMs = 200;
+  const gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+  CreateTransport(kCorkMs * GPR_US_PER_MS);
+  // The ping becomes ready while the first write is held back: it joins it
+  SendPing();
+  ASSERT_TRUE(WaitForWrite());
+  // Allow for the timer list starting from a cached, slightly earlier, time
+  EXPECT_GE(gpr_time_to_millis(gpr_time_sub(g_first_write_time, start)),
+            kCorkMs - 50);
+  std::vector<std::string> writes = Writes();
+  ASSERT_EQ(writes.size(), 1u);
+  std::vector<Frame> frames = ParseFrames(writes[0]);
+  EXPECT_EQ(CountFrames(frames, GRPC_CHTTP2_FRAME_SETTINGS, 0), 1u);
+  EXPECT_EQ(CountFrames(frames, GRPC_CHTTP2_FRAME_PING, 0), 1u);
+}
+
+TEST_F(WriteCorkTest, NoCorkByDefault) {
+  ExecCtx exec_ctx;
+  CreateTransport(0);
+  EXPECT_EQ(NumWrites(), 1u);
+}
+
+// Acks for as many pings as make the transport pause reading are sent at once
+TEST_F(WriteCorkTest, PausedReadingBypassesCork) {
+  ExecCtx exec_ctx;
+  const size_t kNumPings = 10001;
+  CreateTransport(kForeverUs);
+  EXPECT_EQ(NumWrites(), 0u);
+  std::string bytes = FrameHeader(0, GRPC_CHTTP2_FRAME_SETTINGS, 0);
+  for (size_t i = 0; i < kNumPings; i++) {
+    bytes += FrameHeader(8, GRPC_CHTTP2_FRAME_PING, 0);
+    bytes.append(8, static_cast<char>(i));
+  }
+  grpc_mock_endpoint_put_read(
+      endpoint_, grpc_slice_from_copied_buffer(bytes.data(), bytes.size()));
+  ExecCtx::Get()->Flush();
+  ASSERT_TRUE(WaitForWrite());
+  std::vector<Frame> frames = ParseFrames(Writes()[0]);
+  EXPECT_EQ(CountFrames(frames, GRPC_CHTTP2_FRAME_SETTINGS, 0), 1u);
+  EXPECT_EQ(CountFrames(frames, GRPC_CHTTP2_FRAME_SETTINGS,
+                        GRPC_CHTTP2_FLAG_ACK),
+            1u);
+  EXPECT_EQ(CountFrames(frames, GRPC_CHTTP2_FRAME_PING, GRPC_CHTTP2_FLAG_ACK),
+            kNumPings);
+}
+
+TEST_F(WriteCorkTest, CloseSendsCorkedWrite) {
+  ExecCtx exec_ctx;
+  CreateTransport(kForeverUs);
+  EXPECT_EQ(NumWrites(), 0u);
+  Disconnect();
+  ASSERT_TRUE(WaitForWrite());
+  std::vector<Frame> frames = ParseFrames(Writes()[0]);
+  EXPECT_EQ(CountFrames(frames, GRPC_CHTTP2_FRAME_SETTINGS, 0), 1u);
+}
+
+// A GOAWAY alone does not need to go out at once, but it must when the
+// transport closes right after it (as when sending too_many_pings)
+TEST_F(WriteCorkTest, GoawayWaitsForCorkUntilClose) {
+  ExecCtx exec_ctx;
+  CreateTransport(kForeverUs);
+  grpc_transport_op* op = grpc_make_transport_op(nullptr);
+  op->goaway_error = grpc_error_set_int(
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("write_cork_test goaway"),
+      GRPC_ERROR_INT_HTTP2_ERROR, GRPC_HTTP2_NO_ERROR);
+  PerformOp(op);
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(100));
+  EXPECT_EQ(NumWrites(), 0u);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data before;
+  grpc_stats_collect(&before);
+#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+  Disconnect();
+  ASSERT_TRUE(WaitForWrite());
+  std::vector<std::string> writes = Writes();
+  ASSERT_EQ(writes.size(), 1u);
+  std::vector<Frame> frames = ParseFrames(writes[0]);
+  EXPECT_EQ(CountFrames(frames, GRPC_CHTTP2_FRAME_SETTINGS, 0), 1u);
+  EXPECT_EQ(CountFrames(frames, GRPC_CHTTP2_FRAME_GOAWAY, 0), 1u);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  // http2_frames_per_write counts every frame of the write, the GOAWAY
+  // queued outside of the write context included
+  grpc_stats_data after;
+  grpc_stats_collect(&after);
+  grpc_stats_data diff;
+  grpc_stats_diff(&after, &before, &diff);
+  EXPECT_EQ(grpc_stats_histo_count(&diff,
+                                   GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE),
+            1u);
+  const grpc_stats_histograms histogram =
+      GRPC_STATS_HISTOGRAM_HTTP2_FRAMES_PER_WRITE;
+  const gpr_atm* buckets = diff.histograms + grpc_stats_histo_start[histogram];
+  const int* boundaries = grpc_stats_histo_bucket_boundaries[histogram];
+  for (int i = 0; i < grpc_stats_histo_buckets[histogram]; i++) {
+    if (buckets[i] == 0) continue;
+    EXPECT_LE(static_cast<size_t>(boundaries[i]), frames.size());
+    EXPECT_GT(static_cast<size_t>(boundaries[i + 1]), frames.size());
+  }
+#endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  gpr_mu_init(&grpc_core::testing::g_mu);
+  int ret = RUN_ALL_TESTS();
+  gpr_mu_destroy(&grpc_core::testing::g_mu);
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,244 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/transport/delivery_rate_estimator.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include <gtest/gtest.h>
+#include <math.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/timer_manager.h"
+#include "test/core/util/test_config.h"
+
+extern gpr_timespec (*gpr_now_impl)(gpr_clock_type clock_type);
+
+namespace grpc_core {
+namespace testing {
+namespace {
+int64_t g_clock_ms = 0;
+
+gpr_timespec fake_gpr_now(gpr_clock_type clock_type) {
+  gpr_timespec ts;
+  ts.tv_sec = g_clock_ms / GPR_MS_PER_SEC;
+  ts.tv_nsec = (g_clock_ms % GPR_MS_PER_SEC) * GPR_NS_PER_MS;
+  ts.clock_type = clock_type;
+  return ts;
+}
+
+void AdvanceClock(double seconds) {
+  g_clock_ms += static_cast<int64_t>(seconds * 1e3);
+  ExecCtx::Get()->InvalidateNow();
+}
+
+// A path that delivers at most bandwidth bytes per second, and takes rtt
+// seconds to ack a ping when nothing is queued
+class Path {
+ public:
+  Path(double bandwidth, double rtt) : bandwidth_(bandwidth), rtt_(rtt) {}
+
+  // Samples the path with a peer that always fills the window: once the
+  // window exceeds the BDP, the excess queues up ahead of the ping ack
+  void Sample(DeliveryRateEstimator* est) {
+    const int64_t window = est->TargetWindow();
+    const double rtt =
+        GPR_MAX(rtt_, static_cast<double>(window) / bandwidth_);
+    AdvanceClock(rtt);
+    est->AddSample(window, rtt, window);
+  }
+
+  // Samples the path with a peer that has only a little data to send
+  void SampleAppLimited(DeliveryRateEstimator* est) {
+    AdvanceClock(rtt_);
+    est->AddSample(1024, rtt_, est->TargetWindow());
+  }
+
+  double bdp() const { return bandwidth_ * rtt_; }
+
+ private:
+  const double bandwidth_;
+  const double rtt_;
+};
+
+// Number of samples it takes to leave startup on path
+int SamplesToFillPipe(DeliveryRateEstimator* est, Path* path) {
+  int samples = 0;
+  while (est->in_startup() && samples < 100) {
+    path->Sample(est);
+    samples++;
+  }
+  return samples;
+}
+}  // namespace
+
+TEST(DeliveryRateEstimatorTest, NoSamples) {
+  ExecCtx exec_ctx;
+  DeliveryRateEstimator est("test");
+  EXPECT_TRUE(est.in_startup());
+  EXPECT_EQ(est.EstimateBdp(), 65536);
+  EXPECT_GT(est.TargetWindow(), est.EstimateBdp());
+  EXPECT_EQ(est.NextPingDelay(), 0);
+}
+
+TEST(DeliveryRateEstimatorTest, IgnoresSamplesWithoutRtt) {
+  ExecCtx exec_ctx;
+  DeliveryRateEstimator est("test");
+  est.AddSample(1 << 20, 0, 65535);
+  EXPECT_EQ(est.MaxBandwidth(), 0);
+  EXPECT_EQ(est.EstimateBdp(), 65536);
+}
+
+class DeliveryRateEstimatorPathTest
+    : public ::testing::TestWithParam<std::pair<double, double>> {};
+
+TEST_P(DeliveryRateEstimatorPathTest, ConvergesToBdp) {
+  ExecCtx exec_ctx;
+  DeliveryRateEstimator est("test");
+  Path path(GetParam().first, GetParam().second);
+  // Windows grow by ~2.9x per round trip: reaching a BDP of 2^k bytes from
+  // the initial 64KB takes about k/1.5 round trips, plus three to notice
+  // that the delivery rate stopped growing.
+  const int samples = SamplesToFillPipe(&est, &path);
+  EXPECT_FALSE(est.in_startup());
+  EXPECT_LE(samples, 2 + GPR_MAX(0, log2(path.bdp() / 65536)) / 1.5 + 3);
+  EXPECT_NEAR(est.MaxBandwidth(), GetParam().first, GetParam().first * 1e-6);
+  EXPECT_NEAR(est.MinRtt(), GetParam().second, 1e-9);
+  // Once the pipe is full the window stays within the gain cycle's range,
+  // except for briefly dropping every 10 seconds to measure the round trip
+  // time again
+  const int64_t end = g_clock_ms + 60000;
+  int rtt_probes = 0;
+  while (g_clock_ms < end) {
+    path.Sample(&est);
+    EXPECT_FALSE(est.in_startup());
+    EXPECT_NEAR(est.MinRtt(), GetParam().second, 1e-9);
+    if (est.TargetWindow() == 65535) {
+      rtt_probes++;
+      continue;
+    }
+    EXPECT_GE(est.TargetWindow(), GPR_MIN(1.5 * path.bdp(), INT32_MAX));
+    EXPECT_LE(est.TargetWindow(), 2.5 * path.bdp());
+  }
+  EXPECT_GE(rtt_probes, 5);
+  EXPECT_LE(rtt_probes, 6);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Paths, DeliveryRateEstimatorPathTest,
+    ::testing::Values(std::make_pair(1.25e7, 0.050),  // 100Mbps, 50ms
+                      std::make_pair(1.25e8, 0.050),  // 1Gbps, 50ms
+                      std::make_pair(1.25e9, 0.050)   // 10Gbps, 50ms
+                      ));
+
+TEST(DeliveryRateEstimatorTest, SmallBdpPath) {
+  ExecCtx exec_ctx;
+  DeliveryRateEstimator est("test");
+  Path path(1.25e5, 0.001);  // 1Mbps, 1ms
+  SamplesToFillPipe(&est, &path);
+  EXPECT_FALSE(est.in_startup());
+  EXPECT_NEAR(est.MaxBandwidth(), 1.25e5, 1);
+  // Even the smallest window keeps a queue in front of pings, and so does
+  // the initial one: the window is back near the minimum once the round
+  // trip time has been measured again
+  const int64_t end = g_clock_ms + 30000;
+  while (g_clock_ms < end) {
+    path.Sample(&est);
+  }
+  EXPECT_LE(est.TargetWindow(), 2.5 * 65535);
+  EXPECT_GE(est.NextPingDelay(), 100);
+}
+
+TEST(DeliveryRateEstimatorTest, IdleConnectionRestartsStartup) {
+  ExecCtx exec_ctx;
+  DeliveryRateEstimator est("test");
+  Path path(1.25e8, 0.05);
+  for (int i = 0; i < 5; i++) {
+    path.SampleAppLimited(&est);
+  }
+  EXPECT_FALSE(est.in_startup());
+  path.Sample(&est);
+  EXPECT_TRUE(est.in_startup());
+  SamplesToFillPipe(&est, &path);
+  EXPECT_FALSE(est.in_startup());
+  EXPECT_NEAR(est.MaxBandwidth(), 1.25e8, 1);
+}
+
+TEST(DeliveryRateEstimatorTest, AppLimitedSamplesDoNotLowerEstimate) {
+  ExecCtx exec_ctx;
+  DeliveryRateEstimator est("test");
+  Path path(1.25e8, 0.05);
+  SamplesToFillPipe(&est, &path);
+  const double bw = est.MaxBandwidth();
+  const grpc_millis ping_delay = est.NextPingDelay();
+  for (int i = 0; i < 5 * DeliveryRateEstimator::kBandwidthWindow; i++) {
+    path.SampleAppLimited(&est);
+  }
+  EXPECT_EQ(est.MaxBandwidth(), bw);
+  // an idle connection is probed less and less often
+  EXPECT_GT(est.NextPingDelay(), ping_delay);
+  EXPECT_LE(est.NextPingDelay(), 10000);
+  path.Sample(&est);
+  EXPECT_EQ(est.NextPingDelay(), ping_delay);
+}
+
+TEST(DeliveryRateEstimatorTest, BandwidthEstimateFollowsPathDown) {
+  ExecCtx exec_ctx;
+  DeliveryRateEstimator est("test");
+  Path fast(1.25e8, 0.05);
+  SamplesToFillPipe(&est, &fast);
+  Path slow(1.25e7, 0.05);
+  for (int i = 0; i < DeliveryRateEstimator::kBandwidthWindow; i++) {
+    slow.Sample(&est);
+  }
+  EXPECT_NEAR(est.MaxBandwidth(), 1.25e7, 1);
+  EXPECT_LE(est.TargetWindow(), 2.5 * slow.bdp());
+}
+
+TEST(DeliveryRateEstimatorTest, LongerPathIsNoticed) {
+  ExecCtx exec_ctx;
+  DeliveryRateEstimator est("test");
+  Path path(1.25e8, 0.01);
+  SamplesToFillPipe(&est, &path);
+  EXPECT_NEAR(est.MinRtt(), 0.01, 1e-9);
+  Path longer(1.25e8, 0.1);
+  const int64_t expiry = g_clock_ms + 10000;
+  while (g_clock_ms < expiry) {
+    longer.Sample(&est);
+    EXPECT_NEAR(est.MinRtt(), 0.01, 1e-9);
+  }
+  for (int i = 0; i < 2; i++) {
+    longer.Sample(&est);
+  }
+  EXPECT_NEAR(est.MinRtt(), 0.1, 1e-9);
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  gpr_now_impl = grpc_core::testing::fake_gpr_now;
+  grpc_init();
+  grpc_timer_manager_set_threading(false);
+  ::testing::InitGoogleTest(&argc, argv);
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
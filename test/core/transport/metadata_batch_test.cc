@@ -0,0 +1,168 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/transport/metadata_batch.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/slice/slice_utils.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+
+// Enough headers to move a batch out of its inline storage
+constexpr size_t kManyHeaders = 2 * GRPC_MDELEM_LIST_INLINE_ELEMS + 1;
+
+class MetadataBatchTest : public ::testing::Test {
+ protected:
+  MetadataBatchTest() { grpc_metadata_batch_init(&batch_); }
+  ~MetadataBatchTest() { grpc_metadata_batch_destroy(&batch_); }
+
+  static grpc_mdelem Header(size_t i) {
+    const std::string key = "key" + std::to_string(i);
+    return grpc_mdelem_from_slices(
+        grpc_slice_intern(ExternallyManagedSlice(key.data(), key.size())),
+        grpc_slice_from_static_string("value"));
+  }
+
+  // The numbers of the "key<n>" headers in the batch, in order
+  static std::vector<size_t> Keys(const grpc_metadata_batch* batch) {
+    std::vector<size_t> keys;
+    grpc_linked_mdelem* const* elems = grpc_metadata_batch_elems(batch);
+    for (size_t i = 0; i < batch->list.count; i++) {
+      grpc_slice key = GRPC_MDKEY(elems[i]->md);
+      keys.push_back(std::stoul(std::string(
+          reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(key)) + 3,
+          GRPC_SLICE_LENGTH(key) - 3)));
+    }
+    return keys;
+  }
+
+  ExecCtx exec_ctx_;
+  grpc_metadata_batch batch_;
+  grpc_linked_mdelem storage_[kManyHeaders];
+};
+
+TEST_F(MetadataBatchTest, KeepsOrderPastInlineStorage) {
+  std::vector<size_t> expected;
+  for (size_t i = 0; i < kManyHeaders; i++) {
+    if (i % 2 == 0) {
+      ASSERT_EQ(grpc_metadata_batch_add_tail(&batch_, &storage_[i], Header(i)),
+                GRPC_ERROR_NONE);
+      expected.push_back(i);
+    } else {
+      ASSERT_EQ(grpc_metadata_batch_add_head(&batch_, &storage_[i], Header(i)),
+                GRPC_ERROR_NONE);
+      expected.insert(expected.begin(), i);
+    }
+  }
+  EXPECT_EQ(Keys(&batch_), expected);
+  grpc_metadata_batch_remove(&batch_, &storage_[0]);
+  grpc_metadata_batch_remove(&batch_, &storage_[kManyHeaders - 1]);
+  grpc_metadata_batch_remove(&batch_, &storage_[3]);
+  for (size_t removed : {size_t(0), kManyHeaders - 1, size_t(3)}) {
+    expected.erase(std::find(expected.begin(), expected.end(), removed));
+  }
+  EXPECT_EQ(Keys(&batch_), expected);
+}
+
+TEST_F(MetadataBatchTest, CalloutsFollowRemovals) {
+  ASSERT_EQ(grpc_metadata_batch_add_tail(&batch_, &storage_[0], Header(0)),
+            GRPC_ERROR_NONE);
+  ASSERT_EQ(grpc_metadata_batch_add_tail(&batch_, &storage_[1],
+                                         GRPC_MDELEM_GRPC_STATUS_0,
+                                         GRPC_BATCH_GRPC_STATUS),
+            GRPC_ERROR_NONE);
+  ASSERT_EQ(grpc_metadata_batch_add_tail(&batch_, &storage_[2], Header(2)),
+            GRPC_ERROR_NONE);
+  EXPECT_EQ(batch_.idx.named.grpc_status, &storage_[1]);
+  EXPECT_EQ(batch_.list.default_count, 1u);
+  // a second grpc-status is rejected, and leaves the batch as it was
+  storage_[3].md = GRPC_MDELEM_GRPC_STATUS_1;
+  grpc_error* error = grpc_metadata_batch_link_tail(&batch_, &storage_[3]);
+  EXPECT_NE(error, GRPC_ERROR_NONE);
+  GRPC_ERROR_UNREF(error);
+  EXPECT_EQ(batch_.list.count, 3u);
+  grpc_metadata_batch_remove(&batch_, GRPC_BATCH_GRPC_STATUS);
+  EXPECT_EQ(batch_.idx.named.grpc_status, nullptr);
+  EXPECT_EQ(batch_.list.default_count, 0u);
+  EXPECT_EQ(Keys(&batch_), std::vector<size_t>({0, 2}));
+}
+
+static grpc_filtered_mdelem drop_odd_keys(void* user_data, grpc_mdelem md) {
+  grpc_slice key = GRPC_MDKEY(md);
+  const char last = reinterpret_cast<const char*>(
+      GRPC_SLICE_START_PTR(key))[GRPC_SLICE_LENGTH(key) - 1];
+  if ((last - '0') % 2 == 1) return GRPC_FILTERED_REMOVE();
+  return GRPC_FILTERED_MDELEM(md);
+}
+
+TEST_F(MetadataBatchTest, FilterRemovesConsecutiveElements) {
+  // 1, 3, 5 and 7 are removed, including the adjacent 5 and 7
+  for (size_t i : {0, 1, 2, 3, 5, 7, 8}) {
+    ASSERT_EQ(grpc_metadata_batch_add_tail(&batch_, &storage_[i], Header(i)),
+              GRPC_ERROR_NONE);
+  }
+  grpc_error* error =
+      grpc_metadata_batch_filter(&batch_, drop_odd_keys, nullptr, "filter");
+  EXPECT_EQ(error, GRPC_ERROR_NONE);
+  EXPECT_EQ(Keys(&batch_), std::vector<size_t>({0, 2, 8}));
+}
+
+TEST_F(MetadataBatchTest, CopyAndMove) {
+  std::vector<size_t> expected;
+  for (size_t i = 0; i < kManyHeaders; i++) {
+    ASSERT_EQ(grpc_metadata_batch_add_tail(&batch_, &storage_[i], Header(i)),
+              GRPC_ERROR_NONE);
+    expected.push_back(i);
+  }
+  batch_.deadline = 1234;
+  grpc_linked_mdelem copy_storage[kManyHeaders];
+  grpc_metadata_batch copy;
+  grpc_metadata_batch_copy(&batch_, &copy, copy_storage);
+  EXPECT_EQ(Keys(&copy), expected);
+  EXPECT_EQ(copy.deadline, 1234);
+  grpc_metadata_batch moved;
+  grpc_metadata_batch_move(&copy, &moved);
+  EXPECT_TRUE(grpc_metadata_batch_is_empty(&copy));
+  EXPECT_EQ(Keys(&moved), expected);
+  EXPECT_EQ(grpc_metadata_batch_size(&moved),
+            grpc_metadata_batch_size(&batch_));
+  grpc_metadata_batch_destroy(&copy);
+  grpc_metadata_batch_destroy(&moved);
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
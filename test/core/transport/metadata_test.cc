@@ -29,6 +29,7 @@
 #include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_table.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/transport/static_metadata.h"
@@ -175,6 +176,102 @@ static void test_spin_creating_the_same_thing(bool intern_keys,
   grpc_shutdown();
 }
 
+#define CONCURRENT_THREADS 4
+#define CONCURRENT_VALUES 1000
+
+static void intern_concurrently(void* arg) {
+  grpc_core::ExecCtx exec_ctx;
+  char buffer[GPR_LTOA_MIN_BUFSIZE];
+  for (long i = 0; i < MANY; i++) {
+    gpr_ltoa(i % CONCURRENT_VALUES, buffer);
+    grpc_slice value = grpc_slice_intern(grpc_slice_from_static_string(buffer));
+    grpc_mdelem a = grpc_mdelem_from_slices(
+        grpc_slice_intern(grpc_slice_from_static_string("a")),
+        grpc_slice_ref_internal(value));
+    grpc_mdelem b = grpc_mdelem_from_slices(
+        grpc_slice_intern(grpc_slice_from_static_string("a")), value);
+    GPR_ASSERT(a.payload == b.payload);
+    GPR_ASSERT(grpc_slice_str_cmp(GRPC_MDVALUE(a), buffer) == 0);
+    GRPC_MDELEM_UNREF(a);
+    GRPC_MDELEM_UNREF(b);
+  }
+}
+
+/* interned elements are looked up without the shard lock while other threads
+   drop their last refs and the shards are collected and grown */
+static void test_concurrent_interning(void) {
+  gpr_log(GPR_INFO, "test_concurrent_interning");
+
+  grpc_init();
+  grpc_core::Thread threads[CONCURRENT_THREADS];
+  for (auto& th : threads) {
+    th = grpc_core::Thread("grpc_intern_concurrently", intern_concurrently,
+                           nullptr);
+    th.Start();
+  }
+  for (auto& th : threads) {
+    th.Join();
+  }
+  grpc_shutdown();
+}
+
+static gpr_atm g_overlapping_reads_started;
+static gpr_atm g_stop_overlapping_reads;
+
+/* Keeps a lock-free lookup announced at all times: each read starts before
+   the previous one ends */
+static void overlap_reads(void* arg) {
+  void* read = grpc_mdctx_begin_read_for_testing();
+  gpr_atm_rel_store(&g_overlapping_reads_started, 1);
+  while (!gpr_atm_acq_load(&g_stop_overlapping_reads)) {
+    void* next = grpc_mdctx_begin_read_for_testing();
+    grpc_mdctx_end_read_for_testing(read);
+    read = next;
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+  }
+  grpc_mdctx_end_read_for_testing(read);
+}
+
+static void create_and_drop(const char* key, long count) {
+  char buffer[GPR_LTOA_MIN_BUFSIZE];
+  for (long i = 0; i < count; i++) {
+    gpr_ltoa(i, buffer);
+    GRPC_MDELEM_UNREF(grpc_mdelem_from_slices(
+        grpc_slice_intern(grpc_slice_from_static_string(key)),
+        grpc_slice_intern(grpc_slice_from_copied_string(buffer))));
+  }
+}
+
+/* memory unlinked from the table is freed even though some lookup is always
+   in progress */
+static void test_retired_freed_under_constant_reads(void) {
+  gpr_log(GPR_INFO, "test_retired_freed_under_constant_reads");
+
+  grpc_init();
+  grpc_core::ExecCtx exec_ctx;
+  /* nothing unlinked while this read is announced can be freed */
+  void* read = grpc_mdctx_begin_read_for_testing();
+  create_and_drop("retired", MANY);
+  GPR_ASSERT(grpc_mdctx_count_retired_for_testing() > 0);
+  gpr_atm_rel_store(&g_overlapping_reads_started, 0);
+  gpr_atm_rel_store(&g_stop_overlapping_reads, 0);
+  grpc_core::Thread reader("grpc_overlap_reads", overlap_reads, nullptr);
+  reader.Start();
+  while (!gpr_atm_acq_load(&g_overlapping_reads_started)) {
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+  }
+  grpc_mdctx_end_read_for_testing(read);
+  /* lookups that take the shard locks free what they can */
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  while (grpc_mdctx_count_retired_for_testing() > 0) {
+    GPR_ASSERT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0);
+    create_and_drop("lookup", 256);
+  }
+  gpr_atm_rel_store(&g_stop_overlapping_reads, 1);
+  reader.Join();
+  grpc_shutdown();
+}
+
 static void test_identity_laws(bool intern_keys, bool intern_values) {
   gpr_log(GPR_INFO, "test_identity_laws: intern_keys=%d intern_values=%d",
           intern_keys, intern_values);
@@ -407,6 +504,8 @@ int main(int argc, char** argv) {
   }
   test_create_many_persistant_metadata();
   test_things_stick_around();
+  test_concurrent_interning();
+  test_retired_freed_under_constant_reads();
   test_user_data_works();
   test_user_data_works_for_allocated_md();
   grpc_shutdown();
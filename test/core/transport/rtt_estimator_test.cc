@@ -0,0 +1,80 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include "src/core/lib/transport/rtt_estimator.h"
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+
+TEST(RttEstimatorTest, NoSamples) {
+  RttEstimator est;
+  EXPECT_EQ(est.SmoothedRtt(), 0);
+  EXPECT_EQ(est.MinRtt(), 0);
+}
+
+TEST(RttEstimatorTest, IgnoresEmptySamples) {
+  RttEstimator est;
+  est.AddSample(0);
+  est.AddSample(-1);
+  EXPECT_EQ(est.SmoothedRtt(), 0);
+  EXPECT_EQ(est.MinRtt(), 0);
+}
+
+TEST(RttEstimatorTest, FirstSampleIsTheEstimate) {
+  RttEstimator est;
+  est.AddSample(0.05);
+  EXPECT_DOUBLE_EQ(est.SmoothedRtt(), 0.05);
+  EXPECT_DOUBLE_EQ(est.MinRtt(), 0.05);
+}
+
+TEST(RttEstimatorTest, SmoothedRttFollowsSamples) {
+  RttEstimator est;
+  est.AddSample(0.01);
+  est.AddSample(0.09);
+  EXPECT_DOUBLE_EQ(est.SmoothedRtt(), 0.02);
+  for (int i = 0; i < 100; i++) {
+    est.AddSample(0.09);
+  }
+  EXPECT_NEAR(est.SmoothedRtt(), 0.09, 1e-6);
+}
+
+TEST(RttEstimatorTest, MinRttOverRecentSamples) {
+  RttEstimator est;
+  est.AddSample(0.01);
+  for (int i = 1; i < RttEstimator::kMinRttWindow; i++) {
+    est.AddSample(0.05);
+    EXPECT_DOUBLE_EQ(est.MinRtt(), 0.01);
+  }
+  // the fast sample is now out of the window: the path got slower
+  est.AddSample(0.05);
+  EXPECT_DOUBLE_EQ(est.MinRtt(), 0.05);
+  est.AddSample(0.03);
+  EXPECT_DOUBLE_EQ(est.MinRtt(), 0.03);
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -19,6 +19,7 @@
 #include "src/core/lib/iomgr/sockaddr.h"
 
 #include "test/core/util/passthru_endpoint.h"
+#include "test/core/util/trickle_endpoint.h"
 
 #include <inttypes.h>
 #include <string.h>
@@ -32,14 +33,25 @@
 
 #define WRITE_BUFFER_SIZE (2 * 1024 * 1024)
 
+/* bytes through the bandwidth limit, waiting out the one way delay */
+typedef struct in_flight_chunk {
+  size_t length;
+  gpr_timespec arrival;
+  struct in_flight_chunk* next;
+} in_flight_chunk;
+
 typedef struct {
   grpc_endpoint base;
   double bytes_per_second;
+  gpr_timespec one_way_delay;
   grpc_endpoint* wrapped;
   gpr_timespec last_write;
 
   gpr_mu mu;
   grpc_slice_buffer write_buffer;
+  grpc_slice_buffer in_flight_buffer;
+  in_flight_chunk* in_flight_head;
+  in_flight_chunk* in_flight_tail;
   grpc_slice_buffer writing_buffer;
   grpc_error* error;
   bool writing;
@@ -111,6 +123,12 @@ static void te_destroy(grpc_endpoint* ep) {
   grpc_endpoint_destroy(te->wrapped);
   gpr_mu_destroy(&te->mu);
   grpc_slice_buffer_destroy_internal(&te->write_buffer);
+  grpc_slice_buffer_destroy_internal(&te->in_flight_buffer);
+  while (te->in_flight_head != nullptr) {
+    in_flight_chunk* chunk = te->in_flight_head;
+    te->in_flight_head = chunk->next;
+    gpr_free(chunk);
+  }
   grpc_slice_buffer_destroy_internal(&te->writing_buffer);
   GRPC_ERROR_UNREF(te->error);
   gpr_free(te);
@@ -155,14 +173,23 @@ static const grpc_endpoint_vtable vtable = {te_read,
 
 grpc_endpoint* grpc_trickle_endpoint_create(grpc_endpoint* wrap,
                                             double bytes_per_second) {
+  return grpc_trickle_endpoint_create_with_delay(wrap, bytes_per_second, 0);
+}
+
+grpc_endpoint* grpc_trickle_endpoint_create_with_delay(
+    grpc_endpoint* wrap, double bytes_per_second, int one_way_delay_ms) {
   trickle_endpoint* te =
       static_cast<trickle_endpoint*>(gpr_malloc(sizeof(*te)));
   te->base.vtable = &vtable;
   te->wrapped = wrap;
   te->bytes_per_second = bytes_per_second;
+  te->one_way_delay = gpr_time_from_millis(one_way_delay_ms, GPR_TIMESPAN);
   te->write_cb = nullptr;
   gpr_mu_init(&te->mu);
   grpc_slice_buffer_init(&te->write_buffer);
+  grpc_slice_buffer_init(&te->in_flight_buffer);
+  te->in_flight_head = nullptr;
+  te->in_flight_tail = nullptr;
   grpc_slice_buffer_init(&te->writing_buffer);
   te->error = GRPC_ERROR_NONE;
   te->writing = false;
@@ -176,22 +203,48 @@ static double ts2dbl(gpr_timespec s) {
 size_t grpc_trickle_endpoint_trickle(grpc_endpoint* ep) {
   trickle_endpoint* te = reinterpret_cast<trickle_endpoint*>(ep);
   gpr_mu_lock(&te->mu);
-  if (!te->writing && te->write_buffer.length > 0) {
+  if (!te->writing) {
     gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
-    double elapsed = ts2dbl(gpr_time_sub(now, te->last_write));
-    size_t bytes = static_cast<size_t>(te->bytes_per_second * elapsed);
-    // gpr_log(GPR_DEBUG, "%lf elapsed --> %" PRIdPTR " bytes", elapsed, bytes);
-    if (bytes > 0) {
-      grpc_slice_buffer_move_first(&te->write_buffer,
-                                   GPR_MIN(bytes, te->write_buffer.length),
+    if (te->write_buffer.length > 0) {
+      double elapsed = ts2dbl(gpr_time_sub(now, te->last_write));
+      size_t bytes = static_cast<size_t>(te->bytes_per_second * elapsed);
+      // gpr_log(GPR_DEBUG, "%lf elapsed --> %" PRIdPTR " bytes", elapsed,
+      // bytes);
+      if (bytes > 0) {
+        in_flight_chunk* chunk =
+            static_cast<in_flight_chunk*>(gpr_malloc(sizeof(*chunk)));
+        chunk->length = GPR_MIN(bytes, te->write_buffer.length);
+        chunk->arrival = gpr_time_add(now, te->one_way_delay);
+        chunk->next = nullptr;
+        grpc_slice_buffer_move_first(&te->write_buffer, chunk->length,
+                                     &te->in_flight_buffer);
+        if (te->in_flight_tail == nullptr) {
+          te->in_flight_head = chunk;
+        } else {
+          te->in_flight_tail->next = chunk;
+        }
+        te->in_flight_tail = chunk;
+        te->last_write = now;
+        maybe_call_write_cb_locked(te);
+      }
+    }
+    size_t arrived = 0;
+    while (te->in_flight_head != nullptr &&
+           gpr_time_cmp(te->in_flight_head->arrival, now) <= 0) {
+      in_flight_chunk* chunk = te->in_flight_head;
+      arrived += chunk->length;
+      te->in_flight_head = chunk->next;
+      gpr_free(chunk);
+    }
+    if (te->in_flight_head == nullptr) te->in_flight_tail = nullptr;
+    if (arrived > 0) {
+      grpc_slice_buffer_move_first(&te->in_flight_buffer, arrived,
                                    &te->writing_buffer);
       te->writing = true;
-      te->last_write = now;
       grpc_endpoint_write(
           te->wrapped, &te->writing_buffer,
           GRPC_CLOSURE_CREATE(te_finish_write, te, grpc_schedule_on_exec_ctx),
           nullptr);
-      maybe_call_write_cb_locked(te);
     }
   }
   size_t backlog = te->write_buffer.length;
@@ -24,6 +24,11 @@
 grpc_endpoint* grpc_trickle_endpoint_create(grpc_endpoint* wrap,
                                             double bytes_per_second);
 
+/* As grpc_trickle_endpoint_create, but bytes take a further
+   \a one_way_delay_ms to arrive once they are through the bandwidth limit */
+grpc_endpoint* grpc_trickle_endpoint_create_with_delay(
+    grpc_endpoint* wrap, double bytes_per_second, int one_way_delay_ms);
+
 /* Allow up to \a bytes through the endpoint. Returns the new backlog. */
 size_t grpc_trickle_endpoint_trickle(grpc_endpoint* endpoint);
 
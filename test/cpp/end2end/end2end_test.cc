@@ -999,6 +999,71 @@ TEST_P(End2endTest, ResponseStreamWithEverythingCoalesced) {
   EXPECT_TRUE(s.ok());
 }
 
+TEST_P(End2endTest, ResponseStreamReadMessages) {
+  MAYBE_SKIP_TEST;
+  ResetStub();
+  EchoRequest request;
+  std::vector<EchoResponse> responses;
+  ClientContext context;
+  request.set_message("hello");
+  const int kNumResponses = 10;
+  const size_t kMaxMessages = 4;
+  context.AddMetadata(kServerResponseStreamsToSend,
+                      grpc::to_string(kNumResponses));
+
+  auto stream = stub_->ResponseStream(&context, request);
+  // Give every response time to arrive, so that they can be read in batches
+  stream->WaitForInitialMetadata();
+  gpr_sleep_until(gpr_time_add(
+      gpr_now(GPR_CLOCK_REALTIME),
+      gpr_time_from_millis(200 * grpc_test_slowdown_factor(), GPR_TIMESPAN)));
+  int received = 0;
+  while (stream->ReadMessages(&responses, kMaxMessages)) {
+    EXPECT_GE(responses.size(), 1u);
+    EXPECT_LE(responses.size(), kMaxMessages);
+    // Batches need chttp2 to report buffered messages, and interceptors see
+    // every message on its own
+    if (received == 0 && !GetParam().inproc && !GetParam().use_interceptors) {
+      EXPECT_EQ(responses.size(), kMaxMessages);
+    }
+    for (const EchoResponse& response : responses) {
+      EXPECT_EQ(response.message(),
+                request.message() + grpc::to_string(received));
+      ++received;
+    }
+  }
+  EXPECT_TRUE(responses.empty());
+  EXPECT_EQ(received, kNumResponses);
+
+  Status s = stream->Finish();
+  EXPECT_TRUE(s.ok());
+}
+
+TEST_P(End2endTest, ResponseStreamReadMessagesOneAtATime) {
+  MAYBE_SKIP_TEST;
+  ResetStub();
+  EchoRequest request;
+  std::vector<EchoResponse> responses;
+  ClientContext context;
+  request.set_message("hello");
+
+  auto stream = stub_->ResponseStream(&context, request);
+  stream->WaitForInitialMetadata();
+  gpr_sleep_until(gpr_time_add(
+      gpr_now(GPR_CLOCK_REALTIME),
+      gpr_time_from_millis(200 * grpc_test_slowdown_factor(), GPR_TIMESPAN)));
+  for (int i = 0; i < kServerDefaultResponseStreamsToSend; ++i) {
+    EXPECT_TRUE(stream->ReadMessages(&responses, 1));
+    ASSERT_EQ(responses.size(), 1u);
+    EXPECT_EQ(responses[0].message(), request.message() + grpc::to_string(i));
+  }
+  EXPECT_FALSE(stream->ReadMessages(&responses, 1));
+  EXPECT_TRUE(responses.empty());
+
+  Status s = stream->Finish();
+  EXPECT_TRUE(s.ok());
+}
+
 TEST_P(End2endTest, BidiStream) {
   MAYBE_SKIP_TEST;
   ResetStub();
@@ -1024,6 +1089,45 @@ TEST_P(End2endTest, BidiStream) {
   EXPECT_TRUE(s.ok());
 }
 
+TEST_P(End2endTest, BidiStreamReadMessages) {
+  MAYBE_SKIP_TEST;
+  ResetStub();
+  EchoRequest request;
+  std::vector<EchoResponse> responses;
+  ClientContext context;
+  grpc::string msg("hello");
+  const int kNumRequests = 5;
+  const size_t kMaxMessages = 2;
+
+  auto stream = stub_->BidiStream(&context);
+
+  // Write from another thread: with inproc, a write only completes once the
+  // server has read it, and the server only reads on once its echo is read
+  std::thread writer([&stream, &request, &msg] {
+    for (int i = 0; i < kNumRequests; ++i) {
+      request.set_message(msg + grpc::to_string(i));
+      EXPECT_TRUE(stream->Write(request));
+    }
+    stream->WritesDone();
+  });
+  int received = 0;
+  while (stream->ReadMessages(&responses, kMaxMessages)) {
+    EXPECT_GE(responses.size(), 1u);
+    EXPECT_LE(responses.size(), kMaxMessages);
+    for (const EchoResponse& response : responses) {
+      EXPECT_EQ(response.message(), msg + grpc::to_string(received));
+      ++received;
+    }
+  }
+  EXPECT_TRUE(responses.empty());
+  EXPECT_EQ(received, kNumRequests);
+  EXPECT_FALSE(stream->ReadMessages(&responses, kMaxMessages));
+  writer.join();
+
+  Status s = stream->Finish();
+  EXPECT_TRUE(s.ok());
+}
+
 TEST_P(End2endTest, BidiStreamWithCoalescingApi) {
   MAYBE_SKIP_TEST;
   ResetStub();
@@ -1293,6 +1397,30 @@ TEST_P(End2endTest, ChannelState) {
   EXPECT_TRUE(state == GRPC_CHANNEL_CONNECTING || state == GRPC_CHANNEL_READY);
 }
 
+TEST_P(End2endTest, GetRoundTripTimes) {
+  MAYBE_SKIP_TEST;
+  // Round trip times come from HTTP/2 pings
+  if (GetParam().inproc) {
+    return;
+  }
+
+  ResetStub();
+  std::chrono::microseconds smoothed_rtt;
+  std::chrono::microseconds min_rtt;
+  // Nothing measured before the channel connected
+  EXPECT_FALSE(channel_->GetRoundTripTimes(&smoothed_rtt, &min_rtt));
+
+  // The client sends BDP probe pings as it receives responses
+  bool measured = false;
+  for (int i = 0; i < 100 && !measured; i++) {
+    SendRpc(stub_.get(), 1, false);
+    measured = channel_->GetRoundTripTimes(&smoothed_rtt, &min_rtt);
+  }
+  EXPECT_TRUE(measured);
+  EXPECT_GT(smoothed_rtt.count(), 0);
+  EXPECT_GT(min_rtt.count(), 0);
+}
+
 // Takes 10s.
 TEST_P(End2endTest, ChannelStateTimeout) {
   if ((GetParam().credentials_type != kInsecureCredentialsType) ||
@@ -18,6 +18,7 @@
 
 #include <climits>
 #include <thread>
+#include <vector>
 
 #include <grpc/grpc.h>
 #include <grpc/support/log.h>
@@ -124,6 +125,31 @@ class FakeClient {
     EXPECT_TRUE(s.ok());
   }
 
+  void DoResponseStreamReadMessages() {
+    EchoRequest request;
+    std::vector<EchoResponse> responses;
+    request.set_message("hello world");
+
+    ClientContext context;
+    std::unique_ptr<ClientReaderInterface<EchoResponse>> cstream =
+        stub_->ResponseStream(&context, request);
+
+    grpc::string exp = "";
+    while (cstream->ReadMessages(&responses, 2)) {
+      EXPECT_FALSE(responses.empty());
+      EXPECT_LE(responses.size(), 2u);
+      for (const EchoResponse& response : responses) {
+        if (!exp.empty()) exp.append(" ");
+        exp.append(response.message());
+      }
+    }
+    EXPECT_TRUE(responses.empty());
+    EXPECT_EQ(request.message(), exp);
+
+    Status s = cstream->Finish();
+    EXPECT_TRUE(s.ok());
+  }
+
   void DoBidiStream() {
     EchoRequest request;
     EchoResponse response;
@@ -314,6 +340,29 @@ TEST_F(MockTest, ServerStream) {
   client.DoResponseStream();
 }
 
+TEST_F(MockTest, ServerStreamReadMessages) {
+  ResetStub();
+  FakeClient client(stub_.get());
+  client.DoResponseStreamReadMessages();
+
+  MockEchoTestServiceStub stub;
+  auto r = new MockClientReader<EchoResponse>();
+  std::vector<EchoResponse> resps(2);
+  resps[0].set_message("hello");
+  resps[1].set_message("world");
+
+  EXPECT_CALL(*r, ReadMessages(_, 2))
+      .WillOnce(DoAll(SetArgPointee<0>(resps), Return(true)))
+      .WillOnce(
+          DoAll(SetArgPointee<0>(std::vector<EchoResponse>()), Return(false)));
+  EXPECT_CALL(*r, Finish()).WillOnce(Return(Status::OK));
+
+  EXPECT_CALL(stub, ResponseStreamRaw(_, _)).WillOnce(Return(r));
+
+  client.ResetStub(&stub);
+  client.DoResponseStreamReadMessages();
+}
+
 ACTION_P(copy, msg) { arg0->set_message(msg->message()); }
 
 TEST_F(MockTest, BidiStream) {
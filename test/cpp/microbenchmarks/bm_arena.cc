@@ -59,6 +59,35 @@ static void BM_Arena_Batch(benchmark::State& state) {
 }
 BENCHMARK(BM_Arena_Batch)->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
 
+// Calls whose allocations do not fit their initial zone, so that every
+// arena allocates state.range(0) zones of state.range(1) bytes
+static Arena* OverflowingArena(benchmark::State& state) {
+  Arena* a = Arena::Create(256);
+  a->Alloc(256);
+  for (int i = 0; i < state.range(0); i++) {
+    a->Alloc(state.range(1));
+  }
+  return a;
+}
+
+static void BM_Arena_Overflow(benchmark::State& state) {
+  const Arena::ZoneCacheStats cache_before = Arena::GetZoneCacheStats();
+  for (auto _ : state) {
+    OverflowingArena(state)->Destroy();
+  }
+  const Arena::ZoneCacheStats cache_after = Arena::GetZoneCacheStats();
+  const size_t hits = cache_after.hits - cache_before.hits;
+  const size_t misses = cache_after.misses - cache_before.misses;
+  Arena* a = OverflowingArena(state);
+  const Arena::Stats arena_stats = a->GetStats();
+  a->Destroy();
+  state.counters["zones"] = arena_stats.zone_count;
+  state.counters["overflow_bytes"] = arena_stats.overflow_bytes;
+  state.counters["zone_cache_hit_rate"] =
+      hits + misses == 0 ? 0 : static_cast<double>(hits) / (hits + misses);
+}
+BENCHMARK(BM_Arena_Overflow)->Ranges({{1, 16}, {64, 128 * 1024}});
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -66,6 +95,7 @@ void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
 }  // namespace benchmark
 
 int main(int argc, char** argv) {
+  LibraryInitializer libInit;
   ::benchmark::Initialize(&argc, argv);
   ::grpc::testing::InitTest(&argc, &argv, false);
   benchmark::RunTheBenchmarksNamespaced();
@@ -24,7 +24,10 @@
 #include <string.h>
 #include <memory>
 #include <sstream>
+#include <string>
+#include <utility>
 
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/ext/transport/chttp2/transport/incoming_metadata.h"
@@ -45,6 +48,43 @@ static grpc_slice MakeSlice(std::vector<uint8_t> bytes) {
   return s;
 }
 
+// Appends s, Huffman coded, as an HPACK string literal
+static void AppendHuffmanString(std::vector<uint8_t>* out,
+                                const std::string& s) {
+  grpc_slice raw = grpc_slice_from_copied_buffer(s.data(), s.size());
+  grpc_slice huff = grpc_chttp2_huffman_compress(raw);
+  size_t len = GRPC_SLICE_LENGTH(huff);
+  // Length is a 7 bit prefix integer, with the top bit flagging Huffman coding
+  if (len < 0x7f) {
+    out->push_back(static_cast<uint8_t>(0x80 | len));
+  } else {
+    out->push_back(0xff);
+    len -= 0x7f;
+    while (len >= 0x80) {
+      out->push_back(static_cast<uint8_t>(0x80 | (len & 0x7f)));
+      len >>= 7;
+    }
+    out->push_back(static_cast<uint8_t>(len));
+  }
+  out->insert(out->end(), GRPC_SLICE_START_PTR(huff), GRPC_SLICE_END_PTR(huff));
+  grpc_slice_unref(raw);
+  grpc_slice_unref(huff);
+}
+
+// Encodes headers as literal header fields with new names and without
+// indexing, Huffman coding names and values, so that every parse of the result
+// goes through the Huffman decoder.
+static grpc_slice MakeHuffmanLiteralHeaders(
+    const std::vector<std::pair<std::string, std::string>>& headers) {
+  std::vector<uint8_t> bytes;
+  for (const auto& header : headers) {
+    bytes.push_back(0x00);
+    AppendHuffmanString(&bytes, header.first);
+    AppendHuffmanString(&bytes, header.second);
+  }
+  return MakeSlice(bytes);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // HPACK encoder
 //
@@ -166,6 +206,120 @@ static void BM_HpackEncoderEncodeHeader(benchmark::State& state) {
   track_counters.Finish(state);
 }
 
+// Encodes the initial metadata of a sequence of calls on one connection, to
+// see how well the encoder picks what to keep in the decoder's table
+template <class Fixture>
+static void BM_HpackEncoderEncodeCalls(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<std::vector<grpc_mdelem>> calls = Fixture::GetCalls();
+  std::unique_ptr<grpc_chttp2_hpack_compressor> c(
+      new grpc_chttp2_hpack_compressor);
+  grpc_chttp2_hpack_compressor_init(c.get());
+  grpc_transport_one_way_stats stats;
+  stats = {};
+  grpc_slice_buffer outbuf;
+  grpc_slice_buffer_init(&outbuf);
+  std::vector<grpc_linked_mdelem> storage;
+  size_t call = 0;
+  for (auto _ : state) {
+    const std::vector<grpc_mdelem>& elems = calls[call++ % calls.size()];
+    grpc_metadata_batch b;
+    grpc_metadata_batch_init(&b);
+    storage.resize(elems.size());
+    for (size_t i = 0; i < elems.size(); i++) {
+      GPR_ASSERT(GRPC_LOG_IF_ERROR(
+          "addmd", grpc_metadata_batch_add_tail(&b, &storage[i],
+                                                GRPC_MDELEM_REF(elems[i]))));
+    }
+    grpc_encode_header_options hopt = {
+        static_cast<uint32_t>(2 * call + 1),
+        false,
+        Fixture::kEnableTrueBinary,
+        static_cast<size_t>(16384),
+        &stats,
+    };
+    grpc_chttp2_encode_header(c.get(), nullptr, 0, &b, &hopt, &outbuf);
+    grpc_metadata_batch_destroy(&b);
+    grpc_slice_buffer_reset_and_unref_internal(&outbuf);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  state.counters["compression_ratio"] =
+      grpc_chttp2_hpack_compressor_compression_ratio(c.get());
+  state.counters["index_rejected"] = benchmark::Counter(
+      static_cast<double>(c->stats.index_rejected),
+      benchmark::Counter::kAvgIterations);
+  grpc_chttp2_hpack_compressor_destroy(c.get());
+  grpc_slice_buffer_destroy_internal(&outbuf);
+  for (auto& elems : calls) {
+    for (grpc_mdelem elem : elems) {
+      GRPC_MDELEM_UNREF(elem);
+    }
+  }
+
+  std::ostringstream label;
+  label << "header_bytes/iter:"
+        << (static_cast<double>(stats.header_bytes) /
+            static_cast<double>(state.iterations()));
+  track_counters.AddLabel(label.str());
+  track_counters.Finish(state);
+}
+
+// Encodes trailers-only responses on one connection, with the trailers-only
+// fast path if kFastPath, or else with the general encoder
+template <class Fixture, bool kFastPath>
+static void BM_HpackEncoderEncodeTrailersOnly(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<grpc_mdelem> elems = Fixture::GetElems();
+  grpc_mdelem status = GRPC_MDELEM_STATUS_200;
+  grpc_mdelem content_type = GRPC_MDELEM_CONTENT_TYPE_APPLICATION_SLASH_GRPC;
+  grpc_mdelem* extra_headers[] = {&status, &content_type};
+  std::unique_ptr<grpc_chttp2_hpack_compressor> c(
+      new grpc_chttp2_hpack_compressor);
+  grpc_chttp2_hpack_compressor_init(c.get());
+  grpc_transport_one_way_stats stats;
+  stats = {};
+  grpc_slice_buffer outbuf;
+  grpc_slice_buffer_init(&outbuf);
+  std::vector<grpc_linked_mdelem> storage(elems.size());
+  uint32_t stream_id = 1;
+  for (auto _ : state) {
+    grpc_metadata_batch b;
+    grpc_metadata_batch_init(&b);
+    for (size_t i = 0; i < elems.size(); i++) {
+      GPR_ASSERT(GRPC_LOG_IF_ERROR(
+          "addmd", grpc_metadata_batch_add_tail(&b, &storage[i],
+                                                GRPC_MDELEM_REF(elems[i]))));
+    }
+    grpc_encode_header_options hopt = {
+        stream_id, true, true, static_cast<size_t>(16384), &stats,
+    };
+    stream_id += 2;
+    if (!kFastPath ||
+        !grpc_chttp2_encode_trailers_only(c.get(), extra_headers, 2, &b,
+                                          &hopt, &outbuf)) {
+      grpc_chttp2_encode_header(c.get(), extra_headers, 2, &b, &hopt,
+                                &outbuf);
+    }
+    grpc_metadata_batch_destroy(&b);
+    grpc_slice_buffer_reset_and_unref_internal(&outbuf);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  grpc_chttp2_hpack_compressor_destroy(c.get());
+  grpc_slice_buffer_destroy_internal(&outbuf);
+  for (grpc_mdelem elem : elems) {
+    GRPC_MDELEM_UNREF(elem);
+  }
+
+  std::ostringstream label;
+  label << "header_bytes/iter:"
+        << (static_cast<double>(stats.header_bytes) /
+            static_cast<double>(state.iterations()));
+  track_counters.AddLabel(label.str());
+  track_counters.Finish(state);
+}
+
 namespace hpack_encoder_fixtures {
 
 class EmptyBatch {
@@ -424,6 +578,87 @@ BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeHeader,
                    RepresentativeServerTrailingMetadata)
     ->Args({1, 16384});
 
+static grpc_slice InternString(const std::string& s) {
+  grpc_slice copy = grpc_slice_from_copied_buffer(s.data(), s.size());
+  grpc_slice interned = grpc_slice_intern(copy);
+  grpc_slice_unref(copy);
+  return interned;
+}
+
+static grpc_mdelem InternedElem(const std::string& key,
+                                const std::string& value) {
+  return grpc_mdelem_from_slices(InternString(key), InternString(value));
+}
+
+// Calls to a few methods, each carrying some popular custom headers, and
+// tracing headers with values that are unique to the call. Everything is
+// interned, as it would be when a server forwards what it received.
+class TracedCalls {
+ public:
+  static constexpr bool kEnableTrueBinary = true;
+  static constexpr int kCalls = 1024;
+  static std::vector<std::vector<grpc_mdelem>> GetCalls() {
+    static const char* kMethods[] = {"/grpc.test.FooService/Get",
+                                     "/grpc.test.FooService/List",
+                                     "/grpc.test.FooService/Update",
+                                     "/grpc.test.BarService/Lookup"};
+    static const char* kTenants[] = {"alpha", "bravo", "charlie", "delta",
+                                     "echo",  "foxtrot"};
+    std::vector<std::vector<grpc_mdelem>> calls;
+    for (int i = 0; i < kCalls; i++) {
+      char trace_id[33];
+      char span_id[17];
+      snprintf(trace_id, sizeof(trace_id), "%016x%016x", rand(), i);
+      snprintf(span_id, sizeof(span_id), "%08x%08x", rand(), i);
+      calls.push_back({
+          GRPC_MDELEM_SCHEME_HTTP,
+          GRPC_MDELEM_METHOD_POST,
+          InternedElem(":path", kMethods[i % 4]),
+          InternedElem(":authority", "foo.test.google.fr:1234"),
+          GRPC_MDELEM_GRPC_ACCEPT_ENCODING_IDENTITY_COMMA_DEFLATE_COMMA_GZIP,
+          GRPC_MDELEM_TE_TRAILERS,
+          GRPC_MDELEM_CONTENT_TYPE_APPLICATION_SLASH_GRPC,
+          InternedElem("user-agent", "grpc-c/3.0.0-dev (linux; chttp2; green)"),
+          InternedElem("x-tenant", kTenants[i % 6]),
+          InternedElem("x-client-version", i % 8 == 0 ? "2.3.1" : "2.4.0"),
+          InternedElem("x-b3-traceid", trace_id),
+          InternedElem("x-b3-spanid", span_id),
+          InternedElem("x-b3-sampled", "1"),
+          InternedElem("x-request-id", std::to_string(1000000 + i)),
+      });
+    }
+    return calls;
+  }
+};
+
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeCalls, TracedCalls);
+
+// Trailers-only responses: :status and content-type moved over from the
+// initial metadata, followed by the status
+class TrailersOnlyOk {
+ public:
+  static std::vector<grpc_mdelem> GetElems() {
+    return {GRPC_MDELEM_GRPC_STATUS_0};
+  }
+};
+
+class TrailersOnlyError {
+ public:
+  static std::vector<grpc_mdelem> GetElems() {
+    return {grpc_mdelem_from_slices(GRPC_MDSTR_GRPC_STATUS,
+                                    grpc_slice_from_static_string("5")),
+            grpc_mdelem_from_slices(
+                GRPC_MDSTR_GRPC_MESSAGE,
+                grpc_slice_from_static_string("entity not found"))};
+  }
+};
+
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeTrailersOnly, TrailersOnlyOk, false);
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeTrailersOnly, TrailersOnlyOk, true);
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeTrailersOnly, TrailersOnlyError,
+                   false);
+BENCHMARK_TEMPLATE(BM_HpackEncoderEncodeTrailersOnly, TrailersOnlyError, true);
+
 }  // namespace hpack_encoder_fixtures
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -780,6 +1015,48 @@ class RepresentativeServerTrailingMetadata {
   }
 };
 
+// The following fixtures carry the same metadata as the representative ones
+// above, but Huffman coded and not indexed, which is how peers that do not
+// index (or have evicted) those headers send them.
+class HuffmanRepresentativeServerInitialMetadata {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    // test/cpp/microbenchmarks/representative_server_initial_metadata.headers
+    return {MakeHuffmanLiteralHeaders(
+        {{":status", "200"},
+         {"content-type", "application/grpc"},
+         {"grpc-accept-encoding", "identity,deflate,gzip"}})};
+  }
+};
+
+class HuffmanRepresentativeServerTrailingMetadata {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    // test/cpp/microbenchmarks/representative_server_trailing_metadata.headers
+    return {MakeHuffmanLiteralHeaders(
+        {{"grpc-status", "0"}, {"grpc-message", ""}})};
+  }
+};
+
+// Long, high entropy values such as auth tokens and trace contexts
+class HuffmanAuthAndTracingMetadata {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    return {MakeHuffmanLiteralHeaders(
+        {{"authorization",
+          "Bearer ya29.a0AfH6SMBx3kQ9vZtL2pW7nR4cY8uE1oI5aS6dF0gH3jK9lZ2xC7vB4n"
+          "M1qW8eR5tY2uI9oP6aS3dF0gH7jK4lZ1xC8vB5nM2qW9eR6tY3uI0oP7aS4dF1gH8jK5"
+          "lZ2xC9vB6nM3qW0eR7tY4uI1oP8aS5dF2gH9jK6lZ3xC0vB7nM4qW1eR8tY5uI2oP9a"},
+         {"x-cloud-trace-context", "105445aa7843bc8bf206b12000100000/1;o=1"},
+         {"traceparent",
+          "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01"},
+         {"user-agent", "grpc-c++/1.25.0-dev grpc-c/8.0.0 (linux; chttp2)"}})};
+  }
+};
+
 static void free_timeout(void* p) { gpr_free(p); }
 
 // Benchmark the current on_initial_header implementation
@@ -927,6 +1204,12 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
                    RepresentativeServerInitialMetadata, OnInitialHeader);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, SameDeadline, OnHeaderTimeout);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
+                   HuffmanRepresentativeServerInitialMetadata, UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
+                   HuffmanRepresentativeServerTrailingMetadata, UnrefHeader);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, HuffmanAuthAndTracingMetadata,
+                   UnrefHeader);
 
 }  // namespace hpack_parser_fixtures
 
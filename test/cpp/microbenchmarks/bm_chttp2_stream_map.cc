@@ -0,0 +1,130 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Microbenchmarks around the chttp2 stream id -> stream map */
+
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+
+#include <grpc/grpc.h>
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+#include "src/core/ext/transport/chttp2/transport/stream_map.h"
+
+namespace grpc {
+namespace testing {
+
+/* Client initiated stream ids: odd, and increasing as streams are created */
+static uint32_t StreamId(size_t n) { return static_cast<uint32_t>(2 * n + 1); }
+
+/* Holds the streams numbered [oldest, oldest + live) */
+class LiveStreams {
+ public:
+  explicit LiveStreams(size_t live) : live_(live) {
+    grpc_chttp2_stream_map_init(&map_, 8);
+    for (size_t i = 0; i < live_; i++) {
+      grpc_chttp2_stream_map_add(&map_, StreamId(i), this);
+    }
+  }
+  ~LiveStreams() { grpc_chttp2_stream_map_destroy(&map_); }
+
+  grpc_chttp2_stream_map* map() { return &map_; }
+
+  /* The i-th live stream, visiting them in a scattered order as the reads
+   * of incoming frames on many concurrent streams would */
+  uint32_t Scattered(size_t i) const {
+    return StreamId(oldest_ + (i * 7919) % live_);
+  }
+
+  /* Closes the oldest stream and opens a new one */
+  void Churn() {
+    grpc_chttp2_stream_map_delete(&map_, StreamId(oldest_));
+    grpc_chttp2_stream_map_add(&map_, StreamId(oldest_ + live_), this);
+    oldest_++;
+  }
+
+ private:
+  const size_t live_;
+  size_t oldest_ = 0;
+  grpc_chttp2_stream_map map_;
+};
+
+static void BM_StreamMapFind(benchmark::State& state) {
+  TrackCounters track_counters;
+  LiveStreams streams(static_cast<size_t>(state.range(0)));
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        grpc_chttp2_stream_map_find(streams.map(), streams.Scattered(i++)));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapFind)->Arg(10)->Arg(1000)->Arg(100000);
+
+/* Each iteration closes a stream, opens one and looks up a few others */
+static void BM_StreamMapChurn(benchmark::State& state) {
+  constexpr size_t kFindsPerChurn = 4;
+  TrackCounters track_counters;
+  LiveStreams streams(static_cast<size_t>(state.range(0)));
+  size_t i = 0;
+  for (auto _ : state) {
+    streams.Churn();
+    for (size_t j = 0; j < kFindsPerChurn; j++) {
+      benchmark::DoNotOptimize(
+          grpc_chttp2_stream_map_find(streams.map(), streams.Scattered(i++)));
+    }
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapChurn)->Arg(10)->Arg(1000)->Arg(100000);
+
+static void BM_StreamMapForEach(benchmark::State& state) {
+  TrackCounters track_counters;
+  LiveStreams streams(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    size_t visited = 0;
+    grpc_chttp2_stream_map_for_each(
+        streams.map(),
+        [](void* user_data, uint32_t /*key*/, void* /*value*/) {
+          ++*static_cast<size_t*>(user_data);
+        },
+        &visited);
+    benchmark::DoNotOptimize(visited);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_StreamMapForEach)->Arg(10)->Arg(1000)->Arg(100000);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
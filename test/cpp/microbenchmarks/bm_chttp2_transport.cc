@@ -24,6 +24,7 @@
 #include <grpc/support/string_util.h>
 #include <grpcpp/support/channel_arguments.h>
 #include <string.h>
+#include <algorithm>
 #include <memory>
 #include <queue>
 #include <sstream>
@@ -42,7 +43,8 @@
 
 class DummyEndpoint : public grpc_endpoint {
  public:
-  DummyEndpoint() {
+  explicit DummyEndpoint(bool client)
+      : skip_bytes_(client ? GRPC_CHTTP2_CLIENT_CONNECT_STRLEN : 0) {
     static const grpc_endpoint_vtable my_vtable = {read,
                                                    write,
                                                    add_to_pollset,
@@ -71,12 +73,54 @@ class DummyEndpoint : public grpc_endpoint {
     read_cb_ = nullptr;
   }
 
+  // Bytes written to the wire so far.
+  size_t bytes_written() const { return bytes_written_; }
+  // Value of bytes_written() just after the last frame that carried an
+  // END_STREAM flag.
+  size_t last_end_stream_offset() const { return last_end_stream_offset_; }
+
  private:
+  // Follows the HTTP/2 frame headers in the written bytes.
+  void TrackFrames(grpc_slice_buffer* slices) {
+    for (size_t i = 0; i < slices->count; i++) {
+      const uint8_t* p = GRPC_SLICE_START_PTR(slices->slices[i]);
+      const uint8_t* end = GRPC_SLICE_END_PTR(slices->slices[i]);
+      while (p != end) {
+        if (skip_bytes_ > 0) {
+          size_t n = GPR_MIN(skip_bytes_, static_cast<size_t>(end - p));
+          p += n;
+          bytes_written_ += n;
+          skip_bytes_ -= n;
+        } else {
+          frame_header_[frame_header_bytes_++] = *p++;
+          bytes_written_++;
+          if (frame_header_bytes_ < sizeof(frame_header_)) continue;
+          frame_header_bytes_ = 0;
+          skip_bytes_ = (frame_header_[0] << 16) | (frame_header_[1] << 8) |
+                        frame_header_[2];
+          // END_STREAM is flag 0x1 of DATA (0x0) and HEADERS (0x1) frames
+          end_stream_pending_ = frame_header_[3] <= 1 && (frame_header_[4] & 1);
+        }
+        if (skip_bytes_ == 0 && end_stream_pending_) {
+          last_end_stream_offset_ = bytes_written_;
+          end_stream_pending_ = false;
+        }
+      }
+    }
+  }
+
   grpc_resource_user* ru_;
   grpc_closure* read_cb_ = nullptr;
   grpc_slice_buffer* slices_ = nullptr;
   bool have_slice_ = false;
   grpc_slice buffered_slice_;
+  size_t bytes_written_ = 0;
+  size_t last_end_stream_offset_ = 0;
+  // Bytes left in the connection preface or the current frame's payload
+  size_t skip_bytes_;
+  uint8_t frame_header_[9];
+  size_t frame_header_bytes_ = 0;
+  bool end_stream_pending_ = false;
 
   void QueueRead(grpc_slice_buffer* slices, grpc_closure* cb) {
     GPR_ASSERT(read_cb_ == nullptr);
@@ -95,8 +139,9 @@ class DummyEndpoint : public grpc_endpoint {
     static_cast<DummyEndpoint*>(ep)->QueueRead(slices, cb);
   }
 
-  static void write(grpc_endpoint* /*ep*/, grpc_slice_buffer* /*slices*/,
+  static void write(grpc_endpoint* ep, grpc_slice_buffer* slices,
                     grpc_closure* cb, void* /*arg*/) {
+    static_cast<DummyEndpoint*>(ep)->TrackFrames(slices);
     GRPC_CLOSURE_SCHED(cb, GRPC_ERROR_NONE);
   }
 
@@ -131,7 +176,7 @@ class Fixture {
  public:
   Fixture(const grpc::ChannelArguments& args, bool client) {
     grpc_channel_args c_args = args.c_channel_args();
-    ep_ = new DummyEndpoint;
+    ep_ = new DummyEndpoint(client);
     t_ = grpc_create_chttp2_transport(&c_args, ep_, client);
     grpc_chttp2_transport_start_reading(t_, nullptr, nullptr);
     FlushExecCtx();
@@ -148,6 +193,8 @@ class Fixture {
 
   void PushInput(grpc_slice slice) { ep_->PushInput(slice); }
 
+  DummyEndpoint* endpoint() { return ep_; }
+
  private:
   DummyEndpoint* ep_;
   grpc_transport* t_;
@@ -490,6 +537,194 @@ static void BM_TransportStreamSend(benchmark::State& state) {
 }
 BENCHMARK(BM_TransportStreamSend)->Range(0, 128 * 1024 * 1024);
 
+class FifoWrites {
+ public:
+  static grpc::ChannelArguments Args() { return grpc::ChannelArguments(); }
+  static const char* BulkPriority() { return nullptr; }
+};
+
+class WdrrWrites {
+ public:
+  static grpc::ChannelArguments Args() {
+    grpc::ChannelArguments args;
+    args.SetString(GRPC_ARG_HTTP2_WRITE_SCHEDULER, "wdrr");
+    return args;
+  }
+  static const char* BulkPriority() { return nullptr; }
+};
+
+class WdrrWritesLowPriorityBulk : public WdrrWrites {
+ public:
+  static const char* BulkPriority() { return "1"; }
+};
+
+// Issues unary calls on a transport that is also busy sending a bulk stream
+// of state.range(0) byte messages. Reports how many bytes hit the wire between
+// starting each unary call and finishing it, which is how long the call would
+// take on a link that the bulk stream saturates.
+template <class WriteConfig>
+static void BM_UnaryLatencyNextToBulkStream(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  Fixture f(WriteConfig::Args(), true);
+  grpc_transport_stream_op_batch_payload op_payload(nullptr);
+  grpc_transport_stream_op_batch_payload bulk_op_payload(nullptr);
+  grpc_transport_stream_op_batch op;
+  grpc_transport_stream_op_batch bulk_op;
+  auto reset_op = [&]() {
+    op = {};
+    op.payload = &op_payload;
+  };
+  auto reset_bulk_op = [&]() {
+    bulk_op = {};
+    bulk_op.payload = &bulk_op_payload;
+  };
+  std::vector<grpc_mdelem> elems =
+      RepresentativeClientInitialMetadata::GetElems();
+  grpc_metadata_batch unary_md;
+  grpc_metadata_batch_init(&unary_md);
+  unary_md.deadline = GRPC_MILLIS_INF_FUTURE;
+  std::vector<grpc_linked_mdelem> unary_storage(elems.size());
+  for (size_t i = 0; i < elems.size(); i++) {
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "addmd", grpc_metadata_batch_add_tail(&unary_md, &unary_storage[i],
+                                              GRPC_MDELEM_REF(elems[i]))));
+  }
+  grpc_metadata_batch bulk_md;
+  grpc_metadata_batch_init(&bulk_md);
+  bulk_md.deadline = GRPC_MILLIS_INF_FUTURE;
+  std::vector<grpc_linked_mdelem> bulk_storage(elems.size() + 1);
+  for (size_t i = 0; i < elems.size(); i++) {
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "addmd",
+        grpc_metadata_batch_add_tail(&bulk_md, &bulk_storage[i], elems[i])));
+  }
+  if (WriteConfig::BulkPriority() != nullptr) {
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "addmd",
+        grpc_metadata_batch_add_tail(
+            &bulk_md, &bulk_storage[elems.size()],
+            grpc_mdelem_from_slices(
+                grpc_slice_intern(grpc_slice_from_static_string(
+                    "grpc-priority")),
+                grpc_slice_intern(grpc_slice_from_static_string(
+                    WriteConfig::BulkPriority()))))));
+  }
+  grpc_metadata_batch empty_trailers;
+  grpc_metadata_batch_init(&empty_trailers);
+
+  grpc_slice bulk_slice = grpc_slice_malloc_large(state.range(0));
+  memset(GRPC_SLICE_START_PTR(bulk_slice), 0, GRPC_SLICE_LENGTH(bulk_slice));
+  grpc_slice unary_slice = grpc_slice_malloc_large(100);
+  memset(GRPC_SLICE_START_PTR(unary_slice), 0, GRPC_SLICE_LENGTH(unary_slice));
+  grpc_core::ManualConstructor<grpc_core::SliceBufferByteStream> bulk_stream;
+  grpc_core::ManualConstructor<grpc_core::SliceBufferByteStream> unary_stream;
+  auto init_byte_stream =
+      [](grpc_core::ManualConstructor<grpc_core::SliceBufferByteStream>* bs,
+         grpc_slice slice) {
+        grpc_slice_buffer buffer;
+        grpc_slice_buffer_init(&buffer);
+        grpc_slice_buffer_add(&buffer, grpc_slice_ref(slice));
+        bs->Init(&buffer, 0);
+        grpc_slice_buffer_destroy(&buffer);
+      };
+
+  // Queues another bulk message whenever the previous one has been framed, so
+  // the bulk stream is backlogged each time a unary call starts.
+  auto* bulk = new Stream(&f);
+  bulk->Init(state);
+  bool bulk_idle = false;
+  std::unique_ptr<Closure> bulk_sent =
+      MakeClosure([&](grpc_error* /*error*/) { bulk_idle = true; });
+  auto send_bulk = [&]() {
+    bulk_idle = false;
+    init_byte_stream(&bulk_stream, bulk_slice);
+    bulk->chttp2_stream()->flow_control->TestOnlyForceHugeWindow();
+    f.chttp2_transport()->flow_control->TestOnlyForceHugeWindow();
+    reset_bulk_op();
+    bulk_op.on_complete = bulk_sent.get();
+    bulk_op.send_message = true;
+    bulk_op.payload->send_message.send_message.reset(bulk_stream.get());
+    bulk->Op(&bulk_op);
+  };
+  reset_bulk_op();
+  bulk_op.send_initial_metadata = true;
+  bulk_op.payload->send_initial_metadata.send_initial_metadata = &bulk_md;
+  bulk_op.on_complete = bulk_sent.get();
+  bulk->Op(&bulk_op);
+  f.FlushExecCtx();
+
+  auto* s = new Stream(&f);
+  std::vector<size_t> wire_bytes;
+  size_t start_offset = 0;
+  gpr_event bm_done;
+  gpr_event_init(&bm_done);
+  std::unique_ptr<Closure> start;
+  std::unique_ptr<Closure> done;
+  start = MakeClosure([&, s](grpc_error* /*error*/) {
+    if (!state.KeepRunning()) {
+      delete s;
+      gpr_event_set(&bm_done, (void*)1);
+      return;
+    }
+    if (bulk_idle) send_bulk();
+    s->Init(state);
+    init_byte_stream(&unary_stream, unary_slice);
+    s->chttp2_stream()->flow_control->TestOnlyForceHugeWindow();
+    start_offset = f.endpoint()->bytes_written();
+    reset_op();
+    op.on_complete = done.get();
+    op.send_initial_metadata = true;
+    op.payload->send_initial_metadata.send_initial_metadata = &unary_md;
+    op.send_message = true;
+    op.payload->send_message.send_message.reset(unary_stream.get());
+    op.send_trailing_metadata = true;
+    op.payload->send_trailing_metadata.send_trailing_metadata =
+        &empty_trailers;
+    s->Op(&op);
+  });
+  done = MakeClosure([&](grpc_error* /*error*/) {
+    wire_bytes.push_back(f.endpoint()->last_end_stream_offset() -
+                         start_offset);
+    reset_op();
+    op.cancel_stream = true;
+    op.payload->cancel_stream.cancel_error = GRPC_ERROR_CANCELLED;
+    s->Op(&op);
+    s->DestroyThen(start.get());
+  });
+  GRPC_CLOSURE_SCHED(start.get(), GRPC_ERROR_NONE);
+  f.FlushExecCtx();
+  gpr_event_wait(&bm_done, gpr_inf_future(GPR_CLOCK_REALTIME));
+
+  reset_bulk_op();
+  bulk_op.cancel_stream = true;
+  bulk_op.payload->cancel_stream.cancel_error = GRPC_ERROR_CANCELLED;
+  bulk->Op(&bulk_op);
+  bulk->DestroyThen(
+      MakeOnceClosure([bulk](grpc_error* /*error*/) { delete bulk; }));
+  f.FlushExecCtx();
+
+  if (!wire_bytes.empty()) {
+    std::sort(wire_bytes.begin(), wire_bytes.end());
+    std::ostringstream label;
+    label << "wire_bytes_p50:" << wire_bytes[wire_bytes.size() / 2]
+          << " wire_bytes_p99:" << wire_bytes[wire_bytes.size() * 99 / 100];
+    track_counters.AddLabel(label.str());
+  }
+  track_counters.Finish(state);
+  grpc_metadata_batch_destroy(&unary_md);
+  grpc_metadata_batch_destroy(&bulk_md);
+  grpc_metadata_batch_destroy(&empty_trailers);
+  grpc_slice_unref(bulk_slice);
+  grpc_slice_unref(unary_slice);
+}
+BENCHMARK_TEMPLATE(BM_UnaryLatencyNextToBulkStream, FifoWrites)
+    ->Range(64 * 1024, 4 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_UnaryLatencyNextToBulkStream, WdrrWrites)
+    ->Range(64 * 1024, 4 * 1024 * 1024);
+BENCHMARK_TEMPLATE(BM_UnaryLatencyNextToBulkStream, WdrrWritesLowPriorityBulk)
+    ->Range(64 * 1024, 4 * 1024 * 1024);
+
 #define SLICE_FROM_BUFFER(s) grpc_slice_from_static_buffer(s, sizeof(s) - 1)
 
 static grpc_slice CreateIncomingDataSlice(size_t length, size_t frame_size) {
@@ -76,13 +76,39 @@ static void write_csv(std::ostream* out, A0&& a0, Arg&&... arg) {
   write_csv(out, std::forward<Arg>(arg)...);
 }
 
+/* Runs both ends of the connection with the given
+ * GRPC_ARG_HTTP2_WINDOW_STRATEGY */
+class WindowStrategyConfiguration : public FixtureConfiguration {
+ public:
+  explicit WindowStrategyConfiguration(const char* strategy)
+      : strategy_(strategy) {}
+
+  void ApplyCommonChannelArguments(ChannelArguments* c) const override {
+    FixtureConfiguration::ApplyCommonChannelArguments(c);
+    c->SetString(GRPC_ARG_HTTP2_WINDOW_STRATEGY, strategy_);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+    b->AddChannelArgument(GRPC_ARG_HTTP2_WINDOW_STRATEGY,
+                          grpc::string(strategy_));
+  }
+
+ private:
+  const char* strategy_;
+};
+
 class TrickledCHTTP2 : public EndpointPairFixture {
  public:
   TrickledCHTTP2(Service* service, bool streaming, size_t req_size,
                  size_t resp_size, size_t kilobits_per_second,
-                 grpc_passthru_endpoint_stats* stats)
-      : EndpointPairFixture(service, MakeEndpoints(kilobits_per_second, stats),
-                            FixtureConfiguration()),
+                 grpc_passthru_endpoint_stats* stats,
+                 int one_way_delay_ms = 0,
+                 const FixtureConfiguration& config = FixtureConfiguration())
+      : EndpointPairFixture(
+            service,
+            MakeEndpoints(kilobits_per_second, one_way_delay_ms, stats),
+            config),
         stats_(stats) {
     if (FLAGS_log) {
       std::ostringstream fn;
@@ -136,11 +162,13 @@ class TrickledCHTTP2 : public EndpointPairFixture {
         reinterpret_cast<grpc_chttp2_transport*>(server_transport_);
     grpc_chttp2_stream* client_stream =
         client->stream_map.count == 1
-            ? static_cast<grpc_chttp2_stream*>(client->stream_map.values[0])
+            ? static_cast<grpc_chttp2_stream*>(
+                  grpc_chttp2_stream_map_rand(&client->stream_map))
             : nullptr;
     grpc_chttp2_stream* server_stream =
         server->stream_map.count == 1
-            ? static_cast<grpc_chttp2_stream*>(server->stream_map.values[0])
+            ? static_cast<grpc_chttp2_stream*>(
+                  grpc_chttp2_stream_map_rand(&server->stream_map))
             : nullptr;
     write_csv(
         log_.get(),
@@ -184,6 +212,12 @@ class TrickledCHTTP2 : public EndpointPairFixture {
         server_stream ? server_stream->flow_controlled_buffer.length : 0);
   }
 
+  /* Largest connection level window the client has announced to the server
+   * so far: the memory the server may make it buffer */
+  int64_t client_peak_announced_window() const {
+    return client_stats_.peak_announced_window;
+  }
+
   void Step(bool update_stats) {
     grpc_core::ExecCtx exec_ctx;
     inc_time();
@@ -205,6 +239,7 @@ class TrickledCHTTP2 : public EndpointPairFixture {
   struct Stats {
     int streams_stalled_due_to_stream_flow_control = 0;
     int streams_stalled_due_to_transport_flow_control = 0;
+    int64_t peak_announced_window = 0;
   };
   Stats client_stats_;
   Stats server_stats_;
@@ -212,18 +247,23 @@ class TrickledCHTTP2 : public EndpointPairFixture {
   gpr_timespec start_ = gpr_now(GPR_CLOCK_MONOTONIC);
 
   static grpc_endpoint_pair MakeEndpoints(size_t kilobits,
+                                          int one_way_delay_ms,
                                           grpc_passthru_endpoint_stats* stats) {
     grpc_endpoint_pair p;
     grpc_passthru_endpoint_create(&p.client, &p.server,
                                   LibraryInitializer::get().rq(), stats);
     double bytes_per_second = 125.0 * kilobits;
-    p.client = grpc_trickle_endpoint_create(p.client, bytes_per_second);
-    p.server = grpc_trickle_endpoint_create(p.server, bytes_per_second);
+    p.client = grpc_trickle_endpoint_create_with_delay(
+        p.client, bytes_per_second, one_way_delay_ms);
+    p.server = grpc_trickle_endpoint_create_with_delay(
+        p.server, bytes_per_second, one_way_delay_ms);
     return p;
   }
 
   void UpdateStats(grpc_chttp2_transport* t, Stats* s,
                    size_t backlog) GPR_ATTRIBUTE_NO_TSAN {
+    s->peak_announced_window =
+        GPR_MAX(s->peak_announced_window, t->flow_control->announced_window_);
     if (backlog == 0) {
       if (t->lists[GRPC_CHTTP2_LIST_STALLED_BY_STREAM].head != nullptr) {
         s->streams_stalled_due_to_stream_flow_control++;
@@ -450,6 +490,120 @@ static void UnaryTrickleArgs(benchmark::internal::Benchmark* b) {
   }
 }
 BENCHMARK(BM_PumpUnbalancedUnary_Trickle)->Apply(UnaryTrickleArgs);
+
+/* Streams large messages from the server to the client over a fresh
+ * connection with the given window strategy, bandwidth and round trip time,
+ * and reports how long (in the trickle's fake time) it takes for the
+ * throughput over two round trips to reach 90% of the bandwidth, and how big a
+ * window the client had to announce for it. */
+static void BM_StreamingRampUp_Trickle(benchmark::State& state) {
+  static const char* kStrategies[] = {"bdp_pid", "delivery_rate"};
+  constexpr size_t kMessageSize = 256 * 1024;
+  constexpr gpr_atm kMaxRampUpUs = 60 * GPR_US_PER_SEC;
+  const char* strategy = kStrategies[state.range(0)];
+  const int64_t kilobits = state.range(1);
+  const int rtt_ms = static_cast<int>(state.range(2));
+  const gpr_atm sample_us = 2000 * rtt_ms;
+  const double full_sample_bytes = 0.9 * 125.0 * kilobits * 2e-3 * rtt_ms;
+  double total_ramp_up_ms = 0;
+  int64_t peak_announced_window = 0;
+  int ramped_up = 0;
+  for (auto _ : state) {
+    EchoTestService::AsyncService service;
+    std::unique_ptr<TrickledCHTTP2> fixture(new TrickledCHTTP2(
+        &service, true, kMessageSize, kMessageSize, kilobits,
+        grpc_passthru_endpoint_stats_create(), rtt_ms / 2,
+        WindowStrategyConfiguration(strategy)));
+    EchoResponse send_response;
+    EchoResponse recv_response;
+    send_response.set_message(std::string(kMessageSize, 'a'));
+    ServerContext svr_ctx;
+    ServerAsyncReaderWriter<EchoResponse, EchoRequest> response_rw(&svr_ctx);
+    service.RequestBidiStream(&svr_ctx, &response_rw, fixture->cq(),
+                              fixture->cq(), tag(0));
+    std::unique_ptr<EchoTestService::Stub> stub(
+        EchoTestService::NewStub(fixture->channel()));
+    ClientContext cli_ctx;
+    auto request_rw = stub->AsyncBidiStream(&cli_ctx, fixture->cq(), tag(1));
+    int need_tags = (1 << 0) | (1 << 1);
+    void* t;
+    bool ok;
+    while (need_tags) {
+      TrickleCQNext(fixture.get(), &t, &ok, -1);
+      GPR_ASSERT(ok);
+      int i = (int)(intptr_t)t;
+      GPR_ASSERT(need_tags & (1 << i));
+      need_tags &= ~(1 << i);
+    }
+    request_rw->Read(&recv_response, tag(0));
+    response_rw.Write(send_response, tag(1));
+    const gpr_atm start_us = gpr_atm_no_barrier_load(&g_now_us);
+    gpr_atm sample_start_us = start_us;
+    double sample_bytes = 0;
+    gpr_atm ramp_up_us = -1;
+    while (true) {
+      TrickleCQNext(fixture.get(), &t, &ok, 0);
+      GPR_ASSERT(ok);
+      const gpr_atm now_us = gpr_atm_no_barrier_load(&g_now_us);
+      if (t == tag(0)) {
+        sample_bytes += kMessageSize;
+        request_rw->Read(&recv_response, tag(0));
+      } else if (t == tag(1)) {
+        // only stop between writes, so that the stream can be finished
+        if (ramp_up_us >= 0 || now_us - start_us > kMaxRampUpUs) break;
+        response_rw.Write(send_response, tag(1));
+      } else {
+        GPR_ASSERT(false);
+      }
+      if (ramp_up_us < 0 && now_us - sample_start_us >= sample_us) {
+        if (sample_bytes >= full_sample_bytes) {
+          ramp_up_us = now_us - start_us;
+        }
+        sample_start_us = now_us;
+        sample_bytes = 0;
+      }
+    }
+    if (ramp_up_us >= 0) {
+      total_ramp_up_ms += ramp_up_us / 1e3;
+      ramped_up++;
+    }
+    peak_announced_window = GPR_MAX(peak_announced_window,
+                                    fixture->client_peak_announced_window());
+    response_rw.Finish(Status::OK, tag(1));
+    grpc::Status status;
+    request_rw->Finish(&status, tag(2));
+    need_tags = (1 << 0) | (1 << 1) | (1 << 2);
+    while (need_tags) {
+      TrickleCQNext(fixture.get(), &t, &ok, -1);
+      if (t == tag(0) && ok) {
+        request_rw->Read(&recv_response, tag(0));
+        continue;
+      }
+      int i = (int)(intptr_t)t;
+      GPR_ASSERT(need_tags & (1 << i));
+      need_tags &= ~(1 << i);
+    }
+  }
+  state.counters["ramp_up_ms"] =
+      ramped_up > 0 ? total_ramp_up_ms / ramped_up : -1;
+  state.counters["never_ramped_up"] = state.iterations() - ramped_up;
+  state.counters["peak_window_bytes"] = peak_announced_window;
+  state.SetLabel(strategy);
+}
+
+static void RampUpTrickleArgs(benchmark::internal::Benchmark* b) {
+  for (int strategy = 0; strategy < 2; strategy++) {
+    for (int kilobits = 100 * 1000; kilobits <= 1000 * 1000; kilobits *= 10) {
+      for (int rtt_ms = 10; rtt_ms <= 100; rtt_ms *= 10) {
+        b->Args({strategy, kilobits, rtt_ms});
+      }
+    }
+  }
+}
+BENCHMARK(BM_StreamingRampUp_Trickle)
+    ->Apply(RampUpTrickleArgs)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
 }  // namespace testing
 }  // namespace grpc
 
@@ -18,11 +18,15 @@
 
 /* Test out various metadata handling primitives */
 
+#include <string>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 #include <grpc/grpc.h>
 
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/transport/metadata.h"
+#include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/static_metadata.h"
 
 #include "test/cpp/microbenchmarks/helpers.h"
@@ -132,6 +136,39 @@ static void BM_MetadataFromInternedSlicesAlreadyInIndex(
 }
 BENCHMARK(BM_MetadataFromInternedSlicesAlreadyInIndex);
 
+// Each thread looks up the same few interned headers, as the calls of a busy
+// server do
+static void BM_MetadataFromInternedSlicesAcrossThreads(
+    benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  static const char* kValues[] = {"grpc-go/1.25.0", "grpc-java/1.25.0",
+                                  "grpc-c++/1.25.0", "grpc-python/1.25.0"};
+  constexpr size_t kNumValues = GPR_ARRAY_SIZE(kValues);
+  grpc_core::ManagedMemorySlice k("user-agent");
+  grpc_slice v[kNumValues];
+  grpc_mdelem seeds[kNumValues];
+  for (size_t i = 0; i < kNumValues; i++) {
+    v[i] = grpc_core::ManagedMemorySlice(kValues[i]);
+    seeds[i] = grpc_mdelem_create(k, v[i], nullptr);
+  }
+  size_t next = 0;
+  for (auto _ : state) {
+    GRPC_MDELEM_UNREF(grpc_mdelem_create(k, v[next], nullptr));
+    next = (next + 1) % kNumValues;
+  }
+  for (size_t i = 0; i < kNumValues; i++) {
+    GRPC_MDELEM_UNREF(seeds[i]);
+    grpc_slice_unref(v[i]);
+  }
+
+  grpc_slice_unref(k);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_MetadataFromInternedSlicesAcrossThreads)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
 static void BM_MetadataFromInternedKey(benchmark::State& state) {
   TrackCounters track_counters;
   grpc_core::ManagedMemorySlice k("key");
@@ -287,6 +324,106 @@ static void BM_MetadataRefUnrefStatic(benchmark::State& state) {
 }
 BENCHMARK(BM_MetadataRefUnrefStatic);
 
+// The life of the initial metadata of a client call: the application adds its
+// headers, the client filters prepend the http ones, the transport walks the
+// batch, and the server filters remove the headers they consume
+static void BM_MetadataBatchClientInitialMetadata(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_mdelem path = grpc_mdelem_from_slices(
+      grpc_slice_intern(grpc_slice_from_static_string(":path")),
+      grpc_slice_intern(grpc_slice_from_static_string("/foo/bar")));
+  grpc_mdelem authority = grpc_mdelem_from_slices(
+      grpc_slice_intern(grpc_slice_from_static_string(":authority")),
+      grpc_slice_intern(grpc_slice_from_static_string("foo.test.google.fr")));
+  grpc_mdelem user = grpc_mdelem_from_slices(
+      grpc_slice_intern(grpc_slice_from_static_string("x-user-key")),
+      grpc_slice_intern(grpc_slice_from_static_string("user-value")));
+  grpc_linked_mdelem storage[9];
+  for (auto _ : state) {
+    grpc_metadata_batch b;
+    grpc_metadata_batch_init(&b);
+    GPR_ASSERT(grpc_metadata_batch_add_tail(&b, &storage[0],
+                                            GRPC_MDELEM_REF(user)) ==
+               GRPC_ERROR_NONE);
+    GPR_ASSERT(grpc_metadata_batch_add_head(&b, &storage[1],
+                                            GRPC_MDELEM_REF(path),
+                                            GRPC_BATCH_PATH) ==
+               GRPC_ERROR_NONE);
+    GPR_ASSERT(grpc_metadata_batch_add_head(&b, &storage[2],
+                                            GRPC_MDELEM_REF(authority),
+                                            GRPC_BATCH_AUTHORITY) ==
+               GRPC_ERROR_NONE);
+    GPR_ASSERT(grpc_metadata_batch_add_head(&b, &storage[3],
+                                            GRPC_MDELEM_METHOD_POST,
+                                            GRPC_BATCH_METHOD) ==
+               GRPC_ERROR_NONE);
+    GPR_ASSERT(grpc_metadata_batch_add_head(&b, &storage[4],
+                                            GRPC_MDELEM_SCHEME_HTTP,
+                                            GRPC_BATCH_SCHEME) ==
+               GRPC_ERROR_NONE);
+    GPR_ASSERT(grpc_metadata_batch_add_tail(&b, &storage[5],
+                                            GRPC_MDELEM_TE_TRAILERS,
+                                            GRPC_BATCH_TE) == GRPC_ERROR_NONE);
+    GPR_ASSERT(grpc_metadata_batch_add_tail(
+                   &b, &storage[6],
+                   GRPC_MDELEM_CONTENT_TYPE_APPLICATION_SLASH_GRPC,
+                   GRPC_BATCH_CONTENT_TYPE) == GRPC_ERROR_NONE);
+    GPR_ASSERT(
+        grpc_metadata_batch_add_tail(
+            &b, &storage[7],
+            GRPC_MDELEM_GRPC_ACCEPT_ENCODING_IDENTITY_COMMA_DEFLATE_COMMA_GZIP,
+            GRPC_BATCH_GRPC_ACCEPT_ENCODING) == GRPC_ERROR_NONE);
+    GPR_ASSERT(grpc_metadata_batch_add_tail(
+                   &b, &storage[8],
+                   GRPC_MDELEM_ACCEPT_ENCODING_IDENTITY_COMMA_GZIP,
+                   GRPC_BATCH_ACCEPT_ENCODING) == GRPC_ERROR_NONE);
+    benchmark::DoNotOptimize(grpc_metadata_batch_size(&b));
+    grpc_metadata_batch_remove(&b, GRPC_BATCH_METHOD);
+    grpc_metadata_batch_remove(&b, GRPC_BATCH_SCHEME);
+    grpc_metadata_batch_remove(&b, GRPC_BATCH_TE);
+    grpc_metadata_batch_remove(&b, GRPC_BATCH_CONTENT_TYPE);
+    grpc_metadata_batch_destroy(&b);
+  }
+  GRPC_MDELEM_UNREF(path);
+  GRPC_MDELEM_UNREF(authority);
+  GRPC_MDELEM_UNREF(user);
+
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_MetadataBatchClientInitialMetadata);
+
+static grpc_filtered_mdelem keep_mdelem(void* user_data, grpc_mdelem md) {
+  return GRPC_FILTERED_MDELEM(md);
+}
+
+static void BM_MetadataBatchFilter(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  const size_t num_elems = static_cast<size_t>(state.range(0));
+  std::vector<grpc_linked_mdelem> storage(num_elems);
+  grpc_metadata_batch b;
+  grpc_metadata_batch_init(&b);
+  for (size_t i = 0; i < num_elems; i++) {
+    const std::string key = "x-key-" + std::to_string(i);
+    grpc_slice key_slice = grpc_slice_intern(
+        grpc_slice_from_static_buffer(key.data(), key.size()));
+    grpc_mdelem md = grpc_mdelem_from_slices(
+        key_slice,
+        grpc_slice_intern(grpc_slice_from_static_string("value")));
+    GPR_ASSERT(grpc_metadata_batch_add_tail(&b, &storage[i], md) ==
+               GRPC_ERROR_NONE);
+  }
+  for (auto _ : state) {
+    GPR_ASSERT(grpc_metadata_batch_filter(&b, keep_mdelem, nullptr,
+                                          "filter") == GRPC_ERROR_NONE);
+  }
+  grpc_metadata_batch_destroy(&b);
+
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_MetadataBatchFilter)->Arg(4)->Arg(12)->Arg(32);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -33,6 +33,7 @@
 #include "test/cpp/util/test_config.h"
 
 #include <string.h>
+#include <vector>
 
 #ifdef GRPC_LINUX_MULTIPOLL_WITH_EPOLL
 #include <sys/epoll.h>
@@ -255,6 +256,105 @@ static void BM_SingleThreadPollOneFd(benchmark::State& state) {
 }
 BENCHMARK(BM_SingleThreadPollOneFd);
 
+// The benchmarks below are meant to be run once per polling engine, e.g. with
+// GRPC_POLL_STRATEGY=epoll1 and GRPC_POLL_STRATEGY=iouring, comparing latency
+// and the syscall_poll/syscall_io_uring_submit counters per iteration.
+
+static void BM_SingleThreadPollManyFds(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t num_fds = static_cast<size_t>(state.range(0));
+  size_t ps_sz = grpc_pollset_size();
+  grpc_pollset* ps = static_cast<grpc_pollset*>(gpr_zalloc(ps_sz));
+  gpr_mu* mu;
+  grpc_pollset_init(ps, &mu);
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<grpc_wakeup_fd> wakeup_fds(num_fds);
+  std::vector<grpc_fd*> fds(num_fds);
+  std::vector<Closure*> closures(num_fds);
+  size_t pending = 0;
+  bool done = false;
+  for (size_t i = 0; i < num_fds; i++) {
+    GRPC_ERROR_UNREF(grpc_wakeup_fd_init(&wakeup_fds[i]));
+    fds[i] = grpc_fd_create(wakeup_fds[i].read_fd, "wakeup_read", false);
+    grpc_pollset_add_fd(ps, fds[i]);
+    closures[i] = MakeClosure(
+        [&, i]() {
+          if (done) return;
+          GRPC_ERROR_UNREF(grpc_wakeup_fd_consume_wakeup(&wakeup_fds[i]));
+          pending--;
+          grpc_fd_notify_on_read(fds[i], closures[i]);
+        },
+        grpc_schedule_on_exec_ctx);
+    grpc_fd_notify_on_read(fds[i], closures[i]);
+  }
+  gpr_mu_lock(mu);
+  for (auto _ : state) {
+    for (size_t i = 0; i < num_fds; i++) {
+      GRPC_ERROR_UNREF(grpc_wakeup_fd_wakeup(&wakeup_fds[i]));
+    }
+    pending = num_fds;
+    while (pending > 0) {
+      GRPC_ERROR_UNREF(grpc_pollset_work(ps, nullptr, GRPC_MILLIS_INF_FUTURE));
+    }
+  }
+  done = true;
+  for (size_t i = 0; i < num_fds; i++) {
+    grpc_fd_orphan(fds[i], nullptr, nullptr, "done");
+    wakeup_fds[i].read_fd = 0;
+  }
+  grpc_closure shutdown_ps_closure;
+  GRPC_CLOSURE_INIT(&shutdown_ps_closure, shutdown_ps, ps,
+                    grpc_schedule_on_exec_ctx);
+  grpc_pollset_shutdown(ps, &shutdown_ps_closure);
+  gpr_mu_unlock(mu);
+  grpc_core::ExecCtx::Get()->Flush();
+  for (size_t i = 0; i < num_fds; i++) {
+    grpc_wakeup_fd_destroy(&wakeup_fds[i]);
+    delete closures[i];
+  }
+  gpr_free(ps);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SingleThreadPollManyFds)->Range(1, 256);
+
+// Registers and orphans a batch of fds per iteration (as an accept storm
+// followed by disconnects would), with a non-blocking poll after each step.
+static void BM_CreateOrphanManyFds(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t num_fds = static_cast<size_t>(state.range(0));
+  size_t ps_sz = grpc_pollset_size();
+  grpc_pollset* ps = static_cast<grpc_pollset*>(gpr_zalloc(ps_sz));
+  gpr_mu* mu;
+  grpc_pollset_init(ps, &mu);
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<grpc_wakeup_fd> wakeup_fds(num_fds);
+  std::vector<grpc_fd*> fds(num_fds);
+  gpr_mu_lock(mu);
+  for (auto _ : state) {
+    for (size_t i = 0; i < num_fds; i++) {
+      GRPC_ERROR_UNREF(grpc_wakeup_fd_init(&wakeup_fds[i]));
+      fds[i] = grpc_fd_create(wakeup_fds[i].read_fd, "wakeup_read", false);
+      grpc_pollset_add_fd(ps, fds[i]);
+    }
+    GRPC_ERROR_UNREF(grpc_pollset_work(ps, nullptr, 0));
+    for (size_t i = 0; i < num_fds; i++) {
+      grpc_fd_orphan(fds[i], nullptr, nullptr, "done");
+      wakeup_fds[i].read_fd = 0;
+      grpc_wakeup_fd_destroy(&wakeup_fds[i]);
+    }
+    GRPC_ERROR_UNREF(grpc_pollset_work(ps, nullptr, 0));
+  }
+  grpc_closure shutdown_ps_closure;
+  GRPC_CLOSURE_INIT(&shutdown_ps_closure, shutdown_ps, ps,
+                    grpc_schedule_on_exec_ctx);
+  grpc_pollset_shutdown(ps, &shutdown_ps_closure);
+  gpr_mu_unlock(mu);
+  grpc_core::ExecCtx::Get()->Flush();
+  gpr_free(ps);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_CreateOrphanManyFds)->Range(1, 256);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -174,6 +174,31 @@ BENCHMARK(BM_ThreadPoolExternalAdd)
     ->RangePair(524288, 524288, 1, 1024)
     ->ThreadRange(1, 256);  // Concurrent external thread(s) up to 256
 
+// Performs the scenario of concurrent thread(s) putting elements into and
+// getting elements from the thread pool's queue directly, to measure queue
+// contention without closure execution overhead.
+template <class Queue>
+static void BM_MPMCQueuePutGet(benchmark::State& state) {
+  static grpc_core::MPMCQueueInterface* queue = nullptr;
+  if (state.thread_index == 0) {
+    queue = grpc_core::New<Queue>();
+  }
+  int item;
+  for (auto _ : state) {
+    queue->Put(&item);
+    // Every thread puts before it gets, so this never blocks for long.
+    benchmark::DoNotOptimize(queue->Get());
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index == 0) {
+    grpc_core::Delete(queue);
+  }
+}
+BENCHMARK_TEMPLATE(BM_MPMCQueuePutGet, grpc_core::InfLenFIFOQueue)
+    ->ThreadRange(1, 64);
+BENCHMARK_TEMPLATE(BM_MPMCQueuePutGet, grpc_core::InfLenLockFreeQueue)
+    ->ThreadRange(1, 64);
+
 // Functor (closure) that adds itself into pool repeatedly. By adding self, the
 // overhead would be low and can measure the time of add more accurately.
 class AddSelfFunctor : public grpc_experimental_completion_queue_functor {
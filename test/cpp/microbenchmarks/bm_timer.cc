@@ -17,6 +17,7 @@
  */
 
 #include <benchmark/benchmark.h>
+#include <stdlib.h>
 #include <string.h>
 #include <atomic>
 #include <vector>
@@ -29,6 +30,10 @@
 
 #include "src/core/lib/iomgr/timer.h"
 
+extern grpc_timer_vtable* grpc_timer_impl;
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
+
 namespace grpc {
 namespace testing {
 
@@ -99,6 +104,111 @@ BENCHMARK(BM_TimerBatch)
     ->Args({/*check=*/true, /*reverse=*/true})
     ->ThreadRange(1, 128);
 
+/* Keeps state.range(0) timers with deadlines spread over the next hour
+ * outstanding, as a server does with RPC deadlines and keepalives. The timer
+ * list is run outside of the timer manager, so that the heaps of
+ * timer_generic.cc and the wheels of timer_wheel.cc can be compared whichever
+ * of the two the library is currently running with. */
+template <grpc_timer_vtable* kVtable>
+class TimerBacklog {
+ public:
+  explicit TimerBacklog(size_t timer_count)
+      : owns_list_(kVtable != grpc_timer_impl),
+        offsets_(timer_count),
+        timer_closures_(timer_count) {
+    if (owns_list_) kVtable->list_init();
+    for (size_t i = 0; i < timer_count; i++) {
+      offsets_[i] = 1 + rand() % (3600 * 1000);
+    }
+    grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+    for (size_t i = 0; i < timer_count; i++) {
+      GRPC_CLOSURE_INIT(&timer_closures_[i].closure,
+                        [](void* /*args*/, grpc_error* /*err*/) {}, nullptr,
+                        grpc_schedule_on_exec_ctx);
+      kVtable->init(&timer_closures_[i].timer, now + offsets_[i],
+                    &timer_closures_[i].closure);
+    }
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+
+  ~TimerBacklog() {
+    for (auto& timer_closure : timer_closures_) {
+      kVtable->cancel(&timer_closure.timer);
+    }
+    grpc_core::ExecCtx::Get()->Flush();
+    if (owns_list_) kVtable->list_shutdown();
+  }
+
+  /* Cancels a timer if it is still pending and sets it again. Timers are
+     visited in a scattered order, as the timers of unrelated calls would be,
+     rather than in the order they are laid out in memory. */
+  void Rearm(size_t i, grpc_millis now) {
+    TimerClosure* timer_closure =
+        &timer_closures_[(i * 7919) % timer_closures_.size()];
+    kVtable->cancel(&timer_closure->timer);
+    kVtable->init(&timer_closure->timer, now + offsets_[i],
+                  &timer_closure->closure);
+  }
+
+  size_t size() const { return timer_closures_.size(); }
+
+ private:
+  const bool owns_list_;
+  std::vector<grpc_millis> offsets_;
+  std::vector<TimerClosure> timer_closures_;
+};
+
+/* Re-arms one timer of the backlog per iteration, without time passing. */
+template <grpc_timer_vtable* kVtable>
+static void BM_TimerRearmWithBacklog(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  TimerBacklog<kVtable> backlog(static_cast<size_t>(state.range(0)));
+  const grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  size_t i = 0;
+  for (auto _ : state) {
+    backlog.Rearm(i, now);
+    exec_ctx.Flush();
+    if (++i == backlog.size()) i = 0;
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK_TEMPLATE(BM_TimerRearmWithBacklog, &grpc_generic_timer_vtable)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_TimerRearmWithBacklog, &grpc_wheel_timer_vtable)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
+/* Advances a simulated clock by a millisecond per iteration, re-arming one
+ * timer of the backlog and firing the timers that came due. */
+template <grpc_timer_vtable* kVtable>
+static void BM_TimerExpiryWithBacklog(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  TimerBacklog<kVtable> backlog(static_cast<size_t>(state.range(0)));
+  grpc_millis now = grpc_core::ExecCtx::Get()->Now();
+  size_t i = 0;
+  for (auto _ : state) {
+    exec_ctx.TestOnlySetNow(++now);
+    backlog.Rearm(i, now);
+    kVtable->check(nullptr);
+    exec_ctx.Flush();
+    if (++i == backlog.size()) i = 0;
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK_TEMPLATE(BM_TimerExpiryWithBacklog, &grpc_generic_timer_vtable)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_TimerExpiryWithBacklog, &grpc_wheel_timer_vtable)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -0,0 +1,124 @@
+/*
+ *
+ * Copyright 2019 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark batched UDP datagram I/O over loopback */
+
+#include <benchmark/benchmark.h>
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_POSIX_SOCKET
+
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "src/core/lib/iomgr/socket_utils_posix.h"
+#include "src/core/lib/iomgr/udp_server.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+static int BindLoopbackUdpSocket(grpc_resolved_address* resolved_addr) {
+  struct sockaddr_in* addr =
+      reinterpret_cast<struct sockaddr_in*>(resolved_addr->addr);
+  memset(resolved_addr, 0, sizeof(*resolved_addr));
+  resolved_addr->len = static_cast<socklen_t>(sizeof(struct sockaddr_in));
+  addr->sin_family = AF_INET;
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  GPR_ASSERT(fd >= 0);
+  GPR_ASSERT(grpc_set_socket_nonblocking(fd, 1) == GRPC_ERROR_NONE);
+  GPR_ASSERT(grpc_set_socket_rcvbuf(fd, 4 * 1024 * 1024) == GRPC_ERROR_NONE);
+  GPR_ASSERT(bind(fd, reinterpret_cast<struct sockaddr*>(addr),
+                  resolved_addr->len) == 0);
+  GPR_ASSERT(getsockname(fd, reinterpret_cast<struct sockaddr*>(addr),
+                         &resolved_addr->len) == 0);
+  return fd;
+}
+
+/* Sends batch datagrams of the given size to a loopback socket and receives
+ * them back, batch datagrams per syscall on each side. Items processed is the
+ * number of datagrams, so items/s is datagrams/sec for one core doing both
+ * sides. Batch size 1 is the one datagram per syscall baseline. */
+static void BM_UdpSendRecvDatagrams(benchmark::State& state) {
+  TrackCounters track_counters;
+  const size_t batch = static_cast<size_t>(state.range(0));
+  const size_t size = static_cast<size_t>(state.range(1));
+  grpc_resolved_address sender_addr;
+  grpc_resolved_address receiver_addr;
+  int sender_fd = BindLoopbackUdpSocket(&sender_addr);
+  int receiver_fd = BindLoopbackUdpSocket(&receiver_addr);
+  GrpcUdpBatchIo sender(batch, size);
+  GrpcUdpBatchIo receiver(batch, size);
+  std::vector<uint8_t> payload(size, 'x');
+  std::vector<GrpcUdpDatagram> datagrams(batch);
+  for (auto& d : datagrams) {
+    d.addr = receiver_addr;
+    d.data = payload.data();
+    d.length = size;
+  }
+  for (auto _ : state) {
+    size_t sent = 0;
+    while (sent < batch) {
+      int n = sender.SendBatch(sender_fd, datagrams.data() + sent, batch - sent);
+      GPR_ASSERT(n >= 0);
+      sent += n;
+    }
+    size_t received = 0;
+    while (received < batch) {
+      int n = receiver.RecvBatch(receiver_fd);
+      GPR_ASSERT(n >= 0);
+      received += n;
+    }
+  }
+  close(sender_fd);
+  close(receiver_fd);
+  state.SetItemsProcessed(state.iterations() * batch);
+  state.SetBytesProcessed(state.iterations() * batch * size);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_UdpSendRecvDatagrams)
+    ->ArgPair(1, 64)
+    ->ArgPair(8, 64)
+    ->ArgPair(32, 64)
+    ->ArgPair(64, 64)
+    ->ArgPair(1, 1200)
+    ->ArgPair(8, 1200)
+    ->ArgPair(32, 1200)
+    ->ArgPair(64, 1200);
+
+#endif /* GRPC_POSIX_SOCKET */
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  ::grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -101,5 +101,9 @@ void ValidateGetServersResponseProtoJsonTranslation(char* json_c_str) {
       json_c_str);
 }
 
+void ValidateSocketProtoJsonTranslation(char* json_c_str) {
+  VaidateProtoJsonTranslation<grpc::channelz::v1::Socket>(json_c_str);
+}
+
 }  // namespace testing
 }  // namespace grpc
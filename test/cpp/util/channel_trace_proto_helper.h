@@ -30,6 +30,7 @@ void ValidateGetServerResponseProtoJsonTranslation(char* json_c_str);
 void ValidateSubchannelProtoJsonTranslation(char* json_c_str);
 void ValidateServerProtoJsonTranslation(char* json_c_str);
 void ValidateGetServersResponseProtoJsonTranslation(char* json_c_str);
+void ValidateSocketProtoJsonTranslation(char* json_c_str);
 
 }  // namespace testing
 }  // namespace grpc
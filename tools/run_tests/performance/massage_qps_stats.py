@@ -30,6 +30,12 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_server_calls_created"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_calls_created")
+            stats[
+                "core_call_arena_pool_hits"] = massage_qps_stats_helpers.counter(
+                    core_stats, "call_arena_pool_hits")
+            stats[
+                "core_call_arena_pool_misses"] = massage_qps_stats_helpers.counter(
+                    core_stats, "call_arena_pool_misses")
             stats["core_cqs_created"] = massage_qps_stats_helpers.counter(
                 core_stats, "cqs_created")
             stats[
@@ -45,6 +51,13 @@ def massage_qps_stats(scenario_result):
                 core_stats, "syscall_poll")
             stats["core_syscall_wait"] = massage_qps_stats_helpers.counter(
                 core_stats, "syscall_wait")
+            stats[
+                "core_syscall_io_uring_submit"] = massage_qps_stats_helpers.counter(
+                    core_stats, "syscall_io_uring_submit")
+            stats["core_poll_spin_hits"] = massage_qps_stats_helpers.counter(
+                core_stats, "poll_spin_hits")
+            stats["core_poll_spin_sleeps"] = massage_qps_stats_helpers.counter(
+                core_stats, "poll_spin_sleeps")
             stats["core_pollset_kick"] = massage_qps_stats_helpers.counter(
                 core_stats, "pollset_kick")
             stats[
@@ -80,6 +93,32 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_tcp_backup_poller_polls"] = massage_qps_stats_helpers.counter(
                     core_stats, "tcp_backup_poller_polls")
+            stats[
+                "core_tcp_zerocopy_sends"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_zerocopy_sends")
+            stats[
+                "core_tcp_zerocopy_fallbacks"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_zerocopy_fallbacks")
+            stats["core_tcp_read_allocs"] = massage_qps_stats_helpers.counter(
+                core_stats, "tcp_read_allocs")
+            stats[
+                "core_tcp_read_alloc_bytes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_read_alloc_bytes")
+            stats[
+                "core_tcp_read_used_bytes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_read_used_bytes")
+            stats[
+                "core_tcp_read_slab_reuses"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_read_slab_reuses")
+            stats[
+                "core_resource_quota_buffer_pool_hits"] = massage_qps_stats_helpers.counter(
+                    core_stats, "resource_quota_buffer_pool_hits")
+            stats[
+                "core_resource_quota_buffer_pool_misses"] = massage_qps_stats_helpers.counter(
+                    core_stats, "resource_quota_buffer_pool_misses")
+            stats[
+                "core_resource_quota_buffer_pool_flushes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "resource_quota_buffer_pool_flushes")
             stats["core_http2_op_batches"] = massage_qps_stats_helpers.counter(
                 core_stats, "http2_op_batches")
             stats["core_http2_op_cancel"] = massage_qps_stats_helpers.counter(
@@ -119,6 +158,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_partial_writes"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_partial_writes")
+            stats[
+                "core_http2_writes_corked"] = massage_qps_stats_helpers.counter(
+                    core_stats, "http2_writes_corked")
             stats[
                 "core_http2_initiate_write_due_to_initial_write"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_initiate_write_due_to_initial_write")
@@ -260,6 +302,15 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_hpack_send_binary_base64"] = massage_qps_stats_helpers.counter(
                     core_stats, "hpack_send_binary_base64")
+            stats[
+                "core_hpack_send_raw_bytes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "hpack_send_raw_bytes")
+            stats[
+                "core_hpack_send_encoded_bytes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "hpack_send_encoded_bytes")
+            stats[
+                "core_hpack_send_index_rejected"] = massage_qps_stats_helpers.counter(
+                    core_stats, "hpack_send_index_rejected")
             stats[
                 "core_combiner_locks_initiated"] = massage_qps_stats_helpers.counter(
                     core_stats, "combiner_locks_initiated")
@@ -302,12 +353,20 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_executor_push_retries"] = massage_qps_stats_helpers.counter(
                     core_stats, "executor_push_retries")
+            stats["core_executor_steals"] = massage_qps_stats_helpers.counter(
+                core_stats, "executor_steals")
+            stats[
+                "core_executor_stolen_items"] = massage_qps_stats_helpers.counter(
+                    core_stats, "executor_stolen_items")
             stats[
                 "core_server_requested_calls"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_requested_calls")
             stats[
                 "core_server_slowpath_requests_queued"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_slowpath_requests_queued")
+            stats[
+                "core_server_pending_calls_stolen"] = massage_qps_stats_helpers.counter(
+                    core_stats, "server_pending_calls_stolen")
             stats[
                 "core_cq_ev_queue_trylock_failures"] = massage_qps_stats_helpers.counter(
                     core_stats, "cq_ev_queue_trylock_failures")
@@ -494,6 +553,51 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_send_flowctl_per_write_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "http2_frames_per_write")
+            stats["core_http2_frames_per_write"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_http2_frames_per_write_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_http2_frames_per_write_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_http2_frames_per_write_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_http2_frames_per_write_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "http2_write_size")
+            stats["core_http2_write_size"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_http2_write_size_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_http2_write_size_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_http2_write_size_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_http2_write_size_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "executor_queue_depth")
+            stats["core_executor_queue_depth"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_executor_queue_depth_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_executor_queue_depth_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_executor_queue_depth_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_executor_queue_depth_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
             h = massage_qps_stats_helpers.histogram(core_stats,
                                                     "server_cqs_checked")
             stats["core_server_cqs_checked"] = ",".join(
@@ -442,6 +442,22 @@ class CXXLanguage:
                 server_threads_per_cq=2,
                 categories=inproc_categories + [SCALABLE])
 
+            # Sweep the number of server completion queues, with one thread
+            # each: request matching is sharded by completion queue
+            for server_cqs in geometric_progression(1, 65, 2):
+                yield _ping_pong_scenario(
+                    'cpp_protobuf_async_unary_qps_unconstrained_%d_server_cqs_%s'
+                    % (server_cqs, secstr),
+                    rpc_type='UNARY',
+                    client_type='ASYNC_CLIENT',
+                    server_type='ASYNC_SERVER',
+                    unconstrained_client='async',
+                    secure=secure,
+                    async_server_threads=server_cqs,
+                    server_threads_per_cq=1,
+                    channels=64,
+                    categories=[SWEEP])
+
             yield _ping_pong_scenario(
                 'cpp_generic_async_streaming_qps_one_server_core_%s' % secstr,
                 rpc_type='STREAMING',